@@ -31,6 +31,7 @@
 
 #include "badblocks.h"
 #include "file.h"
+#include "winio.h"
 
 FILE* log_fd = NULL;
 static const char abort_msg[] = "Too many bad blocks, aborting test\n";
@@ -238,6 +239,9 @@ static uint32_t num_corruption_errors = 0;
 static bb_badblocks_list bb_list = NULL;
 static blk64_t next_bad = 0;
 static bb_badblocks_iterate bb_iter = NULL;
+static const unsigned int bb_pattern[BADLOCKS_PATTERN_TYPES][BADBLOCK_PATTERN_COUNT] =
+	{ BADBLOCK_PATTERN_ONE_PASS, BADBLOCK_PATTERN_TWO_PASSES, BADBLOCK_PATTERN_SLC,
+	  BADCLOCK_PATTERN_MLC, BADBLOCK_PATTERN_TLC };
 
 static __inline void *allocate_buffer(size_t size) {
 	return _mm_malloc(size, BB_SYS_PAGE_SIZE);
@@ -331,6 +335,7 @@ static void pattern_fill(unsigned char *buffer, unsigned int pattern,
 {
 	unsigned int	i, nb;
 	unsigned char	bpattern[sizeof(pattern)], *ptr;
+	size_t		len;
 
 	if (pattern == (unsigned int) ~0) {
 		PrintInfo(3500, MSG_236);
@@ -349,13 +354,11 @@ static void pattern_fill(unsigned char *buffer, unsigned int pattern,
 			pattern = pattern >> 8;
 		}
 		nb = i ? (i-1) : 0;
-		for (ptr = buffer, i = nb; ptr < buffer + n; ptr++) {
-			*ptr = bpattern[i];
-			if (i == 0)
-				i = nb;
-			else
-				i--;
-		}
+		for (i = 0; (i <= nb) && (i < n); i++)
+			buffer[i] = bpattern[nb - i];
+		/* Replicate the pattern by doubling the filled area, so that memcpy() does the work */
+		for (len = i; len < n; len *= 2)
+			memcpy(buffer + len, buffer, min(len, n - len));
 		cur_pattern++;
 	}
 }
@@ -404,33 +407,38 @@ static int64_t do_write(HANDLE hDrive, unsigned char * buffer, uint64_t tryout,
 	return got;
 }
 
-static unsigned int test_rw(HANDLE hDrive, blk64_t last_block, size_t block_size, blk64_t first_block,
-							size_t blocks_at_once, int pattern_type, int nb_passes)
+static BOOL check_params(blk64_t last_block, size_t block_size, blk64_t first_block,
+			 int pattern_type, int nb_passes)
 {
-	const unsigned int pattern[BADLOCKS_PATTERN_TYPES][BADBLOCK_PATTERN_COUNT] =
-		{ BADBLOCK_PATTERN_ONE_PASS, BADBLOCK_PATTERN_TWO_PASSES, BADBLOCK_PATTERN_SLC,
-		  BADCLOCK_PATTERN_MLC, BADBLOCK_PATTERN_TLC };
-	unsigned char *buffer = NULL, *read_buffer;
-	int i, pat_idx;
-	unsigned int bb_count = 0;
-	blk64_t got, tryout, recover_block = ~0, *blk_id;
-	size_t id_offset = 0;
-
 	if ((pattern_type < 0) || (pattern_type >= BADLOCKS_PATTERN_TYPES)) {
 		uprintf("%sInvalid pattern type\n", bb_prefix);
 		cancel_ops = -1;
-		return 0;
+		return FALSE;
 	}
 	if ((nb_passes < 1) || (nb_passes > BADBLOCK_PATTERN_COUNT)) {
 		uprintf("%sInvalid number of passes\n", bb_prefix);
 		cancel_ops = -1;
-		return 0;
+		return FALSE;
 	}
 	if ((first_block * block_size > 1 * PB) || (last_block * block_size > 1 * PB)) {
 		uprintf("%sDisk is too large\n", bb_prefix);
 		cancel_ops = -1;
-		return 0;
+		return FALSE;
 	}
+	return TRUE;
+}
+
+static unsigned int test_rw(HANDLE hDrive, blk64_t last_block, size_t block_size, blk64_t first_block,
+							size_t blocks_at_once, int pattern_type, int nb_passes)
+{
+	unsigned char *buffer = NULL, *read_buffer;
+	int i, pat_idx;
+	unsigned int bb_count = 0;
+	blk64_t got, tryout, recover_block = ~0, *blk_id;
+	size_t id_offset = 0;
+
+	if (!check_params(last_block, block_size, first_block, pattern_type, nb_passes))
+		return 0;
 
 	buffer = allocate_buffer(2 * blocks_at_once * block_size);
 	if (!buffer) {
@@ -455,11 +463,11 @@ static unsigned int test_rw(HANDLE hDrive, blk64_t last_block, size_t block_size
 			uprintf("%sUsing offset %zu for fake device check\n", bb_prefix, id_offset);
 		}
 		// coverity[dont_call]
-		pattern_fill(buffer, pattern[pattern_type][pat_idx], blocks_at_once * block_size);
+		pattern_fill(buffer, bb_pattern[pattern_type][pat_idx], blocks_at_once * block_size);
 		num_blocks = last_block - 1;
 		currently_testing = first_block;
 		if (s_flag | v_flag)
-			uprintf("%sWriting test pattern 0x%02X\n", bb_prefix, pattern[pattern_type][pat_idx]);
+			uprintf("%sWriting test pattern 0x%02X\n", bb_prefix, bb_pattern[pattern_type][pat_idx]);
 		cur_op = OP_WRITE;
 		tryout = blocks_at_once;
 		while (currently_testing < last_block) {
@@ -566,11 +574,309 @@ out:
 	return bb_count;
 }
 
+/*
+ * Asynchronous engine.
+ * Rather than alternating synchronous writes and reads of a single buffer, we
+ * keep multiple overlapped I/Os in flight and check the data that was read
+ * back on a separate thread. Chunks of BB_BLOCKS_PER_IO blocks are processed
+ * in order, through a ring of slots, where each slot goes through issue,
+ * completion (where failed I/Os are retried one block at a time, so that bad
+ * blocks are accounted for as with test_rw()), verification and collection.
+ */
+enum bb_slot_state { BB_SLOT_FREE = 0, BB_SLOT_PENDING, BB_SLOT_FAILED, BB_SLOT_VERIFYING };
+
+typedef struct {
+	OVERLAPPED	overlapped;
+	unsigned char	*buffer;
+	blk64_t		block;				/* First block of the chunk */
+	blk64_t		count;				/* Number of blocks in the chunk */
+	int		state;
+	HANDLE		verified;			/* Signaled once the chunk has been checked */
+	uint8_t		unreadable[BB_BLOCKS_PER_IO];
+	uint8_t		corrupted[BB_BLOCKS_PER_IO];
+} bb_slot;
+
+typedef struct {
+	HANDLE		hDrive;				/* Synchronous handle, used for retries */
+	HANDLE		hAsync;				/* Overlapped handle */
+	HANDLE		hThread;
+	HANDLE		hWork;				/* Semaphore for the chunks to check */
+	bb_slot		*work[BB_QUEUE_DEPTH];		/* Ring of the slots to check */
+	DWORD		nb_queued;			/* Number of slots added to the ring */
+	volatile LONG	quit;
+	unsigned char	*pattern;			/* Reference data for BB_BLOCKS_PER_IO blocks */
+	unsigned char	*buffers;
+	size_t		block_size;
+	size_t		id_offset;
+	BOOL		stamp_ids;
+	bb_slot		slot[BB_QUEUE_DEPTH];
+} bb_engine;
+
+static BOOL check_block(bb_engine *e, const unsigned char *data, const unsigned char *expected, blk64_t block)
+{
+	size_t end = e->id_offset + sizeof(blk64_t);
+
+	if (!e->stamp_ids)
+		return IsBufferEqual(data, expected, e->block_size);
+	return IsBufferEqual(data, expected, e->id_offset) &&
+		(*(blk64_t*)(intptr_t)(data + e->id_offset) == block) &&
+		IsBufferEqual(data + end, expected + end, e->block_size - end);
+}
+
+/*
+ * Each pass restarts at the first slot, so the slots to check are handed over
+ * through the work ring, rather than assumed to follow each other across passes.
+ * A slot is only queued again once it has been collected, so the ring can't
+ * hold more than BB_QUEUE_DEPTH entries.
+ */
+static DWORD WINAPI verify_thread(LPVOID param)
+{
+	bb_engine *e = (bb_engine*)param;
+	bb_slot *s;
+	blk64_t i;
+	DWORD n = 0;
+
+	while ((WaitForSingleObject(e->hWork, INFINITE) == WAIT_OBJECT_0) && !e->quit) {
+		s = e->work[n++ % BB_QUEUE_DEPTH];
+		for (i = 0; i < s->count; i++)
+			s->corrupted[i] = !s->unreadable[i] && !check_block(e, s->buffer + i * e->block_size,
+				e->pattern + i * e->block_size, s->block + i);
+		SetEvent(s->verified);
+	}
+	return 0;
+}
+
+static void issue_io(bb_engine *e, bb_slot *s, int op, blk64_t block, blk64_t count)
+{
+	uint64_t offset = block * e->block_size;
+	DWORD size = (DWORD)(count * e->block_size);
+	blk64_t i;
+	BOOL r;
+
+	s->block = block;
+	s->count = count;
+	s->overlapped.Offset = (DWORD)offset;
+	s->overlapped.OffsetHigh = (DWORD)(offset >> 32);
+	memset(s->unreadable, 0, sizeof(s->unreadable));
+	if (op == OP_WRITE) {
+		/* Add the block number at a fixed (random) offset during the first pass to
+		   allow for the detection of 'fake' media (eg. 2GB USB masquerading as 16GB) */
+		for (i = 0; e->stamp_ids && (i < count); i++)
+			*(blk64_t*)(intptr_t)(s->buffer + e->id_offset + i * e->block_size) = block + i;
+		r = WriteFile(e->hAsync, s->buffer, size, NULL, &s->overlapped);
+	} else {
+		r = ReadFile(e->hAsync, s->buffer, size, NULL, &s->overlapped);
+	}
+	s->state = (r || (GetLastError() == ERROR_IO_PENDING)) ? BB_SLOT_PENDING : BB_SLOT_FAILED;
+}
+
+/*
+ * Wait for the I/O of a chunk to complete and, if it failed or was short,
+ * retry it one block at a time to find out which blocks are bad.
+ */
+static unsigned int complete_io(bb_engine *e, bb_slot *s, int op)
+{
+	DWORD size = 0;
+	blk64_t i, got;
+	unsigned int bb_count = 0;
+
+	if ((s->state != BB_SLOT_PENDING) ||
+		!GetOverlappedResult(e->hAsync, &s->overlapped, &size, TRUE) ||
+		(size != s->count * e->block_size)) {
+		for (i = 0; (i < s->count) && !cancel_ops; i++) {
+			got = (op == OP_WRITE) ?
+				do_write(e->hDrive, s->buffer + i * e->block_size, 1, e->block_size, s->block + i) :
+				do_read(e->hDrive, s->buffer + i * e->block_size, 1, e->block_size, s->block + i);
+			if (got == 0) {
+				s->unreadable[i] = 1;
+				bb_count += bb_output(s->block + i, (op == OP_WRITE) ? WRITE_ERROR : READ_ERROR);
+			}
+		}
+	}
+	s->state = BB_SLOT_FREE;
+	currently_testing = s->block + s->count;
+	return bb_count;
+}
+
+/*
+ * Report the corrupted blocks of a chunk once it has been checked.
+ */
+static unsigned int collect_io(bb_engine *e, bb_slot *s)
+{
+	blk64_t i;
+	unsigned int bb_count = 0;
+
+	if (s->state != BB_SLOT_VERIFYING)
+		return 0;
+	WaitForSingleObject(s->verified, INFINITE);
+	for (i = 0; i < s->count; i++) {
+		if (s->corrupted[i])
+			bb_count += bb_output(s->block + i, CORRUPTION_ERROR);
+	}
+	s->state = BB_SLOT_FREE;
+	return bb_count;
+}
+
+/*
+ * Write or read back the [first_block, last_block[ range. At step k, we collect
+ * the chunk that last used the slot, issue chunk k and complete chunk k - lag,
+ * so that lag I/Os are in flight while the next chunk to collect gets checked.
+ */
+static BOOL run_pass(bb_engine *e, int op, blk64_t first_block, blk64_t last_block, unsigned int *bb_count)
+{
+	const uint64_t lag = BB_QUEUE_DEPTH - 2;
+	uint64_t k, nb_chunks = (last_block - first_block + BB_BLOCKS_PER_IO - 1) / BB_BLOCKS_PER_IO;
+	uint64_t last_status = GetTickCount64();
+	blk64_t block;
+	bb_slot *s;
+
+	cur_op = op;
+	currently_testing = first_block;
+	for (k = 0; k < nb_chunks + BB_QUEUE_DEPTH; k++) {
+		if (cancel_ops)
+			return FALSE;
+		if (ErrorStatus) {
+			uprintf("%sInterrupting at block %" PRIu64 "\n", bb_prefix,
+				(unsigned long long) currently_testing);
+			cancel_ops = -1;
+			return FALSE;
+		}
+		if (max_bb && *bb_count >= max_bb) {
+			if (s_flag || v_flag) {
+				uprintf(abort_msg);
+				fprintf(log_fd, "%s", abort_msg);
+				fflush(log_fd);
+			}
+			cancel_ops = -1;
+			return FALSE;
+		}
+		s = &e->slot[k % BB_QUEUE_DEPTH];
+		*bb_count += collect_io(e, s);
+		if (k < nb_chunks) {
+			block = first_block + k * BB_BLOCKS_PER_IO;
+			issue_io(e, s, op, block, min(BB_BLOCKS_PER_IO, last_block - block));
+		}
+		if ((k >= lag) && (k - lag < nb_chunks)) {
+			s = &e->slot[(k - lag) % BB_QUEUE_DEPTH];
+			*bb_count += complete_io(e, s, op);
+			if (op == OP_READ) {
+				s->state = BB_SLOT_VERIFYING;
+				e->work[e->nb_queued++ % BB_QUEUE_DEPTH] = s;
+				ReleaseSemaphore(e->hWork, 1, NULL);
+			}
+			/* Progress is driven by I/O completion */
+			if (GetTickCount64() >= last_status + BB_STATUS_INTERVAL) {
+				print_status();
+				last_status = GetTickCount64();
+			}
+		}
+	}
+	print_status();
+	return TRUE;
+}
+
+static unsigned int test_rw_async(HANDLE hDrive, HANDLE hAsync, blk64_t last_block, size_t block_size,
+				  blk64_t first_block, int pattern_type, int nb_passes)
+{
+	const size_t chunk_size = BB_BLOCKS_PER_IO * block_size;
+	bb_engine e = { 0 };
+	unsigned int bb_count = 0;
+	DWORD size;
+	int i, pat_idx;
+
+	if (!check_params(last_block, block_size, first_block, pattern_type, nb_passes))
+		return 0;
+
+	e.hDrive = hDrive;
+	e.hAsync = hAsync;
+	e.block_size = block_size;
+	e.pattern = allocate_buffer(chunk_size);
+	e.buffers = allocate_buffer(BB_QUEUE_DEPTH * chunk_size);
+	e.hWork = CreateSemaphore(NULL, 0, BB_QUEUE_DEPTH + 1, NULL);
+	for (i = 0; i < BB_QUEUE_DEPTH; i++) {
+		e.slot[i].overlapped.hEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+		e.slot[i].verified = CreateEvent(NULL, FALSE, FALSE, NULL);
+		if ((e.slot[i].overlapped.hEvent == NULL) || (e.slot[i].verified == NULL))
+			break;
+	}
+	if ((e.pattern == NULL) || (e.buffers == NULL) || (e.hWork == NULL) || (i < BB_QUEUE_DEPTH)) {
+		uprintf("%sError while allocating buffers\n", bb_prefix);
+		cancel_ops = -1;
+		goto out;
+	}
+	for (i = 0; i < BB_QUEUE_DEPTH; i++)
+		e.slot[i].buffer = e.buffers + i * chunk_size;
+	e.hThread = CreateThread(NULL, 0, verify_thread, &e, 0, NULL);
+	if (e.hThread == NULL) {
+		uprintf("%sUnable to start verification thread: %s\n", bb_prefix, WindowsErrorString());
+		cancel_ops = -1;
+		goto out;
+	}
+
+	uprintf("%sChecking from block %lu to %lu (1 block = %s)\n", bb_prefix,
+		(unsigned long) first_block, (unsigned long) last_block - 1,
+		SizeToHumanReadable(BADBLOCK_BLOCK_SIZE, FALSE, FALSE));
+	nr_pattern = nb_passes;
+	cur_pattern = 0;
+
+	for (pat_idx = 0; pat_idx < nb_passes; pat_idx++) {
+		if (cancel_ops)
+			goto out;
+		e.stamp_ids = detect_fakes && (pat_idx == 0);
+		if (e.stamp_ids) {
+			srand((unsigned int)GetTickCount64());
+			// coverity[dont_call]
+			e.id_offset = (size_t)((uint64_t)rand() * (block_size - sizeof(blk64_t)) / RAND_MAX);
+			uprintf("%sUsing offset %zu for fake device check\n", bb_prefix, e.id_offset);
+		}
+		pattern_fill(e.pattern, bb_pattern[pattern_type][pat_idx], chunk_size);
+		for (i = 0; i < BB_QUEUE_DEPTH; i++)
+			memcpy(e.slot[i].buffer, e.pattern, chunk_size);
+
+		if (s_flag | v_flag)
+			uprintf("%sWriting test pattern 0x%02X\n", bb_prefix, bb_pattern[pattern_type][pat_idx]);
+		num_blocks = last_block - 1;
+		if (!run_pass(&e, OP_WRITE, first_block, last_block, &bb_count))
+			goto out;
+
+		if (s_flag | v_flag)
+			uprintf("%sReading and comparing\n", bb_prefix);
+		num_blocks = last_block;
+		if (!run_pass(&e, OP_READ, first_block, last_block, &bb_count))
+			goto out;
+		num_blocks = 0;
+	}
+
+out:
+	num_blocks = 0;
+	/* Make sure that no I/O is still targeting our buffers before we free them */
+	CancelIoEx(hAsync, NULL);
+	for (i = 0; i < BB_QUEUE_DEPTH; i++) {
+		if (e.slot[i].state == BB_SLOT_PENDING)
+			GetOverlappedResult(hAsync, &e.slot[i].overlapped, &size, TRUE);
+	}
+	if (e.hThread != NULL) {
+		InterlockedExchange(&e.quit, 1);
+		ReleaseSemaphore(e.hWork, 1, NULL);
+		WaitForSingleObject(e.hThread, INFINITE);
+		CloseHandle(e.hThread);
+	}
+	for (i = 0; i < BB_QUEUE_DEPTH; i++) {
+		safe_closehandle(e.slot[i].overlapped.hEvent);
+		safe_closehandle(e.slot[i].verified);
+	}
+	safe_closehandle(e.hWork);
+	free_buffer(e.buffers);
+	free_buffer(e.pattern);
+	return bb_count;
+}
+
 BOOL BadBlocks(HANDLE hPhysicalDrive, ULONGLONG disk_size, int nb_passes,
 			   int flash_type, badblocks_report *report, FILE* fd)
 {
 	errcode_t error_code;
 	blk64_t last_block = disk_size / BADBLOCK_BLOCK_SIZE;
+	HANDLE hAsync;
 
 	if (report == NULL) return FALSE;
 	num_read_errors = 0;
@@ -590,10 +896,17 @@ BOOL BadBlocks(HANDLE hPhysicalDrive, ULONGLONG disk_size, int nb_passes,
 	}
 
 	cancel_ops = 0;
-	/* use a timer to update status every second */
-	SetTimer(hMainDialog, TID_BADBLOCKS_UPDATE, 1000, alarm_intr);
-	report->bb_count = test_rw(hPhysicalDrive, last_block, BADBLOCK_BLOCK_SIZE, 0, BB_BLOCKS_AT_ONCE, flash_type, nb_passes);
-	KillTimer(hMainDialog, TID_BADBLOCKS_UPDATE);
+	hAsync = ReOpenFileAsync(hPhysicalDrive, GENERIC_READ | GENERIC_WRITE);
+	if (hAsync != NULL) {
+		report->bb_count = test_rw_async(hPhysicalDrive, hAsync, last_block, BADBLOCK_BLOCK_SIZE, 0, flash_type, nb_passes);
+		CloseHandle(hAsync);
+	} else {
+		uprintf("%sCould not reopen drive for overlapped I/O: %s\n", bb_prefix, WindowsErrorString());
+		/* use a timer to update status every second */
+		SetTimer(hMainDialog, TID_BADBLOCKS_UPDATE, 1000, alarm_intr);
+		report->bb_count = test_rw(hPhysicalDrive, last_block, BADBLOCK_BLOCK_SIZE, 0, BB_BLOCKS_AT_ONCE, flash_type, nb_passes);
+		KillTimer(hMainDialog, TID_BADBLOCKS_UPDATE);
+	}
 	free(bb_list->list);
 	free(bb_list);
 	report->num_read_errors = num_read_errors;
@@ -604,3 +917,352 @@ BOOL BadBlocks(HANDLE hPhysicalDrive, ULONGLONG disk_size, int nb_passes,
 		return FALSE;
 	return TRUE;
 }
+
+/*
+ * Fake capacity probe.
+ * Counterfeit drives report a larger capacity than they have and, past their
+ * actual capacity, either fail, drop writes or wrap around. So, rather than
+ * writing the whole drive, we stamp a sample of units across the advertised
+ * capacity with their unit number, at a random offset (as test_rw() does for
+ * its fake drive check), and read them back. The sample contains units at
+ * b + 2^k, all of which end up on b if the drive wraps around at a power of
+ * two, a random unit in each [2^k, 2^(k+1)[ range, and random units spread
+ * across the whole drive. All the units are written, flushed and pushed out
+ * of the drive's cache before any of them is read back, so that a drive that
+ * only caches what it fails to store can't serve them from its cache.
+ * If units alias each other, the capacity is found from their distance, else
+ * we narrow down the range between the last good and the first bad unit.
+ * Since only a sample is tested, a drive that passes may still be fake, but
+ * one that fails definitely is.
+ */
+typedef struct {
+	HANDLE		hDrive;
+	DWORD		sector_size;
+	size_t		unit_size;
+	size_t		id_offset;
+	unsigned char	*noise;				/* Content of every unit, bar the unit number */
+	unsigned char	*buffer;
+	unsigned char	*evict;
+	uint64_t	evict_size;
+	int		nb_samples;
+	uint64_t	sample[BB_PROBE_MAX_SAMPLES];
+	uint8_t		bad[BB_PROBE_MAX_SAMPLES];
+} probe_ctx;
+
+static uint64_t rand64(void)
+{
+	// coverity[dont_call]
+	return ((uint64_t)rand() << 45) ^ ((uint64_t)rand() << 30) ^ ((uint64_t)rand() << 15) ^ (uint64_t)rand();
+}
+
+/* Insert a unit in the sorted sample list, unless it's already there */
+static void add_sample(probe_ctx *p, uint64_t unit)
+{
+	int i, j;
+
+	if (p->nb_samples >= BB_PROBE_MAX_SAMPLES)
+		return;
+	for (i = 0; (i < p->nb_samples) && (p->sample[i] < unit); i++);
+	if ((i < p->nb_samples) && (p->sample[i] == unit))
+		return;
+	for (j = p->nb_samples; j > i; j--)
+		p->sample[j] = p->sample[j - 1];
+	p->sample[i] = unit;
+	p->nb_samples++;
+}
+
+static BOOL probe_write(probe_ctx *p, uint64_t unit)
+{
+	memcpy(p->buffer, p->noise, p->unit_size);
+	*(blk64_t*)(intptr_t)(p->buffer + p->id_offset) = (blk64_t)unit;
+	return (write_sectors(p->hDrive, p->sector_size, unit * (p->unit_size / p->sector_size),
+		p->unit_size / p->sector_size, p->buffer) == (int64_t)p->unit_size);
+}
+
+/* Return the unit number that was read back, or -1 if the unit is unreadable or corrupted */
+static int64_t probe_read(probe_ctx *p, uint64_t unit)
+{
+	size_t end = p->id_offset + sizeof(blk64_t);
+
+	if (read_sectors(p->hDrive, p->sector_size, unit * (p->unit_size / p->sector_size),
+		p->unit_size / p->sector_size, p->buffer) != (int64_t)p->unit_size)
+		return -1;
+	if (!IsBufferEqual(p->buffer, p->noise, p->id_offset) ||
+		!IsBufferEqual(p->buffer + end, p->noise + end, p->unit_size - end))
+		return -1;
+	return (int64_t)*(blk64_t*)(intptr_t)(p->buffer + p->id_offset);
+}
+
+static void probe_status(float percent)
+{
+	PrintInfo(0, MSG_355, percent);
+	UpdateProgress(OP_BADBLOCKS, percent);
+}
+
+/*
+ * Flush the units we wrote and read enough of the start of the drive to push
+ * them out of its cache, so that reading them back has to hit the flash.
+ */
+static void probe_flush(probe_ctx *p)
+{
+	uint64_t offset;
+	size_t nb_sectors = BB_PROBE_EVICT_CHUNK / p->sector_size;
+
+	if (!FlushFileBuffers(p->hDrive))
+		uprintf("%sCould not flush drive: %s\n", bb_prefix, WindowsErrorString());
+	for (offset = 0; offset + BB_PROBE_EVICT_CHUNK <= p->evict_size; offset += BB_PROBE_EVICT_CHUNK)
+		read_sectors(p->hDrive, p->sector_size, offset / p->sector_size, nb_sectors, p->evict);
+}
+
+/*
+ * Write BB_PROBE_SPLIT units, evenly spread across [lo, hi[, flush them and
+ * read them back, along with the first nb_good samples, which are known to be
+ * good. The range is then narrowed down to the one between the last good and
+ * the first bad of these units.
+ */
+static void probe_split(probe_ctx *p, uint64_t *lo, uint64_t *hi, int nb_good)
+{
+	uint64_t unit[BB_PROBE_SPLIT];
+	int64_t id;
+	int i, j, first_bad = BB_PROBE_SPLIT;
+
+	for (i = 0; i < BB_PROBE_SPLIT; i++) {
+		unit[i] = *lo + ((*hi - *lo) * (i + 1)) / (BB_PROBE_SPLIT + 1);
+		if (!probe_write(p, unit[i]))
+			first_bad = min(first_bad, i);
+	}
+	probe_flush(p);
+	for (i = 0; i < first_bad; i++) {
+		if (probe_read(p, unit[i]) != (int64_t)unit[i])
+			first_bad = i;
+	}
+	for (j = 0; j < nb_good; j++) {
+		id = probe_read(p, p->sample[j]);
+		if (id != (int64_t)p->sample[j]) {
+			/* One of the units wrapped around to a good sample. If we can't tell which, assume the first */
+			for (i = 0; (i < first_bad) && ((int64_t)unit[i] != id); i++);
+			first_bad = (i < first_bad) ? i : 0;
+			/* Restore the sample, for the next rounds */
+			probe_write(p, p->sample[j]);
+		}
+	}
+	if (first_bad < BB_PROBE_SPLIT)
+		*hi = unit[first_bad];
+	if (first_bad > 0)
+		*lo = unit[first_bad - 1] + 1;
+}
+
+/*
+ * Check whether writing unit base + period overwrites unit base. A drive that
+ * serves unit base from its cache can hide aliasing here, but not fake it, in
+ * which case we fall back to narrowing down the range instead.
+ */
+static BOOL probe_alias(probe_ctx *p, uint64_t base, uint64_t period)
+{
+	return probe_write(p, base) && probe_write(p, base + period) &&
+		(probe_read(p, base) == (int64_t)(base + period));
+}
+
+/*
+ * On a drive that wraps around, the actual capacity divides the distance
+ * between any two aliased units, and is the smallest divisor that aliases.
+ */
+static uint64_t find_wrap_period(probe_ctx *p, uint64_t base, uint64_t distance, uint64_t nb_units)
+{
+	uint64_t d;
+
+	for (d = 1; d * d <= distance; d++) {
+		if ((distance % d == 0) && (base + d < nb_units) && probe_alias(p, base, d))
+			return d;
+	}
+	for (d--; d > 0; d--) {
+		if ((distance % d == 0) && (distance / d != d) && (base + distance / d < nb_units) &&
+			probe_alias(p, base, distance / d))
+			return distance / d;
+	}
+	return 0;
+}
+
+/// <summary>
+/// Quickly find out whether a drive has the capacity it advertises. This is
+/// destructive, as a sample of blocks across the whole drive gets overwritten.
+/// </summary>
+/// <param name="hPhysicalDrive">A handle to the physical drive</param>
+/// <param name="disk_size">The advertised size of the drive</param>
+/// <param name="sector_size">The sector size of the drive</param>
+/// <param name="usable_size">Receives the size that was found to be usable</param>
+/// <returns>TRUE if the probe completed, FALSE on error or if the user cancelled</returns>
+BOOL ProbeCapacity(HANDLE hPhysicalDrive, ULONGLONG disk_size, DWORD sector_size, ULONGLONG *usable_size)
+{
+	BOOL r = FALSE;
+	probe_ctx p = { 0 };
+	char usable_str[32];
+	uint64_t nb_units, base, lo, hi, range, step = 0, nb_steps;
+	uint64_t alias_base = 0, alias_distance = 0;
+	int64_t id;
+	int i, j, k, first_bad;
+
+	if_not_assert((usable_size != NULL) && (sector_size != 0) && IS_POWER_OF_2(sector_size))
+		return FALSE;
+	*usable_size = disk_size;
+	p.hDrive = hPhysicalDrive;
+	p.sector_size = sector_size;
+	p.unit_size = max(BB_PROBE_UNIT, sector_size);
+	nb_units = disk_size / p.unit_size;
+	if (nb_units * p.unit_size < 4 * BB_PROBE_MIN_RANGE) {
+		uprintf("%sDrive is too small for a fake capacity probe\n", bb_prefix);
+		return TRUE;
+	}
+	p.noise = allocate_buffer(p.unit_size);
+	p.buffer = allocate_buffer(p.unit_size);
+	p.evict_size = min(BB_PROBE_EVICT_SIZE, nb_units * p.unit_size);
+	p.evict = allocate_buffer(BB_PROBE_EVICT_CHUNK);
+	if ((p.noise == NULL) || (p.buffer == NULL) || (p.evict == NULL)) {
+		uprintf("%sError while allocating buffers\n", bb_prefix);
+		goto out;
+	}
+	srand((unsigned int)GetTickCount64());
+	for (i = 0; i < (int)p.unit_size; i++)
+		// coverity[dont_call]
+		p.noise[i] = (unsigned char)rand();
+	p.id_offset = (size_t)(rand64() % (p.unit_size - sizeof(blk64_t)));
+
+	/* Pick a base unit in [1 MB, 2 MB[, followed by b + 2^k and random units in [2^k, 2^(k+1)[ */
+	base = (BB_PROBE_MIN_RANGE + rand64() % BB_PROBE_MIN_RANGE) / p.unit_size;
+	add_sample(&p, base);
+	for (k = 0; ((uint64_t)1 << k) < nb_units; k++) {
+		if (((uint64_t)1 << k) <= base)
+			continue;
+		if (base + ((uint64_t)1 << k) < nb_units)
+			add_sample(&p, base + ((uint64_t)1 << k));
+		add_sample(&p, ((uint64_t)1 << k) + rand64() % (min((uint64_t)1 << (k + 1), nb_units) - ((uint64_t)1 << k)));
+	}
+	add_sample(&p, nb_units - 1);
+	/* Fill the rest of the sample with units picked at random across the whole drive */
+	for (i = 0; (p.nb_samples < BB_PROBE_MAX_SAMPLES) && (i < 2 * BB_PROBE_MAX_SAMPLES); i++)
+		add_sample(&p, base + rand64() % (nb_units - base));
+	uprintf("%sProbing %d units across %s, using offset %zu\n", bb_prefix, p.nb_samples,
+		SizeToHumanReadable(disk_size, FALSE, FALSE), p.id_offset);
+
+	/* Write in ascending order, so that wrapped around units overwrite the ones they alias */
+	nb_steps = 2 * (uint64_t)p.nb_samples;
+	for (i = 0; i < p.nb_samples; i++) {
+		CHECK_FOR_USER_CANCEL;
+		if (!probe_write(&p, p.sample[i]))
+			p.bad[i] = 1;
+		probe_status((80.0f * ++step) / nb_steps);
+	}
+	probe_flush(&p);
+	for (i = 0; i < p.nb_samples; i++) {
+		CHECK_FOR_USER_CANCEL;
+		id = probe_read(&p, p.sample[i]);
+		if (id != (int64_t)p.sample[i]) {
+			p.bad[i] = 1;
+			for (j = 0; (j < p.nb_samples) && ((int64_t)p.sample[j] != id); j++);
+			if (j < p.nb_samples) {
+				/* We don't know which of the aliased units is genuine, so flag both */
+				p.bad[j] = 1;
+				if (((uint64_t)id < p.sample[i]) && ((alias_distance == 0) || (p.sample[i] - id < alias_distance))) {
+					alias_distance = p.sample[i] - id;
+					alias_base = id;
+				} else if (((uint64_t)id > p.sample[i]) && ((alias_distance == 0) || (id - p.sample[i] < alias_distance))) {
+					alias_distance = id - p.sample[i];
+					alias_base = p.sample[i];
+				}
+			}
+		}
+		probe_status((80.0f * ++step) / nb_steps);
+	}
+	for (first_bad = 0; (first_bad < p.nb_samples) && !p.bad[first_bad]; first_bad++);
+	if (first_bad >= p.nb_samples) {
+		uprintf("%sAll the probed units could be read back\n", bb_prefix);
+		r = TRUE;
+		goto out;
+	}
+
+	if (alias_distance != 0) {
+		uprintf("%sUnit %" PRIu64 " wraps around to unit %" PRIu64 "\n", bb_prefix,
+			alias_base + alias_distance, alias_base);
+		probe_status(90.0f);
+		lo = find_wrap_period(&p, alias_base, alias_distance, nb_units);
+		if (lo != 0) {
+			*usable_size = lo * p.unit_size;
+			goto report;
+		}
+	}
+
+	/* Narrow down the range between the end of the last good unit and the first bad one */
+	lo = (first_bad == 0) ? 0 : p.sample[first_bad - 1] + 1;
+	hi = p.sample[first_bad];
+	uprintf("%sUnit %" PRIu64 " is bad - narrowing down from unit %" PRIu64 "\n", bb_prefix, hi, lo);
+	for (nb_steps = 1, range = (hi - lo) / (BB_PROBE_SPLIT + 1); range * p.unit_size > BB_PROBE_MIN_RANGE; nb_steps++)
+		range /= BB_PROBE_SPLIT + 1;
+	for (step = 0; (hi - lo) * p.unit_size > BB_PROBE_MIN_RANGE; step++) {
+		CHECK_FOR_USER_CANCEL;
+		probe_split(&p, &lo, &hi, first_bad);
+		probe_status(80.0f + (20.0f * min(step + 1, nb_steps)) / nb_steps);
+	}
+	*usable_size = lo * p.unit_size;
+
+report:
+	probe_status(100.0f);
+	static_strcpy(usable_str, SizeToHumanReadable(*usable_size, FALSE, FALSE));
+	uprintf("%sOnly %s out of %s appear to be usable\n", bb_prefix, usable_str,
+		SizeToHumanReadable(disk_size, FALSE, FALSE));
+	r = TRUE;
+
+out:
+	free_buffer(p.evict);
+	free_buffer(p.buffer);
+	free_buffer(p.noise);
+	return r;
+}
+
+#if defined(RUFUS_TEST)
+/*
+ * Run a bad blocks check against a file image, so that the engine can be
+ * timed without wearing out flash media. The log is left next to the image.
+ * Since a file has no bad blocks, any error that is reported is a failure.
+ */
+BOOL BadBlocksTest(const char* path, ULONGLONG size, int nb_passes, int flash_type)
+{
+	BOOL r = FALSE;
+	char logfile[MAX_PATH];
+	HANDLE h;
+	FILE* fd = NULL;
+	LARGE_INTEGER li;
+	badblocks_report report = { 0 };
+	uint64_t start, elapsed;
+
+	static_sprintf(logfile, "%s.log", path);
+	h = CreateFileU(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+		CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	li.QuadPart = size;
+	if ((h == INVALID_HANDLE_VALUE) || !SetFilePointerEx(h, li, NULL, FILE_BEGIN) || !SetEndOfFile(h)) {
+		uprintf("Could not create '%s': %s", path, WindowsErrorString());
+		goto out;
+	}
+	fd = fopenU(logfile, "w+");
+	if (fd == NULL) {
+		uprintf("Could not create '%s'", logfile);
+		goto out;
+	}
+	start = GetTickCount64();
+	if (BadBlocks(h, size, nb_passes, flash_type, &report, fd)) {
+		elapsed = max(GetTickCount64() - start, 1);
+		uprintf("%s%d pass(es) over %s in %0.2f s (%0.1f MB/s): %d bad block(s) (%d/%d/%d errors)", bb_prefix,
+			nb_passes, SizeToHumanReadable(size, FALSE, FALSE), elapsed / 1000.0f,
+			(2000.0f * nb_passes * size) / (1.0f * MB * elapsed), report.bb_count,
+			report.num_read_errors, report.num_write_errors, report.num_corruption_errors);
+		r = (report.bb_count == 0) && (report.num_read_errors == 0) &&
+			(report.num_write_errors == 0) && (report.num_corruption_errors == 0);
+	}
+
+out:
+	if (fd != NULL)
+		fclose(fd);
+	safe_closehandle(h);
+	DeleteFileU(path);
+	return r;
+}
+#endif
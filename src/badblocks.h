@@ -36,6 +36,20 @@ typedef struct bb_struct_u64_iterate      *bb_u64_iterate;
 #define BB_BAD_BLOCKS_THRESHOLD           256
 #define BB_BLOCKS_AT_ONCE                 64
 #define BB_SYS_PAGE_SIZE                  4096
+// Number of overlapped I/Os (minus two) for the asynchronous engine, and blocks per I/O
+#define BB_QUEUE_DEPTH                    6
+#define BB_BLOCKS_PER_IO                  16
+// Minimum interval between status updates, in ms
+#define BB_STATUS_INTERVAL                1000
+// Size of the units that get written by the fake capacity probe, how many of them,
+// the precision to which the actual capacity is bisected, how many units get tested
+// on each bisection round, and how much is read to push the units out of the cache
+#define BB_PROBE_UNIT                     (4 * KB)
+#define BB_PROBE_MAX_SAMPLES              160
+#define BB_PROBE_MIN_RANGE                (1 * MB)
+#define BB_PROBE_SPLIT                    15
+#define BB_PROBE_EVICT_SIZE               (16 * MB)
+#define BB_PROBE_EVICT_CHUNK              (1 * MB)
 
 enum error_types { READ_ERROR, WRITE_ERROR, CORRUPTION_ERROR };
 enum op_type { OP_READ, OP_WRITE };
@@ -55,3 +69,7 @@ typedef struct {
  */
 BOOL BadBlocks(HANDLE hPhysicalDrive, ULONGLONG disk_size, int nb_passes,
 	int flash_type, badblocks_report *report, FILE* fd);
+BOOL ProbeCapacity(HANDLE hPhysicalDrive, ULONGLONG disk_size, DWORD sector_size, ULONGLONG *usable_size);
+#if defined(RUFUS_TEST)
+BOOL BadBlocksTest(const char* path, ULONGLONG size, int nb_passes, int flash_type);
+#endif
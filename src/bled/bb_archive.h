@@ -236,9 +236,12 @@ typedef struct transformer_state_t {
 	const char *dst_dir;            /* if non-NULL, extract to dir */
 	char     *dst_name;
 	uint64_t dst_size;
+	char     *dst_buf;              /* if non-NULL, writes to dst_fd are gathered there, BB_BUFSIZE at a time */
+	size_t   dst_buf_len;
 	size_t   mem_output_size_max;   /* if non-zero, decompress to RAM instead of fd */
 	size_t   mem_output_size;
 	char     *mem_output_buf;
+	uint64_t mem_output_skip;       /* bytes of output to discard before filling mem_output_buf */
 
 	uint64_t bytes_out;
 	uint64_t bytes_in;  /* used in unzip code only: needs to know packed size */
@@ -255,6 +258,7 @@ typedef struct transformer_state_t {
 void init_transformer_state(transformer_state_t *xstate) FAST_FUNC;
 ssize_t transformer_write(transformer_state_t *xstate, const void *buf, size_t bufsize) FAST_FUNC;
 ssize_t xtransformer_write(transformer_state_t *xstate, const void *buf, size_t bufsize) FAST_FUNC;
+ssize_t transformer_flush(transformer_state_t *xstate) FAST_FUNC;
 int check_signature16(transformer_state_t *xstate, unsigned magic16) FAST_FUNC;
 
 static inline int transformer_switch_file(transformer_state_t* xstate)
@@ -298,6 +302,22 @@ IF_DESKTOP(long long) int unpack_xz_stream(transformer_state_t *xstate) FAST_FUN
 IF_DESKTOP(long long) int unpack_vtsi_stream(transformer_state_t *xstate) FAST_FUNC;
 IF_DESKTOP(long long) int unpack_zstd_stream(transformer_state_t *xstate) FAST_FUNC;
 
+/* Where decoding can start from, for random access to the uncompressed data */
+typedef struct seek_point_t {
+	uint64_t in_offset;     /* file offset of the xz block or zstd frame, or bit offset of the deflate block */
+	uint64_t out_offset;    /* uncompressed offset of the data decoded from there */
+	uint64_t out_end;       /* end of the data that can be decoded from there, in one go */
+	uint64_t in_size;       /* unpadded size of the xz block, or size of the zstd frame */
+	uint8_t  header[12];    /* xz stream header, that the block decoder must see first */
+	uint8_t  *window;       /* 32 KB that precede a deflate block, NULL for a gzip member start */
+} seek_point_t;
+
+int get_xz_seek_points(int fd, seek_point_t **points, size_t *nb_points, uint64_t *size) FAST_FUNC;
+int get_zstd_seek_points(int fd, seek_point_t **points, size_t *nb_points, uint64_t *size) FAST_FUNC;
+int get_gz_seek_points(int fd, uint64_t spacing, seek_point_t **points, size_t *nb_points, uint64_t *size) FAST_FUNC;
+IF_DESKTOP(long long) int unpack_xz_block(transformer_state_t *xstate, const seek_point_t *point) FAST_FUNC;
+IF_DESKTOP(long long) int unpack_gz_from_point(transformer_state_t *xstate, const seek_point_t *point) FAST_FUNC;
+
 char* append_ext(char *filename, const char *expected_ext) FAST_FUNC;
 int bbunpack(char **argv,
 		IF_DESKTOP(long long) int FAST_FUNC (*unpacker)(transformer_state_t *xstate),
@@ -20,14 +20,16 @@ typedef long long int(*unpacker_t)(transformer_state_t *xstate);
 /* Globals */
 smallint bb_got_signal;
 uint64_t bb_total_rb;
+THREAD_LOCAL uint64_t* bb_thread_rb = NULL;
 printf_t bled_printf = NULL;
 read_t bled_read = NULL;
 write_t bled_write = NULL;
 progress_t bled_progress = NULL;
 switch_t bled_switch = NULL;
 unsigned long* bled_cancel_request;
+static unsigned int bled_max_threads = 0;
 static bool bled_initialized = 0;
-jmp_buf bb_error_jmp;
+THREAD_LOCAL jmp_buf bb_error_jmp;
 char* bb_virtual_buf = NULL;
 size_t bb_virtual_len = 0, bb_virtual_pos = 0;
 int bb_virtual_fd = -1;
@@ -268,6 +270,178 @@ int64_t bled_uncompress_from_buffer_to_buffer(const char* src, const size_t src_
 	return ret;
 }
 
+struct bled_seekable {
+	int fd;
+	int type;
+	int64_t size;
+	size_t nb_points;
+	seek_point_t* points;
+};
+
+/* Open file 'src', compressed using 'type', for random access to its uncompressed data */
+bled_seekable_t* bled_seekable_open(const char* src, int type, uint64_t index_spacing)
+{
+	bled_seekable_t* s = NULL;
+	uint64_t size = 0;
+	int r = -1;
+
+	if (!bled_initialized) {
+		bb_error_msg("The library has not been initialized");
+		return NULL;
+	}
+
+	if ((src == NULL) || (src[0] == 0)) {
+		bb_error_msg("Invalid parameter");
+		return NULL;
+	}
+
+	if ((type < 0) || (type >= BLED_COMPRESSION_MAX)) {
+		bb_error_msg("Unsupported compression format");
+		return NULL;
+	}
+
+	s = calloc(1, sizeof(bled_seekable_t));
+	if (s == NULL) {
+		bb_error_msg("Out of memory");
+		return NULL;
+	}
+	s->type = type;
+	s->size = -1;
+	s->fd = _openU(src, _O_RDONLY | _O_BINARY, 0);
+	if (s->fd < 0) {
+		bb_error_msg("Could not open '%s' (errno: %d)", src, errno);
+		free(s);
+		return NULL;
+	}
+
+	if (setjmp(bb_error_jmp))
+		goto out;
+
+	// Without seek points, data is decoded from the start of the file
+	bb_total_rb = 0;
+	switch (type) {
+	case BLED_COMPRESSION_XZ:
+		r = get_xz_seek_points(s->fd, &s->points, &s->nb_points, &size);
+		break;
+	case BLED_COMPRESSION_ZSTD:
+		r = get_zstd_seek_points(s->fd, &s->points, &s->nb_points, &size);
+		break;
+	case BLED_COMPRESSION_GZIP:
+		if (index_spacing != 0)
+			r = get_gz_seek_points(s->fd, index_spacing, &s->points, &s->nb_points, &size);
+		break;
+	default:
+		break;
+	}
+
+out:
+	if (r == 0)
+		s->size = (int64_t)size;
+	else
+		s->nb_points = 0;
+	return s;
+}
+
+/* Uncompress up to 'size' bytes, from offset 'offset' of the uncompressed data, to buffer 'buf' */
+int64_t bled_seekable_read(bled_seekable_t* s, uint64_t offset, char* buf, size_t size)
+{
+	transformer_state_t xstate;
+	seek_point_t* point;
+	int64_t r, total = 0;
+	size_t lo, hi, mid;
+
+	if (!bled_initialized) {
+		bb_error_msg("The library has not been initialized");
+		return -1;
+	}
+
+	if ((s == NULL) || (buf == NULL)) {
+		bb_error_msg("Invalid parameter");
+		return -1;
+	}
+
+	if (s->size >= 0) {
+		if (offset >= (uint64_t)s->size)
+			return 0;
+		size = (size_t)MIN((uint64_t)size, (uint64_t)s->size - offset);
+	}
+
+	if (setjmp(bb_error_jmp))
+		return -1;
+
+	while ((size_t)total < size) {
+		bb_total_rb = 0;
+		init_transformer_state(&xstate);
+		xstate.src_fd = s->fd;
+		xstate.dst_fd = -1;
+		xstate.mem_output_buf = &buf[total];
+		xstate.mem_output_size_max = size - (size_t)total;
+
+		if (s->nb_points == 0) {
+			xstate.mem_output_skip = offset;
+			if (_lseeki64(s->fd, 0, SEEK_SET) != 0)
+				return -1;
+			r = unpacker[s->type](&xstate);
+		} else {
+			// Use the last point that precedes the offset
+			for (lo = 0, hi = s->nb_points; hi - lo > 1; ) {
+				mid = (lo + hi) / 2;
+				if (s->points[mid].out_offset <= offset)
+					lo = mid;
+				else
+					hi = mid;
+			}
+			point = &s->points[lo];
+			if (point->out_end <= offset)
+				break;
+			xstate.mem_output_skip = offset - point->out_offset;
+			xstate.mem_output_size_max = (size_t)MIN((uint64_t)xstate.mem_output_size_max, point->out_end - offset);
+			if (s->type == BLED_COMPRESSION_GZIP) {
+				r = unpack_gz_from_point(&xstate, point);
+			} else {
+				if ((uint64_t)_lseeki64(s->fd, (int64_t)point->in_offset, SEEK_SET) != point->in_offset)
+					return -1;
+				r = (s->type == BLED_COMPRESSION_XZ) ? unpack_xz_block(&xstate, point) : unpack_zstd_stream(&xstate);
+			}
+		}
+		if (r < 0)
+			return -1;
+		total += xstate.mem_output_size;
+		offset += xstate.mem_output_size;
+		// Past the end of the data, or as far as decoding from the start could get us
+		if ((xstate.mem_output_size == 0) || (s->nb_points == 0))
+			break;
+	}
+	return total;
+}
+
+/* Return the uncompressed size, or -1 if it can't be known without decompressing everything */
+int64_t bled_seekable_size(bled_seekable_t* s)
+{
+	return (s == NULL) ? -1 : s->size;
+}
+
+/* Return the number of seek points, 0 if reads decode from the start of the data */
+size_t bled_seekable_nb_points(bled_seekable_t* s)
+{
+	return (s == NULL) ? 0 : s->nb_points;
+}
+
+/* Release a handle from bled_seekable_open() */
+void bled_seekable_close(bled_seekable_t* s)
+{
+	size_t i;
+
+	if (s == NULL)
+		return;
+	for (i = 0; i < s->nb_points; i++)
+		free(s->points[i].window);
+	free(s->points);
+	if (s->fd >= 0)
+		_close(s->fd);
+	free(s);
+}
+
 /* Initialize the library.
  * When the parameters are not NULL or zero you can:
  * - specify the buffer size to use (must be larger than 256KB and a power of two)
@@ -302,6 +476,22 @@ int bled_init(uint32_t buffer_size, printf_t print_function, read_t read_functio
 	return 0;
 }
 
+void bled_set_max_threads(unsigned int n)
+{
+	bled_max_threads = n;
+}
+
+/* Number of threads the parallel decoders may use */
+unsigned int bb_get_nb_threads(void)
+{
+	SYSTEM_INFO si;
+
+	GetSystemInfo(&si);
+	if ((bled_max_threads != 0) && (bled_max_threads < si.dwNumberOfProcessors))
+		return bled_max_threads;
+	return si.dwNumberOfProcessors;
+}
+
 /* This call frees any resource used by the library */
 void bled_exit(void)
 {
@@ -50,6 +50,56 @@ int64_t bled_uncompress_to_dir(const char* src, const char* dir, int type);
 /* Uncompress buffer 'src' of length 'src_len' to buffer 'dst' of size 'dst_len' */
 int64_t bled_uncompress_from_buffer_to_buffer(const char* src, const size_t src_len, char* dst, size_t dst_len, int type);
 
+/* Handle for random access to the uncompressed data of a file */
+typedef struct bled_seekable bled_seekable_t;
+
+/* Open file 'src', compressed using 'type', for random access to its uncompressed data.
+ * The block index of .xz files and the seek table of seekable .zst files are used when present.
+ * For .gz, a checkpoint index, with a point every 'index_spacing' bytes of uncompressed data,
+ * is built when 'index_spacing' is not zero, which decompresses the whole file once.
+ * Data that has no index to start from is decompressed from the start of the file on each read. */
+bled_seekable_t* bled_seekable_open(const char* src, int type, uint64_t index_spacing);
+
+/* Uncompress up to 'size' bytes, from offset 'offset' of the uncompressed data, to buffer 'buf' */
+int64_t bled_seekable_read(bled_seekable_t* s, uint64_t offset, char* buf, size_t size);
+
+/* Return the uncompressed size, or -1 if it can't be known without decompressing everything */
+int64_t bled_seekable_size(bled_seekable_t* s);
+
+/* Return the number of seek points found or built for the archive, 0 if reads decode from the start */
+size_t bled_seekable_nb_points(bled_seekable_t* s);
+
+/* Release a handle from bled_seekable_open() */
+void bled_seekable_close(bled_seekable_t* s);
+
+/* Upper bound of the size of a gzip member holding 'n' bytes, as produced by the call below */
+#define BLED_GZIP_BOUND(n) ((n) + 5 * ((n) / 0x4000 + 2) + 32)
+
+/* Compress buffer 'src' of length 'src_len' into a single gzip member in buffer 'dst' of size 'dst_len'.
+ * This call does not require the library to be initialized and can be issued from multiple threads. */
+int64_t bled_compress_buffer_to_gzip(const char* src, const size_t src_len, char* dst, size_t dst_len);
+
+typedef enum {
+	BLED_CRC_AUTO = 0,		// Fastest implementation supported by the CPU
+	BLED_CRC_BYTEWISE,		// Table lookup, one byte at a time
+	BLED_CRC_SLICE8,		// Table lookup, eight bytes at a time (slicing-by-8)
+	BLED_CRC_HW,			// PCLMULQDQ folding for CRC-32, SSE4.2 instruction for CRC-32C
+	BLED_CRC_MAX
+} bled_crc_implementation;
+
+/* Compute the CRC-32 (IEEE 802.3) of buffer 'buf' of length 'len'. The CRC is not inverted. */
+uint32_t bled_crc32(uint32_t crc, const void* buf, size_t len);
+
+/* Compute the CRC-32C (Castagnoli) of buffer 'buf' of length 'len'. The CRC is not inverted. */
+uint32_t bled_crc32c(uint32_t crc, const void* buf, size_t len);
+
+/* Select the CRC implementation to use, and return the one that was actually selected */
+int bled_crc_select(int impl);
+
+/* Limit the number of threads used to decode a single archive to 'n', or use one per CPU if 'n' is 0.
+ * A value of 1 disables parallel decoding, which can be used to compare against the sequential decoders. */
+void bled_set_max_threads(unsigned int n);
+
 /* Initialize the library.
  * When the parameters are not NULL or zero you can:
  * - specify the buffer size to use (must be larger than 64KB and a power of two)
@@ -0,0 +1,493 @@
+/*
+ * Minimal deflate/gzip compressor for bled
+ *
+ * Greedy LZ77 matching over a 32 KB hash chained window, followed by a
+ * dynamic Huffman encoding of each block (or a stored block, whenever
+ * that happens to be smaller). This is nowhere near as good as zlib at
+ * its higher levels, but it is small, reentrant, and more than adequate
+ * for disk images, where most of the gain comes from long runs of
+ * identical data.
+ *
+ * Copyright © 2024 Pete Batard <pete@akeo.ie>
+ *
+ * Licensed under GPLv2 or later, see file LICENSE in this source tree.
+ */
+
+#include "libbb.h"
+#include "bled.h"
+
+#define WSIZE           0x8000
+#define WMASK           (WSIZE - 1)
+#define HASH_BITS       15
+#define HASH_SIZE       (1 << HASH_BITS)
+#define MIN_MATCH       3
+#define MAX_MATCH       258
+#define MAX_CHAIN       48
+#define GOOD_MATCH      64
+#define MAX_SYMBOLS     0x4000
+#define MAX_STORED      0xffff
+#define L_CODES         286
+#define D_CODES         30
+#define CL_CODES        19
+#define MAX_BITS        15
+#define MAX_CL_BITS     7
+
+typedef struct {
+	/* Bit writer */
+	uint8_t *out;
+	size_t out_len;
+	size_t out_pos;
+	uint64_t bit_buf;
+	unsigned bit_cnt;
+	bool overflow;
+	/* LZ77 state */
+	int32_t head[HASH_SIZE];
+	int32_t prev[WSIZE];
+	/* Symbols of the current block: literals or (length, distance) pairs */
+	uint16_t sym_len[MAX_SYMBOLS];
+	uint16_t sym_dist[MAX_SYMBOLS];
+	unsigned nb_sym;
+	uint32_t l_freq[L_CODES];
+	uint32_t d_freq[D_CODES];
+	/* Length and distance to code lookups */
+	uint8_t len_code[MAX_MATCH + 1];
+	uint8_t dist_code[512];
+} deflate_state_t;
+
+static const uint16_t len_base[29] = {
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+	35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t len_extra[29] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+	3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t dist_base[30] = {
+	1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+	257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t dist_extra[30] = {
+	0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+	7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+static const uint8_t cl_order[CL_CODES] = {
+	16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+static void init_codes(deflate_state_t *s)
+{
+	unsigned c, i;
+
+	for (c = 0, i = MIN_MATCH; i <= MAX_MATCH; i++) {
+		while (c < 28 && i >= len_base[c + 1])
+			c++;
+		s->len_code[i] = (uint8_t)c;
+	}
+	/* Distances up to 256 map directly, larger ones in steps of 128 */
+	for (c = 0, i = 1; i <= 256; i++) {
+		while (c < 29 && i >= dist_base[c + 1])
+			c++;
+		s->dist_code[i - 1] = (uint8_t)c;
+	}
+	for (i = 256; i < 512; i++) {
+		while (c < 29 && ((i - 256) << 7) + 1 >= dist_base[c + 1])
+			c++;
+		s->dist_code[i] = (uint8_t)c;
+	}
+}
+
+static inline unsigned len_code(deflate_state_t *s, unsigned len)
+{
+	return s->len_code[len];
+}
+
+static inline unsigned dist_code(deflate_state_t *s, unsigned dist)
+{
+	return (dist <= 256) ? s->dist_code[dist - 1] : s->dist_code[256 + ((dist - 1) >> 7)];
+}
+
+/* Length of the common prefix of 'a' and 'b', up to 'max' bytes */
+static inline size_t match_length(const uint8_t *a, const uint8_t *b, size_t max)
+{
+	size_t l = 0;
+	uint64_t x, y;
+
+	while (l + 8 <= max) {
+		memcpy(&x, &a[l], sizeof(x));
+		memcpy(&y, &b[l], sizeof(y));
+		if (x != y)
+			break;
+		l += 8;
+	}
+	while (l < max && a[l] == b[l])
+		l++;
+	return l;
+}
+
+static void put_bits(deflate_state_t *s, uint32_t bits, unsigned n)
+{
+	s->bit_buf |= (uint64_t)bits << s->bit_cnt;
+	s->bit_cnt += n;
+	while (s->bit_cnt >= 8) {
+		if (s->out_pos >= s->out_len) {
+			s->overflow = true;
+			s->bit_cnt = 0;
+			s->bit_buf = 0;
+			return;
+		}
+		s->out[s->out_pos++] = (uint8_t)s->bit_buf;
+		s->bit_buf >>= 8;
+		s->bit_cnt -= 8;
+	}
+}
+
+static void align_bits(deflate_state_t *s)
+{
+	if (s->bit_cnt > 0)
+		put_bits(s, 0, 8 - s->bit_cnt);
+}
+
+static void put_bytes(deflate_state_t *s, const uint8_t *buf, size_t len)
+{
+	if (s->overflow || s->out_len - s->out_pos < len) {
+		s->overflow = true;
+		return;
+	}
+	memcpy(&s->out[s->out_pos], buf, len);
+	s->out_pos += len;
+}
+
+/*
+ * Compute the Huffman code lengths for 'n' symbols of frequencies 'freq',
+ * limited to 'limit' bits. Since inflate rejects incomplete codes, we make
+ * sure that at least two symbols are present, which always yields a full
+ * tree. Length limiting is achieved by flattening the frequencies until
+ * the tree fits, which is not optimal, but is simple and rarely needed.
+ */
+static void build_lengths(const uint32_t *freq, unsigned n, unsigned limit, uint8_t *len)
+{
+	uint32_t f[L_CODES], w[2 * L_CODES];
+	uint16_t sym[L_CODES], parent[2 * L_CODES];
+	unsigned i, j, nb, nb_nodes, leaf, node, max_len, a, b;
+
+	memcpy(f, freq, n * sizeof(uint32_t));
+	for (i = 0, nb = 0; i < n; i++)
+		nb += (f[i] != 0);
+	for (i = 0; nb < 2 && i < n; i++) {
+		if (f[i] == 0) {
+			f[i] = 1;
+			nb++;
+		}
+	}
+
+	while (1) {
+		/* Insertion sort of the used symbols by ascending frequency */
+		for (i = 0, nb = 0; i < n; i++) {
+			if (f[i] == 0)
+				continue;
+			for (j = nb; j > 0 && f[sym[j - 1]] > f[i]; j--)
+				sym[j] = sym[j - 1];
+			sym[j] = (uint16_t)i;
+			nb++;
+		}
+		for (i = 0; i < nb; i++)
+			w[i] = f[sym[i]];
+
+		/* Two queue construction: leaves are [0, nb), internal nodes follow */
+		leaf = 0;
+		node = nb;
+		for (nb_nodes = nb; nb_nodes < 2 * nb - 1; nb_nodes++) {
+			a = (leaf < nb && (node >= nb_nodes || w[leaf] <= w[node])) ? leaf++ : node++;
+			b = (leaf < nb && (node >= nb_nodes || w[leaf] <= w[node])) ? leaf++ : node++;
+			w[nb_nodes] = w[a] + w[b];
+			parent[a] = (uint16_t)nb_nodes;
+			parent[b] = (uint16_t)nb_nodes;
+		}
+
+		/* Depths, from the root down (parents always have higher indexes) */
+		w[nb_nodes - 1] = 0;
+		for (i = nb_nodes - 1; i-- > 0; )
+			w[i] = w[parent[i]] + 1;
+		max_len = 0;
+		memset(len, 0, n);
+		for (i = 0; i < nb; i++) {
+			len[sym[i]] = (uint8_t)w[i];
+			max_len = MAX(max_len, w[i]);
+		}
+		if (max_len <= limit)
+			break;
+		for (i = 0; i < n; i++)
+			if (f[i] != 0)
+				f[i] = (f[i] + 1) >> 1;
+	}
+}
+
+/* Assign the canonical codes, bit reversed since deflate writes them LSB first */
+static void build_codes(const uint8_t *len, unsigned n, uint16_t *code)
+{
+	uint16_t bl_count[MAX_BITS + 1] = { 0 }, next[MAX_BITS + 1];
+	unsigned i, b, c = 0, r;
+
+	for (i = 0; i < n; i++)
+		bl_count[len[i]]++;
+	bl_count[0] = 0;
+	for (b = 1; b <= MAX_BITS; b++) {
+		c = (c + bl_count[b - 1]) << 1;
+		next[b] = (uint16_t)c;
+	}
+	for (i = 0; i < n; i++) {
+		if (len[i] == 0)
+			continue;
+		c = next[len[i]]++;
+		for (r = 0, b = 0; b < len[i]; b++, c >>= 1)
+			r = (r << 1) | (c & 1);
+		code[i] = (uint16_t)r;
+	}
+}
+
+/*
+ * Run length encode the concatenated literal/length and distance code
+ * lengths into code length symbols. The repeat count (or 0) goes into the
+ * upper byte of each entry.
+ */
+static unsigned rle_lengths(const uint8_t *lens, unsigned n, uint16_t *out, uint32_t *cl_freq)
+{
+	unsigned i = 0, run, nb = 0;
+
+	while (i < n) {
+		for (run = 1; i + run < n && lens[i + run] == lens[i]; run++);
+		if (lens[i] == 0 && run >= 11) {
+			run = MIN(run, 138);
+			out[nb++] = 18 | ((run - 11) << 8);
+			cl_freq[18]++;
+		} else if (lens[i] == 0 && run >= 3) {
+			out[nb++] = 17 | ((run - 3) << 8);
+			cl_freq[17]++;
+		} else if (lens[i] != 0 && run >= 4) {
+			/* Emit the length once, then repeat it 3 to 6 times */
+			out[nb++] = lens[i];
+			cl_freq[lens[i]]++;
+			run = 1 + MIN(run - 1, 6);
+			out[nb++] = 16 | ((run - 4) << 8);
+			cl_freq[16]++;
+		} else {
+			run = 1;
+			out[nb++] = lens[i];
+			cl_freq[lens[i]]++;
+		}
+		i += run;
+	}
+	return nb;
+}
+
+static void write_stored(deflate_state_t *s, const uint8_t *src, size_t len, bool last)
+{
+	uint8_t hdr[4];
+	size_t chunk;
+
+	do {
+		chunk = MIN(len, MAX_STORED);
+		put_bits(s, (last && chunk == len) ? 1 : 0, 3);
+		align_bits(s);
+		hdr[0] = (uint8_t)chunk;
+		hdr[1] = (uint8_t)(chunk >> 8);
+		hdr[2] = ~hdr[0];
+		hdr[3] = ~hdr[1];
+		put_bytes(s, hdr, sizeof(hdr));
+		put_bytes(s, src, chunk);
+		src += chunk;
+		len -= chunk;
+	} while (len > 0 && !s->overflow);
+}
+
+/* Flush the current symbols as a single block covering src[0, len) */
+static void flush_block(deflate_state_t *s, const uint8_t *src, size_t len, bool last)
+{
+	uint8_t l_len[L_CODES], d_len[D_CODES], cl_len[CL_CODES], all_len[L_CODES + D_CODES];
+	uint16_t l_code[L_CODES], d_code[D_CODES], cl_code[CL_CODES], cl_sym[L_CODES + D_CODES];
+	uint32_t cl_freq[CL_CODES] = { 0 };
+	uint64_t dyn_bits, stored_bits;
+	unsigned i, c, nl, nd, ncl, nb_cl, sym;
+
+	s->l_freq[256]++;
+	build_lengths(s->l_freq, L_CODES, MAX_BITS, l_len);
+	build_lengths(s->d_freq, D_CODES, MAX_BITS, d_len);
+	for (nl = L_CODES; nl > 257 && l_len[nl - 1] == 0; nl--);
+	for (nd = D_CODES; nd > 1 && d_len[nd - 1] == 0; nd--);
+	memcpy(all_len, l_len, nl);
+	memcpy(&all_len[nl], d_len, nd);
+	nb_cl = rle_lengths(all_len, nl + nd, cl_sym, cl_freq);
+	build_lengths(cl_freq, CL_CODES, MAX_CL_BITS, cl_len);
+	for (ncl = CL_CODES; ncl > 4 && cl_len[cl_order[ncl - 1]] == 0; ncl--);
+
+	/* Compare the size of the dynamic block against stored blocks */
+	dyn_bits = 3 + 5 + 5 + 4 + 3 * ncl;
+	for (i = 0; i < nb_cl; i++) {
+		c = cl_sym[i] & 0xff;
+		dyn_bits += cl_len[c] + ((c == 16) ? 2 : (c == 17) ? 3 : (c == 18) ? 7 : 0);
+	}
+	for (i = 0; i < L_CODES; i++)
+		dyn_bits += (uint64_t)s->l_freq[i] * (l_len[i] + ((i > 256) ? len_extra[i - 257] : 0));
+	for (i = 0; i < D_CODES; i++)
+		dyn_bits += (uint64_t)s->d_freq[i] * (d_len[i] + dist_extra[i]);
+	stored_bits = ((uint64_t)len + 5 * (len / MAX_STORED + 1)) * 8;
+
+	if (stored_bits <= dyn_bits) {
+		write_stored(s, src, len, last);
+	} else {
+		build_codes(l_len, L_CODES, l_code);
+		build_codes(d_len, D_CODES, d_code);
+		build_codes(cl_len, CL_CODES, cl_code);
+		put_bits(s, last ? 1 : 0, 1);
+		put_bits(s, 2, 2);
+		put_bits(s, nl - 257, 5);
+		put_bits(s, nd - 1, 5);
+		put_bits(s, ncl - 4, 4);
+		for (i = 0; i < ncl; i++)
+			put_bits(s, cl_len[cl_order[i]], 3);
+		for (i = 0; i < nb_cl; i++) {
+			c = cl_sym[i] & 0xff;
+			put_bits(s, cl_code[c], cl_len[c]);
+			if (c == 16)
+				put_bits(s, cl_sym[i] >> 8, 2);
+			else if (c == 17)
+				put_bits(s, cl_sym[i] >> 8, 3);
+			else if (c == 18)
+				put_bits(s, cl_sym[i] >> 8, 7);
+		}
+		for (i = 0; i < s->nb_sym; i++) {
+			if (s->sym_dist[i] == 0) {
+				put_bits(s, l_code[s->sym_len[i]], l_len[s->sym_len[i]]);
+				continue;
+			}
+			c = len_code(s, s->sym_len[i]);
+			sym = 257 + c;
+			put_bits(s, l_code[sym], l_len[sym]);
+			put_bits(s, s->sym_len[i] - len_base[c], len_extra[c]);
+			c = dist_code(s, s->sym_dist[i]);
+			put_bits(s, d_code[c], d_len[c]);
+			put_bits(s, s->sym_dist[i] - dist_base[c], dist_extra[c]);
+		}
+		put_bits(s, l_code[256], l_len[256]);
+	}
+
+	s->nb_sym = 0;
+	memset(s->l_freq, 0, sizeof(s->l_freq));
+	memset(s->d_freq, 0, sizeof(s->d_freq));
+}
+
+static inline uint32_t hash3(const uint8_t *p)
+{
+	return ((p[0] << 10) ^ (p[1] << 5) ^ p[2]) & (HASH_SIZE - 1);
+}
+
+static inline void insert_hash(deflate_state_t *s, const uint8_t *src, size_t pos)
+{
+	uint32_t h = hash3(&src[pos]);
+	s->prev[pos & WMASK] = s->head[h];
+	s->head[h] = (int32_t)pos;
+}
+
+static void deflate_buffer(deflate_state_t *s, const uint8_t *src, size_t len)
+{
+	size_t i = 0, block_start = 0, cand, max_len, best_len, best_dist, l;
+	int32_t next;
+	unsigned chain;
+
+	memset(s->head, 0xff, sizeof(s->head));
+
+	while (i < len && !s->overflow) {
+		best_len = 0;
+		best_dist = 0;
+		max_len = MIN(MAX_MATCH, len - i);
+		if (max_len >= MIN_MATCH) {
+			next = s->head[hash3(&src[i])];
+			for (chain = MAX_CHAIN; next >= 0 && chain > 0; chain--) {
+				cand = (size_t)next;
+				if (i - cand > WSIZE)
+					break;
+				if (src[cand + best_len] == src[i + best_len] && src[cand] == src[i]) {
+					l = match_length(&src[cand], &src[i], max_len);
+					if (l > best_len) {
+						best_len = l;
+						best_dist = i - cand;
+						if (l >= max_len || l >= GOOD_MATCH)
+							break;
+					}
+				}
+				next = s->prev[cand & WMASK];
+				if (next >= (int32_t)cand)
+					break;
+			}
+		}
+
+		if (best_len >= MIN_MATCH) {
+			s->sym_len[s->nb_sym] = (uint16_t)best_len;
+			s->sym_dist[s->nb_sym++] = (uint16_t)best_dist;
+			s->l_freq[257 + len_code(s, (unsigned)best_len)]++;
+			s->d_freq[dist_code(s, (unsigned)best_dist)]++;
+			for (l = 0; l < best_len; l++, i++)
+				if (i + MIN_MATCH <= len)
+					insert_hash(s, src, i);
+		} else {
+			s->sym_len[s->nb_sym] = src[i];
+			s->sym_dist[s->nb_sym++] = 0;
+			s->l_freq[src[i]]++;
+			if (i + MIN_MATCH <= len)
+				insert_hash(s, src, i);
+			i++;
+		}
+
+		if (s->nb_sym >= MAX_SYMBOLS) {
+			flush_block(s, &src[block_start], i - block_start, i >= len);
+			block_start = i;
+		}
+	}
+	if (s->nb_sym > 0 || block_start < len || len == 0)
+		flush_block(s, &src[block_start], len - block_start, true);
+}
+
+/*
+ * Compress buffer 'src' of length 'src_len' into a single gzip member, in
+ * buffer 'dst' of size 'dst_len'. Returns the size of the member, or -1 if
+ * 'dst' is too small (BLED_GZIP_BOUND() guarantees that it is not).
+ * Unlike the rest of the library, this call does not use any global state,
+ * and can therefore be used from multiple threads at once.
+ */
+int64_t bled_compress_buffer_to_gzip(const char* src, const size_t src_len, char* dst, size_t dst_len)
+{
+	static const uint8_t gz_header[10] = { 0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff };
+	deflate_state_t *s;
+	uint32_t crc;
+	uint8_t trailer[8];
+	int64_t ret = -1;
+
+	if ((src == NULL && src_len != 0) || dst == NULL)
+		return -1;
+
+	s = calloc(1, sizeof(deflate_state_t));
+	if (s == NULL)
+		return -1;
+	s->out = (uint8_t *)dst;
+	s->out_len = dst_len;
+	init_codes(s);
+
+	put_bytes(s, gz_header, sizeof(gz_header));
+	deflate_buffer(s, (const uint8_t *)src, src_len);
+	align_bits(s);
+	crc = ~bled_crc32(~0U, src, src_len);
+	trailer[0] = (uint8_t)crc;
+	trailer[1] = (uint8_t)(crc >> 8);
+	trailer[2] = (uint8_t)(crc >> 16);
+	trailer[3] = (uint8_t)(crc >> 24);
+	trailer[4] = (uint8_t)src_len;
+	trailer[5] = (uint8_t)(src_len >> 8);
+	trailer[6] = (uint8_t)(src_len >> 16);
+	trailer[7] = (uint8_t)(src_len >> 24);
+	put_bytes(s, trailer, sizeof(trailer));
+	if (!s->overflow)
+		ret = (int64_t)s->out_pos;
+
+	free(s);
+	return ret;
+}
@@ -8,6 +8,7 @@
  */
 
 #include "libbb.h"
+#include "bled.h"
 
 #if __GNUC__ >= 3	/* 2.x has "attribute", but only 3.0 has "pure */
 #define attribute(x) __attribute__(x)
@@ -45,32 +46,321 @@ static void crc32init_le(uint32_t *crc32table_le)
 	}
 }
 
+/*
+ * Rufus: Runtime dispatched CRC-32 (IEEE 802.3) and CRC-32C (Castagnoli) engine.
+ * This is used by the gzip and xz decompressors as well as ext2fs' metadata checksums.
+ * For CRC-32, we use PCLMULQDQ folding when available and slicing-by-8 otherwise.
+ * For CRC-32C, we use the SSE4.2 crc32 instruction when available and slicing-by-8
+ * otherwise.
+ * As with crc32_le(), the crc value is neither inverted on entry nor on exit.
+ */
+#if (defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__i386) || \
+     defined(_X86_) || defined(__I86__) || defined(__x86_64__))
+#define CPU_X86_CRC32_ACCELERATION      1
+#include <intrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#define BLED_ENABLE_GCC_ARCH(arch)
+#else
+#define BLED_ENABLE_GCC_ARCH(arch) __attribute__ ((target (arch)))
+#endif
+
+#define CRC32C_POLY_LE 0x82f63b78
+
+enum { CRC_IEEE = 0, CRC_CASTAGNOLI, CRC_MAX };
+
+typedef uint32_t (*crc_fn_t)(uint32_t crc, const uint8_t *p, size_t len);
+
+static uint32_t crc_table[CRC_MAX][8][256];
+static int crc_impl = BLED_CRC_AUTO, crc_best_impl = BLED_CRC_AUTO;
+static crc_fn_t crc_fn[CRC_MAX] = { NULL, NULL };
+static INIT_ONCE crc_init_once = INIT_ONCE_STATIC_INIT;
+
+static void crc_init_tables(void)
+{
+	static const uint32_t poly[CRC_MAX] = { CRCPOLY_LE, CRC32C_POLY_LE };
+	uint32_t c;
+	int t, i, j;
+
+	for (t = 0; t < CRC_MAX; t++) {
+		for (i = 0; i < 256; i++) {
+			c = (uint32_t)i;
+			for (j = 0; j < 8; j++)
+				c = (c >> 1) ^ ((c & 1) ? poly[t] : 0);
+			crc_table[t][0][i] = c;
+		}
+		for (i = 0; i < 256; i++) {
+			for (j = 1; j < 8; j++)
+				crc_table[t][j][i] = (crc_table[t][j - 1][i] >> 8) ^ crc_table[t][0][crc_table[t][j - 1][i] & 0xff];
+		}
+	}
+}
+
+static __inline uint32_t crc_bytewise(uint32_t crc, const uint8_t *p, size_t len, const uint32_t (*t)[256])
+{
+	while (len--)
+		crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xff];
+	return crc;
+}
+
+/* Slicing-by-8. Assumes a little-endian host, which is always the case on Windows. */
+static __inline uint32_t crc_slice8(uint32_t crc, const uint8_t *p, size_t len, const uint32_t (*t)[256])
+{
+	uint32_t lo, hi;
+
+	for (; len > 0 && ((uintptr_t)p & 3); len--)
+		crc = (crc >> 8) ^ t[0][(crc ^ *p++) & 0xff];
+	for (; len >= 8; len -= 8, p += 8) {
+		memcpy(&lo, p, sizeof(lo));
+		memcpy(&hi, p + 4, sizeof(hi));
+		lo ^= crc;
+		crc = t[7][lo & 0xff] ^ t[6][(lo >> 8) & 0xff] ^ t[5][(lo >> 16) & 0xff] ^ t[4][lo >> 24] ^
+		      t[3][hi & 0xff] ^ t[2][(hi >> 8) & 0xff] ^ t[1][(hi >> 16) & 0xff] ^ t[0][hi >> 24];
+	}
+	return crc_bytewise(crc, p, len, t);
+}
+
+static uint32_t crc32_bytewise(uint32_t crc, const uint8_t *p, size_t len)
+{
+	return crc_bytewise(crc, p, len, crc_table[CRC_IEEE]);
+}
+
+static uint32_t crc32c_bytewise(uint32_t crc, const uint8_t *p, size_t len)
+{
+	return crc_bytewise(crc, p, len, crc_table[CRC_CASTAGNOLI]);
+}
+
+static uint32_t crc32_slice8(uint32_t crc, const uint8_t *p, size_t len)
+{
+	return crc_slice8(crc, p, len, crc_table[CRC_IEEE]);
+}
+
+static uint32_t crc32c_slice8(uint32_t crc, const uint8_t *p, size_t len)
+{
+	return crc_slice8(crc, p, len, crc_table[CRC_CASTAGNOLI]);
+}
+
+#if defined(CPU_X86_CRC32_ACCELERATION)
+/*
+ * Detect if the processor supports the ISAs we need for CRC acceleration, i.e.
+ * SSE4.1 and PCLMULQDQ for CRC-32, and SSE4.2 for CRC-32C.
+ */
+static int crc_detect_acceleration(void)
+{
+#if defined(_MSC_VER)
+	int regs0[4] = { 0,0,0,0 }, regs1[4] = { 0,0,0,0 };
+	const uint32_t PCLMUL_BIT = 1u << 1;	/* Function 1, Bit  1 of ECX */
+	const uint32_t SSE41_BIT = 1u << 19;	/* Function 1, Bit 19 of ECX */
+	const uint32_t SSE42_BIT = 1u << 20;	/* Function 1, Bit 20 of ECX */
+
+	__cpuid(regs0, 0);
+	if (regs0[0] /*EAX*/ >= 0x01)
+		__cpuidex(regs1, 1, 0);
+
+	return (regs1[2] /*ECX*/ & PCLMUL_BIT) && (regs1[2] /*ECX*/ & SSE41_BIT) && (regs1[2] /*ECX*/ & SSE42_BIT);
+#elif defined(__GNUC__) || defined(__clang__)
+	return __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1") && __builtin_cpu_supports("sse4.2");
+#else
+	return 0;
+#endif
+}
+
+/*
+ * CRC-32 of a buffer of at least 64 bytes, and of a length that is a multiple of 16,
+ * using carry-less multiplication folding. Based on "Fast CRC Computation for Generic
+ * Polynomials Using PCLMULQDQ Instruction", V. Gopal, E. Ozturk, et al., 2009, and
+ * its implementation in Chromium's zlib.
+ */
+BLED_ENABLE_GCC_ARCH("sse4.1,pclmul")
+static uint32_t crc32_pclmul_fold(uint32_t crc, const uint8_t *p, size_t len)
+{
+	/* Bit-reflected domain constants k1-k5, and the CRC-32 and Barrett polynomials */
+	const __m128i k1k2 = _mm_set_epi32(0x00000001, (int)0xc6e41596, 0x00000001, 0x54442bd4);
+	const __m128i k3k4 = _mm_set_epi32(0x00000000, (int)0xccaa009e, 0x00000001, 0x751997d0);
+	const __m128i k5k0 = _mm_set_epi32(0x00000000, 0x00000000, 0x00000001, 0x63cd6124);
+	const __m128i poly = _mm_set_epi32(0x00000001, (int)0xf7011641, 0x00000001, (int)0xdb710641);
+	const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+	__m128i x1, x2, x3, x4, x5, x6, x7, x8;
+
+	x1 = _mm_loadu_si128((const __m128i *)(p + 0x00));
+	x2 = _mm_loadu_si128((const __m128i *)(p + 0x10));
+	x3 = _mm_loadu_si128((const __m128i *)(p + 0x20));
+	x4 = _mm_loadu_si128((const __m128i *)(p + 0x30));
+	x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128((int)crc));
+	p += 64;
+	len -= 64;
+
+	/* Fold 4 x 128 bits at a time */
+	for (; len >= 64; len -= 64, p += 64) {
+		x5 = _mm_clmulepi64_si128(x1, k1k2, 0x00);
+		x6 = _mm_clmulepi64_si128(x2, k1k2, 0x00);
+		x7 = _mm_clmulepi64_si128(x3, k1k2, 0x00);
+		x8 = _mm_clmulepi64_si128(x4, k1k2, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, k1k2, 0x11);
+		x2 = _mm_clmulepi64_si128(x2, k1k2, 0x11);
+		x3 = _mm_clmulepi64_si128(x3, k1k2, 0x11);
+		x4 = _mm_clmulepi64_si128(x4, k1k2, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i *)(p + 0x00)));
+		x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i *)(p + 0x10)));
+		x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i *)(p + 0x20)));
+		x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i *)(p + 0x30)));
+	}
+
+	/* Fold into 128 bits */
+	x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+	x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+	x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+	x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+	x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+
+	/* Fold the remaining 128 bit blocks, if any */
+	for (; len >= 16; len -= 16, p += 16) {
+		x5 = _mm_clmulepi64_si128(x1, k3k4, 0x00);
+		x1 = _mm_clmulepi64_si128(x1, k3k4, 0x11);
+		x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i *)p)), x5);
+	}
+
+	/* Fold 128 bits into 64 bits */
+	x2 = _mm_clmulepi64_si128(x1, k3k4, 0x10);
+	x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+	x2 = _mm_srli_si128(x1, 4);
+	x1 = _mm_and_si128(x1, mask);
+	x1 = _mm_clmulepi64_si128(x1, k5k0, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	/* Barrett reduction to 32 bits */
+	x2 = _mm_and_si128(x1, mask);
+	x2 = _mm_clmulepi64_si128(x2, poly, 0x10);
+	x2 = _mm_and_si128(x2, mask);
+	x2 = _mm_clmulepi64_si128(x2, poly, 0x00);
+	x1 = _mm_xor_si128(x1, x2);
+
+	return (uint32_t)_mm_extract_epi32(x1, 1);
+}
+
+static uint32_t crc32_pclmul(uint32_t crc, const uint8_t *p, size_t len)
+{
+	size_t fold_len;
+
+	/* Not worth it for small buffers */
+	if (len < 128)
+		return crc32_slice8(crc, p, len);
+	fold_len = len & ~(size_t)15;
+	crc = crc32_pclmul_fold(crc, p, fold_len);
+	return crc32_slice8(crc, p + fold_len, len - fold_len);
+}
+
+BLED_ENABLE_GCC_ARCH("sse4.2")
+static uint32_t crc32c_sse42(uint32_t crc, const uint8_t *p, size_t len)
+{
+	uint32_t v;
+#if defined(_M_X64) || defined(__x86_64__)
+	uint64_t crc64, v64;
+#endif
+
+	for (; len > 0 && ((uintptr_t)p & 7); len--)
+		crc = _mm_crc32_u8(crc, *p++);
+#if defined(_M_X64) || defined(__x86_64__)
+	crc64 = crc;
+	for (; len >= 8; len -= 8, p += 8) {
+		memcpy(&v64, p, sizeof(v64));
+		crc64 = _mm_crc32_u64(crc64, v64);
+	}
+	crc = (uint32_t)crc64;
+#endif
+	for (; len >= 4; len -= 4, p += 4) {
+		memcpy(&v, p, sizeof(v));
+		crc = _mm_crc32_u32(crc, v);
+	}
+	for (; len > 0; len--)
+		crc = _mm_crc32_u8(crc, *p++);
+	return crc;
+}
+#endif
+
+static void crc_set_impl(int impl)
+{
+	switch (impl) {
+	case BLED_CRC_BYTEWISE:
+		crc_fn[CRC_IEEE] = crc32_bytewise;
+		crc_fn[CRC_CASTAGNOLI] = crc32c_bytewise;
+		break;
+#if defined(CPU_X86_CRC32_ACCELERATION)
+	case BLED_CRC_HW:
+		crc_fn[CRC_IEEE] = crc32_pclmul;
+		crc_fn[CRC_CASTAGNOLI] = crc32c_sse42;
+		break;
+#endif
+	default:
+		impl = BLED_CRC_SLICE8;
+		crc_fn[CRC_IEEE] = crc32_slice8;
+		crc_fn[CRC_CASTAGNOLI] = crc32c_slice8;
+		break;
+	}
+	crc_impl = impl;
+}
+
+/*
+ * Build the tables and select the fastest implementation. The CRC calls can be
+ * issued from any thread without initializing the library, so this must only
+ * ever run once, before any of them uses the tables or the function pointers.
+ */
+static BOOL CALLBACK crc_init(PINIT_ONCE once, PVOID param, PVOID *context)
+{
+	crc_init_tables();
+	crc_best_impl = BLED_CRC_SLICE8;
+#if defined(CPU_X86_CRC32_ACCELERATION)
+	if (crc_detect_acceleration())
+		crc_best_impl = BLED_CRC_HW;
+#endif
+	crc_set_impl(crc_best_impl);
+	return TRUE;
+}
+
+/*
+ * Select the CRC implementation to use. BLED_CRC_AUTO selects the fastest one.
+ * Returns the implementation that is actually being used.
+ * This must not be called while CRCs are being computed on other threads.
+ */
+int bled_crc_select(int impl)
+{
+	InitOnceExecuteOnce(&crc_init_once, crc_init, NULL, NULL);
+	if ((impl <= BLED_CRC_AUTO) || (impl > crc_best_impl))
+		impl = crc_best_impl;
+	crc_set_impl(impl);
+	return crc_impl;
+}
+
+uint32_t bled_crc32(uint32_t crc, const void *buf, size_t len)
+{
+	InitOnceExecuteOnce(&crc_init_once, crc_init, NULL, NULL);
+	return crc_fn[CRC_IEEE](crc, (const uint8_t *)buf, len);
+}
+
+uint32_t bled_crc32c(uint32_t crc, const void *buf, size_t len)
+{
+	InitOnceExecuteOnce(&crc_init_once, crc_init, NULL, NULL);
+	return crc_fn[CRC_CASTAGNOLI](crc, (const uint8_t *)buf, len);
+}
+
 /**
  * crc32_le() - Calculate bitwise little-endian Ethernet AUTODIN II CRC32
  * @crc - seed value for computation.  ~0 for Ethernet, sometimes 0 for
  *        other uses, or the previous crc32 value if computing incrementally.
  * @p   - pointer to buffer over which CRC is run
  * @len - length of buffer @p
- * 
+ * @crc32table_le - unused, as all our little-endian tables are for CRCPOLY_LE,
+ *        which the CRC engine above implements
  */
-uint32_t attribute((pure)) crc32_le(uint32_t crc, unsigned char const *p, size_t len, uint32_t *crc32table_le)
+uint32_t crc32_le(uint32_t crc, unsigned char const *p, size_t len, uint32_t *crc32table_le)
 {
-	while (len--) {
-# if CRC_LE_BITS == 8
-		crc = (crc >> 8) ^ crc32table_le[(crc ^ *p++) & 255];
-# elif CRC_LE_BITS == 4
-		crc ^= *p++;
-		crc = (crc >> 4) ^ crc32table_le[crc & 15];
-		crc = (crc >> 4) ^ crc32table_le[crc & 15];
-# elif CRC_LE_BITS == 2
-		crc ^= *p++;
-		crc = (crc >> 2) ^ crc32table_le[crc & 3];
-		crc = (crc >> 2) ^ crc32table_le[crc & 3];
-		crc = (crc >> 2) ^ crc32table_le[crc & 3];
-		crc = (crc >> 2) ^ crc32table_le[crc & 3];
-# endif
-	}
-	return crc;
+	(void)crc32table_le;
+	return bled_crc32(crc, p, len);
 }
 
 /**
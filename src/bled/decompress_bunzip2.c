@@ -92,6 +92,9 @@ struct bunzip_data {
 	int writeCopies, writePos, writeRunCountdown, writeCount;
 	int writeCurrent; /* actually a uint8_t */
 
+	/* Set to stop after the current block, when blocks are decoded on their own */
+	int singleBlock;
+
 	/* The CRC values stored in the block header and calculated from the data */
 	uint32_t headerCRC, totalCRC, writeCRC;
 
@@ -652,6 +655,12 @@ static int read_bunzip(bunzip_data *bd, char *outbuf, int len)
 			bd->totalCRC = bd->headerCRC + 1;
 			return RETVAL_LAST_BLOCK;
 		}
+
+		/* Don't go into the next block if we only want this one */
+		if (bd->singleBlock) {
+			bd->writeCount = RETVAL_LAST_BLOCK;
+			return len;
+		}
 	}
 
 	/* Refill the intermediate buffer by Huffman-decoding next block of input */
@@ -755,9 +764,12 @@ static void FAST_FUNC dealloc_bunzip(bunzip_data *bd)
 }
 
 
-/* Decompress src_fd to dst_fd.  Stops at end of bzip data, not end of file. */
-IF_DESKTOP(long long) int FAST_FUNC
-unpack_bz2_stream(transformer_state_t *xstate)
+/* Decompress src_fd to dst_fd.  Stops at end of bzip data, not end of file.
+   If level is non zero, src_fd is positioned within a stream of that level,
+   with the next block starting 'skip' bits into the next byte, and 'crc' is
+   the combined CRC of the blocks of the stream that precede it. */
+static IF_DESKTOP(long long) int
+unpack_bz2_from(transformer_state_t *xstate, unsigned level, unsigned skip, uint32_t crc)
 {
 	IF_DESKTOP(long long total_written = 0;)
 	bunzip_data *bd;
@@ -765,13 +777,16 @@ unpack_bz2_stream(transformer_state_t *xstate)
 	int i, nwrote;
 	unsigned len;
 
-	if (check_signature16(xstate, BZIP2_MAGIC))
-		return -1;
-
 	outbuf = xmalloc(IOBUF_SIZE);
 	if (outbuf == NULL)
 		return -1;
 	len = 0;
+	if (level != 0) {
+		/* Make up the end of a stream header */
+		outbuf[2] = 'h';
+		outbuf[3] = '0' + level;
+		len = 2;
+	}
 	while (1) { /* "Process one BZ... stream" loop */
 		jmp_buf jmpbuf;
 
@@ -780,6 +795,12 @@ unpack_bz2_stream(transformer_state_t *xstate)
 		if (i == 0)
 			i = start_bunzip(&jmpbuf, &bd, xstate->src_fd, outbuf + 2, len);
 
+		if (i == 0 && level != 0) {
+			get_bits(bd, skip);
+			bd->totalCRC = crc;
+			level = 0;
+		}
+
 		if (i == 0) {
 			while (1) { /* "Produce some output bytes" loop */
 				i = read_bunzip(bd, outbuf, IOBUF_SIZE);
@@ -839,6 +860,432 @@ unpack_bz2_stream(transformer_state_t *xstate)
 	return i ? i : IF_DESKTOP(total_written) + 0;
 }
 
+/*
+ * Parallel decoding of large bzip2 files
+ *
+ * Unlike deflate, every bzip2 block can be decoded on its own: the main
+ * thread looks for the 48-bit block and end of stream magics, which need
+ * not be byte aligned, and hands each block over to a worker. The output
+ * is then written in order by the main thread, which also checks that each
+ * block ended where the next magic was found, as a magic can also show up
+ * by chance within the compressed data. Whenever something doesn't add up,
+ * the rest is left to the sequential decoder, from the last good block.
+ */
+#define MT_MIN_SIZE	(4 * 1024 * 1024)	/* smaller files aren't worth the threads */
+#define MT_READ_SIZE	(1024 * 1024)
+#define MT_OUT_CAP	(4 * 1024 * 1024)	/* the main thread does the rest of a block */
+#define MT_BLOCK_MAGIC	0x314159265359ULL
+#define MT_EOS_MAGIC	0x177245385090ULL
+#define MT_MAGIC_MASK	0xffffffffffffULL
+#if defined(_WIN64)
+#define MT_MAX_WORKERS	8
+#else
+#define MT_MAX_WORKERS	4
+#endif
+
+enum { MT_NONE, MT_BLOCK, MT_EOS };
+
+typedef struct {
+	bunzip_data *bd;
+	uint8_t *in;		/* the block, from the byte it starts in */
+	size_t in_len, in_size;
+	uint64_t start_bit;	/* where the block starts and the next magic was found */
+	uint64_t stop_bit;
+	uint64_t end_bit;	/* where the block actually ended */
+	unsigned level;
+	BOOL eos;		/* the last block of a stream, with combined CRC stream_crc */
+	uint32_t stream_crc;
+	char *out;
+	int out_len;
+	BOOL ok, busy;
+	jmp_buf jmp;
+	HANDLE hDone;
+} mt_job_t;
+
+typedef struct {
+	transformer_state_t *xstate;
+	HANDLE hFile;
+	uint64_t file_size;
+	uint8_t *in;		/* the input, from in_offset */
+	uint64_t in_offset;
+	size_t in_len, in_size;
+	uint32_t crc;		/* combined CRC of the blocks written for the current stream */
+	uint8_t hint[256];	/* bit r is set if the byte can be the second one of a magic at bit r */
+	char *buf;
+	IF_DESKTOP(long long) int total;
+} mt_ctx_t;
+
+/* Make sure that the input is there up to byte 'end', dropping what precedes byte 'keep' */
+static BOOL mt_fill(mt_ctx_t *ctx, uint64_t keep, uint64_t end)
+{
+	OVERLAPPED ov;
+	uint64_t offset;
+	DWORD size, rb;
+	size_t drop;
+
+	if (end > ctx->file_size)
+		return FALSE;
+	if (ctx->in_offset + ctx->in_len >= end)
+		return TRUE;
+	if (keep > ctx->in_offset) {
+		drop = (size_t)MIN(keep - ctx->in_offset, ctx->in_len);
+		memmove(ctx->in, &ctx->in[drop], ctx->in_len - drop);
+		ctx->in_offset += drop;
+		ctx->in_len -= drop;
+	}
+	while (ctx->in_offset + ctx->in_len < end) {
+		offset = ctx->in_offset + ctx->in_len;
+		size = (DWORD)MIN(MT_READ_SIZE, ctx->file_size - offset);
+		if (ctx->in_len + size > ctx->in_size) {
+			uint8_t *in = realloc(ctx->in, ctx->in_len + size);
+			if (in == NULL)
+				return FALSE;
+			ctx->in = in;
+			ctx->in_size = ctx->in_len + size;
+		}
+		memset(&ov, 0, sizeof(ov));
+		ov.Offset = (DWORD)offset;
+		ov.OffsetHigh = (DWORD)(offset >> 32);
+		if (!ReadFile(ctx->hFile, &ctx->in[ctx->in_len], size, &rb, &ov) || rb != size)
+			return FALSE;
+		ctx->in_len += size;
+	}
+	return TRUE;
+}
+
+/* Look for the first block or end of stream magic from bit '*bit', keeping the input from byte 'keep' */
+static int mt_scan(mt_ctx_t *ctx, uint64_t keep, uint64_t *bit)
+{
+	uint64_t pos = *bit >> 3, v, m;
+	unsigned r, hint, first = (unsigned)(*bit & 7);
+	const uint8_t *in;
+	size_t i, j, n;
+
+	/* A magic that starts in in[i] spans up to in[i + 6] */
+	for (; mt_fill(ctx, keep, pos + 7); pos += n) {
+		in = &ctx->in[pos - ctx->in_offset];
+		n = (size_t)(ctx->in_offset + ctx->in_len - pos) - 6;
+		for (i = 0; i < n; i++) {
+			/* The second byte rules out most positions */
+			hint = ctx->hint[in[i + 1]] & (0xff << first);
+			first = 0;
+			if (hint == 0)
+				continue;
+			for (v = 0, j = 0; j < 7; j++)
+				v = (v << 8) | in[i + j];
+			for (r = 0; r < 8; r++) {
+				if (!(hint & (1 << r)))
+					continue;
+				m = (v >> (8 - r)) & MT_MAGIC_MASK;
+				if (m == MT_BLOCK_MAGIC || m == MT_EOS_MAGIC) {
+					*bit = (pos + i) * 8 + r;
+					return (m == MT_BLOCK_MAGIC) ? MT_BLOCK : MT_EOS;
+				}
+			}
+		}
+	}
+	return MT_NONE;
+}
+
+static DWORD WINAPI mt_worker(LPVOID param)
+{
+	mt_job_t *job = (mt_job_t *)param;
+	bunzip_data *bd = job->bd;
+	int r;
+
+	job->ok = FALSE;
+	bd->jmpbuf = &job->jmp;
+	bd->in_fd = -1;
+	bd->inbuf = job->in;
+	bd->inbufCount = (int)job->in_len;
+	bd->inbufPos = 0;
+	bd->inbufBitCount = 0;
+	bd->inbufBits = 0;
+	bd->writeCopies = 0;
+	bd->writeCount = 0;
+	bd->singleBlock = 1;
+	bd->dbufSize = 100000 * job->level;
+	if (setjmp(job->jmp) == 0) {
+		get_bits(bd, job->start_bit & 7);
+		r = read_bunzip(bd, job->out, MT_OUT_CAP);
+		if (r >= 0) {
+			job->out_len = MT_OUT_CAP - r;
+			job->end_bit = (job->start_bit & ~7ULL) + bd->inbufPos * 8ULL - bd->inbufBitCount;
+			job->ok = TRUE;
+		}
+	}
+	SetEvent(job->hDone);
+	return 0;
+}
+
+/* Hand the block from start_bit to stop_bit over to a worker */
+static BOOL mt_dispatch(mt_ctx_t *ctx, mt_job_t *job, uint64_t start_bit, uint64_t stop_bit, unsigned level)
+{
+	/* Up to the end of the next magic, as decoding reads a bit ahead */
+	uint64_t start = start_bit >> 3, end = ((stop_bit + 48 + 7) >> 3);
+	size_t len = (size_t)(end - start);
+
+	if (len > job->in_size) {
+		uint8_t *in = realloc(job->in, len);
+		if (in == NULL)
+			return FALSE;
+		job->in = in;
+		job->in_size = len;
+	}
+	memcpy(job->in, &ctx->in[start - ctx->in_offset], len);
+	job->in_len = len;
+	job->start_bit = start_bit;
+	job->stop_bit = stop_bit;
+	job->level = level;
+	job->busy = TRUE;
+	ResetEvent(job->hDone);
+	if (!QueueUserWorkItem(mt_worker, job, WT_EXECUTELONGFUNCTION))
+		mt_worker(job);
+	return TRUE;
+}
+
+/* Write the output of a job. Returns 0 if the block has to be decoded again, -1 on error */
+static int mt_emit(mt_ctx_t *ctx, mt_job_t *job)
+{
+	bunzip_data *bd = job->bd;
+	char *buf = job->out;
+	int i, len;
+	ssize_t nwrote;
+
+	WaitForSingleObject(job->hDone, INFINITE);
+	job->busy = FALSE;
+	if (!job->ok || job->end_bit != job->stop_bit)
+		return 0;
+	len = job->out_len;
+	if (bled_cancel_request != NULL && *bled_cancel_request != 0)
+		return -1;
+	while (1) {
+		for (i = 0; i < len; i += IOBUF_SIZE) {
+			nwrote = transformer_write(ctx->xstate, &buf[i], MIN(len - i, (int)IOBUF_SIZE));
+			if (nwrote != MIN(len - i, (int)IOBUF_SIZE))
+				return -1;
+		}
+		ctx->total += len;
+		/* The worker stopped at MT_OUT_CAP: do the rest of the block */
+		if (bd->writeCount < 0)
+			break;
+		len = read_bunzip(bd, ctx->buf, IOBUF_SIZE);
+		if (len < 0) {
+			bb_simple_error_msg("CRC error");
+			return -1;
+		}
+		len = IOBUF_SIZE - len;
+		buf = ctx->buf;
+	}
+	ctx->crc = ((ctx->crc << 1) | (ctx->crc >> 31)) ^ bd->headerCRC;
+	if (job->eos) {
+		if (ctx->crc != job->stream_crc) {
+			bb_simple_error_msg("CRC error");
+			return -1;
+		}
+		ctx->crc = 0;
+	}
+	/* Past the combined CRC, for the last block of a stream */
+	bb_total_rb = (job->stop_bit + (job->eos ? 80 + 7 : 0)) >> 3;
+	if (bled_progress != NULL)
+		bled_progress(bb_total_rb);
+	return 1;
+}
+
+/* Returns -2 if the input can't be decoded in parallel */
+static IF_DESKTOP(long long) int unpack_bz2_stream_mt(transformer_state_t *xstate)
+{
+	IF_DESKTOP(long long) int total = -1;
+	LARGE_INTEGER li;
+	mt_ctx_t ctx = { 0 };
+	mt_job_t *jobs = NULL, *job;
+	uint64_t stream, bit, p, block = 0, resume_bit = 0;
+	uint32_t stream_crc = 0;
+	unsigned j, nb_threads, nb_jobs = 0, next = 0, done = 0, level = 0, resume_level = 0;
+	const uint8_t *hdr;
+	BOOL pending, complete = FALSE;
+	int r, type;
+
+	/* Only plain files, where reads can happen anywhere */
+	if (bled_read != NULL || xstate->src_fd == bb_virtual_fd || xstate->mem_output_size_max != 0)
+		return -2;
+	ctx.hFile = (HANDLE)_get_osfhandle(xstate->src_fd);
+	if (ctx.hFile == INVALID_HANDLE_VALUE || GetFileType(ctx.hFile) != FILE_TYPE_DISK ||
+		!GetFileSizeEx(ctx.hFile, &li) || li.QuadPart < MT_MIN_SIZE)
+		return -2;
+	nb_threads = bb_get_nb_threads();
+	if (nb_threads < 2)
+		return -2;
+	/* the magic has just been read */
+	stream = (uint64_t)lseek(xstate->src_fd, 0, SEEK_CUR) - 2;
+	if (stream > (uint64_t)li.QuadPart)
+		return -2;
+
+	ctx.xstate = xstate;
+	ctx.file_size = li.QuadPart;
+	ctx.in_offset = stream;
+	for (j = 0; j < 8; j++) {
+		ctx.hint[(MT_BLOCK_MAGIC >> (32 + j)) & 0xff] |= 1 << j;
+		ctx.hint[(MT_EOS_MAGIC >> (32 + j)) & 0xff] |= 1 << j;
+	}
+	ctx.buf = malloc(IOBUF_SIZE);
+	nb_jobs = MIN(nb_threads, MT_MAX_WORKERS) + 2;
+	jobs = calloc(nb_jobs, sizeof(*jobs));
+	if (ctx.buf == NULL || jobs == NULL) {
+		bb_error_msg("alloc error");
+		nb_jobs = 0;
+		goto out;
+	}
+	for (j = 0; j < nb_jobs; j++) {
+		jobs[j].bd = xzalloc(sizeof(bunzip_data));
+		if (jobs[j].bd == NULL)
+			goto alloc_error;
+		crc32_filltable(jobs[j].bd->crc32Table, 1);
+		/* large enough for any level */
+		jobs[j].bd->dbuf = malloc(9 * 100000 * sizeof(jobs[j].bd->dbuf[0]));
+		jobs[j].out = malloc(MT_OUT_CAP);
+		if (jobs[j].bd->dbuf == NULL || jobs[j].out == NULL)
+			goto alloc_error;
+		jobs[j].hDone = CreateEvent(NULL, TRUE, FALSE, NULL);
+		if (jobs[j].hDone == NULL) {
+			bb_error_msg("could not create event");
+			goto out;
+		}
+	}
+
+	/* Dispatch the blocks as they are found, writing the output of the
+	 * oldest job whenever one is needed for the next block */
+	while (1) { /* "Process one BZ... stream" loop */
+		if (!mt_fill(&ctx, stream, stream + 2) || ctx.in[stream - ctx.in_offset] != 'B' ||
+			ctx.in[stream - ctx.in_offset + 1] != 'Z')
+			break;
+		resume_bit = stream * 8;
+		resume_level = 0;
+		if (!mt_fill(&ctx, stream, stream + 4))
+			goto drain;
+		hdr = &ctx.in[stream - ctx.in_offset];
+		if (hdr[2] != 'h' || hdr[3] < '1' || hdr[3] > '9')
+			goto drain;
+		level = hdr[3] - '0';
+		bit = (stream + 4) * 8;
+		pending = FALSE;
+		while (1) { /* "Find one block" loop */
+			resume_bit = pending ? block : bit;
+			resume_level = level;
+			p = bit;
+			type = mt_scan(&ctx, resume_bit >> 3, &p);
+			if (type == MT_NONE || (!pending && p != bit))
+				goto drain;
+			if (type == MT_EOS) {
+				if (!mt_fill(&ctx, resume_bit >> 3, (p + 80 + 7) >> 3))
+					goto drain;
+				/* The combined CRC follows the magic */
+				stream_crc = 0;
+				for (bit = p + 48; bit < p + 80; bit++)
+					stream_crc = (stream_crc << 1) | ((ctx.in[(bit >> 3) - ctx.in_offset] >> (7 - (bit & 7))) & 1);
+			}
+			if (pending) {
+				job = &jobs[next % nb_jobs];
+				if (job->busy) {
+					r = mt_emit(&ctx, job);
+					done++;
+					if (r < 0)
+						goto err;
+					if (r == 0) {
+						resume_bit = job->start_bit;
+						resume_level = job->level;
+						goto fallback;
+					}
+				}
+				job->eos = (type == MT_EOS);
+				job->stream_crc = stream_crc;
+				if (!mt_dispatch(&ctx, job, block, p, level))
+					goto alloc_error;
+				next++;
+			} else if (type == MT_EOS && stream_crc != 0) {
+				/* An empty stream, that doesn't have the CRC of one */
+				goto drain;
+			}
+			if (type == MT_EOS)
+				break;
+			pending = TRUE;
+			block = p;
+			bit = p + 48;
+		}
+		stream = (p + 80 + 7) >> 3;
+	}
+	complete = TRUE;
+
+ drain:
+	/* Write what has been dispatched, up to the first block that didn't decode */
+	while (done < next) {
+		job = &jobs[done % nb_jobs];
+		r = mt_emit(&ctx, job);
+		done++;
+		if (r < 0)
+			goto err;
+		if (r == 0) {
+			resume_bit = job->start_bit;
+			resume_level = job->level;
+			complete = FALSE;
+			break;
+		}
+	}
+	total = ctx.total;
+	if (complete)
+		goto out;
+
+ fallback:
+	/* Let the sequential decoder take it from there */
+	bb_total_rb = (resume_bit >> 3) + ((resume_level == 0) ? 2 : 0);
+	if ((uint64_t)lseek(xstate->src_fd, bb_total_rb, SEEK_SET) != bb_total_rb) {
+		bb_error_msg("could not seek input");
+		goto err;
+	}
+	total = unpack_bz2_from(xstate, resume_level, resume_bit & 7, ctx.crc);
+	if (total >= 0)
+		total += ctx.total;
+	goto out;
+
+ alloc_error:
+	bb_error_msg("alloc error");
+ err:
+	total = -1;
+ out:
+	/* Don't release any buffer a worker may still be using */
+	for (j = 0; j < nb_jobs; j++) {
+		if (jobs[j].busy)
+			WaitForSingleObject(jobs[j].hDone, INFINITE);
+		if (jobs[j].hDone != NULL)
+			CloseHandle(jobs[j].hDone);
+		if (jobs[j].bd != NULL)
+			dealloc_bunzip(jobs[j].bd);
+		free(jobs[j].in);
+		free(jobs[j].out);
+	}
+	free(jobs);
+	free(ctx.in);
+	free(ctx.buf);
+	return total;
+}
+
+/* Decompress src_fd to dst_fd.  Stops at end of bzip data, not end of file. */
+IF_DESKTOP(long long) int FAST_FUNC
+unpack_bz2_stream(transformer_state_t *xstate)
+{
+	IF_DESKTOP(long long) int total;
+
+	if (check_signature16(xstate, BZIP2_MAGIC))
+		return -1;
+
+	/* Large files on disk are decoded by several threads */
+	total = unpack_bz2_stream_mt(xstate);
+	if (total != -2)
+		return total;
+
+	return unpack_bz2_from(xstate, 0, 0, 0);
+}
+
 char* FAST_FUNC
 unpack_bz2_data(const char *packed, int packed_len, int unpacked_len)
 {
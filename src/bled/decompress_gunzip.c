@@ -21,6 +21,10 @@
  * to free leaked bytebuffer memory (used in unzip.c), and some minor style
  * guide cleanups by Ed Clark
  *
+ * Replaced the huft_build() tables and byte-at-a-time bit buffer with single
+ * lookup (plus subtable) decoding tables, literal pairs, a 64-bit bit buffer
+ * and word-wise match copies, for Rufus
+ *
  * gzip (GNU zip) -- compress files with zip algorithm and 'compress' interface
  * Copyright (C) 1992-1993 Jean-loup Gailly
  * The unzip code was written and put in the public domain by Mark Adler.
@@ -35,26 +39,47 @@
 #include "libbb.h"
 #include "bb_archive.h"
 
-typedef struct huft_t {
-	unsigned char e;	/* number of extra bits or operation */
-	unsigned char b;	/* number of bits in this code or subcode */
-	union {
-		unsigned n;	/* literal, length base, or distance base */
-		/* ^^^^^ was "unsigned short", but that results in larger code */
-		struct huft_t *t;	/* pointer to next level of table */
-	} v;
-} huft_t;
-
 /* gunzip_window size--must be a power of two, and
  * at least 32K for zip's deflate method */
 #define GUNZIP_WSIZE BB_BUFSIZE
 
+/* Bytes left free at the start of bytebuffer, so that whatever whole bytes
+ * are still in the (64-bit) bit buffer can always be given back */
+#define BYTEBUFFER_PAD 8
+
 enum {
-	/* If BMAX needs to be larger than 16, then h and x[] should be ulg. */
-	BMAX = 16,	/* maximum bit length of any code (16 for explode) */
-	N_MAX = 288,	/* maximum number of codes in any set */
+	MAX_CODE_BITS = 15,	/* maximum bit length of any code */
+	LITLEN_BITS = 10,	/* primary lookup bits for literal/length codes */
+	DIST_BITS = 8,		/* primary lookup bits for distance codes */
+	CLEN_BITS = 7,		/* bit length codes are never longer than 7 bits */
+	/* Worst case table sizes: the primary table plus a full size
+	 * subtable for every code that is longer than the primary bits */
+	LITLEN_ENOUGH = (1 << LITLEN_BITS) + 286 * (1 << (MAX_CODE_BITS - LITLEN_BITS)),
+	DIST_ENOUGH = (1 << DIST_BITS) + 30 * (1 << (MAX_CODE_BITS - DIST_BITS)),
+	/* The fast loop needs one full 64-bit refill of input and room for
+	 * the longest match, plus the overrun of a word-wise copy, per symbol */
+	FAST_IN_MARGIN = 16,
+	FAST_OUT_MARGIN = 258 + 16,
 };
 
+/*
+ * Decoding table entries are 32-bit:
+ * bits 0-4:   number of bits of the code that this entry consumes
+ * bits 5-9:   extra bits of a length/distance, bits of a subtable's index,
+ *             or length of the first code of a literal pair
+ * bits 10-12: entry type
+ * bits 16-31: literal (pair), length/distance base or subtable offset
+ * Literal pairs let a single lookup produce two literals, whenever both
+ * codes fit in the primary table bits.
+ */
+enum { E_LIT, E_LIT2, E_BASE, E_EOB, E_SUB, E_BAD };
+enum { TABLE_CLEN, TABLE_LITLEN, TABLE_DIST };
+#define ENTRY(type, val, extra, bits) (((uint32_t)(val) << 16) | ((type) << 10) | ((extra) << 5) | (bits))
+#define E_BITS(e)  ((e) & 0x1f)
+#define E_EXTRA(e) (((e) >> 5) & 0x1f)
+#define E_TYPE(e)  (((e) >> 10) & 0x7)
+#define E_VAL(e)   ((e) >> 16)
+
 
 /* This is somewhat complex-looking arrangement, but it allows
  * to place decompressor state either in bss or in
@@ -73,15 +98,15 @@ typedef struct state_t {
 	uint32_t gunzip_crc;
 
 	int gunzip_src_fd;
-	unsigned gunzip_outbuf_count; /* bytes in output buffer */
+	unsigned gunzip_outbuf_count; /* bytes in output buffer, also the gunzip_window position */
 
 	unsigned char *gunzip_window;
 
 	uint32_t *gunzip_crc_table;
 
 	/* bitbuffer */
-	unsigned gunzip_bb; /* bit buffer */
-	unsigned char gunzip_bk; /* bits in bit buffer */
+	uint64_t gunzip_bb; /* bit buffer */
+	unsigned gunzip_bk; /* bits in bit buffer */
 
 	/* input (compressed) data */
 	unsigned char *bytebuffer;      /* buffer itself */
@@ -91,15 +116,8 @@ typedef struct state_t {
 	unsigned bytebuffer_size;       /* how much data is there (size <= max) */
 
 	/* private data of inflate_codes() */
-	unsigned inflate_codes_ml; /* masks for bl and bd bits */
-	unsigned inflate_codes_md; /* masks for bl and bd bits */
-	unsigned inflate_codes_bb; /* bit buffer */
-	unsigned inflate_codes_k; /* number of bits in bit buffer */
-	unsigned inflate_codes_w; /* current gunzip_window position */
-	huft_t *inflate_codes_tl;
-	huft_t *inflate_codes_td;
-	unsigned inflate_codes_bl;
-	unsigned inflate_codes_bd;
+	const uint32_t *inflate_codes_tl;
+	const uint32_t *inflate_codes_td;
 	unsigned inflate_codes_nn; /* length and index for copy */
 	unsigned inflate_codes_dd;
 
@@ -112,9 +130,13 @@ typedef struct state_t {
 
 	/* private data of inflate_stored() */
 	unsigned inflate_stored_n;
-	unsigned inflate_stored_b;
-	unsigned inflate_stored_k;
-	unsigned inflate_stored_w;
+
+	/* decoding tables */
+	smallint fixed_tables_built;
+	uint32_t litlen_table[LITLEN_ENOUGH];
+	uint32_t dist_table[DIST_ENOUGH];
+	uint32_t fixed_litlen_table[1 << LITLEN_BITS];
+	uint32_t fixed_dist_table[1 << DIST_BITS];
 
 	const char *error_msg;
 	jmp_buf error_jmp;
@@ -134,15 +156,8 @@ typedef struct state_t {
 #define bytebuffer          (S()bytebuffer         )
 #define bytebuffer_offset   (S()bytebuffer_offset  )
 #define bytebuffer_size     (S()bytebuffer_size    )
-#define inflate_codes_ml    (S()inflate_codes_ml   )
-#define inflate_codes_md    (S()inflate_codes_md   )
-#define inflate_codes_bb    (S()inflate_codes_bb   )
-#define inflate_codes_k     (S()inflate_codes_k    )
-#define inflate_codes_w     (S()inflate_codes_w    )
 #define inflate_codes_tl    (S()inflate_codes_tl   )
 #define inflate_codes_td    (S()inflate_codes_td   )
-#define inflate_codes_bl    (S()inflate_codes_bl   )
-#define inflate_codes_bd    (S()inflate_codes_bd   )
 #define inflate_codes_nn    (S()inflate_codes_nn   )
 #define inflate_codes_dd    (S()inflate_codes_dd   )
 #define resume_copy         (S()resume_copy        )
@@ -150,9 +165,11 @@ typedef struct state_t {
 #define need_another_block  (S()need_another_block )
 #define end_reached         (S()end_reached        )
 #define inflate_stored_n    (S()inflate_stored_n   )
-#define inflate_stored_b    (S()inflate_stored_b   )
-#define inflate_stored_k    (S()inflate_stored_k   )
-#define inflate_stored_w    (S()inflate_stored_w   )
+#define fixed_tables_built  (S()fixed_tables_built )
+#define litlen_table        (S()litlen_table       )
+#define dist_table          (S()dist_table         )
+#define fixed_litlen_table  (S()fixed_litlen_table )
+#define fixed_dist_table    (S()fixed_dist_table   )
 #define error_msg           (S()error_msg          )
 #define error_jmp           (S()error_jmp          )
 
@@ -181,13 +198,8 @@ static state_t state;
 #endif
 
 
-static const uint16_t mask_bits[] ALIGN2 = {
-	0x0000, 0x0001, 0x0003, 0x0007, 0x000f, 0x001f, 0x003f, 0x007f, 0x00ff,
-	0x01ff, 0x03ff, 0x07ff, 0x0fff, 0x1fff, 0x3fff, 0x7fff, 0xffff
-};
-
 /* Put lengths/offsets and extra bits in a struct of arrays
- * to make calls to huft_build() have one fewer parameter.
+ * to make calls to build_table() have one fewer parameter.
  */
 struct cp_ext {
 	uint16_t cp[31];
@@ -215,484 +227,499 @@ static const uint8_t border[] ALIGN1 = {
 };
 
 
+static void abort_unzip(STATE_PARAM_ONLY) NORETURN;
+static void abort_unzip(STATE_PARAM_ONLY)
+{
+	longjmp(error_jmp, 1);
+}
+
+/* Read the next chunk of compressed data, after the pad bytes.
+ * Returns 0 at the end of the input. */
+static int refill_bytebuffer(STATE_PARAM_ONLY)
+{
+	unsigned sz = bytebuffer_max - BYTEBUFFER_PAD;
+	int n;
+
+	if (to_read >= 0 && to_read < sz) /* unzip only */
+		sz = (unsigned)to_read;
+	n = safe_read(gunzip_src_fd, &bytebuffer[BYTEBUFFER_PAD], sz);
+	if (n < 1)
+		return 0;
+	if (to_read >= 0) /* unzip only */
+		to_read -= n;
+	bytebuffer_size = n + BYTEBUFFER_PAD;
+	bytebuffer_offset = BYTEBUFFER_PAD;
+	return 1;
+}
+
 /*
- * Free the malloc'ed tables built by huft_build(), which makes a linked
- * list of the tables it made, with the links in a dummy first entry of
- * each table.
- * t: table to free
+ * Add bytes to the bit buffer until it holds at least 'required' bits.
+ * Note that the bits above gunzip_bk are not necessarily zero: the fast
+ * path loads whole words, so they can hold a copy of the upcoming input,
+ * which the OR below then leaves unchanged.
  */
-#define BAD_HUFT(p) ((uintptr_t)(p) & 1)
-#define ERR_RET     ((huft_t*)(uintptr_t)1)
-static void huft_free(huft_t *p)
+static void fill_bitbuffer(STATE_PARAM const unsigned required)
 {
-	huft_t *q;
-
-	/*
-	 * If 'p' has the error bit set we have to clear it, otherwise we might run
-	 * into a segmentation fault or an invalid pointer to free(p)
-	 */
-	//if (BAD_HUFT(p)) // commented out, since bit clearing has effect only if condition is true
-		p = (huft_t*)((uintptr_t)p & ~(uintptr_t)ERR_RET);
+	while (gunzip_bk < required) {
+		if (bytebuffer_offset >= bytebuffer_size && !refill_bytebuffer(PASS_STATE_ONLY)) {
+			error_msg = "unexpected end of file";
+			abort_unzip(PASS_STATE_ONLY);
+		}
+		gunzip_bb |= ((uint64_t) bytebuffer[bytebuffer_offset]) << gunzip_bk;
+		bytebuffer_offset++;
+		gunzip_bk += 8;
+	}
+}
 
-	/* Go through linked list, freeing from the malloced (t[-1]) address. */
-	while (p) {
-		q = (--p)->v.t;
-		free(p);
-		p = q;
+/* Same as above, but stops quietly at the end of input, since the last
+ * codes of a stream may be shorter than what we'd like to look at */
+static void peek_bitbuffer(STATE_PARAM const unsigned wanted)
+{
+	while (gunzip_bk < wanted) {
+		if (bytebuffer_offset >= bytebuffer_size && !refill_bytebuffer(PASS_STATE_ONLY))
+			break;
+		gunzip_bb |= ((uint64_t) bytebuffer[bytebuffer_offset]) << gunzip_bk;
+		bytebuffer_offset++;
+		gunzip_bk += 8;
 	}
 }
 
-static void huft_free_all(STATE_PARAM_ONLY)
+static ALWAYS_INLINE unsigned get_bits(STATE_PARAM const unsigned n)
 {
-	huft_free(inflate_codes_tl);
-	huft_free(inflate_codes_td);
-	inflate_codes_tl = NULL;
-	inflate_codes_td = NULL;
+	unsigned v;
+
+	fill_bitbuffer(PASS_STATE n);
+	v = (unsigned) gunzip_bb & ((1U << n) - 1);
+	gunzip_bb >>= n;
+	gunzip_bk -= n;
+	return v;
 }
 
-static void abort_unzip(STATE_PARAM_ONLY) NORETURN;
-static void abort_unzip(STATE_PARAM_ONLY)
+/* Give the whole bytes that are still in the bit buffer back to
+ * bytebuffer, so that reading can resume byte aligned from there. */
+static void unwind_bitbuffer(STATE_PARAM_ONLY)
 {
-	huft_free_all(PASS_STATE_ONLY);
-	longjmp(error_jmp, 1);
+	unsigned i, n;
+
+	gunzip_bb >>= gunzip_bk & 7;
+	n = gunzip_bk >> 3;
+	bytebuffer_offset -= n;
+	for (i = 0; i < n; i++)
+		bytebuffer[bytebuffer_offset + i] = (unsigned char)(gunzip_bb >> (8 * i));
+	gunzip_bb = 0;
+	gunzip_bk = 0;
 }
 
-static unsigned fill_bitbuffer(STATE_PARAM unsigned bitbuffer, unsigned *current, const unsigned required)
+static ALWAYS_INLINE uint64_t load_le64(const unsigned char *p)
 {
-	while (*current < required) {
-		if (bytebuffer_offset >= bytebuffer_size) {
-			unsigned sz = bytebuffer_max - 4;
-			if (to_read >= 0 && to_read < sz) /* unzip only */
-				sz = (unsigned)to_read;
-			/* Leave the first 4 bytes empty so we can always unwind the bitbuffer
-			 * to the front of the bytebuffer */
-			bytebuffer_size = safe_read(gunzip_src_fd, &bytebuffer[4], sz);
-			if ((int)bytebuffer_size < 1) {
-				error_msg = "unexpected end of file";
-				abort_unzip(PASS_STATE_ONLY);
-			}
-			if (to_read >= 0) /* unzip only */
-				to_read -= bytebuffer_size;
-			bytebuffer_size += 4;
-			bytebuffer_offset = 4;
-		}
-		bitbuffer |= ((unsigned) bytebuffer[bytebuffer_offset]) << *current;
-		bytebuffer_offset++;
-		*current += 8;
-	}
-	// coverity[return_overflow]
-	return bitbuffer;
+	uint64_t v;
+#if BB_LITTLE_ENDIAN
+	memcpy(&v, p, sizeof(v));
+#else
+	int i;
+	for (v = 0, i = 7; i >= 0; i--)
+		v = (v << 8) | p[i];
+#endif
+	return v;
 }
 
 
-/* Given a list of code lengths and a maximum table size, make a set of
- * tables to decode that set of codes.
- *
- * b:	code lengths in bits (all assumed <= BMAX)
- * n:	number of codes (assumed <= N_MAX)
- * s:	number of simple-valued codes (0..s-1)
- * cp_ext->cp,ext: list of base values/extra bits for non-simple codes
- * m:	maximum lookup bits, returns actual
- * result: starting table
- *
- * On error, returns a value with lowest-bit set on error.
- * It can be just the value of 0x1,
- * or a valid pointer to a Huffman table, ORed with 0x1 if incompete table
- * is given: "fixed inflate" decoder feeds us such data.
+/*
+ * Build the decoding table of the canonical Huffman code given by the
+ * code lengths in lens[0..n-1]. Codes of up to root_bits bits are decoded
+ * with a single lookup, longer ones go through a subtable that is shared
+ * by all the codes with the same root_bits prefix.
+ * Returns -1 on over-subscribed code sets, as well as on incomplete ones,
+ * unless allow_incomplete is set or there is only a single 1-bit code
+ * (which is what huft_build() used to accept).
  */
-static huft_t* huft_build(const unsigned *b, const unsigned n,
-			const unsigned s, const struct cp_ext *cp_ext,
-			unsigned *m)
+static int build_table(uint32_t *table, const unsigned table_size, const unsigned root_bits,
+			const uint8_t *lens, const unsigned n, const int kind, const int allow_incomplete)
 {
-	unsigned a;             /* counter for codes of length k */
-	unsigned c[BMAX + 1];   /* bit length count table */
-	unsigned eob_len;       /* length of end-of-block code (value 256) */
-	unsigned f;             /* i repeats in table every f entries */
-	int g;                  /* maximum code length */
-	int htl;                /* table level */
-	unsigned i;             /* counter, current code */
-	unsigned j;             /* counter */
-	int k;                  /* number of bits in current code */
-	const unsigned *p;      /* pointer into c[], b[], or v[] */
-	huft_t *q;              /* points to current table */
-	huft_t r;               /* table entry for structure assignment */
-	huft_t *u[BMAX];        /* table stack */
-	unsigned v[N_MAX + 1];  /* values in order of bit length. last v[] is never used */
-	int ws[BMAX + 1];       /* bits decoded stack */
-	int w;                  /* bits decoded */
-	unsigned x[BMAX + 1];   /* bit offsets, then code stack */
-	unsigned *xp;           /* pointer into x */
-	int y;                  /* number of dummy codes added */
-	unsigned z;             /* number of entries in current table */
-	huft_t *result;
-	huft_t **t;
-
-	/* Length of EOB code, if any */
-	eob_len = n > 256 ? b[256] : BMAX;
-
-	memset(&r, 0, sizeof(r));
-
-	/* Generate counts for each bit length */
-	memset(c, 0, sizeof(c));
-	p = b;
-	i = n;
-	do {
-		c[*p]++; /* assume all entries <= BMAX */
-		p++;     /* can't combine with above line (Solaris bug) */
-	} while (--i);
-	if (c[0] == n) {  /* null input - all zero length codes */
-		q = xzalloc(3 * sizeof(*q));
-		//q[0].v.t = NULL;
-		q[1].e = 99;    /* invalid code marker */
-		q[1].b = 1;
-		q[2].e = 99;    /* invalid code marker */
-		q[2].b = 1;
-		*m = 1;
-		return q + 1;
-	}
-
-	/* Find minimum and maximum length, bound *m by those */
-	for (j = 1; (j <= BMAX) && (c[j] == 0); j++)
-		continue;
-	k = j; /* minimum code length */
-	for (i = BMAX; (c[i] == 0) && i; i--)
-		continue;
-	g = i; /* maximum code length */
-	*m = (*m < j) ? j : ((*m > i) ? i : *m);
-
-	/* Adjust last length count to fill out codes, if needed */
-	for (y = 1 << j; j < i; j++, y <<= 1) {
-		y -= c[j];
-		if (y < 0)
-			return ERR_RET; /* bad input: more codes than bits */
-	}
-	y -= c[i];
-	if (y < 0)
-		return ERR_RET;
-	c[i] += y;
-
-	/* Generate starting offsets into the value table for each length */
-	x[1] = j = 0;
-	p = c + 1;
-	xp = x + 2;
-	while (--i) { /* note that i == g from above */
-		j += *p++;
-		*xp++ = j;
-	}
-
-	/* Make a table of values in order of bit lengths.
-	 * To detect bad input, unused v[i]'s are set to invalid value UINT_MAX.
-	 * In particular, last v[i] is never filled and must not be accessed.
-	 */
-	memset(v, 0xff, sizeof(v));
-	p = b;
-	i = 0;
-	do {
-		j = *p++;
-		if (j != 0) {
-			v[x[j]++] = i;
-		}
-	} while (++i < n);
-
-	/* Generate the Huffman codes and for each, make the table entries */
-	result = ERR_RET;
-	t = &result;
-	x[0] = i = 0;   /* first Huffman code is zero */
-	p = v;          /* grab values in bit order */
-	htl = -1;       /* no tables yet--level -1 */
-	w = ws[0] = 0;  /* bits decoded */
-	u[0] = NULL;    /* just to keep compilers happy */
-	q = NULL;       /* ditto */
-	z = 0;          /* ditto */
-
-	/* go through the bit lengths (k already is bits in shortest code) */
-	for (; k <= g; k++) {
-		a = c[k];
-		while (a--) {
-			/* here i is the Huffman code of length k bits for value *p */
-			/* make tables up to required level */
-			while (k > ws[htl + 1]) {
-				w = ws[++htl];
-
-				/* compute minimum size table less than or equal to *m bits */
-				z = g - w;
-				z = z > *m ? *m : z; /* upper limit on table size */
-				j = k - w;
-				f = 1 << j;
-				if (f > a + 1) { /* try a k-w bit table */
-					/* too few codes for k-w bit table */
-					f -= a + 1; /* deduct codes from patterns left */
-					xp = c + k;
-					while (++j < z) { /* try smaller tables up to z bits */
-						f <<= 1;
-						if (f <= *++xp) {
-							break; /* enough codes to use up j bits */
-						}
-						f -= *xp; /* else deduct codes from patterns */
-					}
-				}
-				j = ((w + j) > (int)eob_len && w < (int)eob_len) ? eob_len - w : j;	/* make EOB code end at table */
-				z = 1 << j;	/* table entries for j-bit table */
-				ws[htl+1] = w + j;	/* set bits decoded in stack */
-
-				/* allocate and link in new table */
-				q = xzalloc((z + 1) * sizeof(huft_t));
-				*t = q + 1;	/* link to list for huft_free() */
-				t = &(q->v.t);
-				u[htl] = ++q;	/* table starts after link */
-
-				/* connect to last table, if there is one */
-				if (htl) {
-					x[htl] = i; /* save pattern for backing up */
-					r.b = (unsigned char) (w - ws[htl - 1]); /* bits to dump before this table */
-					r.e = (unsigned char) (16 + j); /* bits in this table */
-					r.v.t = q; /* pointer to this table */
-					j = (i & ((1 << w) - 1)) >> ws[htl - 1];
-					u[htl - 1][j] = r; /* connect to last table */
-				}
-			}
+	unsigned count[MAX_CODE_BITS + 1];	/* number of codes of each length */
+	unsigned next[MAX_CODE_BITS + 1];	/* next canonical code of each length */
+	uint16_t codes[288];			/* bit-reversed code of each symbol */
+	uint8_t sub_len[1 << LITLEN_BITS];	/* longest code behind each root entry */
+	const unsigned root_size = 1U << root_bits;
+	unsigned i, j, len, max_len = 0, used = root_size;
+	uint32_t e;
+	int left;
+
+	memset(count, 0, sizeof(count));
+	for (i = 0; i < n; i++)
+		count[lens[i]]++;
+	for (i = 0; i < root_size; i++)
+		table[i] = ENTRY(E_BAD, 0, 0, 0);
+	if (count[0] == n)	/* null input - all zero length codes */
+		return 0;
 
-			/* set up table entry in r */
-			r.b = (unsigned char) (k - w);
-			if (/*p >= v + n || -- redundant, caught by the second check: */
-				*p == UINT_MAX /* do we access uninited v[i]? (see memset(v))*/
-			) {
-				r.e = 99; /* out of values--invalid code */
-			} else if (*p < s) {
-				r.e = (unsigned char) (*p < 256 ? 16 : 15);	/* 256 is EOB code */
-				r.v.n = (unsigned short) (*p++); /* simple code is just the value */
-			} else {
-				r.e = (unsigned char) cp_ext->ext[*p - s]; /* non-simple--look up in lists */
-				r.v.n = cp_ext->cp[*p++ - s];
-			}
+	left = 1;
+	for (len = 1; len <= MAX_CODE_BITS; len++) {
+		left = (left << 1) - (int)count[len];
+		if (left < 0)
+			return -1;	/* more codes than bits */
+		if (count[len] != 0)
+			max_len = len;
+	}
+	if (left > 0 && max_len != 1 && !allow_incomplete)
+		return -1;
 
-			/* fill code-like entries with r */
-			f = 1 << (k - w);
-			for (j = i >> w; j < z; j += f) {
-				q[j] = r;
-			}
+	/* Assign the canonical codes, bit-reversed since deflate sends them MSB first */
+	next[1] = 0;
+	for (len = 1; len < MAX_CODE_BITS; len++)
+		next[len + 1] = (next[len] + count[len]) << 1;
+	memset(sub_len, 0, root_size);
+	for (i = 0; i < n; i++) {
+		unsigned code, rev = 0;
+		len = lens[i];
+		if (len == 0)
+			continue;
+		code = next[len]++;
+		for (j = 0; j < len; j++, code >>= 1)
+			rev = (rev << 1) | (code & 1);
+		codes[i] = (uint16_t)rev;
+		if (len > root_bits && len > sub_len[rev & (root_size - 1)])
+			sub_len[rev & (root_size - 1)] = (uint8_t)len;
+	}
 
-			/* backwards increment the k-bit code i */
-			for (j = 1 << (k - 1); i & j; j >>= 1) {
-				i ^= j;
-			}
-			i ^= j;
+	/* Lay out the subtables after the root table */
+	for (i = 0; i < root_size; i++) {
+		if (sub_len[i] == 0)
+			continue;
+		j = sub_len[i] - root_bits;
+		if (used + (1U << j) > table_size)
+			return -1;
+		table[i] = ENTRY(E_SUB, used, j, root_bits);
+		for (len = 0; len < (1U << j); len++)
+			table[used + len] = ENTRY(E_BAD, 0, 0, 0);
+		used += 1U << j;
+	}
 
-			/* backup over finished tables */
-			while ((i & ((1 << w) - 1)) != x[htl]) {
-				w = ws[--htl];
-			}
+	/* Fill the entries, replicating each code over all the unused upper bits */
+	for (i = 0; i < n; i++) {
+		len = lens[i];
+		if (len == 0)
+			continue;
+		switch (kind) {
+		case TABLE_LITLEN:
+			if (i < 256)
+				e = ENTRY(E_LIT, i, 0, len);
+			else if (i == 256)
+				e = ENTRY(E_EOB, 0, 0, len);
+			else if (i < 286)
+				e = ENTRY(E_BASE, lit.cp[i - 257], lit.ext[i - 257], len);
+			else
+				e = ENTRY(E_BAD, 0, 0, len);
+			break;
+		case TABLE_DIST:
+			e = (i < 30) ? ENTRY(E_BASE, dist.cp[i], dist.ext[i], len) : ENTRY(E_BAD, 0, 0, len);
+			break;
+		default:
+			e = ENTRY(E_LIT, i, 0, len);
+			break;
+		}
+		if (len <= root_bits) {
+			for (j = codes[i]; j < root_size; j += 1U << len)
+				table[j] = e;
+		} else {
+			uint32_t s = table[codes[i] & (root_size - 1)];
+			uint32_t *sub = &table[E_VAL(s)];
+			e -= root_bits;
+			for (j = codes[i] >> root_bits; j < (1U << E_EXTRA(s)); j += 1U << (len - root_bits))
+				sub[j] = e;
 		}
 	}
 
-	/* return actual size of base table */
-	*m = ws[1];
+	/* Pair up literals whose codes fit together in the root bits. Going
+	 * downwards, the entry at i >> len is always still a single one. */
+	if (kind == TABLE_LITLEN) {
+		i = root_size;
+		while (i-- > 0) {
+			uint32_t e2;
+			e = table[i];
+			len = E_BITS(e);
+			if (E_TYPE(e) != E_LIT || len >= root_bits)
+				continue;
+			e2 = table[i >> len];
+			if (E_TYPE(e2) != E_LIT || len + E_BITS(e2) > root_bits)
+				continue;
+			table[i] = ENTRY(E_LIT2, E_VAL(e) | (E_VAL(e2) << 8), len, len + E_BITS(e2));
+		}
+	}
+	return 0;
+}
+
+/* Decode a single symbol, one byte of input at a time. Literal pairs are
+ * split, so that the caller can stop exactly where the window fills up. */
+static uint32_t decode_symbol(STATE_PARAM const uint32_t *table, const unsigned root_bits)
+{
+	uint32_t e;
+	unsigned n;
+
+	peek_bitbuffer(PASS_STATE MAX_CODE_BITS);
+	e = table[(unsigned) gunzip_bb & ((1U << root_bits) - 1)];
+	n = E_BITS(e);
+	if (E_TYPE(e) == E_SUB) {
+		e = table[E_VAL(e) + (((unsigned) gunzip_bb >> root_bits) & ((1U << E_EXTRA(e)) - 1))];
+		n += E_BITS(e);
+	} else if (E_TYPE(e) == E_LIT2) {
+		n = E_EXTRA(e);
+		e = ENTRY(E_LIT, E_VAL(e) & 0xff, 0, n);
+	}
+	if (n > gunzip_bk) {
+		error_msg = "unexpected end of file";
+		abort_unzip(PASS_STATE_ONLY);
+	}
+	gunzip_bb >>= n;
+	gunzip_bk -= n;
+	return e;
+}
 
-	if (y != 0 && g != 1) /* we were given an incomplete table */
-		/* return "result" ORed with 1 */
-		return (void*)((uintptr_t)result | 1);
 
-	return result;
+/*
+ * Copy a match of n bytes from distance d, for the fast loop, which
+ * guarantees that the window has room for n bytes plus a word of overrun.
+ * Returns the new window position.
+ */
+static ALWAYS_INLINE unsigned copy_match(unsigned char *window, unsigned w, const unsigned d, unsigned n)
+{
+	unsigned char *dst = window + w;
+	const unsigned char *src;
+	unsigned char *end;
+
+	if (d > w) {
+		/* The match starts in what's left from the previous window */
+		unsigned part = d - w;
+		w += n;
+		src = window + GUNZIP_WSIZE - part;
+		if (part >= n) {
+			memcpy(dst, src, n);
+			return w;
+		}
+		memcpy(dst, src, part);
+		dst += part;
+		n -= part;
+	} else {
+		w += n;
+	}
+	src = dst - d;
+	end = dst + n;
+	if (d >= 8) {
+		/* Each word only ever reads data that's already been written */
+		do {
+			memcpy(dst, src, 8);
+			dst += 8;
+			src += 8;
+		} while (dst < end);
+	} else if (d == 1) {
+		memset(dst, *src, n);
+	} else {
+		do {
+			*dst++ = *src++;
+		} while (dst < end);
+	}
+	return w;
 }
 
+/*
+ * The fast inner loop of inflate_codes(): decode symbols for as long as
+ * there's enough input for a full refill of the 64-bit bit buffer, which
+ * is always enough for a length and a distance code with their extra bits,
+ * and the window has room for a maximum length match.
+ * Returns 1 at the end of the block, 0 when out of margin.
+ */
+static int inflate_codes_fast(STATE_PARAM_ONLY)
+{
+	const uint32_t *tl = inflate_codes_tl;
+	const uint32_t *td = inflate_codes_td;
+	const unsigned char *in = bytebuffer;
+	unsigned char *window = gunzip_window;
+	const unsigned in_last = bytebuffer_size - FAST_IN_MARGIN;
+	const unsigned w_last = GUNZIP_WSIZE - FAST_OUT_MARGIN;
+	unsigned in_pos = bytebuffer_offset;
+	unsigned w = gunzip_outbuf_count;
+	uint64_t bb = gunzip_bb;
+	unsigned k = gunzip_bk;
+	unsigned n, d;
+	uint32_t e;
+	int ret = 0;
+
+	while (in_pos <= in_last && w <= w_last) {
+		/* Branchless refill, to between 56 and 63 bits */
+		bb |= load_le64(&in[in_pos]) << k;
+		in_pos += (63 - k) >> 3;
+		k |= 56;
+
+		e = tl[(unsigned) bb & ((1U << LITLEN_BITS) - 1)];
+		if (E_TYPE(e) == E_SUB) {
+			bb >>= LITLEN_BITS;
+			k -= LITLEN_BITS;
+			e = tl[E_VAL(e) + ((unsigned) bb & ((1U << E_EXTRA(e)) - 1))];
+		}
+		bb >>= E_BITS(e);
+		k -= E_BITS(e);
+		if (E_TYPE(e) <= E_LIT2) {
+			/* One or two literals (the second byte is overwritten later if unused) */
+			window[w] = (unsigned char) E_VAL(e);
+			window[w + 1] = (unsigned char) (E_VAL(e) >> 8);
+			w += 1 + E_TYPE(e);
+			continue;
+		}
+		if (E_TYPE(e) != E_BASE) {
+			if (E_TYPE(e) != E_EOB)
+				abort_unzip(PASS_STATE_ONLY);
+			ret = 1;
+			break;
+		}
+		n = E_VAL(e) + ((unsigned) bb & ((1U << E_EXTRA(e)) - 1));
+		bb >>= E_EXTRA(e);
+		k -= E_EXTRA(e);
+
+		e = td[(unsigned) bb & ((1U << DIST_BITS) - 1)];
+		if (E_TYPE(e) == E_SUB) {
+			bb >>= DIST_BITS;
+			k -= DIST_BITS;
+			e = td[E_VAL(e) + ((unsigned) bb & ((1U << E_EXTRA(e)) - 1))];
+		}
+		if (E_TYPE(e) != E_BASE)
+			abort_unzip(PASS_STATE_ONLY);
+		bb >>= E_BITS(e);
+		k -= E_BITS(e);
+		d = E_VAL(e) + ((unsigned) bb & ((1U << E_EXTRA(e)) - 1));
+		bb >>= E_EXTRA(e);
+		k -= E_EXTRA(e);
+
+		w = copy_match(window, w, d, n);
+	}
+
+	/* restore the globals from the locals */
+	gunzip_bb = bb;
+	gunzip_bk = k;
+	bytebuffer_offset = in_pos;
+	gunzip_outbuf_count = w;
+	return ret;
+}
 
 /*
  * inflate (decompress) the codes in a deflated (compressed) block.
- * Return an error code or zero if it all goes ok.
- *
- * tl, td: literal/length and distance decoder tables
- * bl, bd: number of bits decoded by tl[] and td[]
+ * Returns 1 when the window is full and 0 at the end of the block.
+ * Most of the work happens in inflate_codes_fast(), while this handles
+ * the last few symbols before the end of the input or of the window.
  */
-/* called once from inflate_block */
-
-/* map formerly local static variables to globals */
-#define ml inflate_codes_ml
-#define md inflate_codes_md
-#define bb inflate_codes_bb
-#define k  inflate_codes_k
-#define w  inflate_codes_w
-#define tl inflate_codes_tl
-#define td inflate_codes_td
-#define bl inflate_codes_bl
-#define bd inflate_codes_bd
+/* called once from inflate_get_next_window */
 #define nn inflate_codes_nn
 #define dd inflate_codes_dd
-static void inflate_codes_setup(STATE_PARAM unsigned my_bl, unsigned my_bd)
-{
-	bl = my_bl;
-	bd = my_bd;
-	/* make local copies of globals */
-	bb = gunzip_bb;			/* initialize bit buffer */
-	k = gunzip_bk;
-	w = gunzip_outbuf_count;	/* initialize gunzip_window position */
-	/* inflate the coded data */
-	ml = mask_bits[bl];		/* precompute masks for speed */
-	md = mask_bits[bd];
-}
-/* called once from inflate_get_next_window */
 static NOINLINE int inflate_codes(STATE_PARAM_ONLY)
 {
-	unsigned e;	/* table entry flag/number of extra bits */
-	huft_t *t;	/* pointer to table entry */
+	unsigned w = gunzip_outbuf_count;
+	uint32_t e;
 
 	if (resume_copy)
 		goto do_copy;
 
 	while (1) {			/* do until end of block */
-		bb = fill_bitbuffer(PASS_STATE bb, &k, bl);
-		t = tl + ((unsigned) bb & ml);
-		e = t->e;
-		if (e > 16)
-			do {
-				if (e == 99) {
-					abort_unzip(PASS_STATE_ONLY);
-				}
-				bb >>= t->b;
-				k -= t->b;
-				e -= 16;
-				bb = fill_bitbuffer(PASS_STATE bb, &k, e);
-				t = t->v.t + ((unsigned) bb & mask_bits[e]);
-				e = t->e;
-			} while (e > 16);
-		bb >>= t->b;
-		k -= t->b;
-		if (e == 16) {	/* then it's a literal */
-			gunzip_window[w++] = (unsigned char) t->v.n;
+		if (bytebuffer_size - bytebuffer_offset >= FAST_IN_MARGIN
+		 && GUNZIP_WSIZE - w >= FAST_OUT_MARGIN
+		) {
+			gunzip_outbuf_count = w;
+			if (inflate_codes_fast(PASS_STATE_ONLY))
+				return 0;
+			w = gunzip_outbuf_count;
+			continue;
+		}
+
+		e = decode_symbol(PASS_STATE inflate_codes_tl, LITLEN_BITS);
+		if (E_TYPE(e) == E_LIT) {
+			gunzip_window[w++] = (unsigned char) E_VAL(e);
 			if (w == GUNZIP_WSIZE) {
 				gunzip_outbuf_count = w;
-				//flush_gunzip_window();
-				w = 0;
 				return 1; // We have a block to read
 			}
-		} else {		/* it's an EOB or a length */
-			/* exit if end of block */
-			if (e == 15) {
-				break;
-			}
-
-			/* get length of block to copy */
-			bb = fill_bitbuffer(PASS_STATE bb, &k, e);
-			nn = t->v.n + ((unsigned) bb & mask_bits[e]);
-			bb >>= e;
-			k -= e;
-
-			/* decode distance of block to copy */
-			bb = fill_bitbuffer(PASS_STATE bb, &k, bd);
-			t = td + ((unsigned) bb & md);
-			e = t->e;
-			if (e > 16)
-				do {
-					if (e == 99) {
-						abort_unzip(PASS_STATE_ONLY);
-					}
-					bb >>= t->b;
-					k -= t->b;
-					e -= 16;
-					bb = fill_bitbuffer(PASS_STATE bb, &k, e);
-					t = t->v.t + ((unsigned) bb & mask_bits[e]);
-					e = t->e;
-				} while (e > 16);
-			bb >>= t->b;
-			k -= t->b;
-			bb = fill_bitbuffer(PASS_STATE bb, &k, e);
-			dd = w - t->v.n - ((unsigned) bb & mask_bits[e]);
-			bb >>= e;
-			k -= e;
-
-			/* do the copy */
- do_copy:
-			do {
-				/* Was: nn -= (e = (e = GUNZIP_WSIZE - ((dd &= GUNZIP_WSIZE - 1) > w ? dd : w)) > nn ? nn : e); */
-				/* Who wrote THAT?? rewritten as: */
-				unsigned delta;
-
-				dd &= GUNZIP_WSIZE - 1;
-				e = GUNZIP_WSIZE - (dd > w ? dd : w);
-				delta = w > dd ? w - dd : dd - w;
-				if (e > nn) e = nn;
-				nn -= e;
-
-				/* copy to new buffer to prevent possible overwrite */
-				if (delta >= e) {
-					memcpy(gunzip_window + w, gunzip_window + dd, e);
-					w += e;
-					dd += e;
-				} else {
-					/* do it slow to avoid memcpy() overlap */
-					/* !NOMEMCPY */
-					do {
-						gunzip_window[w++] = gunzip_window[dd++];
-					} while (--e);
-				}
-				if (w == GUNZIP_WSIZE) {
-					gunzip_outbuf_count = w;
-					resume_copy = (nn != 0);
-					//flush_gunzip_window();
-					w = 0;
-					return 1;
-				}
-			} while (nn);
-			resume_copy = 0;
+			continue;
 		}
-	}
+		/* exit if end of block */
+		if (E_TYPE(e) == E_EOB)
+			break;
+		if (E_TYPE(e) != E_BASE)
+			abort_unzip(PASS_STATE_ONLY);
 
-	/* restore the globals from the locals */
-	gunzip_outbuf_count = w;	/* restore global gunzip_window pointer */
-	gunzip_bb = bb;			/* restore global bit buffer */
-	gunzip_bk = k;
+		/* get length of block to copy */
+		nn = E_VAL(e) + get_bits(PASS_STATE E_EXTRA(e));
 
-	/* normally just after call to inflate_codes, but save code by putting it here */
-	/* free the decoding tables (tl and td), return */
-	huft_free_all(PASS_STATE_ONLY);
+		/* decode distance of block to copy */
+		e = decode_symbol(PASS_STATE inflate_codes_td, DIST_BITS);
+		if (E_TYPE(e) != E_BASE)
+			abort_unzip(PASS_STATE_ONLY);
+		dd = w - E_VAL(e) - get_bits(PASS_STATE E_EXTRA(e));
+
+		/* do the copy */
+ do_copy:
+		do {
+			unsigned delta, m;
+
+			dd &= GUNZIP_WSIZE - 1;
+			m = GUNZIP_WSIZE - (dd > w ? dd : w);
+			delta = w > dd ? w - dd : dd - w;
+			if (m > nn) m = nn;
+			nn -= m;
+
+			/* copy to new buffer to prevent possible overwrite */
+			if (delta >= m) {
+				memcpy(gunzip_window + w, gunzip_window + dd, m);
+				w += m;
+				dd += m;
+			} else {
+				/* do it slow to avoid memcpy() overlap */
+				do {
+					gunzip_window[w++] = gunzip_window[dd++];
+				} while (--m);
+			}
+			if (w == GUNZIP_WSIZE) {
+				gunzip_outbuf_count = w;
+				resume_copy = (nn != 0);
+				return 1;
+			}
+		} while (nn);
+		resume_copy = 0;
+	}
 
-	/* done */
+	gunzip_outbuf_count = w;
 	return 0;
 }
-#undef ml
-#undef md
-#undef bb
-#undef k
-#undef w
-#undef tl
-#undef td
-#undef bl
-#undef bd
 #undef nn
 #undef dd
 
 
-/* called once from inflate_block */
-static void inflate_stored_setup(STATE_PARAM unsigned my_n, unsigned my_b, unsigned my_k)
-{
-	inflate_stored_n = my_n;
-	inflate_stored_b = my_b;
-	inflate_stored_k = my_k;
-	/* initialize gunzip_window position */
-	inflate_stored_w = gunzip_outbuf_count;
-}
 /* called once from inflate_get_next_window */
 static int inflate_stored(STATE_PARAM_ONLY)
 {
-	/* read and output the compressed data */
-	while (inflate_stored_n--) {
-		inflate_stored_b = fill_bitbuffer(PASS_STATE inflate_stored_b, &inflate_stored_k, 8);
-		gunzip_window[inflate_stored_w++] = (unsigned char) inflate_stored_b;
-		if (inflate_stored_w == GUNZIP_WSIZE) {
-			gunzip_outbuf_count = inflate_stored_w;
-			//flush_gunzip_window();
-			inflate_stored_w = 0;
-			inflate_stored_b >>= 8;
-			inflate_stored_k -= 8;
+	unsigned w = gunzip_outbuf_count;
+
+	/* the bit buffer was emptied by inflate_block(), so copy straight from bytebuffer */
+	while (inflate_stored_n) {
+		unsigned n = bytebuffer_size - bytebuffer_offset;
+		if (n == 0) {
+			if (!refill_bytebuffer(PASS_STATE_ONLY)) {
+				error_msg = "unexpected end of file";
+				abort_unzip(PASS_STATE_ONLY);
+			}
+			continue;
+		}
+		if (n > inflate_stored_n)
+			n = inflate_stored_n;
+		if (n > GUNZIP_WSIZE - w)
+			n = GUNZIP_WSIZE - w;
+		memcpy(&gunzip_window[w], &bytebuffer[bytebuffer_offset], n);
+		bytebuffer_offset += n;
+		inflate_stored_n -= n;
+		w += n;
+		if (w == GUNZIP_WSIZE) {
+			gunzip_outbuf_count = w;
 			return 1; /* We have a block */
 		}
-		inflate_stored_b >>= 8;
-		inflate_stored_k -= 8;
 	}
 
-	/* restore the globals from the locals */
-	gunzip_outbuf_count = inflate_stored_w;		/* restore global gunzip_window pointer */
-	gunzip_bb = inflate_stored_b;	/* restore global bit buffer */
-	gunzip_bk = inflate_stored_k;
+	gunzip_outbuf_count = w;
 	return 0; /* Finished */
 }
 
@@ -700,254 +727,148 @@ static int inflate_stored(STATE_PARAM_ONLY)
 /*
  * decompress an inflated block
  * e: last block flag
- *
- * GLOBAL VARIABLES: bb, kk,
  */
 /* Return values: -1 = inflate_stored, -2 = inflate_codes */
 /* One callsite in inflate_get_next_window */
 static int inflate_block(STATE_PARAM smallint *e)
 {
-	unsigned ll[286 + 30];  /* literal/length and distance code lengths */
-	unsigned t;     /* block type */
-	unsigned b;     /* bit buffer */
-	unsigned k;     /* number of bits in bit buffer */
-
-	/* make local bit buffer */
-
-	b = gunzip_bb;
-	k = gunzip_bk;
+	uint8_t ll[286 + 30];	/* literal/length and distance code lengths */
+	unsigned t;		/* block type */
 
 	/* read in last block bit */
-	b = fill_bitbuffer(PASS_STATE b, &k, 1);
-	*e = b & 1;
-	b >>= 1;
-	k -= 1;
+	*e = (smallint)get_bits(PASS_STATE 1);
 
 	/* read in block type */
-	b = fill_bitbuffer(PASS_STATE b, &k, 2);
-	t = (unsigned) b & 3;
-	b >>= 2;
-	k -= 2;
-
-	/* restore the global bit buffer */
-	gunzip_bb = b;
-	gunzip_bk = k;
-
-	/* Do we see block type 1 often? Yes!
-	 * TODO: fix performance problem (see below) */
-	//bb_error_msg("blktype %d", t);
+	t = get_bits(PASS_STATE 2);
 
 	/* inflate that block type */
 	switch (t) {
 	case 0: /* Inflate stored */
 	{
 		unsigned n;	/* number of bytes in block */
-		unsigned b_stored;	/* bit buffer */
-		unsigned k_stored;	/* number of bits in bit buffer */
-
-		/* make local copies of globals */
-		b_stored = gunzip_bb;	/* initialize bit buffer */
-		k_stored = gunzip_bk;
 
 		/* go to byte boundary */
-		n = k_stored & 7;
-		b_stored >>= n;
-		k_stored -= n;
+		gunzip_bb >>= gunzip_bk & 7;
+		gunzip_bk &= ~7;
 
 		/* get the length and its complement */
-		b_stored = fill_bitbuffer(PASS_STATE b_stored, &k_stored, 16);
-		n = ((unsigned) b_stored & 0xffff);
-		b_stored >>= 16;
-		k_stored -= 16;
-
-		b_stored = fill_bitbuffer(PASS_STATE b_stored, &k_stored, 16);
-		if (n != (unsigned) ((~b_stored) & 0xffff)) {
+		n = get_bits(PASS_STATE 16);
+		if (n != (~get_bits(PASS_STATE 16) & 0xffff)) {
 			abort_unzip(PASS_STATE_ONLY);	/* error in compressed data */
 		}
-		b_stored >>= 16;
-		k_stored -= 16;
+		inflate_stored_n = n;
 
-		inflate_stored_setup(PASS_STATE n, b_stored, k_stored);
+		/* hand what's left in the bit buffer back for inflate_stored() */
+		unwind_bitbuffer(PASS_STATE_ONLY);
 
 		return -1;
 	}
 	case 1:
 	/* Inflate fixed
-	 * decompress an inflated type 1 (fixed Huffman codes) block. We should
-	 * either replace this with a custom decoder, or at least precompute the
-	 * Huffman tables. TODO */
+	 * decompress an inflated type 1 (fixed Huffman codes) block. The
+	 * tables only need to be built once. */
 	{
-		int i;                  /* temporary variable */
-		unsigned bl;            /* lookup bits for tl */
-		unsigned bd;            /* lookup bits for td */
-		/* gcc 4.2.1 is too dumb to reuse stackspace. Moved up... */
-		//unsigned ll[288];     /* length list for huft_build */
-
-		/* set up literal table */
-		for (i = 0; i < 144; i++)
-			ll[i] = 8;
-		for (; i < 256; i++)
-			ll[i] = 9;
-		for (; i < 280; i++)
-			ll[i] = 7;
-		for (; i < 288; i++) /* make a complete, but wrong code set */
-			ll[i] = 8;
-		bl = 7;
-		inflate_codes_tl = huft_build(ll, 288, 257, &lit, &bl);
-		/* ^^^ never returns error here - we use known data */
-
-		/* set up distance table */
-		for (i = 0; i < 30; i++) /* make an incomplete code set */
-			ll[i] = 5;
-		bd = 5;
-		inflate_codes_td = huft_build(ll, 30, 0, &dist, &bd);
-		/* ^^^ does return error here! (lsb bit is set) - we gave it incomplete code set */
-		/* clearing error bit: */
-		inflate_codes_td = (void*)((uintptr_t)inflate_codes_td & ~(uintptr_t)1);
-
-		/* set up data for inflate_codes() */
-		inflate_codes_setup(PASS_STATE bl, bd);
-
-		/* huft_free code moved into inflate_codes */
+		int i;
+
+		if (!fixed_tables_built) {
+			/* set up literal table */
+			for (i = 0; i < 144; i++)
+				ll[i] = 8;
+			for (; i < 256; i++)
+				ll[i] = 9;
+			for (; i < 280; i++)
+				ll[i] = 7;
+			for (; i < 288; i++) /* make a complete, but wrong code set */
+				ll[i] = 8;
+			build_table(fixed_litlen_table, 1 << LITLEN_BITS, LITLEN_BITS, ll, 288, TABLE_LITLEN, 0);
+			/* ^^^ never returns error here - we use known data */
+
+			/* set up distance table */
+			for (i = 0; i < 30; i++) /* make an incomplete code set */
+				ll[i] = 5;
+			build_table(fixed_dist_table, 1 << DIST_BITS, DIST_BITS, ll, 30, TABLE_DIST, 1);
+			fixed_tables_built = 1;
+		}
+		inflate_codes_tl = fixed_litlen_table;
+		inflate_codes_td = fixed_dist_table;
 
 		return -2;
 	}
 	case 2: /* Inflate dynamic */
 	{
-		enum { dbits = 6 };     /* bits in base distance lookup table */
-		enum { lbits = 9 };     /* bits in base literal/length lookup table */
-
-		huft_t *td;             /* distance code table */
 		unsigned i;             /* temporary variables */
 		unsigned j;
 		unsigned l;             /* last length */
-		unsigned m;             /* mask for bit lengths table */
 		unsigned n;             /* number of lengths to get */
-		unsigned bl;            /* lookup bits for tl */
-		unsigned bd;            /* lookup bits for td */
 		unsigned nb;            /* number of bit length codes */
 		unsigned nl;            /* number of literal/length codes */
 		unsigned nd;            /* number of distance codes */
-
-		//unsigned ll[286 + 30];/* literal/length and distance code lengths */
-		unsigned b_dynamic;     /* bit buffer */
-		unsigned k_dynamic;     /* number of bits in bit buffer */
-
-		/* make local bit buffer */
-		b_dynamic = gunzip_bb;
-		k_dynamic = gunzip_bk;
+		uint32_t e_clen;
 
 		/* read in table lengths */
-		b_dynamic = fill_bitbuffer(PASS_STATE b_dynamic, &k_dynamic, 5);
-		nl = 257 + ((unsigned) b_dynamic & 0x1f);	/* number of literal/length codes */
-
-		b_dynamic >>= 5;
-		k_dynamic -= 5;
-		b_dynamic = fill_bitbuffer(PASS_STATE b_dynamic, &k_dynamic, 5);
-		nd = 1 + ((unsigned) b_dynamic & 0x1f);	/* number of distance codes */
-
-		b_dynamic >>= 5;
-		k_dynamic -= 5;
-		b_dynamic = fill_bitbuffer(PASS_STATE b_dynamic, &k_dynamic, 4);
-		nb = 4 + ((unsigned) b_dynamic & 0xf);	/* number of bit length codes */
-
-		b_dynamic >>= 4;
-		k_dynamic -= 4;
+		nl = 257 + get_bits(PASS_STATE 5);	/* number of literal/length codes */
+		nd = 1 + get_bits(PASS_STATE 5);	/* number of distance codes */
+		nb = 4 + get_bits(PASS_STATE 4);	/* number of bit length codes */
 		if (nl > 286 || nd > 30) {
 			abort_unzip(PASS_STATE_ONLY);	/* bad lengths */
 		}
 
 		/* read in bit-length-code lengths */
-		for (j = 0; j < nb; j++) {
-			b_dynamic = fill_bitbuffer(PASS_STATE b_dynamic, &k_dynamic, 3);
-			ll[border[j]] = (unsigned) b_dynamic & 7;
-			b_dynamic >>= 3;
-			k_dynamic -= 3;
-		}
+		for (j = 0; j < nb; j++)
+			ll[border[j]] = (uint8_t)get_bits(PASS_STATE 3);
 		for (; j < 19; j++)
 			ll[border[j]] = 0;
 
-		/* build decoding table for trees - single level, 7 bit lookup */
-		bl = 7;
-		inflate_codes_tl = huft_build(ll, 19, 19, NULL, &bl);
-		if (BAD_HUFT(inflate_codes_tl)) {
+		/* build decoding table for trees - single level, 7 bit lookup,
+		 * using the literal/length table, which isn't needed yet */
+		if (build_table(litlen_table, 1 << CLEN_BITS, CLEN_BITS, ll, 19, TABLE_CLEN, 0) != 0) {
 			abort_unzip(PASS_STATE_ONLY);	/* incomplete code set */
 		}
 
 		/* read in literal and distance code lengths */
 		n = nl + nd;
-		m = mask_bits[bl];
 		i = l = 0;
-		while ((unsigned) i < n) {
-			b_dynamic = fill_bitbuffer(PASS_STATE b_dynamic, &k_dynamic, (unsigned)bl);
-			td = inflate_codes_tl + ((unsigned) b_dynamic & m);
-			j = td->b;
-			b_dynamic >>= j;
-			k_dynamic -= j;
-			j = td->v.n;
+		while (i < n) {
+			e_clen = decode_symbol(PASS_STATE litlen_table, CLEN_BITS);
+			if (E_TYPE(e_clen) != E_LIT) {
+				abort_unzip(PASS_STATE_ONLY);
+			}
+			j = E_VAL(e_clen);
 			if (j < 16) {	/* length of code in bits (0..15) */
-				ll[i++] = l = j;	/* save last length in l */
-			} else if (j == 16) {	/* repeat last length 3 to 6 times */
-				b_dynamic = fill_bitbuffer(PASS_STATE b_dynamic, &k_dynamic, 2);
-				j = 3 + ((unsigned) b_dynamic & 3);
-				b_dynamic >>= 2;
-				k_dynamic -= 2;
-				if ((unsigned) i + j > n) {
-					abort_unzip(PASS_STATE_ONLY); //return 1;
-				}
-				while (j--) {
-					ll[i++] = l;
-				}
+				ll[i++] = (uint8_t)(l = j);	/* save last length in l */
+				continue;
+			}
+			if (j == 16) {	/* repeat last length 3 to 6 times */
+				j = 3 + get_bits(PASS_STATE 2);
 			} else if (j == 17) {	/* 3 to 10 zero length codes */
-				b_dynamic = fill_bitbuffer(PASS_STATE b_dynamic, &k_dynamic, 3);
-				j = 3 + ((unsigned) b_dynamic & 7);
-				b_dynamic >>= 3;
-				k_dynamic -= 3;
-				if ((unsigned) i + j > n) {
-					abort_unzip(PASS_STATE_ONLY); //return 1;
-				}
-				while (j--) {
-					ll[i++] = 0;
-				}
+				j = 3 + get_bits(PASS_STATE 3);
 				l = 0;
 			} else {	/* j == 18: 11 to 138 zero length codes */
-				b_dynamic = fill_bitbuffer(PASS_STATE b_dynamic, &k_dynamic, 7);
-				j = 11 + ((unsigned) b_dynamic & 0x7f);
-				b_dynamic >>= 7;
-				k_dynamic -= 7;
-				if ((unsigned) i + j > n) {
-					abort_unzip(PASS_STATE_ONLY); //return 1;
-				}
-				while (j--) {
-					ll[i++] = 0;
-				}
+				j = 11 + get_bits(PASS_STATE 7);
 				l = 0;
 			}
+			if (i + j > n) {
+				abort_unzip(PASS_STATE_ONLY);
+			}
+			while (j--) {
+				ll[i++] = (uint8_t)l;
+			}
 		}
 
-		/* free decoding table for trees */
-		huft_free(inflate_codes_tl);
-
-		/* restore the global bit buffer */
-		gunzip_bb = b_dynamic;
-		gunzip_bk = k_dynamic;
+		/* a block that can't end is as broken as it gets */
+		if (ll[256] == 0) {
+			abort_unzip(PASS_STATE_ONLY);
+		}
 
 		/* build the decoding tables for literal/length and distance codes */
-		bl = lbits;
-		inflate_codes_tl = huft_build(ll, nl, 257, &lit, &bl);
-		if (BAD_HUFT(inflate_codes_tl)) {
+		if (build_table(litlen_table, LITLEN_ENOUGH, LITLEN_BITS, ll, nl, TABLE_LITLEN, 0) != 0) {
 			abort_unzip(PASS_STATE_ONLY);
 		}
-		bd = dbits;
-		inflate_codes_td = huft_build(ll + nl, nd, 0, &dist, &bd);
-		if (BAD_HUFT(inflate_codes_td)) {
+		if (build_table(dist_table, DIST_ENOUGH, DIST_BITS, ll + nl, nd, TABLE_DIST, 0) != 0) {
 			abort_unzip(PASS_STATE_ONLY);
 		}
-
-		/* set up data for inflate_codes() */
-		inflate_codes_setup(PASS_STATE bl, bd);
-
-		/* huft_free code moved into inflate_codes */
+		inflate_codes_tl = litlen_table;
+		inflate_codes_td = dist_table;
 
 		return -2;
 	}
@@ -1040,7 +961,6 @@ inflate_unzip_internal(STATE_PARAM transformer_state_t *xstate)
 		int r = inflate_get_next_window(PASS_STATE_ONLY);
 		nwrote = transformer_write(xstate, gunzip_window, gunzip_outbuf_count);
 		if (nwrote != (ssize_t)gunzip_outbuf_count) {
-			huft_free_all(PASS_STATE_ONLY);
 			n = (nwrote <0)?nwrote:-1;
 			goto ret;
 		}
@@ -1056,16 +976,11 @@ inflate_unzip_internal(STATE_PARAM transformer_state_t *xstate)
 		if (r == 0) break;
 	}
 
-	/* Store unused bytes in a global buffer so calling applets can access it */
-	if (gunzip_bk >= 8) {
-		/* Undo too much lookahead. The next read will be byte aligned
-		 * so we can discard unused bits in the last meaningful byte. */
-		bytebuffer_offset--;
-		bytebuffer[bytebuffer_offset] = gunzip_bb & 0xff;
-		gunzip_bb >>= 8;
-		// coverity[overflow_const]
-		gunzip_bk -= 8;
-	}
+	/* Store unused bytes in a global buffer so calling applets can access it.
+	 * The next read will be byte aligned so we can discard unused bits in the
+	 * last meaningful byte, but the word-wise refills may have looked several
+	 * whole bytes too far ahead. */
+	unwind_bitbuffer(PASS_STATE_ONLY);
  ret:
 	/* Cleanup */
 	free(gunzip_window);
@@ -1090,7 +1005,7 @@ inflate_unzip(transformer_state_t *xstate)
 
 	to_read = xstate->bytes_in;
 //	bytebuffer_max = 0x8000;
-	bytebuffer_offset = 4;
+	bytebuffer_offset = BYTEBUFFER_PAD;
 	bytebuffer = xmalloc(bytebuffer_max);
 	n = inflate_unzip_internal(PASS_STATE xstate);
 	free(bytebuffer);
@@ -1233,6 +1148,1045 @@ static int check_header_gzip(STATE_PARAM transformer_state_t *xstate)
 	return 1;
 }
 
+/*
+ * Parallel decoding of large gzip files
+ *
+ * Unlike xz blocks or zstd frames, the blocks of a deflate stream can't be
+ * found without decoding everything that precedes them. So the compressed
+ * data is cut in chunks, and a worker looks for the first thing that parses
+ * as a dynamic block header near the start of each chunk, then decodes from
+ * there without knowing the 32 KB of output that precede it: back-references
+ * into that unknown window are kept as markers, in 16-bit symbols, until the
+ * last 32 KB of output are free of them, after which decoding goes on in
+ * bytes. Each worker stops at the first block boundary past its chunk.
+ * The main thread only uses the output of a worker that started where the
+ * previous output ended, filling in its markers from its own window, and
+ * decodes whatever the workers didn't get right by itself.
+ */
+#define MT_CHUNK_SIZE	(2 * 1024 * 1024)	/* compressed bytes per worker */
+#define MT_MIN_SIZE	(8 * MT_CHUNK_SIZE)	/* smaller files aren't worth the threads */
+#define MT_SEARCH_SIZE	(128 * 1024)		/* how far into a chunk to look for a block header */
+#define MT_OUT_CAP	(32 * 1024 * 1024)	/* stop at the next block past that much output */
+#define MT_SEEK_CAP	(1024 * 1024)		/* same, when reading from a seek point */
+#define MT_MIN_SPACING	(1024 * 1024)		/* minimum output between two seek points */
+#define MT_READ_SIZE	(256 * 1024)
+#define MT_INPUT_PAD	16			/* zeroed bytes past the input, for word-wise refills */
+#define MT_WSIZE	32768
+#define MT_MARKER	256			/* symbols from there on are offsets in the unknown window */
+#define MT_MAX_MISSES	4			/* stop searching chunks after that many useless jobs */
+#define MT_RETRY	8			/* but still search one chunk out of that many */
+#if defined(_WIN64)
+#define MT_MAX_WORKERS	8
+#else
+#define MT_MAX_WORKERS	4
+#endif
+
+enum { MT_OK, MT_NOT_FOUND, MT_ERROR };
+
+typedef struct {
+	uint64_t out_pos;	/* where the member ends, in the output of the job */
+	uint32_t crc;		/* CRC and size from the trailer of the member */
+	uint32_t isize;
+} mt_member_t;
+
+typedef struct {
+	/* input */
+	HANDLE hFile;
+	uint64_t file_size;
+	uint64_t in_offset;	/* file offset of in[0] */
+	uint8_t *in;
+	size_t in_len, in_size;
+	size_t pos;		/* next byte of in[] for the bit buffer */
+	uint64_t bb;
+	unsigned k;
+	/* what to decode */
+	BOOL speculative;	/* look for a block from search_bit, rather than start there */
+	BOOL header;		/* start with a gzip header */
+	uint64_t search_bit;
+	uint64_t stop_bit;	/* stop at the first block boundary from there */
+	size_t out_cap;		/* or past that much output */
+	const uint8_t *window;	/* the 32 KB that precede search_bit, when known */
+	/* output: 16-bit symbols first when speculative, then bytes */
+	BOOL bytes_mode;
+	uint16_t *sym;
+	size_t sym_len, sym_size, last_marker;
+	uint8_t *out;		/* starts with MT_WSIZE bytes of history */
+	size_t out_len, out_size;
+	mt_member_t *members;
+	size_t nb_members, members_size;
+	uint64_t start_bit, end_bit;
+	uint32_t mtime;
+	unsigned blocks;
+	BOOL eos, fatal, busy;
+	int status;
+	/* decoding tables */
+	const uint32_t *tl, *td;
+	BOOL fixed_built;
+	uint32_t ltable[LITLEN_ENOUGH];
+	uint32_t dtable[DIST_ENOUGH];
+	uint32_t fixed_ltable[1 << LITLEN_BITS];
+	uint32_t fixed_dtable[1 << DIST_BITS];
+	jmp_buf jmp;
+	HANDLE hDone;
+} mt_job_t;
+
+typedef struct {
+	transformer_state_t *xstate;
+	uint32_t *crc_table;
+	uint64_t next_bit;	/* the block boundary that the output has reached */
+	uint32_t crc, size;	/* of the current member */
+	BOOL partial;		/* the output started within the current member, so it can't be checked */
+	BOOL eos, full;
+	IF_DESKTOP(long long) int total;
+	uint8_t window[MT_WSIZE];
+} mt_ctx_t;
+
+#define MT_BIT_POS(job)	(((job)->in_offset + (job)->pos) * 8 - (job)->k)
+#define MT_OUT_LEN(job)	((job)->sym_len + (job)->out_len)
+#define MT_IN_EOF(job)	((job)->in_offset + (job)->in_len >= (job)->file_size)
+
+static void mt_abort(mt_job_t *job) NORETURN;
+static void mt_abort(mt_job_t *job)
+{
+	longjmp(job->jmp, 1);
+}
+
+/* For errors that have nothing to do with the data */
+static void mt_fatal(mt_job_t *job) NORETURN;
+static void mt_fatal(mt_job_t *job)
+{
+	job->fatal = TRUE;
+	longjmp(job->jmp, 1);
+}
+
+static void *mt_grow(mt_job_t *job, void *buf, size_t *size, size_t min_size, size_t elem_size)
+{
+	size_t n = MAX(2 * *size, min_size);
+
+	buf = realloc(buf, n * elem_size);
+	if (buf == NULL)
+		mt_fatal(job);
+	*size = n;
+	return buf;
+}
+
+/* Read more input, after dropping the bytes that the bit buffer is done with */
+static void mt_read_more(mt_job_t *job)
+{
+	OVERLAPPED ov = { 0 };
+	uint64_t offset;
+	DWORD size, rb = 0;
+	/* keep a word's worth, for unwinding the bit buffer */
+	size_t drop = (job->pos > 8) ? job->pos - 8 : 0;
+
+	if (drop > 0) {
+		memmove(job->in, &job->in[drop], job->in_len - drop);
+		job->in_offset += drop;
+		job->in_len -= drop;
+		job->pos -= drop;
+	}
+	offset = job->in_offset + job->in_len;
+	size = (DWORD)MIN(MT_READ_SIZE, job->file_size - offset);
+	if (job->in_len + size + MT_INPUT_PAD > job->in_size)
+		job->in = mt_grow(job, job->in, &job->in_size, job->in_len + size + MT_INPUT_PAD, 1);
+	ov.Offset = (DWORD)offset;
+	ov.OffsetHigh = (DWORD)(offset >> 32);
+	if (!ReadFile(job->hFile, &job->in[job->in_len], size, &rb, &ov) || rb != size)
+		mt_fatal(job);
+	job->in_len += size;
+	memset(&job->in[job->in_len], 0, MT_INPUT_PAD);
+}
+
+/* Start reading at bit 'bit' of the file */
+static void mt_seek(mt_job_t *job, uint64_t bit)
+{
+	uint64_t byte = bit >> 3;
+
+	if (byte < job->in_offset || byte >= job->in_offset + job->in_len) {
+		job->in_offset = byte;
+		job->in_len = 0;
+		job->pos = 0;
+		mt_read_more(job);
+	}
+	job->pos = (size_t)(byte - job->in_offset);
+	job->bb = 0;
+	job->k = 0;
+	if (bit & 7) {
+		job->bb = job->in[job->pos++] >> (bit & 7);
+		job->k = 8 - (bit & 7);
+	}
+}
+
+/* Same as fill_bitbuffer(), except that the zeroed bytes past the end of
+ * the file may be used, with truncation detected from the bit position */
+static void mt_fill(mt_job_t *job, unsigned n)
+{
+	while (job->k < n) {
+		if (job->pos >= job->in_len) {
+			if (!MT_IN_EOF(job))
+				mt_read_more(job);
+			else if (job->pos >= job->in_len + 8)
+				mt_abort(job);
+		}
+		job->bb |= (uint64_t)job->in[job->pos++] << job->k;
+		job->k += 8;
+	}
+}
+
+static unsigned mt_bits(mt_job_t *job, unsigned n)
+{
+	unsigned v;
+
+	mt_fill(job, n);
+	v = (unsigned)job->bb & ((1U << n) - 1);
+	job->bb >>= n;
+	job->k -= n;
+	return v;
+}
+
+/* Get at least 56 bits in the bit buffer */
+static ALWAYS_INLINE void mt_refill(mt_job_t *job)
+{
+	if (job->pos + 8 <= job->in_len) {
+		job->bb |= load_le64(&job->in[job->pos]) << job->k;
+		job->pos += (63 - job->k) >> 3;
+		job->k |= 56;
+	} else {
+		mt_fill(job, 56);
+	}
+}
+
+/* Decode a symbol with a table that has no literal pairs */
+static uint32_t mt_symbol(mt_job_t *job, const uint32_t *table, const unsigned root_bits)
+{
+	uint32_t e;
+	unsigned n;
+
+	mt_fill(job, MAX_CODE_BITS);
+	e = table[(unsigned)job->bb & ((1U << root_bits) - 1)];
+	n = E_BITS(e);
+	if (E_TYPE(e) == E_SUB) {
+		e = table[E_VAL(e) + (((unsigned)job->bb >> root_bits) & ((1U << E_EXTRA(e)) - 1))];
+		n += E_BITS(e);
+	}
+	job->bb >>= n;
+	job->k -= n;
+	return e;
+}
+
+/* Look for what could be the header of a dynamic block, that isn't the
+ * last one, from start_bit up to limit. As most candidates fail on the
+ * first few bits or on the code length code, which must be complete,
+ * those are checked here, and the rest is left to decoding. */
+static BOOL mt_find_block(mt_job_t *job, const uint64_t limit)
+{
+	uint64_t b, v;
+
+	for (b = job->start_bit; b < limit; b++) {
+		const uint64_t byte = b >> 3;
+		const unsigned s = b & 7;
+		unsigned j, n, len, count[8] = { 0 };
+		const uint8_t *p;
+		int left;
+
+		if (byte + 24 > job->file_size)
+			break;
+		if (byte < job->in_offset || byte + 24 > job->in_offset + job->in_len) {
+			job->in_offset = byte;
+			job->in_len = 0;
+			job->pos = 0;
+			mt_read_more(job);
+		}
+		p = &job->in[byte - job->in_offset];
+		v = load_le64(p) >> s;
+		/* BFINAL = 0, BTYPE = 2 and at most 286 and 30 codes */
+		if ((v & 7) != 4 || ((v >> 3) & 0x1f) > 29 || ((v >> 8) & 0x1f) > 29)
+			continue;
+		n = 4 + ((v >> 13) & 0xf);
+		for (j = 0; j < n; j++) {
+			const unsigned o = s + 17 + 3 * j;
+			count[(load_le64(&p[o >> 3]) >> (o & 7)) & 7]++;
+		}
+		left = 1;
+		for (len = 1; len < 8 && left >= 0; len++)
+			left = 2 * left - (int)count[len];
+		if (left != 0)
+			continue;
+		job->start_bit = b;
+		return TRUE;
+	}
+	return FALSE;
+}
+
+/* Read the header of the next gzip member, if there is one */
+static BOOL mt_member_header(mt_job_t *job)
+{
+	unsigned flags, n;
+
+	if (MT_BIT_POS(job) + 16 > job->file_size * 8 || mt_bits(job, 16) != 0x8b1f)
+		return FALSE;
+	if (mt_bits(job, 8) != 8)
+		mt_abort(job);
+	flags = mt_bits(job, 8);
+	job->mtime = mt_bits(job, 16);
+	job->mtime |= mt_bits(job, 16) << 16;
+	mt_bits(job, 16);
+	if (flags & 0x04) {
+		for (n = mt_bits(job, 16); n > 0; n--)
+			mt_bits(job, 8);
+	}
+	if (flags & 0x08) {
+		while (mt_bits(job, 8) != 0);
+	}
+	if (flags & 0x10) {
+		while (mt_bits(job, 8) != 0);
+	}
+	if (flags & 0x02)
+		mt_bits(job, 16);
+	return TRUE;
+}
+
+/* Same as case 1 and 2 of inflate_block() */
+static void mt_block_tables(mt_job_t *job, unsigned type)
+{
+	uint8_t ll[286 + 30];
+	unsigned i, j, l, n, nl, nd, nb;
+
+	if (type == 1) {
+		if (!job->fixed_built) {
+			for (i = 0; i < 144; i++)
+				ll[i] = 8;
+			for (; i < 256; i++)
+				ll[i] = 9;
+			for (; i < 280; i++)
+				ll[i] = 7;
+			for (; i < 288; i++)
+				ll[i] = 8;
+			build_table(job->fixed_ltable, 1 << LITLEN_BITS, LITLEN_BITS, ll, 288, TABLE_LITLEN, 0);
+			for (i = 0; i < 30; i++)
+				ll[i] = 5;
+			build_table(job->fixed_dtable, 1 << DIST_BITS, DIST_BITS, ll, 30, TABLE_DIST, 1);
+			job->fixed_built = TRUE;
+		}
+		job->tl = job->fixed_ltable;
+		job->td = job->fixed_dtable;
+		return;
+	}
+
+	nl = 257 + mt_bits(job, 5);
+	nd = 1 + mt_bits(job, 5);
+	nb = 4 + mt_bits(job, 4);
+	if (nl > 286 || nd > 30)
+		mt_abort(job);
+	for (j = 0; j < nb; j++)
+		ll[border[j]] = (uint8_t)mt_bits(job, 3);
+	for (; j < 19; j++)
+		ll[border[j]] = 0;
+	if (build_table(job->ltable, 1 << CLEN_BITS, CLEN_BITS, ll, 19, TABLE_CLEN, 0) != 0)
+		mt_abort(job);
+
+	n = nl + nd;
+	i = l = 0;
+	while (i < n) {
+		uint32_t e = mt_symbol(job, job->ltable, CLEN_BITS);
+		if (E_TYPE(e) != E_LIT)
+			mt_abort(job);
+		j = E_VAL(e);
+		if (j < 16) {
+			ll[i++] = (uint8_t)(l = j);
+			continue;
+		}
+		if (j == 16) {
+			if (i == 0)
+				mt_abort(job);	/* nothing to repeat */
+			j = 3 + mt_bits(job, 2);
+		} else if (j == 17) {
+			j = 3 + mt_bits(job, 3);
+			l = 0;
+		} else {
+			j = 11 + mt_bits(job, 7);
+			l = 0;
+		}
+		if (i + j > n)
+			mt_abort(job);
+		while (j--)
+			ll[i++] = (uint8_t)l;
+	}
+	if (ll[256] == 0)
+		mt_abort(job);
+	if (build_table(job->ltable, LITLEN_ENOUGH, LITLEN_BITS, ll, nl, TABLE_LITLEN, 0) != 0)
+		mt_abort(job);
+	if (build_table(job->dtable, DIST_ENOUGH, DIST_BITS, ll + nl, nd, TABLE_DIST, 0) != 0)
+		mt_abort(job);
+	job->tl = job->ltable;
+	job->td = job->dtable;
+}
+
+/* Switch to bytes, with the last 32 KB of symbols (which have no markers)
+ * as history, or zeros at the start of a new member */
+static void mt_to_bytes(mt_job_t *job, BOOL new_member)
+{
+	size_t i;
+
+	if (new_member) {
+		memset(job->out, 0, MT_WSIZE);
+	} else {
+		for (i = 0; i < MT_WSIZE; i++)
+			job->out[i] = (uint8_t)job->sym[job->sym_len - MT_WSIZE + i];
+	}
+	job->bytes_mode = TRUE;
+}
+
+/*
+ * Decode the codes of a block while the window that precedes the job is
+ * unknown. Returns 0 at the end of the block, or 1 once the last 32 KB of
+ * symbols no longer refer to that window, so that bytes can take over.
+ */
+static int mt_codes16(mt_job_t *job)
+{
+	const uint32_t *tl = job->tl;
+	const uint32_t *td = job->td;
+	unsigned n, d;
+	uint32_t e;
+
+	while (1) {
+		if (job->sym_size - job->sym_len < 258 + 2)
+			job->sym = mt_grow(job, job->sym, &job->sym_size, 1024 * 1024, sizeof(uint16_t));
+		mt_refill(job);
+
+		e = tl[(unsigned)job->bb & ((1U << LITLEN_BITS) - 1)];
+		if (E_TYPE(e) == E_SUB) {
+			job->bb >>= LITLEN_BITS;
+			job->k -= LITLEN_BITS;
+			e = tl[E_VAL(e) + ((unsigned)job->bb & ((1U << E_EXTRA(e)) - 1))];
+		}
+		job->bb >>= E_BITS(e);
+		job->k -= E_BITS(e);
+		if (E_TYPE(e) <= E_LIT2) {
+			job->sym[job->sym_len++] = E_VAL(e) & 0xff;
+			if (E_TYPE(e) == E_LIT2)
+				job->sym[job->sym_len++] = E_VAL(e) >> 8;
+		} else if (E_TYPE(e) == E_EOB) {
+			return 0;
+		} else if (E_TYPE(e) != E_BASE) {
+			mt_abort(job);
+		} else {
+			n = E_VAL(e) + ((unsigned)job->bb & ((1U << E_EXTRA(e)) - 1));
+			job->bb >>= E_EXTRA(e);
+			job->k -= E_EXTRA(e);
+			e = td[(unsigned)job->bb & ((1U << DIST_BITS) - 1)];
+			if (E_TYPE(e) == E_SUB) {
+				job->bb >>= DIST_BITS;
+				job->k -= DIST_BITS;
+				e = td[E_VAL(e) + ((unsigned)job->bb & ((1U << E_EXTRA(e)) - 1))];
+			}
+			if (E_TYPE(e) != E_BASE)
+				mt_abort(job);
+			job->bb >>= E_BITS(e);
+			job->k -= E_BITS(e);
+			d = E_VAL(e) + ((unsigned)job->bb & ((1U << E_EXTRA(e)) - 1));
+			job->bb >>= E_EXTRA(e);
+			job->k -= E_EXTRA(e);
+			for (; n > 0; n--, job->sym_len++) {
+				uint16_t s = (d > job->sym_len) ?
+					(uint16_t)(MT_MARKER + MT_WSIZE + job->sym_len - d) : job->sym[job->sym_len - d];
+				if (s >= MT_MARKER)
+					job->last_marker = job->sym_len + 1;
+				job->sym[job->sym_len] = s;
+			}
+		}
+		if (job->sym_len - job->last_marker >= MT_WSIZE)
+			return 1;
+	}
+}
+
+/* Decode the codes of a block into bytes. This is inflate_codes_fast(),
+ * with an output that grows, rather than a window that wraps around. */
+static void mt_codes8(mt_job_t *job)
+{
+	const uint32_t *tl = job->tl;
+	const uint32_t *td = job->td;
+
+	while (1) {
+		const uint8_t *in = job->in;
+		uint8_t *out = job->out;
+		const size_t in_end = MT_IN_EOF(job) ? job->in_len + MT_INPUT_PAD : job->in_len;
+		const size_t w_last = job->out_size - FAST_OUT_MARGIN;
+		size_t in_pos = job->pos;
+		size_t w = MT_WSIZE + job->out_len;
+		uint64_t bb = job->bb;
+		unsigned k = job->k, n, d;
+		uint32_t e;
+		int eob = 0;
+
+		while (in_pos + 8 <= in_end && w <= w_last) {
+			bb |= load_le64(&in[in_pos]) << k;
+			in_pos += (63 - k) >> 3;
+			k |= 56;
+
+			e = tl[(unsigned)bb & ((1U << LITLEN_BITS) - 1)];
+			if (E_TYPE(e) == E_SUB) {
+				bb >>= LITLEN_BITS;
+				k -= LITLEN_BITS;
+				e = tl[E_VAL(e) + ((unsigned)bb & ((1U << E_EXTRA(e)) - 1))];
+			}
+			bb >>= E_BITS(e);
+			k -= E_BITS(e);
+			if (E_TYPE(e) <= E_LIT2) {
+				out[w] = (uint8_t)E_VAL(e);
+				out[w + 1] = (uint8_t)(E_VAL(e) >> 8);
+				w += 1 + E_TYPE(e);
+				continue;
+			}
+			if (E_TYPE(e) != E_BASE) {
+				if (E_TYPE(e) != E_EOB)
+					mt_abort(job);
+				eob = 1;
+				break;
+			}
+			n = E_VAL(e) + ((unsigned)bb & ((1U << E_EXTRA(e)) - 1));
+			bb >>= E_EXTRA(e);
+			k -= E_EXTRA(e);
+
+			e = td[(unsigned)bb & ((1U << DIST_BITS) - 1)];
+			if (E_TYPE(e) == E_SUB) {
+				bb >>= DIST_BITS;
+				k -= DIST_BITS;
+				e = td[E_VAL(e) + ((unsigned)bb & ((1U << E_EXTRA(e)) - 1))];
+			}
+			if (E_TYPE(e) != E_BASE)
+				mt_abort(job);
+			bb >>= E_BITS(e);
+			k -= E_BITS(e);
+			d = E_VAL(e) + ((unsigned)bb & ((1U << E_EXTRA(e)) - 1));
+			bb >>= E_EXTRA(e);
+			k -= E_EXTRA(e);
+
+			/* the history makes sure that d <= w */
+			w = copy_match(out, (unsigned)w, d, n);
+		}
+
+		job->bb = bb;
+		job->k = k;
+		job->pos = in_pos;
+		job->out_len = w - MT_WSIZE;
+		if (eob)
+			return;
+		if (w > w_last)
+			job->out = mt_grow(job, job->out, &job->out_size, 0, 1);
+		else if (MT_IN_EOF(job))
+			mt_abort(job);
+		else
+			mt_read_more(job);
+	}
+}
+
+/* Copy a stored block straight from the input */
+static void mt_stored(mt_job_t *job)
+{
+	size_t n, m;
+
+	job->bb >>= job->k & 7;
+	job->k &= ~7;
+	n = mt_bits(job, 16);
+	if (n != (~mt_bits(job, 16) & 0xffff))
+		mt_abort(job);
+	/* give the whole bytes that are left in the bit buffer back */
+	job->pos -= job->k >> 3;
+	job->bb = 0;
+	job->k = 0;
+
+	while (n > 0) {
+		if (job->pos >= job->in_len) {
+			if (MT_IN_EOF(job))
+				mt_abort(job);
+			mt_read_more(job);
+			continue;
+		}
+		m = MIN(n, job->in_len - job->pos);
+		if (job->bytes_mode) {
+			if (MT_WSIZE + job->out_len + m > job->out_size)
+				job->out = mt_grow(job, job->out, &job->out_size, MT_WSIZE + job->out_len + m, 1);
+			memcpy(&job->out[MT_WSIZE + job->out_len], &job->in[job->pos], m);
+			job->out_len += m;
+		} else {
+			size_t i;
+			if (job->sym_len + m > job->sym_size)
+				job->sym = mt_grow(job, job->sym, &job->sym_size, job->sym_len + m, sizeof(uint16_t));
+			for (i = 0; i < m; i++)
+				job->sym[job->sym_len++] = job->in[job->pos + i];
+		}
+		job->pos += m;
+		n -= m;
+	}
+}
+
+/* Decode blocks, up to the first boundary at or past stop_bit, or to the end of the stream */
+static void mt_decode(mt_job_t *job)
+{
+	mt_member_t *member;
+	unsigned final, type;
+
+	for (job->blocks = 0; ; job->blocks++) {
+		if (job->blocks > 0 && (MT_BIT_POS(job) >= job->stop_bit || MT_OUT_LEN(job) >= job->out_cap))
+			break;
+		if (bled_cancel_request != NULL && *bled_cancel_request != 0)
+			mt_fatal(job);
+		if (!job->bytes_mode && job->sym_len - job->last_marker >= MT_WSIZE)
+			mt_to_bytes(job, FALSE);
+
+		final = mt_bits(job, 1);
+		type = mt_bits(job, 2);
+		if (type == 0) {
+			mt_stored(job);
+		} else if (type == 3) {
+			mt_abort(job);
+		} else {
+			mt_block_tables(job, type);
+			if (job->bytes_mode || mt_codes16(job) != 0) {
+				if (!job->bytes_mode)
+					mt_to_bytes(job, FALSE);
+				mt_codes8(job);
+			}
+		}
+		if (!final)
+			continue;
+
+		/* the trailer of the member */
+		if (job->nb_members >= job->members_size)
+			job->members = mt_grow(job, job->members, &job->members_size, 16, sizeof(mt_member_t));
+		member = &job->members[job->nb_members++];
+		job->bb >>= job->k & 7;
+		job->k &= ~7;
+		member->out_pos = MT_OUT_LEN(job);
+		member->crc = mt_bits(job, 16);
+		member->crc |= mt_bits(job, 16) << 16;
+		member->isize = mt_bits(job, 16);
+		member->isize |= mt_bits(job, 16) << 16;
+		if (!mt_member_header(job)) {
+			job->eos = TRUE;
+			break;
+		}
+		if (!job->bytes_mode)
+			mt_to_bytes(job, TRUE);
+	}
+	/* the zeroes past the end of the file must not have been used */
+	if (MT_BIT_POS(job) > job->file_size * 8)
+		mt_abort(job);
+	job->end_bit = MT_BIT_POS(job);
+}
+
+static void mt_run_job(mt_job_t *job)
+{
+	job->status = MT_ERROR;
+	job->fatal = FALSE;
+	job->start_bit = job->search_bit;
+	if (setjmp(job->jmp)) {
+		/* A false positive: just try the next candidate */
+		if (!job->speculative || job->fatal || job->blocks > 0)
+			return;
+		job->start_bit++;
+	}
+	job->sym_len = 0;
+	job->last_marker = 0;
+	job->out_len = 0;
+	job->nb_members = 0;
+	job->blocks = 0;
+	job->eos = FALSE;
+	job->bytes_mode = !job->speculative;
+	if (job->out_size < MT_WSIZE + 1024 * 1024)
+		job->out = mt_grow(job, job->out, &job->out_size, MT_WSIZE + 1024 * 1024, 1);
+
+	if (job->speculative) {
+		if (!mt_find_block(job, MIN(job->search_bit + 8 * (uint64_t)MT_SEARCH_SIZE, job->stop_bit))) {
+			job->status = MT_NOT_FOUND;
+			return;
+		}
+	} else {
+		memcpy(job->out, job->window, MT_WSIZE);
+	}
+	mt_seek(job, job->start_bit);
+	if (job->header && !mt_member_header(job))
+		mt_abort(job);
+	mt_decode(job);
+	job->status = MT_OK;
+}
+
+static DWORD WINAPI mt_worker(LPVOID param)
+{
+	mt_job_t *job = (mt_job_t *)param;
+
+	mt_run_job(job);
+	SetEvent(job->hDone);
+	return 0;
+}
+
+static void mt_dispatch(mt_job_t *job, uint64_t search_bit, uint64_t stop_bit, BOOL skip)
+{
+	job->busy = TRUE;
+	ResetEvent(job->hDone);
+	if (skip) {
+		job->speculative = FALSE;
+		job->status = MT_NOT_FOUND;
+		SetEvent(job->hDone);
+		return;
+	}
+	job->speculative = TRUE;
+	job->header = FALSE;
+	job->search_bit = search_bit;
+	job->stop_bit = stop_bit;
+	if (!QueueUserWorkItem(mt_worker, job, WT_EXECUTELONGFUNCTION))
+		mt_worker(job);
+}
+
+static void mt_free_job(mt_job_t *job)
+{
+	free(job->in);
+	free(job->sym);
+	free(job->out);
+	free(job->members);
+}
+
+/* Write some output of a job, checking the members that end in it */
+static int mt_write(mt_ctx_t *ctx, const mt_job_t *job, const uint8_t *data, size_t len, uint64_t base, size_t *m)
+{
+	size_t n, i;
+
+	while (1) {
+		/* the end of a member */
+		while (*m < job->nb_members && job->members[*m].out_pos == base) {
+			if (!ctx->partial && ~ctx->crc != job->members[*m].crc) {
+				bb_simple_error_msg("crc error");
+				return 0;
+			}
+			if (!ctx->partial && ctx->size != job->members[*m].isize) {
+				bb_simple_error_msg("incorrect length");
+				return 0;
+			}
+			ctx->partial = FALSE;
+			ctx->crc = ~0;
+			ctx->size = 0;
+			memset(ctx->window, 0, MT_WSIZE);
+			(*m)++;
+		}
+		if (len == 0)
+			return 1;
+		n = len;
+		if (*m < job->nb_members && job->members[*m].out_pos < base + len)
+			n = (size_t)(job->members[*m].out_pos - base);
+		for (i = 0; i < n && ctx->xstate != NULL; i += BB_BUFSIZE) {
+			size_t size = MIN(n - i, BB_BUFSIZE);
+			ssize_t nwrote = transformer_write(ctx->xstate, &data[i], size);
+			/* A full buffer is how reads to memory end */
+			if (nwrote == -ENOSPC || (ctx->xstate->mem_output_size_max != 0 &&
+				ctx->xstate->mem_output_size == ctx->xstate->mem_output_size_max)) {
+				ctx->full = TRUE;
+				return 0;
+			}
+			if (nwrote != (ssize_t)size)
+				return 0;
+		}
+		ctx->crc = crc32_block_endian0(ctx->crc, data, (unsigned)n, ctx->crc_table);
+		ctx->size += (uint32_t)n;
+		ctx->total += n;
+		if (n >= MT_WSIZE) {
+			memcpy(ctx->window, &data[n - MT_WSIZE], MT_WSIZE);
+		} else {
+			memmove(ctx->window, &ctx->window[n], MT_WSIZE - n);
+			memcpy(&ctx->window[MT_WSIZE - n], data, n);
+		}
+		data += n;
+		base += n;
+		len -= n;
+	}
+}
+
+/* Write the output of a job that starts where the previous one ended */
+static int mt_emit(mt_ctx_t *ctx, mt_job_t *job)
+{
+	uint8_t *b = (uint8_t *)job->sym;
+	size_t i, m = 0;
+
+	/* Fill in the markers, converting the symbols to bytes in place */
+	for (i = 0; i < job->sym_len; i++) {
+		uint16_t s = job->sym[i];
+		b[i] = (s < MT_MARKER) ? (uint8_t)s : ctx->window[s - MT_MARKER];
+	}
+	if (!mt_write(ctx, job, b, job->sym_len, 0, &m) ||
+		!mt_write(ctx, job, &job->out[MT_WSIZE], job->out_len, job->sym_len, &m))
+		return 0;
+	ctx->next_bit = job->end_bit;
+	ctx->eos = job->eos;
+	bb_total_rb = ctx->next_bit >> 3;
+	if (bled_progress != NULL)
+		bled_progress(bb_total_rb);
+	return 1;
+}
+
+/* Decode from where the output is, for one job, with the main thread */
+static int mt_step(mt_ctx_t *ctx, mt_job_t *job, uint64_t stop_bit, BOOL header)
+{
+	job->speculative = FALSE;
+	job->header = header;
+	job->search_bit = ctx->next_bit;
+	job->stop_bit = stop_bit;
+	job->window = ctx->window;
+	mt_run_job(job);
+	if (job->status != MT_OK) {
+		if (!job->fatal)
+			bb_simple_error_msg("corrupted data");
+		return 0;
+	}
+	if (header && ctx->xstate != NULL)
+		ctx->xstate->mtime = job->mtime;
+	return mt_emit(ctx, job);
+}
+
+/* Decode from where the output is up to stop_bit, with the main thread */
+static int mt_sequential(mt_ctx_t *ctx, mt_job_t *job, uint64_t stop_bit, BOOL header)
+{
+	while (!ctx->eos && ctx->next_bit < stop_bit) {
+		if (!mt_step(ctx, job, stop_bit, header))
+			return 0;
+		header = FALSE;
+	}
+	return 1;
+}
+
+/* Returns -2 if the input can't be decoded in parallel */
+static IF_DESKTOP(long long) int unpack_gz_stream_mt(transformer_state_t *xstate)
+{
+	IF_DESKTOP(long long) int total = -1;
+	HANDLE hFile;
+	LARGE_INTEGER li;
+	mt_ctx_t *ctx = NULL;
+	mt_job_t *jobs = NULL, *seq;
+	uint64_t start, nb_chunks, c;
+	unsigned j, nb_threads, nb_jobs = 0, misses = 0;
+
+	/* Only plain files, where reads can happen anywhere */
+	if (bled_read != NULL || xstate->src_fd == bb_virtual_fd || xstate->mem_output_size_max != 0)
+		return -2;
+	hFile = (HANDLE)_get_osfhandle(xstate->src_fd);
+	if (hFile == INVALID_HANDLE_VALUE || GetFileType(hFile) != FILE_TYPE_DISK ||
+		!GetFileSizeEx(hFile, &li) || li.QuadPart < MT_MIN_SIZE)
+		return -2;
+	nb_threads = bb_get_nb_threads();
+	if (nb_threads < 2)
+		return -2;
+	/* the magic has just been read */
+	start = (uint64_t)lseek(xstate->src_fd, 0, SEEK_CUR) - 2;
+	if (start > (uint64_t)li.QuadPart)
+		return -2;
+
+	ctx = calloc(1, sizeof(*ctx));
+	nb_jobs = MIN(nb_threads, MT_MAX_WORKERS) + 2;
+	jobs = calloc(nb_jobs + 1, sizeof(*jobs));
+	if (ctx == NULL || jobs == NULL) {
+		bb_error_msg("alloc error");
+		nb_jobs = 0;
+		goto out;
+	}
+	for (j = 0; j <= nb_jobs; j++) {
+		jobs[j].hFile = hFile;
+		jobs[j].file_size = li.QuadPart;
+		jobs[j].out_cap = MT_OUT_CAP;
+		jobs[j].hDone = CreateEvent(NULL, TRUE, FALSE, NULL);
+		if (jobs[j].hDone == NULL) {
+			bb_error_msg("could not create event");
+			goto out;
+		}
+	}
+	/* The last job is for the main thread */
+	seq = &jobs[nb_jobs];
+	ctx->xstate = xstate;
+	ctx->crc_table = crc32_filltable(NULL, 0);
+	ctx->crc = ~0;
+	ctx->next_bit = start * 8;
+	total = 0;
+
+	/* The first chunk, with the gzip header, is always decoded here. The
+	 * jobs for the next ones are recycled in order. Data without dynamic
+	 * blocks, such as long runs of stored ones, makes for jobs that are
+	 * of no use, so these are mostly skipped after a few misses. */
+#define CHUNK_BIT(c) (((c) < nb_chunks) ? (start + (c) * MT_CHUNK_SIZE) * 8 : UINT64_MAX)
+	nb_chunks = ((uint64_t)li.QuadPart - start + MT_CHUNK_SIZE - 1) / MT_CHUNK_SIZE;
+	for (c = 1; c < nb_chunks && c <= nb_jobs; c++)
+		mt_dispatch(&jobs[(c - 1) % nb_jobs], CHUNK_BIT(c), CHUNK_BIT(c + 1), FALSE);
+	if (!mt_sequential(ctx, seq, CHUNK_BIT(1), TRUE))
+		goto err;
+	for (c = 1; c < nb_chunks && !ctx->eos; c++) {
+		mt_job_t *job = &jobs[(c - 1) % nb_jobs];
+		WaitForSingleObject(job->hDone, INFINITE);
+		job->busy = FALSE;
+		if (job->status == MT_OK && job->start_bit == ctx->next_bit) {
+			if (!mt_emit(ctx, job))
+				goto err;
+			misses = 0;
+		} else if (job->speculative) {
+			misses++;
+		}
+		if (!mt_sequential(ctx, seq, CHUNK_BIT(c + 1), FALSE))
+			goto err;
+		if (c + nb_jobs < nb_chunks && !ctx->eos)
+			mt_dispatch(job, CHUNK_BIT(c + nb_jobs), CHUNK_BIT(c + nb_jobs + 1),
+				misses >= MT_MAX_MISSES && (c + nb_jobs) % MT_RETRY != 0);
+	}
+#undef CHUNK_BIT
+	if (!mt_sequential(ctx, seq, UINT64_MAX, FALSE))
+		goto err;
+	total = ctx->total;
+	goto out;
+
+ err:
+	total = -1;
+ out:
+	/* Don't release any buffer a worker may still be using */
+	for (j = 0; jobs != NULL && j <= nb_jobs; j++) {
+		if (jobs[j].busy)
+			WaitForSingleObject(jobs[j].hDone, INFINITE);
+		if (jobs[j].hDone != NULL)
+			CloseHandle(jobs[j].hDone);
+		mt_free_job(&jobs[j]);
+	}
+	if (ctx != NULL)
+		free(ctx->crc_table);
+	free(jobs);
+	free(ctx);
+	return total;
+}
+
+/* Set up the main thread job and context, for the file of descriptor 'fd' */
+static int mt_seek_init(int fd, mt_ctx_t **ctx, mt_job_t **job)
+{
+	HANDLE hFile;
+	LARGE_INTEGER li;
+
+	*ctx = NULL;
+	*job = NULL;
+	/* The jobs read the file directly */
+	if (bled_read != NULL || fd == bb_virtual_fd)
+		return 0;
+	hFile = (HANDLE)_get_osfhandle(fd);
+	if (hFile == INVALID_HANDLE_VALUE || !GetFileSizeEx(hFile, &li))
+		return 0;
+	*ctx = calloc(1, sizeof(mt_ctx_t));
+	*job = calloc(1, sizeof(mt_job_t));
+	if (*ctx == NULL || *job == NULL) {
+		bb_error_msg("alloc error");
+		return 0;
+	}
+	(*job)->hFile = hFile;
+	(*job)->file_size = li.QuadPart;
+	(*ctx)->crc_table = crc32_filltable(NULL, 0);
+	(*ctx)->crc = ~0;
+	return 1;
+}
+
+static void mt_seek_exit(mt_ctx_t *ctx, mt_job_t *job)
+{
+	if (job != NULL)
+		mt_free_job(job);
+	if (ctx != NULL)
+		free(ctx->crc_table);
+	free(job);
+	free(ctx);
+}
+
+/*
+ * Build a checkpoint index of a gzip file, with a seek point every 'spacing'
+ * bytes of output or so. Unlike with xz or zstd, this means decoding the
+ * whole file, and keeping the 32 KB window that precedes each point.
+ * Returns 0 on success, with the uncompressed size.
+ */
+int FAST_FUNC get_gz_seek_points(int fd, uint64_t spacing, seek_point_t **points, size_t *nb_points, uint64_t *size)
+{
+	mt_ctx_t *ctx;
+	mt_job_t *job;
+	seek_point_t *p;
+	size_t i, max_points = 0;
+	int r = -1;
+
+	*points = NULL;
+	*nb_points = 0;
+	*size = 0;
+	if (!mt_seek_init(fd, &ctx, &job))
+		goto out;
+	job->out_cap = (size_t)MIN(MAX(spacing, MT_MIN_SPACING), MT_OUT_CAP);
+
+	/* The first point is the start of the file, with the header of the first member */
+	while (1) {
+		if (*nb_points >= max_points) {
+			max_points = MAX(2 * max_points, 64);
+			p = realloc(*points, max_points * sizeof(seek_point_t));
+			if (p == NULL) {
+				bb_error_msg("alloc error");
+				goto out;
+			}
+			*points = p;
+		}
+		p = &(*points)[*nb_points];
+		p->in_offset = ctx->next_bit;
+		p->out_offset = ctx->total;
+		p->window = NULL;
+		if (*nb_points > 0) {
+			p->window = malloc(MT_WSIZE);
+			if (p->window == NULL) {
+				bb_error_msg("alloc error");
+				goto out;
+			}
+			memcpy(p->window, ctx->window, MT_WSIZE);
+		}
+		(*nb_points)++;
+		if (!mt_step(ctx, job, UINT64_MAX, *nb_points == 1))
+			goto out;
+		if (ctx->eos)
+			break;
+	}
+	for (i = 0; i < *nb_points; i++)
+		(*points)[i].out_end = ctx->total;
+	*size = ctx->total;
+	r = 0;
+
+out:
+	mt_seek_exit(ctx, job);
+	if (r != 0) {
+		for (i = 0; i < *nb_points; i++)
+			free((*points)[i].window);
+		free(*points);
+		*points = NULL;
+		*nb_points = 0;
+	}
+	return r;
+}
+
+/* Decode to memory from a seek point of get_gz_seek_points() */
+IF_DESKTOP(long long) int FAST_FUNC unpack_gz_from_point(transformer_state_t *xstate, const seek_point_t *point)
+{
+	IF_DESKTOP(long long) int total = -1;
+	mt_ctx_t *ctx;
+	mt_job_t *job;
+
+	if (!mt_seek_init(xstate->src_fd, &ctx, &job))
+		goto out;
+	/* Blocks are small, and we usually want only a few of them */
+	job->out_cap = MT_SEEK_CAP;
+	ctx->xstate = xstate;
+	ctx->next_bit = point->in_offset;
+	if (point->window != NULL) {
+		memcpy(ctx->window, point->window, MT_WSIZE);
+		ctx->partial = TRUE;
+	}
+	if (mt_sequential(ctx, job, UINT64_MAX, point->window == NULL))
+		total = ctx->total;
+	else if (ctx->full)
+		total = xstate->mem_output_size_max;
+
+out:
+	mt_seek_exit(ctx, job);
+	return total;
+}
+
 IF_DESKTOP(long long) int FAST_FUNC
 unpack_gz_stream(transformer_state_t *xstate)
 {
@@ -1261,6 +2215,11 @@ unpack_gz_stream(transformer_state_t *xstate)
 	}
 #endif
 
+	/* Large files on disk are decoded by several threads */
+	total = unpack_gz_stream_mt(xstate);
+	if (total != -2)
+		return total;
+
 	total = 0;
 
 	ALLOC_STATE;
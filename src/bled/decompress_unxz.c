@@ -32,7 +32,11 @@ static uint32_t XZ_FUNC xz_crc32(const uint8_t *buf, size_t size, uint32_t crc)
 	return ~crc32_block_endian0(~crc, buf, size, global_crc32_table);
 }
 
-IF_DESKTOP(long long) int FAST_FUNC unpack_xz_stream(transformer_state_t *xstate)
+/*
+ * Decode a stream, or the blocks that follow the current position of the
+ * source, when 'header' points to the header of the stream they belong to.
+ */
+static IF_DESKTOP(long long) int unpack_xz_stream_inner(transformer_state_t *xstate, const uint8_t *header)
 {
 	IF_DESKTOP(long long) int n = 0;
 	struct xz_buf b;
@@ -57,6 +61,10 @@ IF_DESKTOP(long long) int FAST_FUNC unpack_xz_stream(transformer_state_t *xstate
 	b.in = in;
 	b.in_pos = 0;
 	b.in_size = 0;
+	if (header != NULL) {
+		memcpy(in, header, STREAM_HEADER_SIZE);
+		b.in_size = STREAM_HEADER_SIZE;
+	}
 	b.out = out;
 	b.out_pos = 0;
 	b.out_size = XZ_BUFSIZE;
@@ -82,6 +90,11 @@ IF_DESKTOP(long long) int FAST_FUNC unpack_xz_stream(transformer_state_t *xstate
 			}
 			IF_DESKTOP(n += nwrote;)
 			b.out_pos = 0;
+			/* Don't decode past what the caller is after */
+			if (xstate->mem_output_size_max != 0 && xstate->mem_output_size == xstate->mem_output_size_max) {
+				ret = XZ_BUF_FULL;
+				goto out;
+			}
 		}
 
 		if (ret == XZ_OK)
@@ -104,6 +117,11 @@ IF_DESKTOP(long long) int FAST_FUNC unpack_xz_stream(transformer_state_t *xstate
 			bb_error_msg_and_err("write error (errno: %d)", errno);
 		}
 		IF_DESKTOP(n += nwrote;)
+		/* Blocks decoded on their own end with an index that doesn't match */
+		if (xstate->mem_output_size_max != 0 && xstate->mem_output_size == xstate->mem_output_size_max) {
+			ret = XZ_BUF_FULL;
+			goto out;
+		}
 
 		switch (ret) {
 		case XZ_STREAM_END:
@@ -140,3 +158,462 @@ err:
 	else
 		return -ret;
 }
+
+/*
+ * Random access to .xz files
+ *
+ * The index at the end of each stream lists the compressed and uncompressed
+ * sizes of its blocks, which are decoded independently of each other. So the
+ * data can be decoded from the start of any block, provided that the decoder
+ * is fed the header of the stream first.
+ */
+
+/* Decode the block from the current position of the source, up to the end of its stream */
+IF_DESKTOP(long long) int FAST_FUNC unpack_xz_block(transformer_state_t *xstate, const seek_point_t *point)
+{
+	return unpack_xz_stream_inner(xstate, point->header);
+}
+
+static int xz_get_vli(const uint8_t *buf, size_t size, size_t *pos, uint64_t *vli)
+{
+	unsigned shift;
+
+	*vli = 0;
+	for (shift = 0; shift < 63 && *pos < size; shift += 7) {
+		uint8_t b = buf[(*pos)++];
+		*vli |= (uint64_t)(b & 0x7F) << shift;
+		if ((b & 0x80) == 0)
+			return (b != 0 || shift == 0);
+	}
+	return 0;
+}
+
+/*
+ * Parse the index of a stream that ends at 'end'. Adds a seek point for each
+ * block to 'points', unless NULL, and returns the offset of the stream, or
+ * -1 if the index isn't valid.
+ */
+static int64_t xz_parse_stream(int fd, uint64_t end, seek_point_t *points, size_t *nb_points, uint64_t *size)
+{
+	uint8_t footer[STREAM_HEADER_SIZE], header[STREAM_HEADER_SIZE], *index = NULL;
+	uint64_t index_size, nb_records, unpadded, uncompressed, blocks_size = 0, in_offset, out_offset;
+	int64_t start = -1;
+	size_t pos = 1, i;
+
+	if (end < 2 * STREAM_HEADER_SIZE || !full_read_at(fd, end - STREAM_HEADER_SIZE, footer, STREAM_HEADER_SIZE))
+		return -1;
+	if (memcmp(&footer[10], FOOTER_MAGIC, FOOTER_MAGIC_SIZE) != 0 ||
+		xz_crc32(&footer[4], 6, 0) != get_le32(footer))
+		return -1;
+	index_size = ((uint64_t)get_le32(&footer[4]) + 1) * 4;
+	if (index_size + 2 * STREAM_HEADER_SIZE > end)
+		return -1;
+	index = malloc((size_t)index_size);
+	if (index == NULL)
+		return -1;
+	if (!full_read_at(fd, end - STREAM_HEADER_SIZE - index_size, index, (size_t)index_size))
+		goto out;
+	if (index[0] != 0 || xz_crc32(index, (size_t)index_size - 4, 0) != get_le32(&index[index_size - 4]))
+		goto out;
+	if (!xz_get_vli(index, (size_t)index_size - 4, &pos, &nb_records))
+		goto out;
+	/* Each record takes at least two bytes */
+	if (nb_records > index_size / 2)
+		goto out;
+
+	/* The records give us where the blocks, and thus the stream, start */
+	for (i = 0; i < nb_records; i++) {
+		if (!xz_get_vli(index, (size_t)index_size - 4, &pos, &unpadded) ||
+			!xz_get_vli(index, (size_t)index_size - 4, &pos, &uncompressed) || unpadded == 0)
+			goto out;
+		blocks_size += (unpadded + 3) & ~3ULL;
+	}
+	if (blocks_size + index_size + 2 * STREAM_HEADER_SIZE > end)
+		goto out;
+	in_offset = end - STREAM_HEADER_SIZE - index_size - blocks_size;
+	if (!full_read_at(fd, in_offset - STREAM_HEADER_SIZE, header, STREAM_HEADER_SIZE) ||
+		memcmp(header, HEADER_MAGIC, HEADER_MAGIC_SIZE) != 0 ||
+		memcmp(&header[HEADER_MAGIC_SIZE], &footer[8], 2) != 0)
+		goto out;
+
+	pos = 1;
+	xz_get_vli(index, (size_t)index_size - 4, &pos, &nb_records);
+	for (i = 0, out_offset = *size; i < nb_records; i++) {
+		xz_get_vli(index, (size_t)index_size - 4, &pos, &unpadded);
+		xz_get_vli(index, (size_t)index_size - 4, &pos, &uncompressed);
+		if (points != NULL) {
+			points[*nb_points].in_offset = in_offset;
+			points[*nb_points].in_size = unpadded;
+			points[*nb_points].out_offset = out_offset;
+			memcpy(points[*nb_points].header, header, STREAM_HEADER_SIZE);
+			points[*nb_points].window = NULL;
+		}
+		(*nb_points)++;
+		in_offset += (unpadded + 3) & ~3ULL;
+		out_offset += uncompressed;
+	}
+	/* Blocks can only be decoded up to the end of their own stream */
+	for (i = 0; points != NULL && i < nb_records; i++)
+		points[*nb_points - 1 - i].out_end = out_offset;
+	*size = out_offset;
+	start = (int64_t)(end - STREAM_HEADER_SIZE - index_size - blocks_size - STREAM_HEADER_SIZE);
+
+out:
+	free(index);
+	return start;
+}
+
+/* Skip the stream padding that precedes 'end' */
+static int64_t xz_skip_padding(int fd, uint64_t end)
+{
+	uint32_t pad;
+
+	while (end >= 4) {
+		if (!full_read_at(fd, end - 4, &pad, 4))
+			return -1;
+		if (pad != 0)
+			break;
+		end -= 4;
+	}
+	return (int64_t)end;
+}
+
+/*
+ * Build the seek points of a .xz file, from the indexes of its streams, which
+ * are read from the end. Returns 0 on success, with the uncompressed size.
+ */
+int FAST_FUNC get_xz_seek_points(int fd, seek_point_t **points, size_t *nb_points, uint64_t *size)
+{
+	int64_t end, start;
+	uint64_t *ends = NULL, *tmp;
+	size_t nb_streams = 0, max_streams = 0, i;
+	int r = -1;
+
+	xz_crc32_init();
+	*points = NULL;
+	*nb_points = 0;
+	*size = 0;
+
+	/* Find where the streams are and how many blocks they hold */
+	end = _lseeki64(fd, 0, SEEK_END);
+	if (end < 0 || (end & 3) != 0)
+		goto out;
+	while (end > 0) {
+		end = xz_skip_padding(fd, end);
+		if (end <= 0)
+			break;
+		start = xz_parse_stream(fd, end, NULL, nb_points, size);
+		if (start < 0)
+			goto out;
+		if (nb_streams >= max_streams) {
+			max_streams = MAX(2 * max_streams, 4);
+			tmp = realloc(ends, max_streams * sizeof(uint64_t));
+			if (tmp == NULL)
+				goto out;
+			ends = tmp;
+		}
+		ends[nb_streams++] = end;
+		end = start;
+	}
+	if (end != 0 || nb_streams == 0)
+		goto out;
+
+	/* Then add their blocks, in order */
+	*points = calloc(MAX(*nb_points, 1), sizeof(seek_point_t));
+	if (*points == NULL)
+		goto out;
+	*nb_points = 0;
+	*size = 0;
+	for (i = nb_streams; i > 0; i--) {
+		if (xz_parse_stream(fd, ends[i - 1], *points, nb_points, size) < 0)
+			goto out;
+	}
+	r = 0;
+
+out:
+	free(ends);
+	if (r != 0) {
+		free(*points);
+		*points = NULL;
+		*nb_points = 0;
+	}
+	return r;
+}
+
+/*
+ * Parallel decoding of multi-block .xz files
+ *
+ * As blocks can be decoded on their own, the main thread hands each of the
+ * blocks listed in the index over to a worker, and writes their output in
+ * order. A worker decodes its block as a stream of its own: the header of
+ * the stream, the block, then an index and a footer for that one block, so
+ * that the decoder checks the block against its index record, as it would
+ * for the whole stream. Files with blocks that are too large to be held in
+ * memory, such as those that have a single one, are left to the sequential
+ * decoder.
+ */
+#define XZ_MT_MIN_SIZE		(4 * 1024 * 1024)	/* smaller files aren't worth the threads */
+#define XZ_MT_MAX_BLOCK		(64 * 1024 * 1024)	/* compressed or uncompressed size of a block */
+#define XZ_MT_INDEX_SIZE	(28 + STREAM_HEADER_SIZE)	/* the largest index with one record, and a footer */
+#if defined(_WIN64)
+#define XZ_MT_MAX_WORKERS	8
+#define XZ_MT_MAX_MEMORY	(512 * 1024 * 1024)
+#else
+#define XZ_MT_MAX_WORKERS	4
+#define XZ_MT_MAX_MEMORY	(128 * 1024 * 1024)
+#endif
+
+typedef struct {
+	HANDLE hFile;
+	const seek_point_t *point;
+	struct xz_dec *s;
+	uint8_t *in;
+	uint8_t *out;
+	size_t out_len, out_size;
+	enum xz_ret ret;
+	BOOL unchecked;		/* the check type isn't supported, so it wasn't verified */
+	BOOL busy;
+	HANDLE hDone;
+} xz_mt_job_t;
+
+static void xz_put_le32(uint8_t *buf, uint32_t v)
+{
+	buf[0] = (uint8_t)v;
+	buf[1] = (uint8_t)(v >> 8);
+	buf[2] = (uint8_t)(v >> 16);
+	buf[3] = (uint8_t)(v >> 24);
+}
+
+static size_t xz_put_vli(uint8_t *buf, uint64_t vli)
+{
+	size_t i = 0;
+
+	for (; vli >= 0x80; vli >>= 7)
+		buf[i++] = (uint8_t)vli | 0x80;
+	buf[i++] = (uint8_t)vli;
+	return i;
+}
+
+/* Write the index and footer of a stream that only holds the block of 'point' */
+static size_t xz_mt_index(uint8_t *buf, const seek_point_t *point, uint64_t out_size)
+{
+	size_t pos = 0;
+
+	buf[pos++] = 0;
+	pos += xz_put_vli(&buf[pos], 1);
+	pos += xz_put_vli(&buf[pos], point->in_size);
+	pos += xz_put_vli(&buf[pos], out_size);
+	while (pos & 3)
+		buf[pos++] = 0;
+	xz_put_le32(&buf[pos], xz_crc32(buf, pos, 0));
+	pos += 4;
+	/* The footer holds the size of the index and the flags of the header */
+	xz_put_le32(&buf[pos + 4], (uint32_t)(pos / 4 - 1));
+	memcpy(&buf[pos + 8], &point->header[HEADER_MAGIC_SIZE], 2);
+	memcpy(&buf[pos + 10], FOOTER_MAGIC, FOOTER_MAGIC_SIZE);
+	xz_put_le32(&buf[pos], xz_crc32(&buf[pos + 4], 6, 0));
+	return pos + STREAM_HEADER_SIZE;
+}
+
+static DWORD WINAPI xz_mt_worker(LPVOID param)
+{
+	xz_mt_job_t *job = (xz_mt_job_t *)param;
+	const seek_point_t *point = job->point;
+	DWORD size = (DWORD)((point->in_size + 3) & ~3ULL), rb;
+	OVERLAPPED ov;
+	struct xz_buf b;
+
+	job->ret = XZ_DATA_ERROR;
+	job->unchecked = FALSE;
+	job->out_len = 0;
+	memset(&ov, 0, sizeof(ov));
+	ov.Offset = (DWORD)point->in_offset;
+	ov.OffsetHigh = (DWORD)(point->in_offset >> 32);
+	memcpy(job->in, point->header, STREAM_HEADER_SIZE);
+	if (ReadFile(job->hFile, &job->in[STREAM_HEADER_SIZE], size, &rb, &ov) && rb == size) {
+		xz_dec_reset(job->s);
+		b.in = job->in;
+		b.in_pos = 0;
+		b.in_size = STREAM_HEADER_SIZE + size;
+		b.in_size += xz_mt_index(&job->in[b.in_size], point, job->out_size);
+		b.out = job->out;
+		b.out_pos = 0;
+		b.out_size = job->out_size;
+		do {
+			job->ret = xz_dec_run(job->s, &b);
+			if (job->ret == XZ_UNSUPPORTED_CHECK)
+				job->unchecked = TRUE;
+		} while (job->ret == XZ_OK || job->ret == XZ_UNSUPPORTED_CHECK);
+		job->out_len = b.out_pos;
+		if (job->ret == XZ_STREAM_END && b.out_pos != b.out_size)
+			job->ret = XZ_DATA_ERROR;
+	}
+	SetEvent(job->hDone);
+	return 0;
+}
+
+static void xz_mt_dispatch(xz_mt_job_t *job, const seek_point_t *point, uint64_t out_size)
+{
+	job->point = point;
+	job->out_size = (size_t)out_size;
+	job->busy = TRUE;
+	ResetEvent(job->hDone);
+	if (!QueueUserWorkItem(xz_mt_worker, job, WT_EXECUTELONGFUNCTION))
+		xz_mt_worker(job);
+}
+
+/* Write the output of a job, once it is done. Returns -1 on error */
+static int xz_mt_emit(transformer_state_t *xstate, xz_mt_job_t *job, BOOL *warned)
+{
+	size_t i, n;
+
+	WaitForSingleObject(job->hDone, INFINITE);
+	job->busy = FALSE;
+	if (job->unchecked && !*warned) {
+		bb_error_msg("unsupported check; not verifying file integrity");
+		*warned = TRUE;
+	}
+	switch (job->ret) {
+	case XZ_STREAM_END:
+		break;
+	case XZ_MEM_ERROR:
+		bb_error_msg("memory allocation error");
+		return -1;
+	case XZ_MEMLIMIT_ERROR:
+		bb_error_msg("memory usage limit error");
+		return -1;
+	case XZ_OPTIONS_ERROR:
+		bb_error_msg("unsupported XZ header option");
+		return -1;
+	default:
+		bb_error_msg("corrupted archive");
+		return -1;
+	}
+	if (bled_cancel_request != NULL && *bled_cancel_request != 0)
+		return -1;
+	for (i = 0; i < job->out_len; i += n) {
+		n = MIN(job->out_len - i, BB_BUFSIZE);
+		if (transformer_write(xstate, &job->out[i], n) != (ssize_t)n) {
+			bb_error_msg("write error (errno: %d)", errno);
+			return -1;
+		}
+	}
+	bb_total_rb = job->point->in_offset + ((job->point->in_size + 3) & ~3ULL);
+	if (bled_progress != NULL)
+		bled_progress(bb_total_rb);
+	return 0;
+}
+
+/* Returns -2 if the input can't be decoded in parallel */
+static IF_DESKTOP(long long) int unpack_xz_stream_mt(transformer_state_t *xstate)
+{
+	IF_DESKTOP(long long) int total = -2;
+	HANDLE hFile;
+	LARGE_INTEGER li;
+	seek_point_t *points = NULL;
+	xz_mt_job_t *jobs = NULL;
+	uint64_t size, in_size, out_size, max_in = 0, max_out = 0;
+	size_t nb_points = 0, nb_blocks, i;
+	unsigned j, nb_threads, nb_jobs = 0;
+	BOOL warned = FALSE;
+	int r;
+
+	/* Only plain files, where reads can happen anywhere */
+	if (bled_read != NULL || xstate->src_fd == bb_virtual_fd || xstate->mem_output_size_max != 0)
+		return -2;
+	hFile = (HANDLE)_get_osfhandle(xstate->src_fd);
+	if (hFile == INVALID_HANDLE_VALUE || GetFileType(hFile) != FILE_TYPE_DISK ||
+		!GetFileSizeEx(hFile, &li) || li.QuadPart < XZ_MT_MIN_SIZE)
+		return -2;
+	nb_threads = bb_get_nb_threads();
+	/* The indexes are read from the end, so the file must start with the stream */
+	if (nb_threads < 2 || lseek(xstate->src_fd, 0, SEEK_CUR) != 0)
+		return -2;
+	r = get_xz_seek_points(xstate->src_fd, &points, &nb_points, &size);
+	/* Reading the indexes isn't progress, and decoding starts from the beginning */
+	bb_total_rb = 0;
+	if (lseek(xstate->src_fd, 0, SEEK_SET) != 0) {
+		bb_error_msg("could not seek input");
+		total = -1;
+		goto out;
+	}
+	if (r != 0)
+		goto out;
+
+	/* Like the sequential decoder, only decode the first stream */
+	for (nb_blocks = 0; nb_blocks < nb_points && points[nb_blocks].out_end == points[0].out_end; nb_blocks++) {
+		in_size = (points[nb_blocks].in_size + 3) & ~3ULL;
+		out_size = ((nb_blocks + 1 < nb_points) ? points[nb_blocks + 1].out_offset :
+			points[nb_blocks].out_end) - points[nb_blocks].out_offset;
+		max_in = MAX(max_in, in_size);
+		max_out = MAX(max_out, out_size);
+	}
+	if (nb_blocks < 2 || max_in > XZ_MT_MAX_BLOCK || max_out > XZ_MT_MAX_BLOCK)
+		goto out;
+	nb_jobs = MIN(nb_threads, XZ_MT_MAX_WORKERS) + 2;
+	nb_jobs = (unsigned)MIN(nb_jobs, XZ_MT_MAX_MEMORY / (max_in + max_out + XZ_MT_INDEX_SIZE + STREAM_HEADER_SIZE));
+	nb_jobs = (unsigned)MIN(nb_jobs, nb_blocks);
+	if (nb_jobs < 2) {
+		nb_jobs = 0;
+		goto out;
+	}
+	total = -1;
+	jobs = calloc(nb_jobs, sizeof(*jobs));
+	if (jobs == NULL) {
+		nb_jobs = 0;
+		goto alloc_error;
+	}
+	for (j = 0; j < nb_jobs; j++) {
+		jobs[j].hFile = hFile;
+		jobs[j].s = xz_dec_init(XZ_DYNALLOC, 1 << 26);
+		jobs[j].in = malloc((size_t)max_in + XZ_MT_INDEX_SIZE + STREAM_HEADER_SIZE);
+		jobs[j].out = malloc((size_t)MAX(max_out, 1));
+		if (jobs[j].s == NULL || jobs[j].in == NULL || jobs[j].out == NULL)
+			goto alloc_error;
+		jobs[j].hDone = CreateEvent(NULL, TRUE, FALSE, NULL);
+		if (jobs[j].hDone == NULL) {
+			bb_error_msg("could not create event");
+			goto out;
+		}
+	}
+
+	/* Keep all the jobs busy, writing the output of the oldest one before reusing it */
+	for (i = 0; i < nb_blocks + nb_jobs; i++) {
+		if (i >= nb_jobs && xz_mt_emit(xstate, &jobs[(i - nb_jobs) % nb_jobs], &warned) < 0)
+			goto out;
+		if (i < nb_blocks)
+			xz_mt_dispatch(&jobs[i % nb_jobs], &points[i], ((i + 1 < nb_points) ?
+				points[i + 1].out_offset : points[i].out_end) - points[i].out_offset);
+	}
+	total = points[0].out_end;
+	goto out;
+
+ alloc_error:
+	bb_error_msg("alloc error");
+ out:
+	/* Don't release any buffer a worker may still be using */
+	for (j = 0; j < nb_jobs; j++) {
+		if (jobs[j].busy)
+			WaitForSingleObject(jobs[j].hDone, INFINITE);
+		if (jobs[j].hDone != NULL)
+			CloseHandle(jobs[j].hDone);
+		xz_dec_end(jobs[j].s);
+		free(jobs[j].in);
+		free(jobs[j].out);
+	}
+	free(jobs);
+	free(points);
+	return total;
+}
+
+IF_DESKTOP(long long) int FAST_FUNC unpack_xz_stream(transformer_state_t *xstate)
+{
+	IF_DESKTOP(long long) int total;
+
+	/* Large files on disk, with several blocks, are decoded by several threads */
+	total = unpack_xz_stream_mt(xstate);
+	if (total != -2)
+		return total;
+
+	return unpack_xz_stream_inner(xstate, NULL);
+}
@@ -515,6 +515,262 @@ unzip_extract(zip_header_t* zip, transformer_state_t* xstate)
 	return n;
 }
 
+#if ENABLE_FEATURE_UNZIP_CDF
+/*
+ * Parallel extraction to a directory
+ *
+ * With a central directory, we know where each entry is, so the entries can
+ * be extracted by a pool of workers, each reading from its own descriptor.
+ * The main thread walks the central directory and creates the files in the
+ * same order as the sequential code, so that the switch callback sees the
+ * same sequence, then hands each of them to the next free worker. Progress
+ * is reported from the main thread, from the bytes that the workers read.
+ * Only stored and deflated entries are handed out, the other methods being
+ * rare enough to be extracted by the main thread itself.
+ */
+#if defined(_WIN64)
+#define ZIP_MT_MAX_WORKERS	8
+#else
+#define ZIP_MT_MAX_WORKERS	4
+#endif
+#define ZIP_MT_PROGRESS_MS	200
+
+typedef struct {
+	transformer_state_t xstate;	/* with the worker's own source descriptor */
+	zip_header_t zip;
+	uint64_t offset;		/* of the compressed data */
+	uint64_t rb;			/* compressed bytes read so far */
+	IF_DESKTOP(long long) int n;
+	BOOL busy;
+	HANDLE hDone;
+} zip_job_t;
+
+typedef struct {
+	zip_job_t jobs[ZIP_MT_MAX_WORKERS];
+	HANDLE events[ZIP_MT_MAX_WORKERS];
+	unsigned nb_jobs;
+	uint64_t rb, rb_done;		/* read by the main thread, and by workers that are done */
+	IF_DESKTOP(long long) int total;
+	BOOL failed;
+	jmp_buf saved_jmp;
+} zip_mt_t;
+
+static DWORD WINAPI zip_mt_worker(LPVOID param)
+{
+	zip_job_t *job = (zip_job_t *)param;
+	/* In case we run on the main thread */
+	uint64_t *saved_rb = bb_thread_rb;
+	jmp_buf saved_jmp;
+
+	memcpy(saved_jmp, bb_error_jmp, sizeof(jmp_buf));
+	bb_thread_rb = &job->rb;
+	job->n = -1;
+	if (setjmp(bb_error_jmp))
+		goto out;
+	if ((uint64_t)lseek(job->xstate.src_fd, job->offset, SEEK_SET) != job->offset)
+		goto out;
+	job->n = unzip_extract(&job->zip, &job->xstate);
+	if (job->n >= 0 && transformer_flush(&job->xstate) < 0)
+		job->n = -1;
+
+out:
+	job->xstate.dst_buf_len = 0;
+	if (job->xstate.dst_fd > 0) {
+		_close(job->xstate.dst_fd);
+		job->xstate.dst_fd = -1;
+	}
+	bb_thread_rb = saved_rb;
+	memcpy(bb_error_jmp, saved_jmp, sizeof(jmp_buf));
+	SetEvent(job->hDone);
+	return 0;
+}
+
+static void zip_mt_progress(zip_mt_t *ctx)
+{
+	unsigned j;
+
+	bb_total_rb = ctx->rb + ctx->rb_done;
+	for (j = 0; j < ctx->nb_jobs; j++) {
+		if (ctx->jobs[j].busy)
+			bb_total_rb += ctx->jobs[j].rb;
+	}
+	if (bled_progress != NULL)
+		bled_progress(bb_total_rb);
+}
+
+/* Wait for a worker to be done, or all of them if 'all' is set, and return its job */
+static zip_job_t *zip_mt_wait(zip_mt_t *ctx, BOOL all)
+{
+	zip_job_t *job;
+	DWORD r;
+	unsigned j;
+
+	while (1) {
+		for (j = 0; j < ctx->nb_jobs; j++) {
+			job = &ctx->jobs[j];
+			if (job->busy && WaitForSingleObject(job->hDone, 0) == WAIT_OBJECT_0) {
+				/* Only busy jobs may be signaled, for the wait below */
+				ResetEvent(job->hDone);
+				job->busy = FALSE;
+				ctx->rb_done += job->rb;
+				if (job->n < 0)
+					ctx->failed = TRUE;
+				else
+					ctx->total += job->n;
+			}
+			if (!job->busy && !all)
+				return job;
+		}
+		for (j = 0; j < ctx->nb_jobs && !ctx->jobs[j].busy; j++);
+		if (j >= ctx->nb_jobs)
+			return NULL;
+		r = WaitForMultipleObjects(ctx->nb_jobs, ctx->events, FALSE, ZIP_MT_PROGRESS_MS);
+		if (r == WAIT_TIMEOUT)
+			zip_mt_progress(ctx);
+		else if (r == WAIT_FAILED)
+			Sleep(ZIP_MT_PROGRESS_MS);
+	}
+}
+
+/* Returns -2 if the archive can't be extracted in parallel */
+static IF_DESKTOP(long long) int unpack_zip_stream_mt(transformer_state_t *xstate, uint64_t cdf_offset)
+{
+	IF_DESKTOP(long long) int n = -2;
+	zip_mt_t *ctx = NULL;
+	zip_job_t *job;
+	zip_header_t zip;
+	cdf_header_t cdf;
+	HANDLE hFile, h;
+	FILE_ALLOCATION_INFO fai;
+	unsigned j, nb_threads;
+
+	if (xstate->dst_dir == NULL || cdf_offset == BAD_CDF_OFFSET || bled_read != NULL ||
+		xstate->src_fd == bb_virtual_fd)
+		return -2;
+	hFile = (HANDLE)_get_osfhandle(xstate->src_fd);
+	if (hFile == INVALID_HANDLE_VALUE || GetFileType(hFile) != FILE_TYPE_DISK)
+		return -2;
+	nb_threads = bb_get_nb_threads();
+	if (nb_threads < 2)
+		return -2;
+
+	ctx = calloc(1, sizeof(*ctx));
+	if (ctx == NULL)
+		return -2;
+	ctx->nb_jobs = MIN(nb_threads, ZIP_MT_MAX_WORKERS);
+	for (j = 0; j < ctx->nb_jobs; j++) {
+		ctx->jobs[j].xstate.src_fd = -1;
+		ctx->jobs[j].xstate.dst_fd = -1;
+	}
+	for (j = 0; j < ctx->nb_jobs; j++) {
+		job = &ctx->jobs[j];
+		/* A separate handle, for a separate file position */
+		h = ReOpenFile(hFile, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, FILE_FLAG_SEQUENTIAL_SCAN);
+		if (h != INVALID_HANDLE_VALUE) {
+			job->xstate.src_fd = _open_osfhandle((intptr_t)h, _O_RDONLY);
+			if (job->xstate.src_fd < 0)
+				CloseHandle(h);
+		}
+		job->xstate.dst_buf = malloc(BB_BUFSIZE);
+		job->hDone = CreateEvent(NULL, TRUE, FALSE, NULL);
+		ctx->events[j] = job->hDone;
+		if (job->xstate.src_fd < 0 || job->xstate.dst_buf == NULL || job->hDone == NULL)
+			goto out;
+	}
+
+	/* From here on, errors of the main thread must wait for the workers */
+	n = -1;
+	memcpy(ctx->saved_jmp, bb_error_jmp, sizeof(jmp_buf));
+	ctx->rb = bb_total_rb;
+	bb_thread_rb = &ctx->rb;
+	if (setjmp(bb_error_jmp)) {
+		ctx->failed = TRUE;
+		goto wait;
+	}
+
+	while (!ctx->failed) {
+		cdf_offset = read_next_cdf(xstate->src_fd, cdf_offset, &cdf);
+		if (cdf_offset == 0) /* EOF? */
+			break;
+		lseek(xstate->src_fd,
+			SWAP_LE32(cdf.fmt.relative_offset_of_local_header) + 4,
+			SEEK_SET);
+		xread(xstate->src_fd, zip.raw, ZIP_HEADER_LEN);
+		FIX_ENDIANNESS_ZIP(zip);
+		if (zip.fmt.zip_flags & SWAP_LE16(0x0008)) {
+			zip.fmt.crc32 = cdf.fmt.crc32;
+			zip.fmt.cmpsize = cdf.fmt.cmpsize;
+			zip.fmt.ucmpsize = cdf.fmt.ucmpsize;
+		}
+		if (zip.fmt.zip_flags & SWAP_LE16(0x0001)) {
+			bb_error_msg_and_die("zip flag %s is not supported",
+					"1 (encryption)");
+		}
+		unzip_set_xstate(xstate, &zip);
+
+		/* Directories get created along with the files they hold */
+		if (cdf.fmt.external_attributes & 0x40000010) {
+			free(xstate->dst_name);
+			xstate->dst_name = NULL;
+			continue;
+		}
+		if (zip.fmt.method != 0 && zip.fmt.method != 8) {
+			if (transformer_switch_file(xstate) < 0) {
+				ctx->failed = TRUE;
+				break;
+			}
+			unzip_extract(&zip, xstate);
+			ctx->total += xstate->dst_size;
+			continue;
+		}
+
+		job = zip_mt_wait(ctx, FALSE);
+		if (job == NULL || ctx->failed)
+			break;
+		if (transformer_switch_file(xstate) < 0) {
+			ctx->failed = TRUE;
+			break;
+		}
+		/* The worker owns the target from now on */
+		job->xstate.dst_fd = xstate->dst_fd;
+		xstate->dst_fd = -1;
+		job->xstate.dst_size = xstate->dst_size;
+		job->xstate.bytes_in = xstate->bytes_in;
+		job->xstate.bytes_out = 0;
+		job->zip = zip;
+		job->offset = (uint64_t)lseek(xstate->src_fd, 0, SEEK_CUR);
+		job->rb = 0;
+		/* Reserve the space of the file, which limits its fragmentation */
+		fai.AllocationSize.QuadPart = job->xstate.dst_size;
+		if (job->xstate.dst_size != 0)
+			SetFileInformationByHandle((HANDLE)_get_osfhandle(job->xstate.dst_fd),
+				FileAllocationInfo, &fai, sizeof(fai));
+		job->busy = TRUE;
+		if (!QueueUserWorkItem(zip_mt_worker, job, WT_EXECUTELONGFUNCTION))
+			zip_mt_worker(job);
+		zip_mt_progress(ctx);
+	}
+
+ wait:
+	zip_mt_wait(ctx, TRUE);
+	zip_mt_progress(ctx);
+	n = ctx->failed ? -1 : ctx->total;
+	bb_thread_rb = NULL;
+	memcpy(bb_error_jmp, ctx->saved_jmp, sizeof(jmp_buf));
+
+ out:
+	for (j = 0; j < ctx->nb_jobs; j++) {
+		job = &ctx->jobs[j];
+		if (job->xstate.src_fd >= 0)
+			_close(job->xstate.src_fd);
+		if (job->hDone != NULL)
+			CloseHandle(job->hDone);
+		free(job->xstate.dst_buf);
+	}
+	free(ctx);
+	return n;
+}
+#endif
 
 IF_DESKTOP(long long) int FAST_FUNC
 unpack_zip_stream(transformer_state_t *xstate)
@@ -523,6 +779,14 @@ unpack_zip_stream(transformer_state_t *xstate)
 	bool is_dir = false;
 	uint64_t cdf_offset = find_cdf_offset(xstate->src_fd);	/* try to seek to the end, find CDE and CDF start */
 
+#if ENABLE_FEATURE_UNZIP_CDF
+	/* Entries that go to a directory are extracted in parallel, when possible */
+	n = unpack_zip_stream_mt(xstate, cdf_offset);
+	if (n != -2)
+		return n;
+	n = -EFAULT;
+#endif
+
 	while (1) {
 		zip_header_t zip;
 		if (!ENABLE_FEATURE_UNZIP_CDF || cdf_offset == BAD_CDF_OFFSET) {
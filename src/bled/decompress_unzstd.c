@@ -90,7 +90,11 @@ unpack_zstd_stream_inner(transformer_state_t *xstate,
 				has_error = true;
 				break;
 			}
-			IF_DESKTOP(total = (nwrote == -ENOSPC) ? xstate->mem_output_size_max : total + output.pos);
+			/* Stop as soon as the caller's buffer is full */
+			if (nwrote == -ENOSPC || (xstate->mem_output_size_max != 0 &&
+				xstate->mem_output_size == xstate->mem_output_size_max))
+				return xstate->mem_output_size_max;
+			IF_DESKTOP(total += output.pos);
 		}
 		if (has_error)
 			break;
@@ -116,8 +120,8 @@ unpack_zstd_stream_inner(transformer_state_t *xstate,
 	return IF_DESKTOP(total) + 0;
 }
 
-IF_DESKTOP(long long) int FAST_FUNC
-unpack_zstd_stream(transformer_state_t *xstate)
+static IF_DESKTOP(long long) int
+unpack_zstd_stream_seq(transformer_state_t *xstate)
 {
 	const size_t in_allocsize = roundupsize(ZSTD_DStreamInSize(), 1024),
 		   out_allocsize = roundupsize(ZSTD_DStreamOutSize(), 1024);
@@ -139,3 +143,390 @@ unpack_zstd_stream(transformer_state_t *xstate)
 	ZSTD_freeDStream(dctx);
 	return result;
 }
+
+/*
+ * Random access to zstd files that use the seekable format, where the data
+ * is cut in independent frames, which are listed in a seek table that sits
+ * in a skippable frame at the end of the file.
+ */
+#define ZSTD_SEEKABLE_MAGIC		0x8F92EAB1
+#define ZSTD_SEEK_TABLE_MAGIC		0x184D2A5E
+#define ZSTD_SEEK_TABLE_FOOTER_SIZE	9
+#define ZSTD_SEEK_TABLE_MAX_FRAMES	0x8000000
+
+/* Build the seek points of a seekable zstd file. Returns 0 on success, with the uncompressed size. */
+int FAST_FUNC get_zstd_seek_points(int fd, seek_point_t **points, size_t *nb_points, uint64_t *size)
+{
+	uint8_t footer[ZSTD_SEEK_TABLE_FOOTER_SIZE], *table = NULL;
+	uint64_t file_size, table_size, in_offset = 0, out_offset = 0;
+	uint32_t nb_frames, entry_size, i;
+	int r = -1;
+
+	*points = NULL;
+	*nb_points = 0;
+	*size = 0;
+
+	file_size = (uint64_t)_lseeki64(fd, 0, SEEK_END);
+	if ((int64_t)file_size < ZSTD_SEEK_TABLE_FOOTER_SIZE + 8 ||
+		!full_read_at(fd, file_size - ZSTD_SEEK_TABLE_FOOTER_SIZE, footer, sizeof(footer)))
+		return -1;
+	/* Reserved bits of the descriptor must be zero */
+	if (get_le32(&footer[5]) != ZSTD_SEEKABLE_MAGIC || (footer[4] & 0x7C) != 0)
+		return -1;
+	nb_frames = get_le32(footer);
+	entry_size = (footer[4] & 0x80) ? 12 : 8;
+	if (nb_frames == 0 || nb_frames > ZSTD_SEEK_TABLE_MAX_FRAMES)
+		return -1;
+	table_size = (uint64_t)nb_frames * entry_size + ZSTD_SEEK_TABLE_FOOTER_SIZE + 8;
+	if (table_size > file_size)
+		return -1;
+	table = malloc((size_t)table_size);
+	*points = calloc(nb_frames, sizeof(seek_point_t));
+	if (table == NULL || *points == NULL)
+		goto out;
+	if (!full_read_at(fd, file_size - table_size, table, (size_t)table_size) ||
+		get_le32(table) != ZSTD_SEEK_TABLE_MAGIC || get_le32(&table[4]) != table_size - 8)
+		goto out;
+
+	for (i = 0; i < nb_frames; i++) {
+		(*points)[i].in_offset = in_offset;
+		(*points)[i].out_offset = out_offset;
+		(*points)[i].in_size = get_le32(&table[8 + i * entry_size]);
+		in_offset += get_le32(&table[8 + i * entry_size]);
+		out_offset += get_le32(&table[8 + i * entry_size + 4]);
+	}
+	/* The frames must account for all of the data that precedes the table */
+	if (in_offset != file_size - table_size)
+		goto out;
+	/* Frames follow each other, so decoding can go on to the end */
+	for (i = 0; i < nb_frames; i++)
+		(*points)[i].out_end = out_offset;
+	*nb_points = nb_frames;
+	*size = out_offset;
+	r = 0;
+
+out:
+	free(table);
+	if (r != 0) {
+		free(*points);
+		*points = NULL;
+	}
+	return r;
+}
+
+/*
+ * Parallel decoding of multi-frame zstd files
+ *
+ * Frames are independent of each other, so the main thread lists them, from
+ * the seek table of seekable files or by walking their block headers, hands
+ * each one over to a worker, which decodes it in one go, and writes their
+ * output in order. Frames that are too large to be held in memory, or that
+ * don't give their uncompressed size, as well as everything that follows, as
+ * with files that consist of a single frame, are left to the sequential decoder.
+ */
+#define ZSTD_MT_MIN_SIZE	(4 * 1024 * 1024)	/* smaller files aren't worth the threads */
+#define ZSTD_MT_MAX_FRAME	(64 * 1024 * 1024)	/* compressed or uncompressed size of a frame */
+#if defined(_WIN64)
+#define ZSTD_MT_MAX_WORKERS	8
+#define ZSTD_MT_MAX_MEMORY	(512 * 1024 * 1024)
+#else
+#define ZSTD_MT_MAX_WORKERS	4
+#define ZSTD_MT_MAX_MEMORY	(128 * 1024 * 1024)
+#endif
+
+typedef struct {
+	uint64_t in_offset;
+	uint64_t in_size;
+	uint64_t out_size;
+} zstd_mt_frame_t;
+
+typedef struct {
+	HANDLE hFile;
+	const zstd_mt_frame_t *frame;
+	ZSTD_DCtx *dctx;
+	uint8_t *in;
+	uint8_t *out;
+	size_t result;
+	BOOL read_ok;
+	BOOL busy;
+	HANDLE hDone;
+} zstd_mt_job_t;
+
+static BOOL zstd_mt_read(HANDLE hFile, uint64_t offset, void *buf, DWORD size)
+{
+	OVERLAPPED ov;
+	DWORD rb;
+
+	memset(&ov, 0, sizeof(ov));
+	ov.Offset = (DWORD)offset;
+	ov.OffsetHigh = (DWORD)(offset >> 32);
+	return ReadFile(hFile, buf, size, &rb, &ov) && rb == size;
+}
+
+/* Add a frame to the list, unless it is too large to be decoded in one go */
+static BOOL zstd_mt_add(zstd_mt_frame_t **frames, size_t *nb_frames, size_t *max_frames,
+	uint64_t in_offset, uint64_t in_size, uint64_t out_size)
+{
+	zstd_mt_frame_t *f;
+
+	if (in_size > ZSTD_MT_MAX_FRAME || out_size > ZSTD_MT_MAX_FRAME)
+		return FALSE;
+	if (*nb_frames >= *max_frames) {
+		*max_frames = MAX(2 * *max_frames, 64);
+		f = realloc(*frames, *max_frames * sizeof(zstd_mt_frame_t));
+		if (f == NULL)
+			return FALSE;
+		*frames = f;
+	}
+	f = &(*frames)[(*nb_frames)++];
+	f->in_offset = in_offset;
+	f->in_size = in_size;
+	f->out_size = out_size;
+	return TRUE;
+}
+
+/*
+ * List the frames that can be decoded in parallel, from 'start'. Returns the
+ * offset of the data that follows them, which is left to the sequential decoder.
+ */
+static uint64_t zstd_mt_list_frames(int fd, HANDLE hFile, uint64_t start, uint64_t file_size,
+	zstd_mt_frame_t **frames, size_t *nb_frames)
+{
+	ZSTD_frameHeader zfh;
+	seek_point_t *points = NULL;
+	size_t nb_points = 0, max_frames = 0, i;
+	uint64_t total_size, pos = start, end;
+	uint8_t hdr[ZSTD_FRAMEHEADERSIZE_MAX];
+	uint32_t block, type, size;
+	BOOL last;
+
+	*frames = NULL;
+	*nb_frames = 0;
+
+	/* The seek table of seekable files has the sizes of all the frames */
+	if (start == 0 && get_zstd_seek_points(fd, &points, &nb_points, &total_size) == 0) {
+		for (i = 0; i < nb_points; i++) {
+			if (!zstd_mt_add(frames, nb_frames, &max_frames, points[i].in_offset, points[i].in_size,
+				((i + 1 < nb_points) ? points[i + 1].out_offset : total_size) - points[i].out_offset))
+				break;
+			pos = points[i].in_offset + points[i].in_size;
+		}
+		free(points);
+		return pos;
+	}
+
+	/* Otherwise, the frames must give their uncompressed size */
+	while (pos < file_size) {
+		end = MIN(file_size - pos, sizeof(hdr));
+		if (!zstd_mt_read(hFile, pos, hdr, (DWORD)end) || ZSTD_getFrameHeader(&zfh, hdr, (size_t)end) != 0)
+			break;
+		if (zfh.frameType == ZSTD_skippableFrame) {
+			if (pos + ZSTD_SKIPPABLEHEADERSIZE + zfh.frameContentSize > file_size)
+				break;
+			pos += ZSTD_SKIPPABLEHEADERSIZE + zfh.frameContentSize;
+			continue;
+		}
+		if (zfh.frameContentSize == ZSTD_CONTENTSIZE_UNKNOWN || zfh.frameContentSize > ZSTD_MT_MAX_FRAME)
+			break;
+		/* Each block starts with its type and size, over 3 bytes, and the last one is flagged */
+		for (last = FALSE, end = pos + zfh.headerSize; !last; end += 3 + size) {
+			if (end + 3 > file_size || end - pos > ZSTD_MT_MAX_FRAME || !zstd_mt_read(hFile, end, hdr, 3))
+				break;
+			block = hdr[0] | (hdr[1] << 8) | (hdr[2] << 16);
+			type = (block >> 1) & 3;
+			/* Reserved block type */
+			if (type == 3)
+				break;
+			/* RLE blocks hold a single byte */
+			size = (type == 1) ? 1 : (block >> 3);
+			last = block & 1;
+		}
+		if (!last)
+			break;
+		if (zfh.checksumFlag)
+			end += 4;
+		if (end > file_size || !zstd_mt_add(frames, nb_frames, &max_frames, pos, end - pos, zfh.frameContentSize))
+			break;
+		pos = end;
+	}
+	return pos;
+}
+
+static DWORD WINAPI zstd_mt_worker(LPVOID param)
+{
+	zstd_mt_job_t *job = (zstd_mt_job_t *)param;
+	const zstd_mt_frame_t *frame = job->frame;
+
+	job->read_ok = zstd_mt_read(job->hFile, frame->in_offset, job->in, (DWORD)frame->in_size);
+	if (job->read_ok)
+		job->result = ZSTD_decompressDCtx(job->dctx, job->out, (size_t)frame->out_size,
+			job->in, (size_t)frame->in_size);
+	SetEvent(job->hDone);
+	return 0;
+}
+
+static void zstd_mt_dispatch(zstd_mt_job_t *job, const zstd_mt_frame_t *frame)
+{
+	job->frame = frame;
+	job->busy = TRUE;
+	ResetEvent(job->hDone);
+	if (!QueueUserWorkItem(zstd_mt_worker, job, WT_EXECUTELONGFUNCTION))
+		zstd_mt_worker(job);
+}
+
+/* Write the output of a job, once it is done. Returns -1 on error */
+static int zstd_mt_emit(transformer_state_t *xstate, zstd_mt_job_t *job)
+{
+	size_t i, n, len = (size_t)job->frame->out_size;
+
+	WaitForSingleObject(job->hDone, INFINITE);
+	job->busy = FALSE;
+	if (!job->read_ok) {
+		bb_perror_msg(bb_msg_read_error);
+		return -1;
+	}
+	if (ZSTD_isError(job->result) || job->result != len) {
+#if defined(ZSTD_STRIP_ERROR_STRINGS) && ZSTD_STRIP_ERROR_STRINGS == 1
+		bb_error_msg("zstd decoder error: %u", (unsigned)job->result);
+#else
+		bb_error_msg("zstd decoder error: %s", ZSTD_isError(job->result) ?
+			ZSTD_getErrorName(job->result) : "incorrect length");
+#endif
+		return -1;
+	}
+	if (bled_cancel_request != NULL && *bled_cancel_request != 0)
+		return -1;
+	for (i = 0; i < len; i += n) {
+		n = MIN(len - i, BB_BUFSIZE);
+		if (transformer_write(xstate, &job->out[i], n) != (ssize_t)n) {
+			bb_perror_msg(bb_msg_write_error);
+			return -1;
+		}
+	}
+	bb_total_rb = job->frame->in_offset + job->frame->in_size;
+	if (bled_progress != NULL)
+		bled_progress(bb_total_rb);
+	return 0;
+}
+
+/* Returns -2 if the input can't be decoded in parallel */
+static IF_DESKTOP(long long) int unpack_zstd_stream_mt(transformer_state_t *xstate)
+{
+	IF_DESKTOP(long long) int total = -2, r;
+	HANDLE hFile;
+	LARGE_INTEGER li;
+	zstd_mt_frame_t *frames = NULL;
+	zstd_mt_job_t *jobs = NULL;
+	uint64_t start, end, max_in = 0, max_out = 0;
+	size_t nb_frames = 0, i;
+	unsigned j, nb_threads, nb_jobs = 0;
+
+	/* Only plain files, where reads can happen anywhere */
+	if (bled_read != NULL || xstate->src_fd == bb_virtual_fd || xstate->mem_output_size_max != 0)
+		return -2;
+	hFile = (HANDLE)_get_osfhandle(xstate->src_fd);
+	if (hFile == INVALID_HANDLE_VALUE || GetFileType(hFile) != FILE_TYPE_DISK ||
+		!GetFileSizeEx(hFile, &li) || li.QuadPart < ZSTD_MT_MIN_SIZE)
+		return -2;
+	nb_threads = bb_get_nb_threads();
+	if (nb_threads < 2)
+		return -2;
+	/* the magic may have been read */
+	start = (uint64_t)lseek(xstate->src_fd, 0, SEEK_CUR) - (xstate->signature_skipped ? 4 : 0);
+	if (start > (uint64_t)li.QuadPart)
+		return -2;
+
+	end = zstd_mt_list_frames(xstate->src_fd, hFile, start, li.QuadPart, &frames, &nb_frames);
+	/* Reading the seek table isn't progress */
+	bb_total_rb = 0;
+	for (i = 0; i < nb_frames; i++) {
+		max_in = MAX(max_in, frames[i].in_size);
+		max_out = MAX(max_out, frames[i].out_size);
+	}
+	nb_jobs = MIN(nb_threads, ZSTD_MT_MAX_WORKERS) + 2;
+	nb_jobs = (unsigned)MIN(nb_jobs, ZSTD_MT_MAX_MEMORY / (max_in + max_out + 1));
+	nb_jobs = (unsigned)MIN(nb_jobs, nb_frames);
+	if (nb_frames < 2 || nb_jobs < 2) {
+		nb_jobs = 0;
+		/* Let the sequential decoder start where we were */
+		if ((uint64_t)lseek(xstate->src_fd, start + (xstate->signature_skipped ? 4 : 0), SEEK_SET) !=
+			start + (xstate->signature_skipped ? 4 : 0)) {
+			bb_error_msg("could not seek input");
+			total = -1;
+		}
+		goto out;
+	}
+	total = -1;
+	jobs = calloc(nb_jobs, sizeof(*jobs));
+	if (jobs == NULL) {
+		nb_jobs = 0;
+		goto alloc_error;
+	}
+	for (j = 0; j < nb_jobs; j++) {
+		jobs[j].hFile = hFile;
+		jobs[j].dctx = ZSTD_createDCtx();
+		jobs[j].in = malloc((size_t)MAX(max_in, 1));
+		jobs[j].out = malloc((size_t)MAX(max_out, 1));
+		if (jobs[j].dctx == NULL || jobs[j].in == NULL || jobs[j].out == NULL)
+			goto alloc_error;
+		jobs[j].hDone = CreateEvent(NULL, TRUE, FALSE, NULL);
+		if (jobs[j].hDone == NULL) {
+			bb_error_msg("could not create event");
+			goto out;
+		}
+	}
+
+	/* Keep all the jobs busy, writing the output of the oldest one before reusing it */
+	for (i = 0; i < nb_frames + nb_jobs; i++) {
+		if (i >= nb_jobs && zstd_mt_emit(xstate, &jobs[(i - nb_jobs) % nb_jobs]) < 0)
+			goto out;
+		if (i < nb_frames)
+			zstd_mt_dispatch(&jobs[i % nb_jobs], &frames[i]);
+	}
+	total = 0;
+	for (i = 0; i < nb_frames; i++)
+		total += frames[i].out_size;
+
+	/* Let the sequential decoder take it from there */
+	if (end < (uint64_t)li.QuadPart) {
+		if ((uint64_t)lseek(xstate->src_fd, end, SEEK_SET) != end) {
+			bb_error_msg("could not seek input");
+			total = -1;
+			goto out;
+		}
+		xstate->signature_skipped = 0;
+		r = unpack_zstd_stream_seq(xstate);
+		total = (r < 0) ? -1 : total + r;
+	}
+	goto out;
+
+ alloc_error:
+	bb_error_msg("alloc error");
+ out:
+	/* Don't release any buffer a worker may still be using */
+	for (j = 0; j < nb_jobs; j++) {
+		if (jobs[j].busy)
+			WaitForSingleObject(jobs[j].hDone, INFINITE);
+		if (jobs[j].hDone != NULL)
+			CloseHandle(jobs[j].hDone);
+		ZSTD_freeDCtx(jobs[j].dctx);
+		free(jobs[j].in);
+		free(jobs[j].out);
+	}
+	free(jobs);
+	free(frames);
+	return total;
+}
+
+IF_DESKTOP(long long) int FAST_FUNC
+unpack_zstd_stream(transformer_state_t *xstate)
+{
+	IF_DESKTOP(long long) int total;
+
+	/* Large files on disk, with several frames, are decoded by several threads */
+	total = unpack_zstd_stream_mt(xstate);
+	if (total != -2)
+		return total;
+
+	return unpack_zstd_stream_seq(xstate);
+}
@@ -117,10 +117,17 @@ typedef unsigned int uid_t;
 #define get_le16(ptr) (*(const uint16_t *)(ptr))
 #endif
 
+#if defined(_MSC_VER)
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
 extern uint32_t BB_BUFSIZE;
 extern smallint bb_got_signal;
 extern uint32_t *global_crc32_table;
-extern jmp_buf bb_error_jmp;
+/* Per thread, so that worker threads can bail out on their own */
+extern THREAD_LOCAL jmp_buf bb_error_jmp;
 extern char* bb_virtual_buf;
 extern size_t bb_virtual_len, bb_virtual_pos;
 extern int bb_virtual_fd;
@@ -157,6 +164,7 @@ extern void (*bled_switch) (const char* filename, const uint64_t filesize);
 extern int (*bled_read)(int fd, void* buf, unsigned int count);
 extern int (*bled_write)(int fd, const void* buf, unsigned int count);
 extern unsigned long* bled_cancel_request;
+unsigned int bb_get_nb_threads(void);
 
 #define xfunc_die() longjmp(bb_error_jmp, 1)
 #define bb_printf(...) do { if (bled_printf != NULL) bled_printf(__VA_ARGS__); \
@@ -193,6 +201,8 @@ static inline pid_t wait(int* status) { *status = 4; return -1; }
 
 /* This enables the display of a progress based on the number of bytes read */
 extern uint64_t bb_total_rb;
+/* If set, the reads of the current thread are counted there instead, and not reported */
+extern THREAD_LOCAL uint64_t *bb_thread_rb;
 static inline int full_read(int fd, void *buf, unsigned int count) {
 	int rb;
 
@@ -223,7 +233,9 @@ static inline int full_read(int fd, void *buf, unsigned int count) {
 	} else {
 		rb = (bled_read != NULL) ? bled_read(fd, buf, count) : _read(fd, buf, count);
 	}
-	if (rb > 0) {
+	if (rb > 0 && bb_thread_rb != NULL) {
+		*bb_thread_rb += rb;
+	} else if (rb > 0) {
 		bb_total_rb += rb;
 		if (bled_progress != NULL)
 			bled_progress(bb_total_rb);
@@ -231,6 +243,21 @@ static inline int full_read(int fd, void *buf, unsigned int count) {
 	return rb;
 }
 
+/* Read exactly 'len' bytes at offset 'offset', in as many reads as needed. Returns 0 on error. */
+static inline int full_read_at(int fd, uint64_t offset, void *buf, size_t len) {
+	uint8_t *p = buf;
+	size_t n;
+
+	if ((uint64_t)_lseeki64(fd, (int64_t)offset, SEEK_SET) != offset)
+		return 0;
+	for (; len > 0; p += n, len -= n) {
+		n = MIN(len, BB_BUFSIZE);
+		if (full_read(fd, p, (unsigned int)n) != (int)n)
+			return 0;
+	}
+	return 1;
+}
+
 static inline int full_write(int fd, const void* buffer, unsigned int count)
 {
 	/* None of our r/w buffers should be larger than BB_BUFSIZE */
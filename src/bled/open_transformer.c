@@ -30,6 +30,13 @@ ssize_t FAST_FUNC transformer_write(transformer_state_t *xstate, const void *buf
 	if (xstate->mem_output_size_max != 0) {
 		size_t pos = xstate->mem_output_size;
 		nwrote = bufsize;
+		// Output that precedes the range we are after is dropped
+		if (xstate->mem_output_skip != 0) {
+			size_t skip = (size_t)MIN(xstate->mem_output_skip, (uint64_t)bufsize);
+			xstate->mem_output_skip -= skip;
+			buf = (const char *)buf + skip;
+			bufsize -= skip;
+		}
 		if ((pos + bufsize) > xstate->mem_output_size_max) {
 			bufsize = xstate->mem_output_size_max - pos;
 			// Use ENOSPC as an indicator that our buffer is full
@@ -37,6 +44,19 @@ ssize_t FAST_FUNC transformer_write(transformer_state_t *xstate, const void *buf
 		}
 		memcpy(xstate->mem_output_buf + pos, buf, bufsize);
 		xstate->mem_output_size += bufsize;
+	} else if (xstate->dst_buf != NULL) {
+		// Gather small writes into large ones
+		const char *p = buf;
+		size_t n;
+		for (nwrote = bufsize; bufsize > 0; p += n, bufsize -= n) {
+			if (xstate->dst_buf_len >= BB_BUFSIZE && transformer_flush(xstate) < 0) {
+				nwrote = -1;
+				goto ret;
+			}
+			n = MIN(bufsize, BB_BUFSIZE - xstate->dst_buf_len);
+			memcpy(&xstate->dst_buf[xstate->dst_buf_len], p, n);
+			xstate->dst_buf_len += n;
+		}
 	} else {
 		nwrote = full_write(xstate->dst_fd, buf, (unsigned int)bufsize);
 		if (nwrote != (ssize_t)bufsize) {
@@ -52,6 +72,22 @@ ssize_t FAST_FUNC transformer_write(transformer_state_t *xstate, const void *buf
 	return nwrote;
 }
 
+/* Write what transformer_write() has gathered in dst_buf */
+ssize_t FAST_FUNC transformer_flush(transformer_state_t *xstate)
+{
+	ssize_t nwrote;
+
+	if (xstate->dst_buf == NULL || xstate->dst_buf_len == 0)
+		return 0;
+	nwrote = full_write(xstate->dst_fd, xstate->dst_buf, (unsigned int)xstate->dst_buf_len);
+	if (nwrote != (ssize_t)xstate->dst_buf_len) {
+		bb_perror_msg("write error: %d", (int)nwrote);
+		return -1;
+	}
+	xstate->dst_buf_len = 0;
+	return nwrote;
+}
+
 ssize_t FAST_FUNC xtransformer_write(transformer_state_t *xstate, const void *buf, size_t bufsize)
 {
 	ssize_t nwrote = transformer_write(xstate, buf, bufsize);
@@ -0,0 +1,878 @@
+/*
+ * Rufus: The Reliable USB Formatting Utility
+ * Compressed drive image capture
+ * Copyright © 2024 Pete Batard <pete@akeo.ie>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*
+ * This produces a gzip compressed DD image of a drive (or of an image file)
+ * that can be written back as is. Rather than compressing every sector, the
+ * partition table and the FAT, NTFS and ext allocation bitmaps are parsed so
+ * that the unallocated parts of these file systems are captured as zeroes,
+ * without even being read. The image is then compressed in fixed size blocks,
+ * each of which becomes an independent gzip member, so that blocks can be
+ * compressed in parallel and the result still be decompressed as a regular
+ * gzip stream.
+ */
+
+#ifdef _CRTDBG_MAP_ALLOC
+#include <stdlib.h>
+#include <crtdbg.h>
+#endif
+
+#include <windows.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rufus.h"
+#include "missing.h"
+#include "resource.h"
+#include "vhd.h"
+#include "msapi_utf8.h"
+#include "winio.h"
+#include "localization.h"
+#include "bled/bled.h"
+#include "file.h"
+
+#define CAPTURE_BLOCK_SIZE          (4 * MB)	// Input size of each gzip member
+#define CAPTURE_UNIT_SIZE           (64 * KB)	// Granularity of the allocation map
+#define CAPTURE_MAX_WORKERS         8
+#define CAPTURE_META_CHUNK          (1 * MB)	// How much FAT or bitmap data we read at once
+#define CAPTURE_MAX_PARTITIONS      128
+
+typedef struct {
+	HANDLE hSrc;
+	uint64_t size;
+	DWORD sector_size;
+	uint64_t nb_units;
+	uint8_t* used;			// One bit per CAPTURE_UNIT_SIZE, set when the unit must be captured
+} capture_map;
+
+typedef struct {
+	uint64_t offset;
+	uint64_t size;
+} capture_part;
+
+typedef struct {
+	HANDLE hDone;
+	BOOL busy;
+	uint64_t offset;
+	DWORD size;
+	uint8_t* in;
+	char* out;
+	size_t out_size;
+	int64_t out_len;
+} capture_job;
+
+static __inline uint16_t rd16(const uint8_t* p) { return p[0] | (p[1] << 8); }
+static __inline uint32_t rd32(const uint8_t* p) { return rd16(p) | ((uint32_t)rd16(&p[2]) << 16); }
+static __inline uint64_t rd64(const uint8_t* p) { return rd32(p) | ((uint64_t)rd32(&p[4]) << 32); }
+
+/*
+ * Mark [offset, offset + len) as used, which includes any unit it overlaps,
+ * or as free, which only includes the units it fully covers.
+ */
+static void map_set(capture_map* m, uint64_t offset, uint64_t len, BOOL used)
+{
+	uint64_t i, start, end;
+
+	if (offset >= m->size || len == 0)
+		return;
+	len = min(len, m->size - offset);
+	if (used) {
+		start = offset / CAPTURE_UNIT_SIZE;
+		end = (offset + len + CAPTURE_UNIT_SIZE - 1) / CAPTURE_UNIT_SIZE;
+	} else {
+		start = (offset + CAPTURE_UNIT_SIZE - 1) / CAPTURE_UNIT_SIZE;
+		end = (offset + len) / CAPTURE_UNIT_SIZE;
+	}
+	for (i = start; i < end && i < m->nb_units; i++) {
+		if (used)
+			m->used[i >> 3] |= (uint8_t)(1 << (i & 7));
+		else
+			m->used[i >> 3] &= (uint8_t)~(1 << (i & 7));
+	}
+}
+
+static __inline BOOL map_is_used(capture_map* m, uint64_t unit)
+{
+	return (m->used[unit >> 3] >> (unit & 7)) & 1;
+}
+
+/* Read 'len' bytes at byte offset 'offset', which need not be sector aligned */
+static BOOL read_at(capture_map* m, uint64_t offset, void* buf, size_t len)
+{
+	uint64_t start = offset / m->sector_size;
+	uint64_t nb = (offset + len + m->sector_size - 1) / m->sector_size - start;
+	uint8_t* tmp;
+	BOOL r;
+
+	if (offset + len > m->size)
+		return FALSE;
+	if ((offset % m->sector_size == 0) && (len % m->sector_size == 0))
+		return (read_sectors(m->hSrc, m->sector_size, start, nb, buf) == (int64_t)len);
+	tmp = malloc((size_t)(nb * m->sector_size));
+	if (tmp == NULL)
+		return FALSE;
+	r = (read_sectors(m->hSrc, m->sector_size, start, nb, tmp) == (int64_t)(nb * m->sector_size));
+	if (r)
+		memcpy(buf, &tmp[offset - start * m->sector_size], len);
+	free(tmp);
+	return r;
+}
+
+/*
+ * Mark the clusters flagged in an allocation bitmap as used. 'bits' holds
+ * 'nb_bits' bits, the first of which describes cluster 'first', and cluster
+ * 'n' starts at byte 'base' + 'n' * 'cluster_size'.
+ */
+static void map_set_from_bitmap(capture_map* m, const uint8_t* bits, uint64_t nb_bits,
+	uint64_t first, uint64_t base, uint64_t cluster_size)
+{
+	uint64_t i, run_start = 0;
+	BOOL in_run = FALSE, bit;
+
+	for (i = 0; i < nb_bits; i++) {
+		// Fast path for whole bytes of free or used clusters
+		if ((i & 7) == 0 && i + 8 <= nb_bits && (bits[i >> 3] == 0x00 || bits[i >> 3] == 0xff)) {
+			bit = (bits[i >> 3] != 0);
+			if (bit && !in_run) {
+				run_start = i;
+				in_run = TRUE;
+			} else if (!bit && in_run) {
+				map_set(m, base + (first + run_start) * cluster_size, (i - run_start) * cluster_size, TRUE);
+				in_run = FALSE;
+			}
+			i += 7;
+			continue;
+		}
+		bit = (bits[i >> 3] >> (i & 7)) & 1;
+		if (bit && !in_run) {
+			run_start = i;
+			in_run = TRUE;
+		} else if (!bit && in_run) {
+			map_set(m, base + (first + run_start) * cluster_size, (i - run_start) * cluster_size, TRUE);
+			in_run = FALSE;
+		}
+	}
+	if (in_run)
+		map_set(m, base + (first + run_start) * cluster_size, (nb_bits - run_start) * cluster_size, TRUE);
+}
+
+/* FAT12/16/32: the clusters that have a non zero FAT entry are in use */
+static BOOL map_fat(capture_map* m, capture_part* p, const uint8_t* bs)
+{
+	uint32_t bps = rd16(&bs[11]), spc = bs[13], reserved = rd16(&bs[14]), nb_fats = bs[16];
+	uint32_t root_entries = rd16(&bs[17]), fat_size, root_secs, entry_size;
+	uint64_t total, data_start, nb_clusters, c, i, n, cluster_size, fat_bytes, chunk;
+	uint8_t* fat = NULL, * bits = NULL;
+	BOOL r = FALSE;
+
+	if ((bs[0] != 0xeb && bs[0] != 0xe9) || (bps != 512 && bps != 1024 && bps != 2048 && bps != 4096) ||
+		spc == 0 || (spc & (spc - 1)) != 0 || reserved == 0 || nb_fats == 0 || nb_fats > 2)
+		return FALSE;
+	fat_size = (rd16(&bs[22]) != 0) ? rd16(&bs[22]) : rd32(&bs[36]);
+	total = (rd16(&bs[19]) != 0) ? rd16(&bs[19]) : rd32(&bs[32]);
+	root_secs = (root_entries * 32 + bps - 1) / bps;
+	data_start = (uint64_t)reserved + (uint64_t)nb_fats * fat_size + root_secs;
+	if (fat_size == 0 || total <= data_start || total * bps > p->size)
+		return FALSE;
+	nb_clusters = (total - data_start) / spc;
+	cluster_size = (uint64_t)spc * bps;
+	entry_size = (nb_clusters < 4085) ? 12 : ((nb_clusters < 65525) ? 16 : 32);
+	uprintf("  FAT%d file system, %lld clusters of %s", entry_size, nb_clusters,
+		SizeToHumanReadable(cluster_size, FALSE, FALSE));
+
+	// Boot sectors, FATs and root directory
+	map_set(m, p->offset, data_start * bps, TRUE);
+
+	// Convert the FAT into a bitmap of used clusters, which we then process as a whole
+	bits = calloc((size_t)((nb_clusters + 2 + 7) / 8), 1);
+	fat_bytes = ((nb_clusters + 2) * entry_size + 7) / 8;
+	fat_bytes = min(fat_bytes, (uint64_t)fat_size * bps);
+	// FAT12 entries straddle bytes, so read that FAT (which is never larger than 6 KB) at once
+	chunk = (entry_size == 12) ? fat_bytes : CAPTURE_META_CHUNK;
+	fat = malloc((size_t)chunk);
+	if (bits == NULL || fat == NULL)
+		goto out;
+	for (c = 0, i = 0; i < fat_bytes; i += chunk) {
+		n = min(chunk, fat_bytes - i);
+		if (!read_at(m, p->offset + (uint64_t)reserved * bps + i, fat, (size_t)n))
+			goto out;
+		switch (entry_size) {
+		case 12:
+			for (; c < nb_clusters + 2 && (c * 3) / 2 + 1 < n; c++) {
+				uint16_t e = rd16(&fat[(c * 3) / 2]);
+				if (((c & 1) ? (e >> 4) : (e & 0xfff)) != 0)
+					bits[c >> 3] |= (uint8_t)(1 << (c & 7));
+			}
+			break;
+		case 16:
+			for (; c < nb_clusters + 2 && c * 2 < i + n; c++)
+				if (rd16(&fat[c * 2 - i]) != 0)
+					bits[c >> 3] |= (uint8_t)(1 << (c & 7));
+			break;
+		default:
+			for (; c < nb_clusters + 2 && c * 4 < i + n; c++)
+				if ((rd32(&fat[c * 4 - i]) & 0x0fffffff) != 0)
+					bits[c >> 3] |= (uint8_t)(1 << (c & 7));
+			break;
+		}
+	}
+	// Entries 0 and 1 are reserved, and cluster 2 starts at the data area
+	bits[0] &= 0xfc;
+	map_set_from_bitmap(m, &bits[0], nb_clusters + 2, 0, p->offset + data_start * bps - 2 * cluster_size, cluster_size);
+	r = TRUE;
+
+out:
+	free(fat);
+	free(bits);
+	return r;
+}
+
+/* NTFS: use the $Bitmap metafile, which is MFT record 6 */
+static BOOL map_ntfs(capture_map* m, capture_part* p, const uint8_t* bs)
+{
+	uint32_t bps = rd16(&bs[11]), spc = bs[13], rec_size, i, usa_ofs, usa_count, ofs, len;
+	uint64_t cluster_size, nb_clusters, bitmap_size, mft_offset, lcn = 0, run_len, done, n;
+	uint8_t *rec = NULL, *attr, *run, *bits = NULL, hdr;
+	int64_t delta;
+	int8_t cpr = (int8_t)bs[64];
+	BOOL r = FALSE;
+
+	if (memcmp(&bs[3], "NTFS    ", 8) != 0 || bps < 512 || bps > 4096 || spc == 0)
+		return FALSE;
+	// Cluster sizes of 128 KB and above are encoded as a negative power of two
+	if (spc > 0x80)
+		spc = 1 << (256 - spc);
+	cluster_size = (uint64_t)spc * bps;
+	nb_clusters = rd64(&bs[40]) / spc;
+	rec_size = (cpr < 0) ? (1 << -cpr) : (uint32_t)(cpr * cluster_size);
+	if (rec_size < 1024 || rec_size > 64 * KB || nb_clusters * cluster_size > p->size)
+		return FALSE;
+	uprintf("  NTFS file system, %lld clusters of %s", nb_clusters, SizeToHumanReadable(cluster_size, FALSE, FALSE));
+
+	rec = malloc(rec_size);
+	if (rec == NULL)
+		return FALSE;
+	mft_offset = p->offset + rd64(&bs[48]) * cluster_size;
+	if (!read_at(m, mft_offset + 6 * (uint64_t)rec_size, rec, rec_size) || memcmp(rec, "FILE", 4) != 0)
+		goto out;
+	// Apply the update sequence fixups, which NTFS uses in 512 byte strides
+	usa_ofs = rd16(&rec[4]);
+	usa_count = rd16(&rec[6]);
+	if (usa_count == 0 || usa_ofs + 2 * usa_count > rec_size || (usa_count - 1) * 512 > rec_size)
+		goto out;
+	for (i = 1; i < usa_count; i++) {
+		if (rd16(&rec[i * 512 - 2]) != rd16(&rec[usa_ofs]))
+			goto out;
+		rec[i * 512 - 2] = rec[usa_ofs + 2 * i];
+		rec[i * 512 - 1] = rec[usa_ofs + 2 * i + 1];
+	}
+
+	// Look for the unnamed $DATA attribute
+	for (ofs = rd16(&rec[20]); ofs + 16 <= rec_size; ofs += len) {
+		attr = &rec[ofs];
+		len = rd32(&attr[4]);
+		if (rd32(attr) == 0xffffffff || len < 16 || ofs + len > rec_size)
+			goto out;
+		if (rd32(attr) == 0x80 && attr[9] == 0)
+			break;
+	}
+	if (ofs + 16 > rec_size)
+		goto out;
+	bitmap_size = (nb_clusters + 7) / 8;
+	bits = malloc((size_t)((bitmap_size + cluster_size - 1) / cluster_size * cluster_size));
+	if (bits == NULL)
+		goto out;
+
+	if (attr[8] == 0) {
+		// Resident bitmap (only possible for very small volumes)
+		if (rd32(&attr[16]) < bitmap_size || rd16(&attr[20]) + bitmap_size > len)
+			goto out;
+		memcpy(bits, &attr[rd16(&attr[20])], (size_t)bitmap_size);
+	} else {
+		// Non resident bitmap: decode the run list
+		run = &attr[rd16(&attr[32])];
+		for (done = 0; done < bitmap_size && run < &attr[len] && *run != 0; ) {
+			hdr = *run++;
+			if ((hdr & 0x0f) == 0 || (hdr & 0x0f) > 8 || (hdr >> 4) > 8 || run + (hdr & 0x0f) + (hdr >> 4) > &attr[len])
+				goto out;
+			for (run_len = 0, i = 0; i < (uint32_t)(hdr & 0x0f); i++)
+				run_len |= (uint64_t)*run++ << (8 * i);
+			if ((hdr >> 4) == 0)
+				goto out;	// $Bitmap is never sparse
+			for (delta = 0, i = 0; i < (uint32_t)(hdr >> 4); i++)
+				delta |= (int64_t)*run++ << (8 * i);
+			// Sign extend the LCN delta
+			if ((hdr >> 4) < 8 && (run[-1] & 0x80))
+				delta |= -1LL << (8 * (hdr >> 4));
+			lcn += delta;
+			n = min(run_len * cluster_size, bitmap_size - done);
+			n = (n + cluster_size - 1) / cluster_size * cluster_size;
+			if (!read_at(m, p->offset + lcn * cluster_size, &bits[done], (size_t)n))
+				goto out;
+			done += n;
+		}
+		if (done < bitmap_size)
+			goto out;
+	}
+
+	map_set_from_bitmap(m, bits, nb_clusters, 0, p->offset, cluster_size);
+	// The backup boot sector lies right after the last cluster
+	map_set(m, p->offset, cluster_size, TRUE);
+	map_set(m, p->offset + rd64(&bs[40]) * bps, bps, TRUE);
+	r = TRUE;
+
+out:
+	free(bits);
+	free(rec);
+	return r;
+}
+
+static BOOL ext_group_has_super(uint32_t group, BOOL sparse)
+{
+	uint32_t n;
+
+	if (!sparse || group <= 1)
+		return TRUE;
+	for (n = 3; n <= group; n *= 3)
+		if (n == group)
+			return TRUE;
+	for (n = 5; n <= group; n *= 5)
+		if (n == group)
+			return TRUE;
+	for (n = 7; n <= group; n *= 7)
+		if (n == group)
+			return TRUE;
+	return FALSE;
+}
+
+/* ext2/3/4: use the block bitmap of each group, except for the uninitialized ones */
+static BOOL map_ext(capture_map* m, capture_part* p)
+{
+	uint8_t sb[1024], *gdt = NULL, *bits = NULL, *d;
+	uint32_t incompat, ro_compat, block_size, bpg, ipg, inode_size, desc_size, first, nb_groups, g;
+	uint64_t nb_blocks, start, nb, gdt_blocks, it_blocks, bb, ib, it;
+	BOOL is_64bit, has_uninit, r = FALSE;
+
+	if (!read_at(m, p->offset + 1024, sb, sizeof(sb)) || rd16(&sb[56]) != 0xef53)
+		return FALSE;
+	incompat = rd32(&sb[96]);
+	ro_compat = rd32(&sb[100]);
+	// META_BG and SPARSE_SUPER2 move metadata around in ways we don't bother with
+	if ((incompat & 0x10) || (rd32(&sb[92]) & 0x200) || rd32(&sb[24]) > 6) {
+		uprintf("  Unsupported ext feature set - capturing the whole partition");
+		return FALSE;
+	}
+	is_64bit = (incompat & 0x80) != 0;
+	has_uninit = (ro_compat & (0x10 | 0x400)) != 0;
+	block_size = 1024 << rd32(&sb[24]);
+	first = rd32(&sb[20]);
+	bpg = rd32(&sb[32]);
+	ipg = rd32(&sb[40]);
+	inode_size = (rd32(&sb[76]) == 0) ? 128 : rd16(&sb[88]);
+	desc_size = (is_64bit && rd16(&sb[254]) >= 64) ? rd16(&sb[254]) : 32;
+	nb_blocks = rd32(&sb[4]) | (is_64bit ? ((uint64_t)rd32(&sb[336]) << 32) : 0);
+	if (bpg == 0 || bpg > 8 * block_size || nb_blocks <= first || nb_blocks * block_size > p->size)
+		return FALSE;
+	nb_groups = (uint32_t)((nb_blocks - first + bpg - 1) / bpg);
+	gdt_blocks = ((uint64_t)nb_groups * desc_size + block_size - 1) / block_size;
+	it_blocks = ((uint64_t)ipg * inode_size + block_size - 1) / block_size;
+	uprintf("  ext file system, %lld blocks of %s in %d groups", nb_blocks,
+		SizeToHumanReadable(block_size, FALSE, FALSE), nb_groups);
+
+	gdt = malloc((size_t)(gdt_blocks * block_size));
+	bits = malloc(block_size);
+	if (gdt == NULL || bits == NULL)
+		goto out;
+	if (!read_at(m, p->offset + ((uint64_t)first + 1) * block_size, gdt, (size_t)(gdt_blocks * block_size)))
+		goto out;
+
+	// Boot block and primary superblock
+	map_set(m, p->offset, 2048, TRUE);
+	for (g = 0; g < nb_groups; g++) {
+		d = &gdt[(size_t)g * desc_size];
+		start = first + (uint64_t)g * bpg;
+		nb = min(bpg, nb_blocks - start);
+		bb = rd32(&d[0]) | (is_64bit ? ((uint64_t)rd32(&d[0x20]) << 32) : 0);
+		ib = rd32(&d[4]) | (is_64bit ? ((uint64_t)rd32(&d[0x24]) << 32) : 0);
+		it = rd32(&d[8]) | (is_64bit ? ((uint64_t)rd32(&d[0x28]) << 32) : 0);
+		if (bb >= nb_blocks || ib >= nb_blocks || it + it_blocks > nb_blocks)
+			goto out;
+		if (ext_group_has_super(g, ro_compat & 0x1))
+			map_set(m, p->offset + start * block_size, (1 + gdt_blocks + rd16(&sb[206])) * block_size, TRUE);
+		map_set(m, p->offset + bb * block_size, block_size, TRUE);
+		map_set(m, p->offset + ib * block_size, block_size, TRUE);
+		map_set(m, p->offset + it * block_size, it_blocks * block_size, TRUE);
+		// BLOCK_UNINIT groups only contain the metadata we just marked
+		if (has_uninit && (rd16(&d[18]) & 0x2))
+			continue;
+		if (!read_at(m, p->offset + bb * block_size, bits, block_size))
+			goto out;
+		map_set_from_bitmap(m, bits, nb, start, p->offset, block_size);
+	}
+	r = TRUE;
+
+out:
+	free(bits);
+	free(gdt);
+	return r;
+}
+
+/* Clear the map for the part of a partition that its file system reports as free */
+static void map_partition(capture_map* m, capture_part* p)
+{
+	uint8_t* bs = malloc(max(m->sector_size, 512));
+
+	if (bs == NULL || !read_at(m, p->offset, bs, max(m->sector_size, 512)))
+		goto out;
+	map_set(m, p->offset, p->size, FALSE);
+	if (map_ntfs(m, p, bs) || map_fat(m, p, bs) || map_ext(m, p))
+		goto out;
+	// Unknown or unsupported file system: capture it all
+	map_set(m, p->offset, p->size, TRUE);
+out:
+	free(bs);
+}
+
+static void add_partition(capture_map* m, capture_part* parts, int* nb_parts, uint64_t start, uint64_t size)
+{
+	if (*nb_parts >= CAPTURE_MAX_PARTITIONS || start >= m->size || size == 0)
+		return;
+	parts[*nb_parts].offset = start;
+	parts[*nb_parts].size = min(size, m->size - start);
+	uprintf("Partition %d: %s at offset 0x%llx", *nb_parts + 1,
+		SizeToHumanReadable(parts[*nb_parts].size, FALSE, FALSE), start);
+	(*nb_parts)++;
+}
+
+/* Parse an MBR (with its extended partitions) or a GPT */
+static int get_partitions(capture_map* m, capture_part* parts)
+{
+	uint32_t ss = m->sector_size, i, nb_entries, entry_size, loops;
+	uint8_t *buf = malloc(max(ss, 512)), *entries = NULL, *e;
+	uint64_t ebr_base, ebr;
+	int nb_parts = 0;
+	static const uint8_t zero_guid[16] = { 0 };
+
+	if (buf == NULL || !read_at(m, 0, buf, max(ss, 512)) || buf[510] != 0x55 || buf[511] != 0xaa)
+		goto out;
+	// A file system boot record also has a 0x55AA marker, but no partition table
+	if (memcmp(&buf[3], "NTFS    ", 8) == 0 || memcmp(&buf[0x36], "FAT", 3) == 0 ||
+		memcmp(&buf[0x52], "FAT32", 5) == 0)
+		goto out;
+	for (i = 0; i < 4; i++)
+		if (buf[446 + 16 * i] != 0x00 && buf[446 + 16 * i] != 0x80)
+			goto out;
+
+	// Protective MBR
+	if (buf[446 + 4] == 0xee) {
+		if (!read_at(m, ss, buf, 512) || memcmp(buf, "EFI PART", 8) != 0)
+			goto out;
+		nb_entries = rd32(&buf[80]);
+		entry_size = rd32(&buf[84]);
+		if (nb_entries > 1024 || entry_size < 128 || entry_size > 1024)
+			goto out;
+		entries = malloc((size_t)nb_entries * entry_size);
+		if (entries == NULL || !read_at(m, rd64(&buf[72]) * ss, entries, (size_t)nb_entries * entry_size))
+			goto out;
+		for (i = 0; i < nb_entries; i++) {
+			e = &entries[(size_t)i * entry_size];
+			if (memcmp(e, zero_guid, 16) != 0 && rd64(&e[40]) >= rd64(&e[32]))
+				add_partition(m, parts, &nb_parts, rd64(&e[32]) * ss, (rd64(&e[40]) - rd64(&e[32]) + 1) * ss);
+		}
+		goto out;
+	}
+
+	memcpy(&buf[0], &buf[446], 64);
+	for (i = 0; i < 4; i++) {
+		e = &buf[16 * i];
+		if (e[4] == 0x00)
+			continue;
+		if (e[4] != 0x05 && e[4] != 0x0f && e[4] != 0x85) {
+			add_partition(m, parts, &nb_parts, (uint64_t)rd32(&e[8]) * ss, (uint64_t)rd32(&e[12]) * ss);
+			continue;
+		}
+		// Walk the chain of extended boot records
+		entries = malloc(max(ss, 512));
+		if (entries == NULL)
+			goto out;
+		ebr_base = rd32(&e[8]);
+		for (ebr = ebr_base, loops = 0; ebr != 0 && loops < CAPTURE_MAX_PARTITIONS; loops++) {
+			if (!read_at(m, ebr * ss, entries, max(ss, 512)) || entries[510] != 0x55 || entries[511] != 0xaa)
+				break;
+			if (entries[446 + 4] != 0x00)
+				add_partition(m, parts, &nb_parts, (ebr + rd32(&entries[446 + 8])) * ss,
+					(uint64_t)rd32(&entries[446 + 12]) * ss);
+			ebr = (entries[462 + 4] != 0x00 && rd32(&entries[462 + 8]) != 0) ? ebr_base + rd32(&entries[462 + 8]) : 0;
+		}
+		safe_free(entries);
+	}
+
+out:
+	free(entries);
+	free(buf);
+	return nb_parts;
+}
+
+static DWORD WINAPI capture_worker(LPVOID param)
+{
+	capture_job* job = (capture_job*)param;
+
+	job->out_len = bled_compress_buffer_to_gzip((char*)job->in, job->size, job->out, job->out_size);
+	SetEvent(job->hDone);
+	return 0;
+}
+
+/* Wait for a job to complete and append its gzip member to the image */
+static BOOL flush_job(capture_job* job, HANDLE hDst, const char* zero_member, int64_t zero_len)
+{
+	const char* buf;
+	DWORD len;
+
+	// out_len is only valid once the worker is done with this slot
+	WaitForSingleObject(job->hDone, INFINITE);
+	job->busy = FALSE;
+	buf = (job->out_len == -2) ? zero_member : job->out;
+	len = (DWORD)((job->out_len == -2) ? zero_len : job->out_len);
+	if (job->out_len == -1) {
+		uprintf("Could not compress block at offset 0x%llx", job->offset);
+		ErrorStatus = RUFUS_ERROR(ERROR_NOT_ENOUGH_MEMORY);
+		return FALSE;
+	}
+	if (!WriteFileWithRetry(hDst, buf, len, NULL, WRITE_RETRIES)) {
+		ErrorStatus = RUFUS_ERROR(ERROR_WRITE_FAULT);
+		return FALSE;
+	}
+	return TRUE;
+}
+
+/// <summary>
+/// Capture a drive or an image file to a gzip compressed DD image, skipping
+/// the space that FAT, NTFS or ext file systems report as unallocated.
+/// </summary>
+/// <param name="src">The path of the physical drive or image file to capture.</param>
+/// <param name="dst">The path of the .img.gz image to create.</param>
+/// <param name="sector_size">The sector size of the source.</param>
+/// <returns>TRUE on success, FALSE on error.</returns>
+BOOL CaptureImage(const char* src, const char* dst, DWORD sector_size)
+{
+	BOOL r = FALSE;
+	HANDLE hDst = INVALID_HANDLE_VALUE;
+	GET_LENGTH_INFORMATION li;
+	LARGE_INTEGER file_size;
+	SYSTEM_INFO si;
+	capture_map m = { INVALID_HANDLE_VALUE, 0, 0, 0, NULL };
+	capture_part* parts = NULL;
+	capture_job jobs[2 * CAPTURE_MAX_WORKERS] = { 0 };
+	char* zero_member = NULL, str[32];
+	int64_t zero_len = 0;
+	uint64_t i, u, unit, nb_blocks, used_size = 0, start, len;
+	uint32_t nb_jobs = 0, j;
+	int p, nb_parts;
+	DWORD size, t0 = GetTickCount();
+
+	if_not_assert(src != NULL && dst != NULL && sector_size != 0)
+		return FALSE;
+
+	m.sector_size = sector_size;
+	m.hSrc = CreateFileU(src, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING,
+		FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (m.hSrc == INVALID_HANDLE_VALUE) {
+		uprintf("Could not open '%s': %s", src, WindowsErrorString());
+		ErrorStatus = RUFUS_ERROR(ERROR_OPEN_FAILED);
+		goto out;
+	}
+	if (DeviceIoControl(m.hSrc, IOCTL_DISK_GET_LENGTH_INFO, NULL, 0, &li, sizeof(li), &size, NULL))
+		m.size = li.Length.QuadPart;
+	else if (GetFileSizeEx(m.hSrc, &file_size))
+		m.size = file_size.QuadPart;
+	if (m.size == 0) {
+		uprintf("Could not get the size of '%s'", src);
+		ErrorStatus = RUFUS_ERROR(ERROR_READ_FAULT);
+		goto out;
+	}
+	hDst = CreateFileU(dst, GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hDst == INVALID_HANDLE_VALUE) {
+		uprintf("Could not create '%s': %s", dst, WindowsErrorString());
+		ErrorStatus = RUFUS_ERROR(ERROR_OPEN_FAILED);
+		goto out;
+	}
+
+	// Build the allocation map: everything is used, except what a file system says isn't
+	m.nb_units = (m.size + CAPTURE_UNIT_SIZE - 1) / CAPTURE_UNIT_SIZE;
+	m.used = malloc((size_t)((m.nb_units + 7) / 8));
+	parts = calloc(CAPTURE_MAX_PARTITIONS, sizeof(capture_part));
+	if (m.used == NULL || parts == NULL) {
+		ErrorStatus = RUFUS_ERROR(ERROR_NOT_ENOUGH_MEMORY);
+		goto out;
+	}
+	memset(m.used, 0xff, (size_t)((m.nb_units + 7) / 8));
+	nb_parts = get_partitions(&m, parts);
+	if (nb_parts == 0) {
+		// No partition table: try the whole source as a single file system
+		parts[0].offset = 0;
+		parts[0].size = m.size;
+		nb_parts = 1;
+	}
+	for (p = 0; p < nb_parts; p++) {
+		map_partition(&m, &parts[p]);
+		CHECK_FOR_USER_CANCEL;
+	}
+	for (u = 0; u < m.nb_units; u++)
+		if (map_is_used(&m, u))
+			used_size += min(CAPTURE_UNIT_SIZE, m.size - u * CAPTURE_UNIT_SIZE);
+	static_strcpy(str, SizeToHumanReadable(m.size, FALSE, FALSE));
+	uprintf("Capturing %s of data, out of %s", SizeToHumanReadable(used_size, FALSE, FALSE), str);
+
+	// Blocks that are entirely unallocated all compress to the same member
+	zero_member = malloc(BLED_GZIP_BOUND(CAPTURE_BLOCK_SIZE));
+	jobs[0].in = calloc(1, CAPTURE_BLOCK_SIZE);
+	if (zero_member == NULL || jobs[0].in == NULL) {
+		ErrorStatus = RUFUS_ERROR(ERROR_NOT_ENOUGH_MEMORY);
+		goto out;
+	}
+	zero_len = bled_compress_buffer_to_gzip((char*)jobs[0].in, CAPTURE_BLOCK_SIZE,
+		zero_member, BLED_GZIP_BOUND(CAPTURE_BLOCK_SIZE));
+
+	GetSystemInfo(&si);
+	nb_jobs = 2 * min(max(si.dwNumberOfProcessors, 1), CAPTURE_MAX_WORKERS);
+	for (j = 0; j < nb_jobs; j++) {
+		jobs[j].out_size = BLED_GZIP_BOUND(CAPTURE_BLOCK_SIZE);
+		jobs[j].out = malloc(jobs[j].out_size);
+		if (jobs[j].in == NULL)
+			jobs[j].in = malloc(CAPTURE_BLOCK_SIZE);
+		jobs[j].hDone = CreateEvent(NULL, TRUE, FALSE, NULL);
+		if (jobs[j].in == NULL || jobs[j].out == NULL || jobs[j].hDone == NULL) {
+			ErrorStatus = RUFUS_ERROR(ERROR_NOT_ENOUGH_MEMORY);
+			goto out;
+		}
+	}
+
+	// Jobs are recycled in order, so that the members are written in order
+	nb_blocks = (m.size + CAPTURE_BLOCK_SIZE - 1) / CAPTURE_BLOCK_SIZE;
+	for (i = 0; i < nb_blocks + nb_jobs; i++) {
+		capture_job* job = &jobs[i % nb_jobs];
+		if (job->busy) {
+			if (!flush_job(job, hDst, zero_member, zero_len))
+				goto out;
+			UpdateProgressWithInfo(OP_FORMAT, MSG_261, job->offset + job->size, m.size);
+		}
+		if (i >= nb_blocks)
+			continue;
+		CHECK_FOR_USER_CANCEL;
+
+		job->offset = i * CAPTURE_BLOCK_SIZE;
+		job->size = (DWORD)min(CAPTURE_BLOCK_SIZE, m.size - job->offset);
+		job->busy = TRUE;
+		ResetEvent(job->hDone);
+		// Read the runs of used units, and zero the rest
+		for (unit = job->offset / CAPTURE_UNIT_SIZE, start = 0; start < job->size; unit++, start += len) {
+			len = min(CAPTURE_UNIT_SIZE, job->size - start);
+			if (!map_is_used(&m, unit)) {
+				memset(&job->in[start], 0, (size_t)len);
+				continue;
+			}
+			for (; start + len < job->size && map_is_used(&m, unit + 1); unit++)
+				len += min(CAPTURE_UNIT_SIZE, job->size - start - len);
+			if (!read_at(&m, job->offset + start, &job->in[start], (size_t)len)) {
+				uprintf("Could not read data at offset 0x%llx", job->offset + start);
+				job->busy = FALSE;
+				ErrorStatus = RUFUS_ERROR(ERROR_READ_FAULT);
+				goto out;
+			}
+		}
+		if (job->size == CAPTURE_BLOCK_SIZE && zero_len > 0 && IsBufferZero(job->in, job->size)) {
+			job->out_len = -2;
+			SetEvent(job->hDone);
+		} else if (!QueueUserWorkItem(capture_worker, job, WT_EXECUTELONGFUNCTION)) {
+			capture_worker(job);
+		}
+	}
+	r = TRUE;
+	uprintf("Saved '%s' in %d.%d seconds", dst, (GetTickCount() - t0) / 1000, ((GetTickCount() - t0) % 1000) / 100);
+
+out:
+	// Don't release any buffer a worker may still be using
+	for (j = 0; j < nb_jobs; j++) {
+		if (jobs[j].busy)
+			WaitForSingleObject(jobs[j].hDone, INFINITE);
+		safe_closehandle(jobs[j].hDone);
+		free(jobs[j].in);
+		free(jobs[j].out);
+	}
+	if (nb_jobs == 0)
+		free(jobs[0].in);
+	free(zero_member);
+	free(parts);
+	free(m.used);
+	safe_closehandle(m.hSrc);
+	safe_closehandle(hDst);
+	if (!r)
+		DeleteFileU(dst);
+	return r;
+}
+
+#if defined(RUFUS_TEST)
+/* Which 64 KB units of the test image hold allocated clusters */
+static BOOL test_unit_used(uint64_t unit, uint64_t nb_meta_units)
+{
+	uint64_t units_per_block = CAPTURE_BLOCK_SIZE / CAPTURE_UNIT_SIZE;
+
+	if (unit < nb_meta_units)
+		return TRUE;
+	// Alternate used, empty and partially used blocks, so that the jobs get
+	// recycled between blocks that are compressed and blocks that are all zeroes
+	switch ((unit / units_per_block) % 4) {
+	case 0:
+		return TRUE;
+	case 3:
+		return ((unit % units_per_block) < 4);
+	default:
+		return FALSE;
+	}
+}
+
+/*
+ * Capture a mostly empty FAT32 superfloppy image, with garbage in its free
+ * clusters, and check that decompressing the result gives back the allocated
+ * data, with zeroes in place of the free clusters.
+ */
+BOOL CaptureImageTest(const char* path, uint64_t size)
+{
+	const uint32_t bps = 512, reserved = 32;
+	BOOL r = FALSE;
+	char gz_path[MAX_PATH], out_path[MAX_PATH];
+	HANDLE hImg = INVALID_HANDLE_VALUE, hOut = INVALID_HANDLE_VALUE;
+	uint8_t *buf = NULL, *out = NULL;
+	uint32_t fat_size, val;
+	uint64_t total, data_start, nb_clusters, nb_meta_units, offset, o, e, u;
+	int64_t out_size;
+	DWORD k, len, rlen;
+
+	static_sprintf(gz_path, "%s.gz", path);
+	static_sprintf(out_path, "%s.out", path);
+	// One sector per cluster, so that FAT32 can be used from 64 MB onwards
+	size -= size % CAPTURE_UNIT_SIZE;
+	if (size < 64 * MB) {
+		uprintf("Test image size must be at least 64 MB");
+		return FALSE;
+	}
+	total = size / bps;
+	fat_size = (uint32_t)(((total - reserved + 2) * 4 + bps - 1) / bps);
+	data_start = reserved + 2 * (uint64_t)fat_size;
+	nb_clusters = total - data_start;
+	nb_meta_units = (data_start * bps + CAPTURE_UNIT_SIZE - 1) / CAPTURE_UNIT_SIZE;
+
+	buf = malloc(CAPTURE_BLOCK_SIZE);
+	out = malloc(CAPTURE_BLOCK_SIZE);
+	hImg = CreateFileU(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS,
+		FILE_ATTRIBUTE_NORMAL, NULL);
+	if (buf == NULL || out == NULL || hImg == INVALID_HANDLE_VALUE) {
+		uprintf("Could not create '%s': %s", path, WindowsErrorString());
+		goto out;
+	}
+	for (offset = 0; offset < size; offset += len) {
+		len = (DWORD)min(CAPTURE_BLOCK_SIZE, size - offset);
+		for (k = 0; k < len; k += 4) {
+			o = offset + k;
+			if (o >= (uint64_t)reserved * bps && o < data_start * bps) {
+				// Both FATs, where a cluster is allocated if its unit is used
+				e = ((o - (uint64_t)reserved * bps) % ((uint64_t)fat_size * bps)) / 4;
+				if (e < 2)
+					val = (e == 0) ? 0x0ffffff8 : 0x0fffffff;
+				else if (e < nb_clusters + 2 && test_unit_used((data_start * bps + (e - 2) * bps) / CAPTURE_UNIT_SIZE, nb_meta_units))
+					val = 0x0fffffff;
+				else
+					val = 0;
+			} else if (test_unit_used(o / CAPTURE_UNIT_SIZE, nb_meta_units)) {
+				val = (uint32_t)(o >> 2) * 0x9e3779b1;
+			} else {
+				val = 0xa5a5a5a5;
+			}
+			*(uint32_t*)&buf[k] = val;
+		}
+		if (offset == 0) {
+			memset(buf, 0, bps);
+			memcpy(buf, "\xeb\x58\x90MSWIN4.1", 11);
+			*(uint16_t*)&buf[11] = (uint16_t)bps;
+			buf[13] = 1;
+			*(uint16_t*)&buf[14] = (uint16_t)reserved;
+			buf[16] = 2;
+			buf[21] = 0xf8;
+			*(uint32_t*)&buf[32] = (uint32_t)total;
+			*(uint32_t*)&buf[36] = fat_size;
+			*(uint32_t*)&buf[44] = 2;
+			memcpy(&buf[0x52], "FAT32   ", 8);
+			buf[510] = 0x55;
+			buf[511] = 0xaa;
+		}
+		if (!WriteFileWithRetry(hImg, buf, len, NULL, WRITE_RETRIES)) {
+			uprintf("Could not write '%s': %s", path, WindowsErrorString());
+			goto out;
+		}
+	}
+	safe_closehandle(hImg);
+
+	if (!CaptureImage(path, gz_path, bps))
+		goto out;
+	bled_init(0, uprintf, NULL, NULL, NULL, NULL, &ErrorStatus);
+	out_size = bled_uncompress(gz_path, out_path, BLED_COMPRESSION_GZIP);
+	bled_exit();
+	if (out_size != (int64_t)size) {
+		uprintf("Decompressed image is %lld bytes instead of %lld", out_size, size);
+		goto out;
+	}
+
+	hImg = CreateFileU(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	hOut = CreateFileU(out_path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (hImg == INVALID_HANDLE_VALUE || hOut == INVALID_HANDLE_VALUE) {
+		uprintf("Could not open test images: %s", WindowsErrorString());
+		goto out;
+	}
+	for (offset = 0; offset < size; offset += len) {
+		len = (DWORD)min(CAPTURE_BLOCK_SIZE, size - offset);
+		if (!ReadFile(hImg, buf, len, &rlen, NULL) || rlen != len ||
+			!ReadFile(hOut, out, len, &rlen, NULL) || rlen != len) {
+			uprintf("Could not read test images: %s", WindowsErrorString());
+			goto out;
+		}
+		for (k = 0; k < len; k += CAPTURE_UNIT_SIZE) {
+			u = (offset + k) / CAPTURE_UNIT_SIZE;
+			if (test_unit_used(u, nb_meta_units) ? (memcmp(&buf[k], &out[k], CAPTURE_UNIT_SIZE) != 0) :
+				!IsBufferZero(&out[k], CAPTURE_UNIT_SIZE)) {
+				uprintf("Mismatch in %s unit at offset 0x%llx", test_unit_used(u, nb_meta_units) ?
+					"used" : "free", offset + k);
+				goto out;
+			}
+		}
+	}
+	uprintf("Captured image matches the allocated data of '%s'", path);
+	r = TRUE;
+
+out:
+	free(buf);
+	free(out);
+	safe_closehandle(hImg);
+	safe_closehandle(hOut);
+	DeleteFileU(path);
+	DeleteFileU(gz_path);
+	DeleteFileU(out_path);
+	return r;
+}
+#endif
@@ -2570,6 +2570,25 @@ BOOL RefreshDriveLayout(HANDLE hDrive)
 	return r;
 }
 
+/*
+ * Discard (TRIM/UNMAP) the whole content of a drive. Note that this is only
+ * a hint to the device, and that we can't assume that it reads back as zero.
+ */
+BOOL DiscardDrive(HANDLE hDrive)
+{
+	BOOL r;
+	DWORD size;
+	DEVICE_MANAGE_DATA_SET_ATTRIBUTES dsm = { 0 };
+
+	dsm.Size = sizeof(dsm);
+	dsm.Action = DeviceDsmAction_Trim;
+	dsm.Flags = DEVICE_DSM_FLAG_ENTIRE_DATA_SET_RANGE;
+	r = DeviceIoControl(hDrive, IOCTL_STORAGE_MANAGE_DATA_SET_ATTRIBUTES, &dsm, sizeof(dsm), NULL, 0, &size, NULL);
+	if (!r)
+		uprintf("Could not discard drive content: %s", WindowsErrorString());
+	return r;
+}
+
 /* Initialize disk for partitioning */
 BOOL InitializeDisk(HANDLE hDrive)
 {
@@ -32,6 +32,10 @@
 #define IOCTL_MOUNTMGR_SET_AUTO_MOUNT       \
 	CTL_CODE(MOUNTMGRCONTROLTYPE, 16, METHOD_BUFFERED, FILE_READ_ACCESS | FILE_WRITE_ACCESS)
 
+#ifndef DEVICE_DSM_FLAG_ENTIRE_DATA_SET_RANGE
+#define DEVICE_DSM_FLAG_ENTIRE_DATA_SET_RANGE   0x00000001
+#endif
+
 #define XP_MSR                              0x01
 #define XP_ESP                              0x02
 #define XP_UEFI_NTFS                        0x04
@@ -412,6 +416,7 @@ char* AltMountVolume(DWORD DriveIndex, uint64_t PartitionOffset, BOOL bSilent);
 BOOL RemountVolume(char* drive_name, BOOL bSilent);
 BOOL CreatePartition(HANDLE hDrive, int partition_style, int file_system, BOOL mbr_uefi_marker, uint8_t extra_partitions);
 BOOL InitializeDisk(HANDLE hDrive);
+BOOL DiscardDrive(HANDLE hDrive);
 BOOL RefreshDriveLayout(HANDLE hDrive);
 const char* GetMBRPartitionType(const uint8_t type);
 const char* GetGPTPartitionType(const GUID* guid);
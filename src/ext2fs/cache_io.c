@@ -0,0 +1,717 @@
+/*
+ * cache_io.c --- This is a caching layer for another I/O manager.
+ *
+ * Implements an N-block write-back cache, that sits on top of the
+ * actual I/O manager (e.g. nt_io). Dirty blocks are only written
+ * when they get evicted or when the channel is flushed, at which
+ * stage adjacent blocks are coalesced into large writes. Blocks are
+ * looked up through a hash table, and evicted in LRU order.
+ *
+ * Based on undo_io.c, Copyright (C) 1993, 1994, 1995 Theodore Ts'o.
+ *
+ * %Begin-Header%
+ * This file may be redistributed under the terms of the GNU Library
+ * General Public License, version 2.
+ * %End-Header%
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+
+#include "config.h"
+#include "ext2fs.h"
+
+#define EXT2_ET_MAGIC_CACHE_IO_CHANNEL	0x10ee
+
+#define CACHE_DEFAULT_SIZE	64		/* Number of cached blocks */
+#define CACHE_MAX_SIZE		65536
+#define CACHE_MAX_WRITE		(1024 * 1024)	/* Largest coalesced write */
+
+struct cache_entry {
+	unsigned long long	block;
+	struct cache_entry	*hash_next;
+	struct cache_entry	*prev, *next;	/* LRU list, most recently used first */
+	unsigned		dirty:1;
+	unsigned		in_use:1;
+	char			*buf;
+};
+
+struct cache_private_data {
+	int			magic;
+	io_channel		real;
+	int			cache_size;
+	unsigned int		hash_mask;
+	struct cache_entry	*cache;
+	struct cache_entry	**hash;
+	struct cache_entry	*mru, *lru;
+	struct cache_entry	**sorted;
+	char			*write_buf;
+	struct struct_io_stats	io_stats;
+};
+
+static io_manager backing_manager = NULL;
+struct cache_io_backing_stats cache_io_backing_stats = { 0 };
+
+static errcode_t cache_open(const char *name, int flags, io_channel *channel);
+static errcode_t cache_close(io_channel channel);
+static errcode_t cache_set_blksize(io_channel channel, int blksize);
+static errcode_t cache_read_blk(io_channel channel, unsigned long block, int count, void *data);
+static errcode_t cache_read_blk64(io_channel channel, unsigned long long block, int count, void *data);
+static errcode_t cache_write_blk(io_channel channel, unsigned long block, int count, const void *data);
+static errcode_t cache_write_blk64(io_channel channel, unsigned long long block, int count, const void *data);
+static errcode_t cache_flush(io_channel channel);
+static errcode_t cache_write_byte(io_channel channel, unsigned long offset, int size, const void *data);
+static errcode_t cache_set_option(io_channel channel, const char *option, const char *arg);
+static errcode_t cache_get_stats(io_channel channel, io_stats *stats);
+static errcode_t cache_discard(io_channel channel, unsigned long long block, unsigned long long count);
+static errcode_t cache_readahead(io_channel channel, unsigned long long block, unsigned long long count);
+static errcode_t cache_zeroout(io_channel channel, unsigned long long block, unsigned long long count);
+
+static struct struct_io_manager struct_cache_manager = {
+	.magic		= EXT2_ET_MAGIC_IO_MANAGER,
+	.name		= "Caching I/O Manager",
+	.open		= cache_open,
+	.close		= cache_close,
+	.set_blksize	= cache_set_blksize,
+	.read_blk	= cache_read_blk,
+	.write_blk	= cache_write_blk,
+	.flush		= cache_flush,
+	.write_byte	= cache_write_byte,
+	.set_option	= cache_set_option,
+	.get_stats	= cache_get_stats,
+	.read_blk64	= cache_read_blk64,
+	.write_blk64	= cache_write_blk64,
+	.discard	= cache_discard,
+	.cache_readahead = cache_readahead,
+	.zeroout	= cache_zeroout
+};
+
+io_manager cache_io_manager = &struct_cache_manager;
+
+errcode_t set_cache_io_backing_manager(io_manager manager)
+{
+	backing_manager = manager;
+	return 0;
+}
+
+/*
+ * Cache management
+ */
+static void free_cache(struct cache_private_data *data)
+{
+	int i;
+
+	if (data->cache != NULL) {
+		for (i = 0; i < data->cache_size; i++)
+			free(data->cache[i].buf);
+	}
+	free(data->cache);
+	data->cache = NULL;
+	free(data->hash);
+	data->hash = NULL;
+	free(data->sorted);
+	data->sorted = NULL;
+	free(data->write_buf);
+	data->write_buf = NULL;
+}
+
+static errcode_t alloc_cache(struct cache_private_data *data, int block_size)
+{
+	int i;
+
+	/* Use a power of two number of hash buckets, of at least the number of blocks */
+	for (data->hash_mask = 1; (int)data->hash_mask < data->cache_size; data->hash_mask <<= 1);
+	data->cache = calloc(data->cache_size, sizeof(struct cache_entry));
+	data->hash = calloc(data->hash_mask, sizeof(struct cache_entry *));
+	data->hash_mask--;
+	data->sorted = calloc(data->cache_size, sizeof(struct cache_entry *));
+	data->write_buf = malloc(CACHE_MAX_WRITE > block_size ? CACHE_MAX_WRITE : block_size);
+	if (data->cache == NULL || data->hash == NULL || data->sorted == NULL || data->write_buf == NULL)
+		goto nomem;
+	for (i = 0; i < data->cache_size; i++) {
+		data->cache[i].buf = malloc(block_size);
+		if (data->cache[i].buf == NULL)
+			goto nomem;
+		data->cache[i].prev = (i > 0) ? &data->cache[i - 1] : NULL;
+		data->cache[i].next = (i < data->cache_size - 1) ? &data->cache[i + 1] : NULL;
+	}
+	data->mru = &data->cache[0];
+	data->lru = &data->cache[data->cache_size - 1];
+	return 0;
+
+nomem:
+	free_cache(data);
+	return EXT2_ET_NO_MEMORY;
+}
+
+static struct cache_entry *find_cached_block(struct cache_private_data *data,
+					     unsigned long long block)
+{
+	struct cache_entry *entry;
+
+	for (entry = data->hash[block & data->hash_mask]; entry != NULL; entry = entry->hash_next) {
+		if (entry->block == block)
+			return entry;
+	}
+	return NULL;
+}
+
+/* Move an entry to the front (most recently used) or the back of the LRU list */
+static void move_entry(struct cache_private_data *data, struct cache_entry *entry, int front)
+{
+	if (front ? (data->mru == entry) : (data->lru == entry))
+		return;
+	if (entry->prev != NULL)
+		entry->prev->next = entry->next;
+	else
+		data->mru = entry->next;
+	if (entry->next != NULL)
+		entry->next->prev = entry->prev;
+	else
+		data->lru = entry->prev;
+	if (front) {
+		entry->prev = NULL;
+		entry->next = data->mru;
+		data->mru->prev = entry;
+		data->mru = entry;
+	} else {
+		entry->next = NULL;
+		entry->prev = data->lru;
+		data->lru->next = entry;
+		data->lru = entry;
+	}
+}
+
+/* Make an entry hold a block, and mark it as the most recently used */
+static void claim_entry(struct cache_private_data *data, struct cache_entry *entry,
+			unsigned long long block)
+{
+	entry->block = block;
+	entry->in_use = 1;
+	entry->dirty = 0;
+	entry->hash_next = data->hash[block & data->hash_mask];
+	data->hash[block & data->hash_mask] = entry;
+	move_entry(data, entry, 1);
+}
+
+/* Drop the block an entry holds, and make the entry the first one to be reused */
+static void release_entry(struct cache_private_data *data, struct cache_entry *entry)
+{
+	struct cache_entry **p;
+
+	if (!entry->in_use)
+		return;
+	for (p = &data->hash[entry->block & data->hash_mask]; *p != NULL; p = &(*p)->hash_next) {
+		if (*p == entry) {
+			*p = entry->hash_next;
+			break;
+		}
+	}
+	entry->hash_next = NULL;
+	entry->in_use = 0;
+	entry->dirty = 0;
+	move_entry(data, entry, 0);
+}
+
+/*
+ * Accesses to the backing I/O manager, which are accounted for in
+ * cache_io_backing_stats, so that the effect of the cache can be measured.
+ */
+static errcode_t backing_read(struct cache_private_data *data, unsigned long long block,
+			      int count, void *buf)
+{
+	cache_io_backing_stats.reads++;
+	cache_io_backing_stats.bytes_read += (count < 0) ? -count :
+		(unsigned long long)count * data->real->block_size;
+	return io_channel_read_blk64(data->real, block, count, buf);
+}
+
+static errcode_t backing_write(struct cache_private_data *data, unsigned long long block,
+			       int count, const void *buf)
+{
+	cache_io_backing_stats.writes++;
+	cache_io_backing_stats.bytes_written += (count < 0) ? -count :
+		(unsigned long long)count * data->real->block_size;
+	return io_channel_write_blk64(data->real, block, count, buf);
+}
+
+static int cache_entry_cmp(const void *a, const void *b)
+{
+	unsigned long long block_a = (*(struct cache_entry * const *)a)->block;
+	unsigned long long block_b = (*(struct cache_entry * const *)b)->block;
+
+	return (block_a < block_b) ? -1 : ((block_a > block_b) ? 1 : 0);
+}
+
+/*
+ * Write all the dirty blocks, in ascending order, coalescing the
+ * ones that are adjacent into a single write.
+ */
+static errcode_t flush_cached_blocks(io_channel channel)
+{
+	struct cache_private_data *data = (struct cache_private_data *) channel->private_data;
+	int i, j, k, n = 0, max_run = CACHE_MAX_WRITE / channel->block_size;
+	errcode_t retval;
+
+	for (i = 0; i < data->cache_size; i++) {
+		if (data->cache[i].in_use && data->cache[i].dirty)
+			data->sorted[n++] = &data->cache[i];
+	}
+	if (n == 0)
+		return 0;
+	qsort(data->sorted, n, sizeof(struct cache_entry *), cache_entry_cmp);
+
+	for (i = 0; i < n; i = j) {
+		for (j = i + 1; j < n && j - i < max_run &&
+		     data->sorted[j]->block == data->sorted[i]->block + (j - i); j++);
+		if (j - i == 1) {
+			retval = backing_write(data, data->sorted[i]->block,
+							1, data->sorted[i]->buf);
+		} else {
+			for (k = i; k < j; k++)
+				memcpy(&data->write_buf[(k - i) * channel->block_size],
+				       data->sorted[k]->buf, channel->block_size);
+			retval = backing_write(data, data->sorted[i]->block,
+							j - i, data->write_buf);
+		}
+		if (retval)
+			return retval;
+		data->io_stats.bytes_written += (unsigned long long)(j - i) * channel->block_size;
+		for (k = i; k < j; k++)
+			data->sorted[k]->dirty = 0;
+	}
+	return 0;
+}
+
+/* Drop the cached blocks in the range, after they have been superseded */
+static void invalidate_cached_blocks(struct cache_private_data *data,
+				     unsigned long long block, unsigned long long count)
+{
+	struct cache_entry *entry;
+	int i;
+
+	if (count <= (unsigned long long)data->cache_size) {
+		for (; count > 0; block++, count--) {
+			entry = find_cached_block(data, block);
+			if (entry != NULL)
+				release_entry(data, entry);
+		}
+		return;
+	}
+	for (i = 0; i < data->cache_size; i++) {
+		if (data->cache[i].in_use && data->cache[i].block >= block &&
+		    data->cache[i].block < block + count)
+			release_entry(data, &data->cache[i]);
+	}
+}
+
+/* Get an entry for a new block, evicting the least recently used if needed */
+static errcode_t get_free_entry(io_channel channel, struct cache_entry **entry)
+{
+	struct cache_private_data *data = (struct cache_private_data *) channel->private_data;
+	struct cache_entry *lru = data->lru;
+	errcode_t retval;
+
+	/* Released entries are moved to the back, so they get reused first */
+	if (lru->in_use) {
+		/* Evicting a dirty block is a good time to write all the others too */
+		if (lru->dirty) {
+			retval = flush_cached_blocks(channel);
+			if (retval)
+				return retval;
+		}
+		release_entry(data, lru);
+	}
+	*entry = lru;
+	return 0;
+}
+
+/* Add freshly read blocks to the cache */
+static errcode_t add_cached_blocks(io_channel channel, unsigned long long block,
+				   int count, const char *buf)
+{
+	struct cache_private_data *data = (struct cache_private_data *) channel->private_data;
+	struct cache_entry *entry;
+	errcode_t retval;
+	int i;
+
+	for (i = 0; i < count; i++) {
+		retval = get_free_entry(channel, &entry);
+		if (retval)
+			return retval;
+		memcpy(entry->buf, &buf[i * channel->block_size], channel->block_size);
+		claim_entry(data, entry, block + i);
+	}
+	return 0;
+}
+
+/*
+ * I/O manager functions
+ */
+static errcode_t cache_open(const char *name, int flags, io_channel *channel)
+{
+	io_channel io = NULL;
+	struct cache_private_data *data = NULL;
+	errcode_t retval;
+
+	if (name == NULL)
+		return EXT2_ET_BAD_DEVICE_NAME;
+	if (backing_manager == NULL)
+		return EXT2_ET_INVALID_ARGUMENT;
+
+	retval = ext2fs_get_memzero(sizeof(struct struct_io_channel), &io);
+	if (retval)
+		goto cleanup;
+	retval = ext2fs_get_mem(strlen(name) + 1, &io->name);
+	if (retval)
+		goto cleanup;
+	strcpy(io->name, name);
+	retval = ext2fs_get_memzero(sizeof(struct cache_private_data), &data);
+	if (retval)
+		goto cleanup;
+	data->magic = EXT2_ET_MAGIC_CACHE_IO_CHANNEL;
+	data->cache_size = CACHE_DEFAULT_SIZE;
+	data->io_stats.num_fields = 2;
+
+	retval = backing_manager->open(name, flags, &data->real);
+	if (retval)
+		goto cleanup;
+
+	io->magic = EXT2_ET_MAGIC_IO_CHANNEL;
+	io->manager = cache_io_manager;
+	io->block_size = data->real->block_size;
+	io->flags = data->real->flags;
+	io->align = data->real->align;
+	io->refcount = 1;
+	io->private_data = data;
+
+	retval = alloc_cache(data, io->block_size);
+	if (retval)
+		goto cleanup;
+
+	*channel = io;
+	return 0;
+
+cleanup:
+	if (data != NULL) {
+		if (data->real != NULL)
+			io_channel_close(data->real);
+		ext2fs_free_mem(&data);
+	}
+	if (io != NULL) {
+		if (io->name != NULL)
+			ext2fs_free_mem(&io->name);
+		ext2fs_free_mem(&io);
+	}
+	return retval;
+}
+
+static errcode_t cache_close(io_channel channel)
+{
+	struct cache_private_data *data;
+	errcode_t retval = 0;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct cache_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_CACHE_IO_CHANNEL);
+
+	if (--channel->refcount > 0)
+		return 0;
+
+	retval = flush_cached_blocks(channel);
+	if (data->real != NULL)
+		io_channel_close(data->real);
+	free_cache(data);
+	ext2fs_free_mem(&channel->private_data);
+	if (channel->name != NULL)
+		ext2fs_free_mem(&channel->name);
+	ext2fs_free_mem(&channel);
+	return retval;
+}
+
+static errcode_t cache_set_blksize(io_channel channel, int blksize)
+{
+	struct cache_private_data *data;
+	errcode_t retval;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct cache_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_CACHE_IO_CHANNEL);
+
+	if (channel->block_size == blksize)
+		return 0;
+
+	retval = flush_cached_blocks(channel);
+	if (retval)
+		return retval;
+	retval = io_channel_set_blksize(data->real, blksize);
+	if (retval)
+		return retval;
+	channel->block_size = data->real->block_size;
+	free_cache(data);
+	return alloc_cache(data, channel->block_size);
+}
+
+static errcode_t cache_read_blk64(io_channel channel, unsigned long long block, int count, void *buf)
+{
+	struct cache_private_data *data;
+	struct cache_entry *entry;
+	char *cp = (char *) buf;
+	errcode_t retval;
+	int i;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct cache_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_CACHE_IO_CHANNEL);
+
+	/* Byte sized reads bypass the cache, once it has been written back */
+	if (count < 0) {
+		retval = flush_cached_blocks(channel);
+		if (retval)
+			return retval;
+		data->io_stats.bytes_read += -count;
+		return backing_read(data, block, count, buf);
+	}
+
+	while (count > 0) {
+		entry = find_cached_block(data, block);
+		if (entry != NULL) {
+			move_entry(data, entry, 1);
+			memcpy(cp, entry->buf, channel->block_size);
+			block++;
+			count--;
+			cp += channel->block_size;
+			continue;
+		}
+		/* Read the run of uncached blocks in one go */
+		for (i = 1; i < count && find_cached_block(data, block + i) == NULL; i++);
+		retval = backing_read(data, block, i, cp);
+		if (retval)
+			return retval;
+		data->io_stats.bytes_read += (unsigned long long)i * channel->block_size;
+		/* Don't let large sequential reads thrash the cache */
+		if (i <= data->cache_size / 4) {
+			retval = add_cached_blocks(channel, block, i, cp);
+			if (retval)
+				return retval;
+		}
+		block += i;
+		count -= i;
+		cp += i * channel->block_size;
+	}
+	return 0;
+}
+
+static errcode_t cache_read_blk(io_channel channel, unsigned long block, int count, void *buf)
+{
+	return cache_read_blk64(channel, block, count, buf);
+}
+
+static errcode_t cache_write_blk64(io_channel channel, unsigned long long block, int count, const void *buf)
+{
+	struct cache_private_data *data;
+	struct cache_entry *entry;
+	const char *cp = (const char *) buf;
+	errcode_t retval;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct cache_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_CACHE_IO_CHANNEL);
+
+	if (count < 0) {
+		retval = flush_cached_blocks(channel);
+		if (retval)
+			return retval;
+		invalidate_cached_blocks(data, block,
+			(-count + channel->block_size - 1) / channel->block_size);
+		data->io_stats.bytes_written += -count;
+		return backing_write(data, block, count, buf);
+	}
+
+	/* Large writes go straight through, superseding any cached data */
+	if (count > data->cache_size / 2) {
+		invalidate_cached_blocks(data, block, count);
+		data->io_stats.bytes_written += (unsigned long long)count * channel->block_size;
+		return backing_write(data, block, count, buf);
+	}
+
+	while (count > 0) {
+		entry = find_cached_block(data, block);
+		if (entry == NULL) {
+			retval = get_free_entry(channel, &entry);
+			if (retval)
+				return retval;
+			claim_entry(data, entry, block);
+		} else {
+			move_entry(data, entry, 1);
+		}
+		memcpy(entry->buf, cp, channel->block_size);
+		entry->dirty = 1;
+		block++;
+		count--;
+		cp += channel->block_size;
+	}
+	return 0;
+}
+
+static errcode_t cache_write_blk(io_channel channel, unsigned long block, int count, const void *buf)
+{
+	return cache_write_blk64(channel, block, count, buf);
+}
+
+static errcode_t cache_flush(io_channel channel)
+{
+	struct cache_private_data *data;
+	errcode_t retval;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct cache_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_CACHE_IO_CHANNEL);
+
+	retval = flush_cached_blocks(channel);
+	if (retval)
+		return retval;
+	return io_channel_flush(data->real);
+}
+
+static errcode_t cache_write_byte(io_channel channel, unsigned long offset, int size, const void *buf)
+{
+	struct cache_private_data *data;
+	errcode_t retval;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct cache_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_CACHE_IO_CHANNEL);
+
+	if (data->real->manager->write_byte == NULL)
+		return EXT2_ET_UNIMPLEMENTED;
+	retval = flush_cached_blocks(channel);
+	if (retval)
+		return retval;
+	invalidate_cached_blocks(data, offset / channel->block_size,
+		(offset % channel->block_size + size + channel->block_size - 1) / channel->block_size);
+	data->io_stats.bytes_written += size;
+	cache_io_backing_stats.writes++;
+	cache_io_backing_stats.bytes_written += size;
+	return io_channel_write_byte(data->real, offset, size, buf);
+}
+
+/*
+ * "cache_blocks=<n>" sets the number of cached blocks. Other options
+ * are passed on to the backing I/O manager.
+ */
+static errcode_t cache_set_option(io_channel channel, const char *option, const char *arg)
+{
+	struct cache_private_data *data;
+	errcode_t retval;
+	char *end;
+	long n;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct cache_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_CACHE_IO_CHANNEL);
+
+	if (strcmp(option, "cache_blocks") == 0) {
+		if (arg == NULL)
+			return EXT2_ET_INVALID_ARGUMENT;
+		n = strtol(arg, &end, 0);
+		if (*end != 0 || n < 1 || n > CACHE_MAX_SIZE)
+			return EXT2_ET_INVALID_ARGUMENT;
+		retval = flush_cached_blocks(channel);
+		if (retval)
+			return retval;
+		free_cache(data);
+		data->cache_size = (int) n;
+		return alloc_cache(data, channel->block_size);
+	}
+
+	if (data->real->manager->set_option == NULL)
+		return EXT2_ET_INVALID_ARGUMENT;
+	return data->real->manager->set_option(data->real, option, arg);
+}
+
+static errcode_t cache_get_stats(io_channel channel, io_stats *stats)
+{
+	struct cache_private_data *data;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct cache_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_CACHE_IO_CHANNEL);
+
+	if (stats)
+		*stats = &data->io_stats;
+	return 0;
+}
+
+static errcode_t cache_discard(io_channel channel, unsigned long long block, unsigned long long count)
+{
+	struct cache_private_data *data;
+	errcode_t retval;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct cache_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_CACHE_IO_CHANNEL);
+
+	retval = io_channel_discard(data->real, block, count);
+	if (retval == 0)
+		invalidate_cached_blocks(data, block, count);
+	return retval;
+}
+
+static errcode_t cache_zeroout(io_channel channel, unsigned long long block, unsigned long long count)
+{
+	struct cache_private_data *data;
+	errcode_t retval;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct cache_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_CACHE_IO_CHANNEL);
+
+	cache_io_backing_stats.zeroouts++;
+	retval = io_channel_zeroout(data->real, block, count);
+	if (retval == 0)
+		invalidate_cached_blocks(data, block, count);
+	return retval;
+}
+
+static errcode_t cache_readahead(io_channel channel, unsigned long long block, unsigned long long count)
+{
+	struct cache_private_data *data;
+	errcode_t retval;
+	int i, max_run;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct cache_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_CACHE_IO_CHANNEL);
+
+	/* Only read ahead what the cache can hold without thrashing */
+	if (count > (unsigned long long)data->cache_size / 2)
+		count = data->cache_size / 2;
+	max_run = CACHE_MAX_WRITE / channel->block_size;
+
+	while (count > 0) {
+		if (find_cached_block(data, block) != NULL) {
+			block++;
+			count--;
+			continue;
+		}
+		for (i = 1; i < (int)count && i < max_run &&
+		     find_cached_block(data, block + i) == NULL; i++);
+		/* Write back first, as write_buf is also the flush buffer */
+		retval = flush_cached_blocks(channel);
+		if (retval)
+			return retval;
+		retval = backing_read(data, block, i, data->write_buf);
+		if (retval)
+			return retval;
+		data->io_stats.bytes_read += (unsigned long long)i * channel->block_size;
+		retval = add_cached_blocks(channel, block, i, data->write_buf);
+		if (retval)
+			return retval;
+		block += i;
+		count -= i;
+	}
+	return 0;
+}
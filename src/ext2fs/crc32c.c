@@ -42,6 +42,10 @@
 #include "crc32c_defs.h"
 
 #include "ext2fs.h"
+
+/* Rufus: Use the CRC engine from bled */
+extern uint32_t bled_crc32c(uint32_t crc, const void* buf, size_t len);
+
 #ifdef WORDS_BIGENDIAN
 #define __constant_cpu_to_le32(x) ___constant_swab32((x))
 #define __constant_cpu_to_be32(x) (x)
@@ -187,7 +191,8 @@ static inline uint32_t crc32_le_generic(uint32_t crc, unsigned char const *p,
 
 uint32_t ext2fs_crc32c_le(uint32_t crc, unsigned char const *p, size_t len)
 {
-	return crc32_le_generic(crc, p, len, crc32ctable_le, CRC32C_POLY_LE);
+	/* Rufus: Use bled's CRC engine, which can use the SSE4.2 crc32 instruction */
+	return bled_crc32c(crc, p, len);
 }
 
 /**
@@ -152,6 +152,18 @@ extern io_manager undo_io_manager;
 extern errcode_t set_undo_io_backing_manager(io_manager manager);
 extern errcode_t set_undo_io_backup_file(char *file_name);
 
+/* cache_io.c */
+struct cache_io_backing_stats {
+	unsigned long long	reads;
+	unsigned long long	writes;
+	unsigned long long	zeroouts;
+	unsigned long long	bytes_read;
+	unsigned long long	bytes_written;
+};
+extern io_manager cache_io_manager;
+extern struct cache_io_backing_stats cache_io_backing_stats;
+extern errcode_t set_cache_io_backing_manager(io_manager manager);
+
 /* test_io.c */
 extern io_manager test_io_manager, test_io_backing_manager;
 extern void (*test_io_cb_read_blk)
@@ -0,0 +1,322 @@
+/*
+ * ext_bench.c --- Time ext formatting against a sparse file image.
+ *
+ * Runs the same sequence of ext2fs calls as FormatExtFs() from Rufus'
+ * format_ext.c, with cache_io on top of unix_io rather than nt_io, and
+ * reports the time and the I/O that reached the image for each format.
+ * This is a host tool, meant to be built on Linux, and it is not part
+ * of the Windows build.
+ *
+ * Copyright (C) 2024 Pete Batard <pete@akeo.ie>
+ *
+ * %Begin-Header%
+ * This file may be redistributed under the terms of the GNU Library
+ * General Public License, version 2.
+ * %End-Header%
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <stdio.h>
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include "config.h"
+#include "ext2fs.h"
+
+#define KB			1024ULL
+#define MB			(1024ULL * KB)
+#define GB			(1024ULL * MB)
+#define TB			(1024ULL * GB)
+
+typedef struct {
+	uint64_t max_size;
+	uint32_t block_size;
+	uint32_t inode_size;
+	uint32_t inode_ratio;
+} ext2fs_default_t;
+
+/* Called by the library, and provided by Rufus and bled in the Windows build */
+void uprintf(const char *format, ...)
+{
+	va_list args;
+
+	va_start(args, format);
+	vprintf(format, args);
+	va_end(args);
+	putchar('\n');
+}
+
+uint32_t bled_crc32c(uint32_t crc, const void *buf, size_t len)
+{
+	const uint8_t *p = (const uint8_t *)buf;
+	int i;
+
+	while (len--) {
+		crc ^= *p++;
+		for (i = 0; i < 8; i++)
+			crc = (crc >> 1) ^ (0x82f63b78 & (0 - (crc & 1)));
+	}
+	return crc;
+}
+
+const char *error_message(errcode_t error_code)
+{
+	static char msg[32];
+
+	snprintf(msg, sizeof(msg), "error %ld", (long)error_code);
+	return msg;
+}
+
+errcode_t ext2fs_print_progress(int64_t cur_value, int64_t max_value)
+{
+	return 0;
+}
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void random_bytes(uint8_t *buf, size_t len)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++)
+		buf[i] = (uint8_t)rand();
+}
+
+/* Mirrors FormatExtFs(), bar the progress reporting and the persistence file */
+static errcode_t format_ext(const char *path, const char *fs_name, int quick, const char *options)
+{
+	const float reserve_ratio = 0.05f;
+	const ext2fs_default_t ext2fs_default[5] = {
+		{ 3 * MB, 1024, 128, 3},
+		{ 512 * MB, 1024, 128, 2},
+		{ 4 * GB, 4096, 256, 2},
+		{ 16 * GB, 4096, 256, 3},
+		{ 1024 * TB, 4096, 256, 4}
+	};
+	int i, count, run_count = 0, lazy_itable_init = quick;
+	struct ext2_super_block features = { 0 };
+	blk_t journal_size;
+	blk64_t size = 0, cur, run_start = 0;
+	ext2_filsys ext2fs = NULL;
+	errcode_t r;
+	uint8_t *buf;
+	uint32_t block_size;
+
+	r = ext2fs_get_device_size2(path, KB, &size);
+	if (r != 0)
+		return r;
+	size *= KB;
+	for (i = 0; i < 4; i++) {
+		if (size < ext2fs_default[i].max_size)
+			break;
+	}
+	block_size = ext2fs_default[i].block_size;
+	for (features.s_log_block_size = 0; EXT2_BLOCK_SIZE(&features) != block_size; features.s_log_block_size++);
+	features.s_log_cluster_size = features.s_log_block_size;
+	size /= block_size;
+
+	ext2fs_blocks_count_set(&features, size);
+	ext2fs_r_blocks_count_set(&features, (blk64_t)(reserve_ratio * size));
+	features.s_rev_level = 1;
+	features.s_inode_size = ext2fs_default[i].inode_size;
+	features.s_inodes_count = ((ext2fs_blocks_count(&features) >> ext2fs_default[i].inode_ratio) > UINT32_MAX) ?
+		UINT32_MAX : (uint32_t)(ext2fs_blocks_count(&features) >> ext2fs_default[i].inode_ratio);
+
+	ext2fs_set_feature_dir_index(&features);
+	ext2fs_set_feature_filetype(&features);
+	ext2fs_set_feature_large_file(&features);
+	ext2fs_set_feature_sparse_super(&features);
+	ext2fs_set_feature_xattr(&features);
+	if (fs_name[3] != '2')
+		ext2fs_set_feature_journal(&features);
+	if (fs_name[3] == '4') {
+		ext2fs_set_feature_extents(&features);
+		ext2fs_set_feature_flex_bg(&features);
+		features.s_log_groups_per_flex = 4;
+		ext2fs_set_feature_huge_file(&features);
+		ext2fs_set_feature_dir_nlink(&features);
+		ext2fs_set_feature_64bit(&features);
+		ext2fs_set_feature_metadata_csum(&features);
+		if (features.s_inode_size >= sizeof(struct ext2_inode_large))
+			ext2fs_set_feature_extra_isize(&features);
+	}
+	features.s_default_mount_opts = EXT2_DEFM_XATTR_USER | EXT2_DEFM_ACL;
+
+	set_cache_io_backing_manager(unix_io_manager);
+	r = ext2fs_initialize(path, EXT2_FLAG_EXCLUSIVE | EXT2_FLAG_64BITS, &features, cache_io_manager, &ext2fs);
+	if (r != 0)
+		return r;
+	if (options != NULL) {
+		r = io_channel_set_options(ext2fs->io, options);
+		if (r != 0)
+			goto out;
+	}
+
+	buf = calloc(16, ext2fs->io->block_size);
+	if (buf == NULL) {
+		r = EXT2_ET_NO_MEMORY;
+		goto out;
+	}
+	r = io_channel_write_blk64(ext2fs->io, 0, 16, buf);
+	free(buf);
+	if (r != 0)
+		goto out;
+
+	random_bytes(ext2fs->super->s_uuid, sizeof(ext2fs->super->s_uuid));
+	if (ext2fs_has_feature_metadata_csum(ext2fs->super))
+		ext2fs->super->s_checksum_type = EXT2_CRC32C_CHKSUM;
+	ext2fs_init_csum_seed(ext2fs);
+	ext2fs->super->s_def_hash_version = EXT2_HASH_HALF_MD4;
+	random_bytes((uint8_t *)ext2fs->super->s_hash_seed, sizeof(ext2fs->super->s_hash_seed));
+	ext2fs->super->s_max_mnt_count = -1;
+	ext2fs->super->s_creator_os = EXT2_OS_WINDOWS;
+	ext2fs->super->s_errors = EXT2_ERRORS_CONTINUE;
+	strcpy((char *)ext2fs->super->s_volume_name, "rufus_test");
+
+	r = ext2fs_allocate_tables(ext2fs);
+	if (r != 0)
+		goto out;
+	r = ext2fs_convert_subcluster_bitmap(ext2fs, &ext2fs->block_map);
+	if (r != 0)
+		goto out;
+
+	lazy_itable_init = lazy_itable_init && ext2fs_has_group_desc_csum(ext2fs);
+	for (i = 0; i <= (int)ext2fs->group_desc_count; i++) {
+		if (i < (int)ext2fs->group_desc_count) {
+			cur = ext2fs_inode_table_loc(ext2fs, i);
+			if (lazy_itable_init) {
+				count = ext2fs_div_ceil((ext2fs->super->s_inodes_per_group - ext2fs_bg_itable_unused(ext2fs, i))
+					* EXT2_INODE_SIZE(ext2fs->super), EXT2_BLOCK_SIZE(ext2fs->super));
+			} else {
+				count = ext2fs->inode_blocks_per_group;
+				if (ext2fs_has_group_desc_csum(ext2fs)) {
+					ext2fs_bg_flags_set(ext2fs, i, EXT2_BG_INODE_ZEROED);
+					ext2fs_group_desc_csum_set(ext2fs, i);
+				}
+			}
+			if ((count == 0) || ((run_count != 0) && (cur == run_start + run_count) &&
+				(run_count <= INT_MAX / 2 - count))) {
+				run_count += count;
+				continue;
+			}
+		}
+		if (run_count != 0) {
+			r = ext2fs_zero_blocks2(ext2fs, run_start, run_count, &run_start, &run_count);
+			if (r != 0)
+				goto out;
+		}
+		run_start = cur;
+		run_count = count;
+	}
+
+	r = ext2fs_mkdir(ext2fs, EXT2_ROOT_INO, EXT2_ROOT_INO, 0);
+	if (r != 0)
+		goto out;
+	ext2fs->umask = 077;
+	r = ext2fs_mkdir(ext2fs, EXT2_ROOT_INO, 0, "lost+found");
+	if (r != 0)
+		goto out;
+
+	for (i = EXT2_ROOT_INO + 1; i < (int)EXT2_FIRST_INODE(ext2fs->super); i++)
+		ext2fs_inode_alloc_stats(ext2fs, i, 1);
+	ext2fs_mark_ib_dirty(ext2fs);
+	r = ext2fs_mark_inode_bitmap2(ext2fs->inode_map, EXT2_BAD_INO);
+	if (r != 0)
+		goto out;
+	ext2fs_inode_alloc_stats(ext2fs, EXT2_BAD_INO, 1);
+	r = ext2fs_update_bb_inode(ext2fs, NULL);
+	if (r != 0)
+		goto out;
+
+	if (fs_name[3] != '2') {
+		journal_size = ext2fs_default_journal_size(ext2fs_blocks_count(ext2fs->super));
+		journal_size /= 2;
+		r = ext2fs_add_journal_inode(ext2fs, journal_size, EXT2_MKJOURNAL_NO_MNT_CHECK | (quick ? EXT2_MKJOURNAL_LAZYINIT : 0));
+		if (r != 0)
+			goto out;
+	}
+
+	if (ext2fs_has_group_desc_csum(ext2fs))
+		ext2fs_set_gdt_csum(ext2fs);
+	r = ext2fs_close(ext2fs);
+	if (r == 0)
+		ext2fs = NULL;
+
+out:
+	ext2fs_free(ext2fs);
+	return r;
+}
+
+/*
+ * Usage: ext_bench <image> <size in MB> [io options] [ext2|ext3|ext4]
+ * The io options, such as "cache_blocks=1&zeroout=0", are set on the
+ * channel once it is open. When a file system is specified, only that
+ * one gets formatted, and the image is kept, so that it can be checked.
+ */
+int main(int argc, char **argv)
+{
+	const char *fs_name[] = { "ext2", "ext3", "ext4" };
+	const char *path, *options = NULL, *fs = NULL;
+	uint64_t size;
+	double start, elapsed;
+	struct stat st;
+	errcode_t r;
+	int i, fd, quick, ret = 0;
+
+	if (argc < 3) {
+		fprintf(stderr, "Usage: %s <image> <size in MB> [io options] [ext2|ext3|ext4]\n", argv[0]);
+		return 1;
+	}
+	path = argv[1];
+	size = strtoull(argv[2], NULL, 0) * MB;
+	if ((argc > 3) && (argv[3][0] != 0))
+		options = argv[3];
+	if (argc > 4)
+		fs = argv[4];
+	srand((unsigned int)time(NULL));
+
+	for (i = 0; i < 3; i++) {
+		if ((fs != NULL) && (strcmp(fs, fs_name[i]) != 0))
+			continue;
+		for (quick = 1; quick >= 0; quick--) {
+			fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+			if ((fd < 0) || (ftruncate(fd, (off_t)size) != 0)) {
+				perror(path);
+				return 1;
+			}
+			close(fd);
+
+			memset(&cache_io_backing_stats, 0, sizeof(cache_io_backing_stats));
+			start = now();
+			r = format_ext(path, fs_name[i], quick, options);
+			elapsed = now() - start;
+			if ((r == 0) && (stat(path, &st) != 0))
+				r = EXT2_ET_BAD_DEVICE_NAME;
+			printf("%s %s format: %0.2f s, %llu reads (%0.1f MB), %llu writes (%0.1f MB), %llu zeroouts, "
+				"%0.1f MB allocated%s\n", quick ? "Quick" : "Full", fs_name[i], elapsed,
+				cache_io_backing_stats.reads, (double)cache_io_backing_stats.bytes_read / MB,
+				cache_io_backing_stats.writes, (double)cache_io_backing_stats.bytes_written / MB,
+				cache_io_backing_stats.zeroouts, (r == 0) ? (double)st.st_blocks * 512 / MB : 0.0,
+				(r == 0) ? "" : " [FAILED]");
+			if (r != 0)
+				ret = 1;
+		}
+	}
+	if (fs == NULL)
+		unlink(path);
+	return ret;
+}
@@ -80,6 +80,7 @@ static errcode_t nt_read_blk64(io_channel channel, unsigned long long block, int
 static errcode_t nt_write_blk(io_channel channel, unsigned long block, int count, const void *data);
 static errcode_t nt_write_blk64(io_channel channel, unsigned long long block, int count, const void* data);
 static errcode_t nt_flush(io_channel channel);
+static errcode_t nt_zeroout(io_channel channel, unsigned long long block, unsigned long long count);
 
 struct struct_io_manager struct_nt_manager = {
 	.magic		= EXT2_ET_MAGIC_IO_MANAGER,
@@ -91,7 +92,8 @@ struct struct_io_manager struct_nt_manager = {
 	.read_blk64	= nt_read_blk64,
 	.write_blk	= nt_write_blk,
 	.write_blk64	= nt_write_blk64,
-	.flush		= nt_flush
+	.flush		= nt_flush,
+	.zeroout	= nt_zeroout
 };
 
 io_manager nt_io_manager = &struct_nt_manager;
@@ -749,3 +751,36 @@ static errcode_t nt_flush(io_channel channel)
 
 	return 0;
 }
+
+static errcode_t nt_zeroout(io_channel channel, unsigned long long block, unsigned long long count)
+{
+	IO_STATUS_BLOCK IoStatusBlock;
+	FILE_ZERO_DATA_INFORMATION fzdi;
+	PNT_PRIVATE_DATA nt_data = NULL;
+	PF_INIT(NtFsControlFile, NtDll);
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	nt_data = (PNT_PRIVATE_DATA) channel->private_data;
+	EXT2_CHECK_MAGIC(nt_data, EXT2_ET_MAGIC_NT_IO_CHANNEL);
+
+	if (nt_data->read_only)
+		return EACCES;
+
+	// Zero ranges are only supported for files (e.g. when using an image
+	// for testing), and not raw devices. Let the caller fall back to
+	// regular writes for these.
+	if (pfNtFsControlFile == NULL)
+		return EXT2_ET_UNIMPLEMENTED;
+	fzdi.FileOffset.QuadPart = block * channel->block_size + nt_data->offset;
+	fzdi.BeyondFinalZero.QuadPart = fzdi.FileOffset.QuadPart + count * channel->block_size;
+	if (!NT_SUCCESS(pfNtFsControlFile(nt_data->handle, NULL, NULL, NULL, &IoStatusBlock,
+		FSCTL_SET_ZERO_DATA, &fzdi, sizeof(fzdi), NULL, 0)))
+		return EXT2_ET_UNIMPLEMENTED;
+
+	if ((nt_data->buffer_block_number != 0xffffffff) && (nt_data->buffer_block_number >= block) &&
+	    (nt_data->buffer_block_number < block + count))
+		nt_data->buffer_block_number = 0xffffffff;
+	nt_data->written = TRUE;
+
+	return 0;
+}
@@ -0,0 +1,365 @@
+/*
+ * unix_io.c --- This is a minimal POSIX I/O interface to the I/O manager.
+ *
+ * Reads and writes a file image (which may be sparse) through pread and
+ * pwrite, so that the ext formatting code can be exercised and timed on
+ * non Windows hosts. It is not part of the Windows build.
+ *
+ * Copyright (C) 1993, 1994, 1995 Theodore Ts'o.
+ * Copyright (C) 2024 Pete Batard <pete@akeo.ie>
+ *
+ * %Begin-Header%
+ * This file may be redistributed under the terms of the GNU Library
+ * General Public License, version 2.
+ * %End-Header%
+ */
+
+#if !defined(_WIN32)
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include "config.h"
+#include "ext2fs.h"
+
+#define EXT2_ET_MAGIC_UNIX_IO_PRIVATE	0x10ef
+
+struct unix_private_data {
+	int			magic;
+	int			fd;
+	int			no_zeroout;
+	struct struct_io_stats	io_stats;
+};
+
+static errcode_t unix_open(const char *name, int flags, io_channel *channel);
+static errcode_t unix_close(io_channel channel);
+static errcode_t unix_set_blksize(io_channel channel, int blksize);
+static errcode_t unix_read_blk(io_channel channel, unsigned long block, int count, void *data);
+static errcode_t unix_read_blk64(io_channel channel, unsigned long long block, int count, void *data);
+static errcode_t unix_write_blk(io_channel channel, unsigned long block, int count, const void *data);
+static errcode_t unix_write_blk64(io_channel channel, unsigned long long block, int count, const void *data);
+static errcode_t unix_flush(io_channel channel);
+static errcode_t unix_write_byte(io_channel channel, unsigned long offset, int size, const void *data);
+static errcode_t unix_set_option(io_channel channel, const char *option, const char *arg);
+static errcode_t unix_get_stats(io_channel channel, io_stats *stats);
+static errcode_t unix_discard(io_channel channel, unsigned long long block, unsigned long long count);
+static errcode_t unix_zeroout(io_channel channel, unsigned long long block, unsigned long long count);
+
+static struct struct_io_manager struct_unix_manager = {
+	.magic		= EXT2_ET_MAGIC_IO_MANAGER,
+	.name		= "Unix I/O Manager",
+	.open		= unix_open,
+	.close		= unix_close,
+	.set_blksize	= unix_set_blksize,
+	.read_blk	= unix_read_blk,
+	.write_blk	= unix_write_blk,
+	.flush		= unix_flush,
+	.write_byte	= unix_write_byte,
+	.set_option	= unix_set_option,
+	.get_stats	= unix_get_stats,
+	.read_blk64	= unix_read_blk64,
+	.write_blk64	= unix_write_blk64,
+	.discard	= unix_discard,
+	.zeroout	= unix_zeroout
+};
+
+io_manager unix_io_manager = &struct_unix_manager;
+
+/*
+ * Helpers
+ */
+static errcode_t raw_io(int fd, ext2_loff_t offset, size_t size, void *buf, int write)
+{
+	ssize_t r;
+	char *cp = (char *) buf;
+
+	while (size > 0) {
+		r = write ? pwrite(fd, cp, size, offset) : pread(fd, cp, size, offset);
+		if (r < 0) {
+			if (errno == EINTR)
+				continue;
+			return errno;
+		}
+		if (r == 0) {
+			/* Reading past the end of a file image returns zeroes */
+			if (!write) {
+				memset(cp, 0, size);
+				return 0;
+			}
+			return EXT2_ET_SHORT_WRITE;
+		}
+		cp += r;
+		offset += r;
+		size -= r;
+	}
+	return 0;
+}
+
+static ssize_t io_size(io_channel channel, int count)
+{
+	return (count < 0) ? -count : (ssize_t)count * channel->block_size;
+}
+
+/*
+ * Interface functions
+ */
+errcode_t ext2fs_check_if_mounted(const char *file, int *mount_flags)
+{
+	*mount_flags = 0;
+	return 0;
+}
+
+// Not implemented
+errcode_t ext2fs_check_mount_point(const char *file, int *mount_flags, char *mtpt, int mtlen)
+{
+	return EXT2_ET_OP_NOT_SUPPORTED;
+}
+
+// Returns the number of blocks in a file image
+errcode_t ext2fs_get_device_size2(const char *file, int blocksize, blk64_t *retblocks)
+{
+	struct stat st;
+
+	if (stat(file, &st) != 0)
+		return errno;
+	*retblocks = (blk64_t)(st.st_size / blocksize);
+	return 0;
+}
+
+/*
+ * Table elements
+ */
+static errcode_t unix_open(const char *name, int flags, io_channel *channel)
+{
+	io_channel io = NULL;
+	struct unix_private_data *data = NULL;
+	errcode_t retval;
+
+	if (name == NULL)
+		return EXT2_ET_BAD_DEVICE_NAME;
+
+	retval = ext2fs_get_memzero(sizeof(struct struct_io_channel), &io);
+	if (retval)
+		goto cleanup;
+	retval = ext2fs_get_mem(strlen(name) + 1, &io->name);
+	if (retval)
+		goto cleanup;
+	strcpy(io->name, name);
+	retval = ext2fs_get_memzero(sizeof(struct unix_private_data), &data);
+	if (retval)
+		goto cleanup;
+	data->magic = EXT2_ET_MAGIC_UNIX_IO_PRIVATE;
+	data->io_stats.num_fields = 2;
+	data->fd = open(name, (flags & IO_FLAG_RW) ? O_RDWR : O_RDONLY);
+	if (data->fd < 0) {
+		retval = errno;
+		goto cleanup;
+	}
+
+	io->magic = EXT2_ET_MAGIC_IO_CHANNEL;
+	io->manager = unix_io_manager;
+	io->block_size = EXT2_MIN_BLOCK_SIZE;
+	io->flags = flags & IO_FLAG_RW;
+	io->refcount = 1;
+	io->private_data = data;
+
+	*channel = io;
+	return 0;
+
+cleanup:
+	if (data != NULL)
+		ext2fs_free_mem(&data);
+	if (io != NULL) {
+		if (io->name != NULL)
+			ext2fs_free_mem(&io->name);
+		ext2fs_free_mem(&io);
+	}
+	return retval;
+}
+
+static errcode_t unix_close(io_channel channel)
+{
+	struct unix_private_data *data;
+	errcode_t retval = 0;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct unix_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_UNIX_IO_PRIVATE);
+
+	if (--channel->refcount > 0)
+		return 0;
+
+	if (close(data->fd) != 0)
+		retval = errno;
+	ext2fs_free_mem(&channel->private_data);
+	if (channel->name != NULL)
+		ext2fs_free_mem(&channel->name);
+	ext2fs_free_mem(&channel);
+	return retval;
+}
+
+static errcode_t unix_set_blksize(io_channel channel, int blksize)
+{
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	channel->block_size = blksize;
+	return 0;
+}
+
+static errcode_t unix_read_blk64(io_channel channel, unsigned long long block, int count, void *buf)
+{
+	struct unix_private_data *data;
+	ssize_t size;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct unix_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_UNIX_IO_PRIVATE);
+
+	size = io_size(channel, count);
+	data->io_stats.bytes_read += size;
+	return raw_io(data->fd, (ext2_loff_t)block * channel->block_size, size, buf, 0);
+}
+
+static errcode_t unix_read_blk(io_channel channel, unsigned long block, int count, void *buf)
+{
+	return unix_read_blk64(channel, block, count, buf);
+}
+
+static errcode_t unix_write_blk64(io_channel channel, unsigned long long block, int count, const void *buf)
+{
+	struct unix_private_data *data;
+	ssize_t size;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct unix_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_UNIX_IO_PRIVATE);
+
+	size = io_size(channel, count);
+	data->io_stats.bytes_written += size;
+	return raw_io(data->fd, (ext2_loff_t)block * channel->block_size, size, (void *)buf, 1);
+}
+
+static errcode_t unix_write_blk(io_channel channel, unsigned long block, int count, const void *buf)
+{
+	return unix_write_blk64(channel, block, count, buf);
+}
+
+static errcode_t unix_write_byte(io_channel channel, unsigned long offset, int size, const void *buf)
+{
+	struct unix_private_data *data;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct unix_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_UNIX_IO_PRIVATE);
+
+	data->io_stats.bytes_written += size;
+	return raw_io(data->fd, offset, size, (void *)buf, 1);
+}
+
+static errcode_t unix_flush(io_channel channel)
+{
+	struct unix_private_data *data;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct unix_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_UNIX_IO_PRIVATE);
+
+	return (fsync(data->fd) == 0) ? 0 : errno;
+}
+
+/*
+ * "zeroout=0" makes zeroout fail, so that zeroes get written instead,
+ * as they are on a raw device. This gives a more realistic idea of the
+ * I/O a format issues than punching holes in the image does.
+ */
+static errcode_t unix_set_option(io_channel channel, const char *option, const char *arg)
+{
+	struct unix_private_data *data;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct unix_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_UNIX_IO_PRIVATE);
+
+	if (strcmp(option, "zeroout") == 0) {
+		if (arg == NULL)
+			return EXT2_ET_INVALID_ARGUMENT;
+		data->no_zeroout = (strcmp(arg, "0") == 0);
+		return 0;
+	}
+	return EXT2_ET_INVALID_ARGUMENT;
+}
+
+static errcode_t unix_get_stats(io_channel channel, io_stats *stats)
+{
+	struct unix_private_data *data;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct unix_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_UNIX_IO_PRIVATE);
+
+	if (stats)
+		*stats = &data->io_stats;
+	return 0;
+}
+
+static errcode_t unix_discard(io_channel channel, unsigned long long block, unsigned long long count)
+{
+#if defined(FALLOC_FL_PUNCH_HOLE)
+	struct unix_private_data *data;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct unix_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_UNIX_IO_PRIVATE);
+
+	if (fallocate(data->fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+		      (off_t)block * channel->block_size,
+		      (off_t)count * channel->block_size) == 0)
+		return 0;
+	return (errno == EOPNOTSUPP) ? EXT2_ET_UNIMPLEMENTED : errno;
+#else
+	return EXT2_ET_UNIMPLEMENTED;
+#endif
+}
+
+/*
+ * Sparse file images read back as zeroes, so the fastest way to zero a
+ * range is to punch a hole in it. If the file system does not support
+ * that, let the caller fall back to writing zeroes.
+ */
+static errcode_t unix_zeroout(io_channel channel, unsigned long long block, unsigned long long count)
+{
+#if defined(FALLOC_FL_PUNCH_HOLE) || defined(FALLOC_FL_ZERO_RANGE)
+	struct unix_private_data *data;
+	off_t offset, len;
+
+	EXT2_CHECK_MAGIC(channel, EXT2_ET_MAGIC_IO_CHANNEL);
+	data = (struct unix_private_data *) channel->private_data;
+	EXT2_CHECK_MAGIC(data, EXT2_ET_MAGIC_UNIX_IO_PRIVATE);
+
+	if (!(channel->flags & IO_FLAG_RW))
+		return EXT2_ET_RO_FILSYS;
+	if (data->no_zeroout)
+		return EXT2_ET_UNIMPLEMENTED;
+	offset = (off_t)block * channel->block_size;
+	len = (off_t)count * channel->block_size;
+#if defined(FALLOC_FL_PUNCH_HOLE)
+	if (fallocate(data->fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, offset, len) == 0)
+		return 0;
+#endif
+#if defined(FALLOC_FL_ZERO_RANGE)
+	if (fallocate(data->fd, FALLOC_FL_ZERO_RANGE, offset, len) == 0)
+		return 0;
+#endif
+#endif
+	return EXT2_ET_UNIMPLEMENTED;
+}
+
+#endif /* !_WIN32 */
@@ -58,9 +58,6 @@
 #include "bled/bled.h"
 #include "../res/grub/grub_version.h"
 
-/* Numbers of buffer used for asynchronous DD reads */
-#define NUM_BUFFERS 2
-
 /*
  * Globals
  */
@@ -69,15 +66,17 @@ DWORD ErrorStatus = 0, LastWriteError = 0;
 badblocks_report report = { 0 };
 static float format_percent = 0.0f;
 static int task_number = 0, actual_fs_type;
-static unsigned int sec_buf_pos = 0;
+static WRITE_QUEUE write_queue = { 0 };
 extern const int nb_steps[FS_MAX];
 extern const char* md5sum_name[2];
 extern uint32_t dur_mins, dur_secs;
 extern uint32_t wim_nb_files, wim_proc_files, wim_extra_files;
 extern BOOL force_large_fat32, enable_ntfs_compression, lock_drive, zero_drive, fast_zeroing, enable_file_indexing;
-extern BOOL write_as_image, use_vds, write_as_esp, is_vds_available, has_ffu_support, use_rufus_mbr;
+extern BOOL write_as_image, use_vds, write_as_esp, is_vds_available, has_ffu_support, use_rufus_mbr, sparse_write;
+extern BOOL verify_write, cpu_has_sha256_accel;
+extern int dd_queue_depth;
 extern char* archive_path;
-uint8_t *grub2_buf = NULL, *sec_buf = NULL;
+uint8_t *grub2_buf = NULL;
 long grub2_len;
 
 /*
@@ -1096,65 +1095,95 @@ static void update_progress(const uint64_t processed_bytes)
 	}
 }
 
-// Some compressed images use streams that aren't multiple of the sector
-// size and cause write failures => Use a write override that alleviates
-// the problem. See GitHub issue #1422 for details.
-static int sector_write(int fd, const void* _buf, unsigned int count)
+// Compressed images are written through a write queue, so that the drive can be
+// written to while we decompress the next blocks. Since the queue only issues
+// sector aligned writes, this also takes care of compressed streams that aren't
+// multiple of the sector size. See GitHub issue #1422 for details.
+static int queued_write(int fd, const void* buf, unsigned int count)
 {
-	const uint8_t* buf = (const uint8_t*)_buf;
-	unsigned int sec_size = (unsigned int)SelectedDrive.SectorSize;
-	int written, fill_size = 0;
-
-	if (sec_size == 0)
-		sec_size = 512;
-	if_not_assert(sec_size <= 64 * KB)
-		return -1;
-	if_not_assert(count <= 1 * GB)
-		return -1;
-
-	// If we are on a sector boundary and count is multiple of the
-	// sector size, just issue a regular write
-	if ((sec_buf_pos == 0) && (count % sec_size == 0))
-		return _write(fd, buf, count);
-
-	// If we have an existing partial sector, fill and write it
-	if (sec_buf_pos > 0) {
-		if_not_assert(sec_size >= sec_buf_pos)
-			return -1;
-		fill_size = min(sec_size - sec_buf_pos, count);
-		memcpy(&sec_buf[sec_buf_pos], buf, fill_size);
-		sec_buf_pos += fill_size;
-		// If we don't have a full sector just buffer it for next call
-		if (sec_buf_pos < sec_size)
-			return (int)count;
-		sec_buf_pos = 0;
-		written = _write(fd, sec_buf, sec_size);
-		if (written != sec_size)
-			return written;
-	}
-
-	// Now write as many full sectors as we can
-	uint32_t sec_num = (count - fill_size) / sec_size;
-	written = _write(fd, &buf[fill_size], sec_num * sec_size);
-	if (written < 0)
-		return written;
-	if (written != sec_num * sec_size) {
-		// Detect overflows
-		// coverity[overflow]
-		int v = fill_size + written;
-		if_not_assert(v >= fill_size)
-			return -1;
-		else
-			return v;
+	return WriteQueuePush(&write_queue, buf, count);
+}
+
+/*
+ * Fast-zeroing state. Probing a block costs a read, and saves us from writing the parts
+ * of it that are already blank, so it is only worth doing as long as the proportion of
+ * blank data we find is larger than the ratio between the time it takes to read and to
+ * write the same amount of data. When that is not the case, we exponentially back off.
+ */
+#define FAST_ZERO_PROBE_SIZE    (1 * MB)	// Granularity at which blank data is detected
+#define FAST_ZERO_MAX_BACKOFF   64			// Maximum number of blocks we write without probing
+
+typedef struct {
+	uint64_t read_bytes, read_ms;
+	uint64_t write_bytes, write_ms;
+	uint64_t probed, blank;
+	uint64_t skipped;
+	int backoff, countdown;
+} FAST_ZERO_STATE;
+
+static BOOL FastZeroShouldProbe(FAST_ZERO_STATE* fz)
+{
+	if (fz->countdown > 0) {
+		fz->countdown--;
+		return FALSE;
+	}
+	return TRUE;
+}
+
+static void FastZeroAdapt(FAST_ZERO_STATE* fz, DWORD blank, DWORD size)
+{
+	BOOL worth_it;
+	double hit_rate, read_time, write_time;
+
+	fz->probed += size;
+	fz->blank += blank;
+	fz->skipped += blank;
+	if (blank == size) {
+		worth_it = TRUE;
+	} else if ((fz->read_bytes == 0) || (fz->write_bytes == 0) || (fz->write_ms == 0)) {
+		// Not enough data yet to make a decision
+		worth_it = (blank != 0);
+	} else {
+		hit_rate = (double)fz->blank / (double)fz->probed;
+		read_time = (double)fz->read_ms / (double)fz->read_bytes;
+		write_time = (double)fz->write_ms / (double)fz->write_bytes;
+		worth_it = (hit_rate * write_time > read_time);
+	}
+	fz->backoff = worth_it ? 0 : min(max(2 * fz->backoff, 1), FAST_ZERO_MAX_BACKOFF);
+	fz->countdown = fz->backoff;
+
+	// Halve our statistics once in a while, so that they follow the most recent data
+	if (fz->probed > 64ULL * DD_BUFFER_SIZE) {
+		fz->probed /= 2;
+		fz->blank /= 2;
+		fz->read_bytes /= 2;
+		fz->read_ms /= 2;
+		fz->write_bytes /= 2;
+		fz->write_ms /= 2;
 	}
-	sec_buf_pos = count - fill_size - written;
-	if_not_assert(sec_buf_pos < sec_size)
-		return -1;
+}
 
-	// Keep leftover bytes, if any, in the sector buffer
-	if (sec_buf_pos != 0)
-		memcpy(sec_buf, &buf[fill_size + written], sec_buf_pos);
-	return (int)count;
+/* Write a sector aligned range of a drive, with retries */
+static BOOL WriteDriveRange(HANDLE hDrive, uint64_t offset, const uint8_t* buf, DWORD size, FAST_ZERO_STATE* fz)
+{
+	LARGE_INTEGER li;
+	uint64_t start_time = GetTickCount64();
+
+	li.QuadPart = offset;
+	if (!SetFilePointerEx(hDrive, li, NULL, FILE_BEGIN)) {
+		uprintf("\r\nError: Could not set position - %s", WindowsErrorString());
+		return FALSE;
+	}
+	if (!WriteFileWithRetry(hDrive, buf, size, NULL, WRITE_RETRIES)) {
+		uprintf("\r\nWrite error at sector %lld", offset / SelectedDrive.SectorSize);
+		ErrorStatus = RUFUS_ERROR(ERROR_WRITE_FAULT);
+		return FALSE;
+	}
+	if (fz != NULL) {
+		fz->write_bytes += size;
+		fz->write_ms += GetTickCount64() - start_time;
+	}
+	return TRUE;
 }
 
 /* Write an image file or zero a drive */
@@ -1162,15 +1191,17 @@ static BOOL WriteDrive(HANDLE hPhysicalDrive, BOOL bZeroDrive)
 {
 	BOOL s, ret = FALSE;
 	LARGE_INTEGER li;
-	HANDLE hSourceImage = INVALID_HANDLE_VALUE;
-	DWORD i, read_size[NUM_BUFFERS] = { 0 }, write_size, comp_size, buf_size;
+	HANDLE hSourceImage = INVALID_HANDLE_VALUE, hAsyncDrive = NULL;
+	DWORD read_size = 0, comp_size, buf_size;
 	uint64_t wb, target_size = bZeroDrive ? SelectedDrive.DiskSize : MIN((uint64_t)SelectedDrive.DiskSize, img_report.image_size);
 	uint64_t cur_value, last_value = 0;
 	int64_t bled_ret;
-	uint8_t* buffer = NULL;
-	uint32_t zero_data, *cmp_buffer = NULL;
+	uint8_t *buffer = NULL, *cmp_buffer = NULL;
+	uint64_t start_time;
+	DWORD pos, end, blank_size;
 	char* vhd_path = NULL;
-	int throttle_fast_zeroing = 0, read_bufnum = 0, proc_bufnum = 1;
+	FAST_ZERO_STATE fz = { 0 };
+	IO_QUEUE q = { 0 };
 
 	if (SelectedDrive.SectorSize < 512) {
 		uprintf("Unexpected sector size (%d) - Aborting", SelectedDrive.SectorSize);
@@ -1200,7 +1231,7 @@ static BOOL WriteDrive(HANDLE hPhysicalDrive, BOOL bZeroDrive)
 		memset(buffer, fast_zeroing ? 0xff : 0x00, buf_size);
 
 		if (fast_zeroing) {
-			cmp_buffer = (uint32_t*)_mm_malloc(buf_size, SelectedDrive.SectorSize);
+			cmp_buffer = (uint8_t*)_mm_malloc(buf_size, SelectedDrive.SectorSize);
 			if (cmp_buffer == NULL) {
 				ErrorStatus = RUFUS_ERROR(ERROR_NOT_ENOUGH_MEMORY);
 				uprintf("Could not allocate disk comparison buffer");
@@ -1210,86 +1241,66 @@ static BOOL WriteDrive(HANDLE hPhysicalDrive, BOOL bZeroDrive)
 				goto out;
 		}
 
-		read_size[0] = buf_size;
-		for (wb = 0, write_size = 0; wb < target_size; wb += write_size) {
+		read_size = buf_size;
+		for (wb = 0; wb < target_size; wb += read_size) {
 			UpdateProgressWithInfo(OP_FORMAT, fast_zeroing ? MSG_306 : MSG_286, wb, target_size);
 			cur_value = (wb * 80) / target_size;
 			for (; cur_value > last_value && last_value < 80; last_value++)
 				uprintfs("+");
 			// Don't overflow our projected size (mostly for VHDs)
-			if (wb + read_size[0] > target_size)
-				read_size[0] = (DWORD)(target_size - wb);
+			if (wb + read_size > target_size)
+				read_size = (DWORD)(target_size - wb);
 
 			// WriteFile fails unless the size is a multiple of sector size
-			if (read_size[0] % SelectedDrive.SectorSize != 0)
-				read_size[0] = ((read_size[0] + SelectedDrive.SectorSize - 1) / SelectedDrive.SectorSize) * SelectedDrive.SectorSize;
+			if (read_size % SelectedDrive.SectorSize != 0)
+				read_size = ((read_size + SelectedDrive.SectorSize - 1) / SelectedDrive.SectorSize) * SelectedDrive.SectorSize;
+
+			CHECK_FOR_USER_CANCEL;
 
 			// Fast-zeroing: Depending on your hardware, reading from flash may be much faster than writing, so
-			// we might speed things up by skipping empty blocks, or skipping the write if the data is the same.
+			// we might speed things up by only writing the parts of a block that aren't already empty.
 			// Notes: A block is declared empty when all bits are either 0 (zeros) or 1 (flash block erased).
-			// Also, a back-off strategy is used to limit reading.
-			if (throttle_fast_zeroing) {
-				throttle_fast_zeroing--;
-			} else if (fast_zeroing) {
-				CHECK_FOR_USER_CANCEL;
-
-				// Read block and compare against the block that needs to be written
-				s = ReadFile(hPhysicalDrive, cmp_buffer, read_size[0], &comp_size, NULL);
-				if ((!s) || (comp_size != read_size[0])) {
-					uprintf("\r\nRead error: Could not read data for fast zeroing comparison - %s", WindowsErrorString());
+			// Also, how often we read is adjusted according to how much this has been saving us so far.
+			if (!fast_zeroing || !FastZeroShouldProbe(&fz)) {
+				if (!WriteDriveRange(hPhysicalDrive, wb, buffer, read_size, fast_zeroing ? &fz : NULL))
 					goto out;
-				}
-
-				// Check for an empty block by comparing with the first element
-				zero_data = cmp_buffer[0];
-				// Check all bits are the same
-				if ((zero_data == 0) || (zero_data == 0xffffffff)) {
-					// Compare the rest of the block against the first element
-					for (i = 1; (i < read_size[0] / sizeof(uint32_t)) && (cmp_buffer[i] == zero_data); i++);
-					if (i >= read_size[0] / sizeof(uint32_t)) {
-						// Block is empty, skip write
-						write_size = read_size[0];
-						continue;
-					}
-				}
-
-				// Move the file pointer position back for writing
-				li.QuadPart = wb;
-				if (!SetFilePointerEx(hPhysicalDrive, li, NULL, FILE_BEGIN)) {
-					uprintf("\r\nError: Could not reset position - %s", WindowsErrorString());
-					goto out;
-				}
-				// Throttle read operations
-				throttle_fast_zeroing = 15;
+				continue;
 			}
 
-			for (i = 1; i <= WRITE_RETRIES; i++) {
-				CHECK_FOR_USER_CANCEL;
-				s = WriteFile(hPhysicalDrive, buffer, read_size[0], &write_size, NULL);
-				if ((s) && (write_size == read_size[0]))
-					break;
-				if (s)
-					uprintf("\r\nWrite error: Wrote %d bytes, expected %d bytes", write_size, read_size[0]);
-				else
-					uprintf("\r\nWrite error at sector %lld: %s", wb / SelectedDrive.SectorSize, WindowsErrorString());
-				if (i < WRITE_RETRIES) {
-					li.QuadPart = wb;
-					uprintf("Retrying in %d seconds...", WRITE_TIMEOUT / 1000);
-					Sleep(WRITE_TIMEOUT);
-					if (!SetFilePointerEx(hPhysicalDrive, li, NULL, FILE_BEGIN)) {
-						uprintf("Write error: Could not reset position - %s", WindowsErrorString());
-						goto out;
-					}
-				} else {
-					ErrorStatus = RUFUS_ERROR(ERROR_WRITE_FAULT);
-					goto out;
-				}
-				Sleep(200);
+			li.QuadPart = wb;
+			if (!SetFilePointerEx(hPhysicalDrive, li, NULL, FILE_BEGIN)) {
+				uprintf("\r\nError: Could not set position - %s", WindowsErrorString());
+				goto out;
 			}
-			if (i > WRITE_RETRIES)
+			start_time = GetTickCount64();
+			s = ReadFile(hPhysicalDrive, cmp_buffer, read_size, &comp_size, NULL);
+			if ((!s) || (comp_size != read_size)) {
+				uprintf("\r\nRead error: Could not read data for fast zeroing comparison - %s", WindowsErrorString());
 				goto out;
+			}
+			fz.read_bytes += read_size;
+			fz.read_ms += GetTickCount64() - start_time;
+
+			// Only write the runs of probed sections that aren't empty
+			blank_size = 0;
+			for (pos = 0; pos < read_size; pos = end) {
+				if (IsBufferBlank(&cmp_buffer[pos], min(FAST_ZERO_PROBE_SIZE, read_size - pos))) {
+					end = pos + min(FAST_ZERO_PROBE_SIZE, read_size - pos);
+					blank_size += end - pos;
+					continue;
+				}
+				for (end = pos + FAST_ZERO_PROBE_SIZE; (end < read_size) &&
+					!IsBufferBlank(&cmp_buffer[end], min(FAST_ZERO_PROBE_SIZE, read_size - end)); end += FAST_ZERO_PROBE_SIZE);
+				end = min(end, read_size);
+				if (!WriteDriveRange(hPhysicalDrive, wb + pos, buffer, end - pos, &fz))
+					goto out;
+			}
+			FastZeroAdapt(&fz, blank_size, read_size);
 		}
 		uprintfs("\r\n");
+		if (fast_zeroing)
+			uprintf("%s did not need to be written (%0.1f%%)", SizeToHumanReadable(fz.skipped, FALSE, FALSE),
+				(100.0f * fz.skipped) / target_size);
 	} else if (img_report.compression_type != BLED_COMPRESSION_NONE && img_report.compression_type < BLED_COMPRESSION_MAX) {
 		uprintf("Writing compressed image:");
 		hSourceImage = CreateFileU(image_path, GENERIC_READ, FILE_SHARE_READ, NULL,
@@ -1299,28 +1310,28 @@ static BOOL WriteDrive(HANDLE hPhysicalDrive, BOOL bZeroDrive)
 			ErrorStatus = RUFUS_ERROR(ERROR_OPEN_FAILED);
 			goto out;
 		}
-		sec_buf = (uint8_t*)_mm_malloc(SelectedDrive.SectorSize, SelectedDrive.SectorSize);
-		if (sec_buf == NULL) {
+		// Use the same overall amount of memory as for uncompressed images
+		buf_size = max((2 * DD_BUFFER_SIZE) / dd_queue_depth, 1 * MB);
+		if (!WriteQueueInit(&write_queue, hPhysicalDrive, SelectedDrive.SectorSize, buf_size, dd_queue_depth)) {
 			ErrorStatus = RUFUS_ERROR(ERROR_NOT_ENOUGH_MEMORY);
-			uprintf("Could not allocate disk write buffer");
+			uprintf("Could not allocate disk write buffers");
 			goto out;
 		}
-		if_not_assert((uintptr_t)sec_buf% SelectedDrive.SectorSize == 0)
-			goto out;
-		sec_buf_pos = 0;
-		bled_init(256 * KB, uprintf, NULL, sector_write, update_progress, NULL, &ErrorStatus);
+		if (verify_write)
+			uprintf("Notice: Verification is not available for compressed images");
+		bled_init(256 * KB, uprintf, NULL, queued_write, update_progress, NULL, &ErrorStatus);
 		bled_ret = bled_uncompress_with_handles(hSourceImage, hPhysicalDrive, img_report.compression_type);
 		bled_exit();
 		uprintfs("\r\n");
-		if ((bled_ret >= 0) && (sec_buf_pos != 0)) {
+		if (bled_ret >= 0) {
 			// A disk image that doesn't end up on disk boundary should be a rare
-			// enough case, so we dont bother checking the write operation and
-			// just issue a notice about it in the log.
-			uprintf("Notice: Compressed image data didn't end on block boundary.");
-			// Gonna assert that WriteFile() and _write() share the same file offset
-			WriteFile(hPhysicalDrive, sec_buf, SelectedDrive.SectorSize, &write_size, NULL);
+			// enough case, so we just issue a notice about it in the log.
+			if (write_queue.dwFill % SelectedDrive.SectorSize != 0)
+				uprintf("Notice: Compressed image data didn't end on block boundary.");
+			if (!WriteQueueFlush(&write_queue) && (SCODE_CODE(ErrorStatus) != ERROR_CANCELLED))
+				bled_ret = -1;
 		}
-		safe_mm_free(sec_buf);
+		WriteQueueExit(&write_queue);
 		if ((bled_ret < 0) && (SCODE_CODE(ErrorStatus) != ERROR_CANCELLED)) {
 			// Unfortunately, different compression backends return different negative error codes
 			uprintf("Could not write compressed image: %lld", bled_ret);
@@ -1339,104 +1350,74 @@ static BOOL WriteDrive(HANDLE hPhysicalDrive, BOOL bZeroDrive)
 				goto out;
 		}
 
-		hSourceImage = CreateFileAsync(vhd_path != NULL ? vhd_path : image_path, GENERIC_READ,
-			FILE_SHARE_READ, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN);
-		if (hSourceImage == NULL) {
+		hSourceImage = CreateFileU(vhd_path != NULL ? vhd_path : image_path, GENERIC_READ, FILE_SHARE_READ,
+			NULL, OPEN_EXISTING, FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (hSourceImage == INVALID_HANDLE_VALUE) {
 			uprintf("Could not open image '%s': %s", image_path, WindowsErrorString());
 			ErrorStatus = RUFUS_ERROR(ERROR_OPEN_FAILED);
 			goto out;
 		}
 
-		// Our buffer size must be a multiple of the sector size and *ALIGNED* to the sector size
-		buf_size = ((DD_BUFFER_SIZE + SelectedDrive.SectorSize - 1) / SelectedDrive.SectorSize) * SelectedDrive.SectorSize;
-		buffer = (uint8_t*)_mm_malloc(buf_size * NUM_BUFFERS, SelectedDrive.SectorSize);
-		if (buffer == NULL) {
+		// To keep more than one write in flight, we need an overlapped handle to the drive.
+		// If we can't get one, the queue still overlaps reads, but writes become synchronous.
+		hAsyncDrive = ReOpenFileAsync(hPhysicalDrive, GENERIC_READ | GENERIC_WRITE);
+		if (hAsyncDrive == NULL)
+			uprintf("Could not reopen drive for asynchronous writes: %s", WindowsErrorString());
+
+		// Use the same overall amount of memory, regardless of the number of buffers
+		buf_size = max((2 * DD_BUFFER_SIZE) / dd_queue_depth, 1 * MB);
+		if (!IoQueueInit(&q, hSourceImage, (hAsyncDrive != NULL) ? hAsyncDrive : hPhysicalDrive,
+			target_size, SelectedDrive.SectorSize, buf_size, dd_queue_depth)) {
 			ErrorStatus = RUFUS_ERROR(ERROR_NOT_ENOUGH_MEMORY);
-			uprintf("Could not allocate disk write buffer");
+			uprintf("Could not allocate disk write buffers");
 			goto out;
 		}
-		if_not_assert((uintptr_t)buffer% SelectedDrive.SectorSize == 0)
-			goto out;
-
-		// Start the initial read
-		ReadFileAsync(hSourceImage, &buffer[read_bufnum * buf_size], (DWORD)MIN(buf_size, target_size));
-
-		read_size[proc_bufnum] = 1;	// To avoid early loop exit
-		for (wb = 0; read_size[proc_bufnum] != 0; wb += read_size[proc_bufnum]) {
-			// 0. Update the progress
-			UpdateProgressWithInfo(OP_FORMAT, MSG_261, wb, target_size);
-			cur_value = (wb * 80) / target_size;
-			for ( ; cur_value > last_value && last_value < 80; last_value++)
-				uprintfs("+");
-
-			if (wb >= target_size)
-				break;
-
-			// 1. Wait for the current read operation to complete (and update the read size)
-			if ((!WaitFileAsync(hSourceImage, DRIVE_ACCESS_TIMEOUT)) ||
-				(!GetSizeAsync(hSourceImage, &read_size[read_bufnum]))) {
-				uprintf("\r\nRead error: %s", WindowsErrorString());
-				ErrorStatus = RUFUS_ERROR(ERROR_READ_FAULT);
+		uprintf("Using %d x %s buffers", q.dwDepth, SizeToHumanReadable(q.dwBufferSize, FALSE, FALSE));
+
+		// In sparse mode, zeroed data from the image is only written if the target doesn't
+		// already read back as zero. Discarding the target first should make that the case
+		// for most of it, on devices that support it.
+		if (sparse_write) {
+			uprintf("Using sparse writes");
+			DiscardDrive(hPhysicalDrive);
+			if (!IoQueueSetSparse(&q, FALSE))
 				goto out;
-			}
+		}
 
+		// To verify the data, we hash it while it is being written, and then compare
+		// with the hashes of the data we read back.
+		if (verify_write && !IoQueueSetHash(&q, cpu_has_sha256_accel ? HASH_SHA256 : HASH_MD5)) {
+			ErrorStatus = RUFUS_ERROR(ERROR_NOT_ENOUGH_MEMORY);
+			uprintf("Could not allocate verification hashes");
+			goto out;
+		}
 
-			// 2. WriteFile fails unless the size is a multiple of sector size
-			if (read_size[read_bufnum] % SelectedDrive.SectorSize != 0) {
-				if_not_assert(HI_ALIGN_X_TO_Y(read_size[read_bufnum], SelectedDrive.SectorSize) <= buf_size)
-					goto out;
-				read_size[read_bufnum] = HI_ALIGN_X_TO_Y(read_size[read_bufnum], SelectedDrive.SectorSize);
-			}
+		if (!IoQueueCopy(&q, MSG_261))
+			goto out;
+		uprintfs("\r\n");
+		if (sparse_write) {
+			uprintf("%s written", SizeToHumanReadable(q.qwWritten, FALSE, FALSE));
+			uprintf("%s skipped", SizeToHumanReadable(q.qwSkipped, FALSE, FALSE));
+		}
 
-			// 3. Switch to the next reading buffer
-			proc_bufnum = read_bufnum;
-			read_bufnum = (read_bufnum + 1) % NUM_BUFFERS;
-
-			// 3. Launch the next asynchronous read operation
-			// It is VERY IMPORTANT here that we don't attempt to read past the source
-			// or target sizes, as mounted VHDs will SCREW YOU if you attempt to do so
-			// and will even start returning ERRONEOUS DATA for sectors before the end
-			// of the disk... So we make sure to adjust the size not to ever overflow.
-			// Also we need to make sure we add read_size[proc_bufnum] to wb since we
-			// have already read the data and are about to write it.
-			ReadFileAsync(hSourceImage, &buffer[read_bufnum * buf_size], (DWORD)MIN(buf_size, target_size - (wb + read_size[proc_bufnum])));
-
-			// 4. Synchronously write the current data buffer
-			for (i = 1; i <= WRITE_RETRIES; i++) {
-				CHECK_FOR_USER_CANCEL;
-				s = WriteFile(hPhysicalDrive, &buffer[proc_bufnum * buf_size], read_size[proc_bufnum], &write_size, NULL);
-				if ((s) && (write_size == read_size[proc_bufnum]))
-					break;
-				if (s)
-					uprintf("\r\nWrite error: Wrote %d bytes, expected %d bytes", write_size, read_size[proc_bufnum]);
-				else
-					uprintf("\r\nWrite error at sector %lld: %s", wb / SelectedDrive.SectorSize, WindowsErrorString());
-				if (i < WRITE_RETRIES) {
-					li.QuadPart = wb;
-					uprintf("Retrying in %d seconds...", WRITE_TIMEOUT / 1000);
-					Sleep(WRITE_TIMEOUT);
-					if (!SetFilePointerEx(hPhysicalDrive, li, NULL, FILE_BEGIN)) {
-						uprintf("Write error: Could not reset position - %s", WindowsErrorString());
-						goto out;
-					}
-				} else {
-					ErrorStatus = RUFUS_ERROR(ERROR_WRITE_FAULT);
-					goto out;
-				}
-				Sleep(200);
-			}
-			if (i > WRITE_RETRIES)
+		if (verify_write) {
+			if (!FlushFileBuffers(hPhysicalDrive))
+				uprintf("Could not flush drive: %s", WindowsErrorString());
+			uprintf("Verifying written data:");
+			if (!IoQueueVerify(&q, (hAsyncDrive != NULL) ? hAsyncDrive : hPhysicalDrive, MSG_352))
 				goto out;
+			uprintfs("\r\n");
+			uprintf("Verification succeeded");
 		}
-		uprintfs("\r\n");
 	}
 	RefreshDriveLayout(hPhysicalDrive);
 	ret = TRUE;
 out:
-	if (img_report.compression_type != BLED_COMPRESSION_NONE && img_report.compression_type < BLED_COMPRESSION_MAX)
-		safe_closehandle(hSourceImage);
-	else
-		CloseFileAsync(hSourceImage);
+	// Pending I/O must be cancelled before we close the handles
+	IoQueueExit(&q);
+	WriteQueueExit(&write_queue);
+	safe_closehandle(hAsyncDrive);
+	safe_closehandle(hSourceImage);
 	if (vhd_path != NULL)
 		VhdUnmountImage();
 	safe_mm_free(buffer);
@@ -1557,7 +1538,10 @@ DWORD WINAPI FormatThread(void* param)
 	GetDrivePartitionData(SelectedDrive.DeviceNumber, fs_name, sizeof(fs_name), TRUE);
 
 	// Now get RW access to the physical drive
-	hPhysicalDrive = GetPhysicalHandle(DriveIndex, actual_lock_drive, TRUE, !actual_lock_drive);
+	// When writing an image, we need to allow write sharing, so that WriteDrive() can reopen the
+	// drive for overlapped access. Note that the drive remains locked, if lock was requested.
+	hPhysicalDrive = GetPhysicalHandle(DriveIndex, actual_lock_drive, TRUE,
+		!actual_lock_drive || ((boot_type == BT_IMAGE) && write_as_image));
 	if (hPhysicalDrive == INVALID_HANDLE_VALUE) {
 		ErrorStatus = RUFUS_ERROR(ERROR_OPEN_FAILED);
 		goto out;
@@ -1606,7 +1590,35 @@ DWORD WINAPI FormatThread(void* param)
 		}
 	}
 
-	if (IsChecked(IDC_BAD_BLOCKS)) {
+	if (IsChecked(IDC_BAD_BLOCKS) && (ComboBox_GetCurSel(hNBPasses) == BADBLOCK_FAKE_PROBE)) {
+		do {
+			char disk_size_str[32];
+			ULONGLONG usable_size;
+			if (!ProbeCapacity(hPhysicalDrive, SelectedDrive.DiskSize, SelectedDrive.SectorSize, &usable_size)) {
+				uprintf("Bad blocks: Fake drive probe failed.");
+				if (!IS_ERROR(ErrorStatus))
+					ErrorStatus = RUFUS_ERROR(APPERR(ERROR_BADBLOCKS_FAILURE));
+				ClearMBRGPT(hPhysicalDrive, SelectedDrive.DiskSize, SelectedDrive.SectorSize, FALSE);
+				goto out;
+			}
+			r = IDOK;
+			if (usable_size < SelectedDrive.DiskSize) {
+				static_strcpy(disk_size_str, SizeToHumanReadable(SelectedDrive.DiskSize, FALSE, FALSE));
+				r = MessageBoxExU(hMainDialog, lmprintf(MSG_357, disk_size_str, SizeToHumanReadable(usable_size, FALSE, FALSE)),
+					lmprintf(MSG_356), MB_ABORTRETRYIGNORE | MB_ICONWARNING | MB_IS_RTL, selected_langid);
+			}
+		} while (r == IDRETRY);
+		if (r == IDABORT) {
+			ErrorStatus = RUFUS_ERROR(ERROR_CANCELLED);
+			goto out;
+		}
+		if (!ClearMBRGPT(hPhysicalDrive, SelectedDrive.DiskSize, SelectedDrive.SectorSize, use_large_fat32)) {
+			uprintf("unable to zero MBR/GPT");
+			if (!IS_ERROR(ErrorStatus))
+				ErrorStatus = RUFUS_ERROR(ERROR_WRITE_FAULT);
+			goto out;
+		}
+	} else if (IsChecked(IDC_BAD_BLOCKS)) {
 		do {
 			FILE* log_fd;
 			int sel = ComboBox_GetCurSel(hNBPasses);
@@ -117,6 +117,13 @@ typedef BOOLEAN (WINAPI* EnableVolumeCompression_t)(
 
 BOOL WritePBR(HANDLE hLogicalDrive);
 BOOL FormatLargeFAT32(DWORD DriveIndex, uint64_t PartitionOffset, DWORD ClusterSize, LPCSTR FSName, LPCSTR Label, DWORD Flags);
+#if defined(RUFUS_TEST)
+BOOL ClearSystemAreaBenchmark(const char* path, uint64_t size);
+BOOL ClearSystemAreaVolumeTest(const char* path, uint64_t size);
+#endif
 BOOL FormatExtFs(DWORD DriveIndex, uint64_t PartitionOffset, DWORD BlockSize, LPCSTR FSName, LPCSTR Label, DWORD Flags);
+#if defined(RUFUS_TEST)
+BOOL ExtFsBenchmark(const char* path, uint64_t size);
+#endif
 BOOL FormatPartition(DWORD DriveIndex, uint64_t PartitionOffset, DWORD UnitAllocationSize, USHORT FSType, LPCSTR Label, DWORD Flags);
 DWORD WINAPI FormatThread(void* param);
@@ -26,6 +26,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <assert.h>
 
 #include "rufus.h"
@@ -225,6 +226,11 @@ const char* GetExtFsLabel(DWORD DriveIndex, uint64_t PartitionOffset)
 #define TEST_IMG_SIZE               4000		// Size in MB
 #define SET_EXT2_FORMAT_ERROR(x)    if (!IS_ERROR(ErrorStatus)) ErrorStatus = ext2_last_winerror(x)
 
+#if defined(RUFUS_TEST)
+// Image to format instead of TEST_IMG_PATH, when set by ExtFsBenchmark()
+static const char* ext_test_path = NULL;
+#endif
+
 BOOL FormatExtFs(DWORD DriveIndex, uint64_t PartitionOffset, DWORD BlockSize, LPCSTR FSName, LPCSTR Label, DWORD Flags)
 {
 	// Mostly taken from mke2fs.conf
@@ -237,13 +243,13 @@ BOOL FormatExtFs(DWORD DriveIndex, uint64_t PartitionOffset, DWORD BlockSize, LP
 		{ 1024 * TB, 4096, 256, 4}	// "huge"
 	};
 
-	BOOL ret = FALSE;
+	BOOL ret = FALSE, lazy_itable_init = (Flags & FP_QUICK) ? TRUE : FALSE;
 	char* volume_name = NULL;
-	int i, count;
+	int i, count, run_count = 0;
 	struct ext2_super_block features = { 0 };
-	io_manager manager = nt_io_manager;
+	io_manager manager = cache_io_manager;
 	blk_t journal_size;
-	blk64_t size = 0, cur;
+	blk64_t size = 0, cur, run_start = 0;
 	ext2_filsys ext2fs = NULL;
 	errcode_t r;
 	uint8_t* buf = NULL;
@@ -254,21 +260,27 @@ BOOL FormatExtFs(DWORD DriveIndex, uint64_t PartitionOffset, DWORD BlockSize, LP
 	HANDLE h;
 	DWORD dwSize;
 	HCRYPTPROV hCryptProv = 0;
-	volume_name = strdup(TEST_IMG_PATH);
-	uprintf("Creating '%s'...", volume_name);
-	if (!CryptAcquireContext(&hCryptProv, NULL, NULL, PROV_RSA_FULL, CRYPT_VERIFYCONTEXT) || !CryptGenRandom(hCryptProv, sizeof(zb), zb)) {
-		uprintf("Failed to randomize buffer - filling with constant value");
-		memset(zb, rand(), sizeof(zb));
-	}
-	CryptReleaseContext(hCryptProv, 0);
-	h = CreateFileU(volume_name, GENERIC_WRITE, FILE_SHARE_WRITE, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
-	for (i = 0; i < TEST_IMG_SIZE * sizeof(zb); i++) {
-		if (!WriteFile(h, zb, sizeof(zb), &dwSize, NULL) || (dwSize != sizeof(zb))) {
-			uprintf("Write error: %s", WindowsErrorString());
-			break;
+	if (ext_test_path != NULL) {
+		volume_name = malloc(strlen(ext_test_path) + 5);
+		if (volume_name != NULL)
+			sprintf(volume_name, "\\??\\%s", ext_test_path);
+	} else {
+		volume_name = strdup(TEST_IMG_PATH);
+		uprintf("Creating '%s'...", volume_name);
+		if (!CryptAcquireContext(&hCryptProv, NULL, NULL, PROV_RSA_FULL, CRYPT_VERIFYCONTEXT) || !CryptGenRandom(hCryptProv, sizeof(zb), zb)) {
+			uprintf("Failed to randomize buffer - filling with constant value");
+			memset(zb, rand(), sizeof(zb));
+		}
+		CryptReleaseContext(hCryptProv, 0);
+		h = CreateFileU(volume_name, GENERIC_WRITE, FILE_SHARE_WRITE, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+		for (i = 0; i < TEST_IMG_SIZE * sizeof(zb); i++) {
+			if (!WriteFile(h, zb, sizeof(zb), &dwSize, NULL) || (dwSize != sizeof(zb))) {
+				uprintf("Write error: %s", WindowsErrorString());
+				break;
+			}
 		}
+		CloseHandle(h);
 	}
-	CloseHandle(h);
 #else
 	volume_name = GetExtPartitionName(DriveIndex, PartitionOffset);
 #endif
@@ -279,11 +291,9 @@ BOOL FormatExtFs(DWORD DriveIndex, uint64_t PartitionOffset, DWORD BlockSize, LP
 	if (strchr(volume_name, ' ') != NULL)
 		uprintf("Notice: Using physical device to access partition data");
 
-	if ((strcmp(FSName, FileSystemLabel[FS_EXT2]) != 0) && (strcmp(FSName, FileSystemLabel[FS_EXT3]) != 0)) {
-		if (strcmp(FSName, FileSystemLabel[FS_EXT4]) == 0)
-			uprintf("ext4 file system is not supported, defaulting to ext3");
-		else
-			uprintf("Invalid ext file system version requested, defaulting to ext3");
+	if ((strcmp(FSName, FileSystemLabel[FS_EXT2]) != 0) && (strcmp(FSName, FileSystemLabel[FS_EXT3]) != 0) &&
+		(strcmp(FSName, FileSystemLabel[FS_EXT4]) != 0)) {
+		uprintf("Invalid ext file system version requested, defaulting to ext3");
 		FSName = FileSystemLabel[FS_EXT3];
 	}
 
@@ -340,9 +350,24 @@ BOOL FormatExtFs(DWORD DriveIndex, uint64_t PartitionOffset, DWORD BlockSize, LP
 	ext2fs_set_feature_xattr(&features);
 	if (FSName[3] != '2')
 		ext2fs_set_feature_journal(&features);
+	if (FSName[3] == '4') {
+		// Same as the ext4 defaults from mke2fs.conf
+		ext2fs_set_feature_extents(&features);
+		ext2fs_set_feature_flex_bg(&features);
+		features.s_log_groups_per_flex = 4;
+		ext2fs_set_feature_huge_file(&features);
+		ext2fs_set_feature_dir_nlink(&features);
+		ext2fs_set_feature_64bit(&features);
+		ext2fs_set_feature_metadata_csum(&features);
+		if (features.s_inode_size >= sizeof(struct ext2_inode_large))
+			ext2fs_set_feature_extra_isize(&features);
+	}
 	features.s_default_mount_opts = EXT2_DEFM_XATTR_USER | EXT2_DEFM_ACL;
 
-	// Now that we have set our base features, initialize a virtual superblock
+	// Now that we have set our base features, initialize a virtual superblock.
+	// Metadata is written through a write-back cache, so that the many single
+	// block updates get coalesced into large writes to the device.
+	set_cache_io_backing_manager(nt_io_manager);
 	r = ext2fs_initialize(volume_name, EXT2_FLAG_EXCLUSIVE | EXT2_FLAG_64BITS, &features, manager, &ext2fs);
 	if (r != 0) {
 		SET_EXT2_FORMAT_ERROR(ERROR_INVALID_DATA);
@@ -363,6 +388,8 @@ BOOL FormatExtFs(DWORD DriveIndex, uint64_t PartitionOffset, DWORD BlockSize, LP
 
 	// Finish setting up the file system
 	IGNORE_RETVAL(CoCreateGuid((GUID*)ext2fs->super->s_uuid));
+	if (ext2fs_has_feature_metadata_csum(ext2fs->super))
+		ext2fs->super->s_checksum_type = EXT2_CRC32C_CHKSUM;
 	ext2fs_init_csum_seed(ext2fs);
 	ext2fs->super->s_def_hash_version = EXT2_HASH_HALF_MD4;
 	IGNORE_RETVAL(CoCreateGuid((GUID*)ext2fs->super->s_hash_seed));
@@ -384,22 +411,48 @@ BOOL FormatExtFs(DWORD DriveIndex, uint64_t PartitionOffset, DWORD BlockSize, LP
 		goto out;
 	}
 
+	// On quick format, let the kernel initialize the inode tables on first mount,
+	// rather than zeroing them all ourselves, which on large drives amounts to
+	// gigabytes of writes. This requires group descriptor checksums, which only
+	// ext4 has (through metadata_csum), so that ext2 and ext3 are left as they are.
+	lazy_itable_init = lazy_itable_init && ext2fs_has_group_desc_csum(ext2fs);
 	ext2_percent_start = 0.0f;
 	ext2_percent_share = (FSName[3] == '2') ? 1.0f : 0.5f;
-	uprintf("Creating %d inode sets: [1 marker = %0.1f set(s)]", ext2fs->group_desc_count,
-		max((float)ext2fs->group_desc_count / ext2_max_marker, 1.0f));
-	for (i = 0; i < (int)ext2fs->group_desc_count; i++) {
-		if (ext2fs_print_progress((int64_t)i, (int64_t)ext2fs->group_desc_count))
-			goto out;
-		cur = ext2fs_inode_table_loc(ext2fs, i);
-		count = ext2fs_div_ceil((ext2fs->super->s_inodes_per_group - ext2fs_bg_itable_unused(ext2fs, i))
-			* EXT2_INODE_SIZE(ext2fs->super), EXT2_BLOCK_SIZE(ext2fs->super));
-		r = ext2fs_zero_blocks2(ext2fs, cur, count, &cur, &count);
-		if (r != 0) {
-			SET_EXT2_FORMAT_ERROR(ERROR_WRITE_FAULT);
-			uprintf("\r\nCould not zero inode set at position %llu (%d blocks): %s", cur, count, error_message(r));
-			goto out;
+	uprintf("Creating %d inode sets%s: [1 marker = %0.1f set(s)]", ext2fs->group_desc_count,
+		lazy_itable_init ? " (lazy init)" : "", max((float)ext2fs->group_desc_count / ext2_max_marker, 1.0f));
+	for (i = 0; i <= (int)ext2fs->group_desc_count; i++) {
+		if (i < (int)ext2fs->group_desc_count) {
+			if (ext2fs_print_progress((int64_t)i, (int64_t)ext2fs->group_desc_count))
+				goto out;
+			cur = ext2fs_inode_table_loc(ext2fs, i);
+			if (lazy_itable_init) {
+				// Only zero the part of the table that holds the reserved inodes
+				count = ext2fs_div_ceil((ext2fs->super->s_inodes_per_group - ext2fs_bg_itable_unused(ext2fs, i))
+					* EXT2_INODE_SIZE(ext2fs->super), EXT2_BLOCK_SIZE(ext2fs->super));
+			} else {
+				count = ext2fs->inode_blocks_per_group;
+				if (ext2fs_has_group_desc_csum(ext2fs)) {
+					ext2fs_bg_flags_set(ext2fs, i, EXT2_BG_INODE_ZEROED);
+					ext2fs_group_desc_csum_set(ext2fs, i);
+				}
+			}
+			// Coalesce contiguous tables (e.g. with flex_bg) into a single large write
+			if ((count == 0) || ((run_count != 0) && (cur == run_start + run_count) &&
+				(run_count <= INT_MAX / 2 - count))) {
+				run_count += count;
+				continue;
+			}
+		}
+		if (run_count != 0) {
+			r = ext2fs_zero_blocks2(ext2fs, run_start, run_count, &run_start, &run_count);
+			if (r != 0) {
+				SET_EXT2_FORMAT_ERROR(ERROR_WRITE_FAULT);
+				uprintf("\r\nCould not zero inode set at position %llu (%d blocks): %s", run_start, run_count, error_message(r));
+				goto out;
+			}
 		}
+		run_start = cur;
+		run_count = count;
 	}
 	uprintfs("\r\n");
 
@@ -480,6 +533,12 @@ BOOL FormatExtFs(DWORD DriveIndex, uint64_t PartitionOffset, DWORD BlockSize, LP
 		ext2fs_new_inode(ext2fs, EXT2_ROOT_INO, 010755, 0, &inode_id);
 		ext2fs_link(ext2fs, EXT2_ROOT_INO, name, inode_id, EXT2_FT_REG_FILE);
 		ext2fs_inode_alloc_stats(ext2fs, inode_id, 1);
+		if (ext2fs_has_feature_extents(ext2fs->super)) {
+			// Set up an empty extent tree, so that data gets mapped through extents
+			ext2_extent_handle_t handle;
+			if (ext2fs_extent_open2(ext2fs, inode_id, &inode, &handle) == 0)
+				ext2fs_extent_free(handle);
+		}
 		ext2fs_write_new_inode(ext2fs, inode_id, &inode);
 		ext2fs_file_open(ext2fs, inode_id, EXT2_FILE_WRITE, &ext2fd);
 		if ((ext2fs_file_write(ext2fd, data, fsize, &written) != 0) || (written != fsize))
@@ -489,6 +548,10 @@ BOOL FormatExtFs(DWORD DriveIndex, uint64_t PartitionOffset, DWORD BlockSize, LP
 		ext2fs_file_close(ext2fd);
 	}
 
+	// Update the group descriptors' uninit flags and unused inode counts
+	if (ext2fs_has_group_desc_csum(ext2fs))
+		ext2fs_set_gdt_csum(ext2fs);
+
 	// Finally we can call close() to get the file system gets created
 	r = ext2fs_close(ext2fs);
 	if (r == 0) {
@@ -508,3 +571,53 @@ out:
 	free(buf);
 	return ret;
 }
+
+#if defined(RUFUS_TEST)
+/*
+ * Format a sparse image with each of ext2, ext3 and ext4, both quick and full,
+ * and report how much I/O actually reached the device through cache_io.
+ */
+BOOL ExtFsBenchmark(const char* path, uint64_t size)
+{
+	const int fs[] = { FS_EXT2, FS_EXT3, FS_EXT4 };
+	BOOL r, ret = TRUE;
+	DWORD cbRet;
+	HANDLE h;
+	LARGE_INTEGER li;
+	uint64_t start, elapsed;
+	int i, quick;
+
+	for (i = 0; i < ARRAYSIZE(fs); i++) {
+		for (quick = 1; quick >= 0; quick--) {
+			h = CreateFileU(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+				CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+			li.QuadPart = size;
+			if ((h == INVALID_HANDLE_VALUE) || !DeviceIoControl(h, FSCTL_SET_SPARSE, NULL, 0, NULL, 0, &cbRet, NULL) ||
+				!SetFilePointerEx(h, li, NULL, FILE_BEGIN) || !SetEndOfFile(h)) {
+				uprintf("Could not create '%s': %s", path, WindowsErrorString());
+				safe_closehandle(h);
+				ret = FALSE;
+				goto out;
+			}
+			safe_closehandle(h);
+
+			memset(&cache_io_backing_stats, 0, sizeof(cache_io_backing_stats));
+			ext_test_path = path;
+			start = GetTickCount64();
+			r = FormatExtFs(0, 0, 0, FileSystemLabel[fs[i]], "rufus_test", quick ? FP_QUICK : 0);
+			elapsed = max(GetTickCount64() - start, 1);
+			ext_test_path = NULL;
+			uprintf("%s %s format: %0.2f s, %llu reads (%0.1f MB), %llu writes (%0.1f MB), %llu zeroouts%s",
+				quick ? "Quick" : "Full", FileSystemLabel[fs[i]], elapsed / 1000.0f,
+				cache_io_backing_stats.reads, (float)cache_io_backing_stats.bytes_read / MB,
+				cache_io_backing_stats.writes, (float)cache_io_backing_stats.bytes_written / MB,
+				cache_io_backing_stats.zeroouts, r ? "" : " [FAILED]");
+			ret = ret && r;
+		}
+	}
+
+out:
+	DeleteFileU(path);
+	return ret;
+}
+#endif
@@ -35,10 +35,14 @@
 #include "format.h"
 #include "missing.h"
 #include "resource.h"
+#include "winio.h"
 #include "msapi_utf8.h"
 #include "localization.h"
 
 #define die(msg, err) do { uprintf(msg); ErrorStatus = RUFUS_ERROR(err); goto out; } while(0)
+// Size and number of the buffers used to clear the system area
+#define CLEAR_BUFFER_SIZE   (4 * MB)
+#define CLEAR_QUEUE_DEPTH   4
 
 extern BOOL write_as_esp;
 
@@ -149,6 +153,41 @@ static DWORD GetFATSizeSectors(DWORD DskSize, DWORD ReservedSecCnt, DWORD SecPer
  * Large FAT32 volume formatting from fat32format by Tom Thornhill
  * http://www.ridgecrop.demon.co.uk/index.htm?fat32format.htm
  */
+/*
+ * Zero the first qwSize bytes of a volume. If the target can zero the range
+ * on its own, as is the case for file images, we let it. Else we issue multi
+ * MB positional writes through an I/O queue.
+ */
+static BOOL ClearSystemArea(HANDLE hLogicalVolume, DWORD BytesPerSect, uint64_t qwSize, BOOL bAllowOffload)
+{
+	BOOL r = FALSE;
+	DWORD size;
+	IO_QUEUE q = { 0 };
+	FILE_ZERO_DATA_INFORMATION zero_data;
+
+	zero_data.FileOffset.QuadPart = 0;
+	zero_data.BeyondFinalZero.QuadPart = qwSize;
+	if (bAllowOffload && DeviceIoControl(hLogicalVolume, FSCTL_SET_ZERO_DATA, &zero_data, sizeof(zero_data), NULL, 0, &size, NULL)) {
+		UpdateProgressWithInfo(OP_FORMAT, MSG_217, qwSize, qwSize);
+		return TRUE;
+	}
+
+	// The volume is opened without write sharing, which we want to keep for the
+	// handle we format with, so it can't be reopened for overlapped access, and
+	// the queue issues synchronous writes.
+	if (!IoQueueInit(&q, NULL, hLogicalVolume, qwSize, BytesPerSect, CLEAR_BUFFER_SIZE, CLEAR_QUEUE_DEPTH)) {
+		uprintf("Could not initialize I/O queue: %s", WindowsErrorString());
+		ErrorStatus = RUFUS_ERROR(ERROR_NOT_ENOUGH_MEMORY);
+		goto out;
+	}
+	r = IoQueueCopy(&q, MSG_217);
+	uprintfs("\r\n");
+
+out:
+	IoQueueExit(&q);
+	return r;
+}
+
 BOOL FormatLargeFAT32(DWORD DriveIndex, uint64_t PartitionOffset, DWORD ClusterSize, LPCSTR FSName, LPCSTR Label, DWORD Flags)
 {
 	BOOL r = FALSE;
@@ -166,7 +205,6 @@ BOOL FormatLargeFAT32(DWORD DriveIndex, uint64_t PartitionOffset, DWORD ClusterS
 	DWORD BackupBootSect = 6;
 	DWORD VolumeId = 0; // calculated before format
 	char* VolumeName = NULL;
-	DWORD BurstSize = 128; // Zero in blocks of 64K typically
 
 	// Calculated later
 	DWORD FatSize = 0;
@@ -182,7 +220,6 @@ BOOL FormatLargeFAT32(DWORD DriveIndex, uint64_t PartitionOffset, DWORD ClusterS
 	FAT_BOOTSECTOR32* pFAT32BootSect = NULL;
 	FAT_FSINFO* pFAT32FsInfo = NULL;
 	DWORD* pFirstSectOfFat = NULL;
-	BYTE* pZeroSect = NULL;
 	char VolId[12] = "NO NAME    ";
 
 	// Debug temp vars
@@ -416,18 +453,9 @@ BOOL FormatLargeFAT32(DWORD DriveIndex, uint64_t PartitionOffset, DWORD ClusterS
 	SystemAreaSize = ReservedSectCount + (NumFATs * FatSize) + SectorsPerCluster;
 	uprintf("Clearing out %d sectors for reserved sectors, FATs and root cluster...", SystemAreaSize);
 
-	// Not the most effective, but easy on RAM
-	pZeroSect = (BYTE*)calloc(BytesPerSect, BurstSize);
-	if (!pZeroSect) {
-		die("Failed to allocate memory", ERROR_NOT_ENOUGH_MEMORY);
-	}
-
-	for (i = 0; i < (SystemAreaSize + BurstSize - 1); i += BurstSize) {
-		UpdateProgressWithInfo(OP_FORMAT, MSG_217, (uint64_t)i, (uint64_t)SystemAreaSize + BurstSize);
+	if (!ClearSystemArea(hLogicalVolume, BytesPerSect, (uint64_t)SystemAreaSize * BytesPerSect, TRUE)) {
 		CHECK_FOR_USER_CANCEL;
-		if (write_sectors(hLogicalVolume, BytesPerSect, i, BurstSize, pZeroSect) != (BytesPerSect * BurstSize)) {
-			die("Error clearing reserved sectors", ERROR_WRITE_FAULT);
-		}
+		die("Error clearing reserved sectors", ERROR_WRITE_FAULT);
 	}
 
 	uprintf ("Initializing reserved sectors and FATs...");
@@ -476,6 +504,105 @@ out:
 	safe_free(pFAT32BootSect);
 	safe_free(pFAT32FsInfo);
 	safe_free(pFirstSectOfFat);
-	safe_free(pZeroSect);
 	return r;
 }
+
+#if defined(RUFUS_TEST)
+/*
+ * Benchmark the clearing of a FAT32 system area, using a file image as target.
+ */
+BOOL ClearSystemAreaBenchmark(const char* path, uint64_t size)
+{
+	const DWORD BytesPerSect = 512, BurstSize = 128;
+	const char* method[3] = { "64 KB synchronous writes", "I/O queue", "Zeroing offload" };
+	BOOL r, ret = FALSE;
+	BYTE* pZeroSect = NULL;
+	HANDLE h = INVALID_HANDLE_VALUE;
+	LARGE_INTEGER li;
+	uint64_t i, start, elapsed;
+	int m;
+
+	h = CreateFileU(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+		CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	li.QuadPart = size;
+	if ((h == INVALID_HANDLE_VALUE) || !SetFilePointerEx(h, li, NULL, FILE_BEGIN) || !SetEndOfFile(h)) {
+		uprintf("Could not create '%s': %s", path, WindowsErrorString());
+		goto out;
+	}
+	pZeroSect = (BYTE*)calloc(BytesPerSect, BurstSize);
+	if (pZeroSect == NULL)
+		goto out;
+
+	for (m = 0, ret = TRUE; m < 3; m++) {
+		start = GetTickCount64();
+		if (m == 0) {
+			for (i = 0, r = TRUE; r && (i < size / BytesPerSect); i += BurstSize)
+				r = (write_sectors(h, BytesPerSect, i, BurstSize, pZeroSect) == (BytesPerSect * BurstSize));
+		} else {
+			r = ClearSystemArea(h, BytesPerSect, size, (m == 2));
+		}
+		FlushFileBuffers(h);
+		elapsed = max(GetTickCount64() - start, 1);
+		uprintf("%s: %s cleared in %0.2f s (%0.1f MB/s)%s", method[m], SizeToHumanReadable(size, FALSE, FALSE),
+			elapsed / 1000.0f, (1000.0f * size) / (1.0f * MB * elapsed), r ? "" : " [FAILED]");
+		ret = ret && r;
+	}
+
+out:
+	free(pZeroSect);
+	safe_closehandle(h);
+	DeleteFileU(path);
+	return ret;
+}
+
+/*
+ * Clear the start of a real volume, opened and locked the same way as when
+ * formatting (i.e. without write sharing), and check that it reads back as
+ * zeroes. THIS DESTROYS THE DATA ON THE VOLUME.
+ */
+BOOL ClearSystemAreaVolumeTest(const char* path, uint64_t size)
+{
+	const DWORD BytesPerSect = 4096;
+	BOOL r = FALSE;
+	DWORD cbRet;
+	HANDLE h;
+	uint8_t* buf = NULL;
+	uint64_t i, start, elapsed;
+
+	size -= size % CLEAR_BUFFER_SIZE;
+	h = CreateFileU(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (h == INVALID_HANDLE_VALUE) {
+		uprintf("Could not open '%s': %s", path, WindowsErrorString());
+		return FALSE;
+	}
+	if (!DeviceIoControl(h, FSCTL_LOCK_VOLUME, NULL, 0, NULL, 0, &cbRet, NULL)) {
+		uprintf("Could not lock '%s': %s", path, WindowsErrorString());
+		goto out;
+	}
+	UnmountVolume(h);
+
+	start = GetTickCount64();
+	r = ClearSystemArea(h, BytesPerSect, size, FALSE);
+	elapsed = max(GetTickCount64() - start, 1);
+	uprintf("%s of '%s' cleared in %0.2f s (%0.1f MB/s)", SizeToHumanReadable(size, FALSE, FALSE), path,
+		elapsed / 1000.0f, (1000.0f * size) / (1.0f * MB * elapsed));
+
+	buf = (uint8_t*)_mm_malloc(CLEAR_BUFFER_SIZE, BytesPerSect);
+	if (buf == NULL) {
+		r = FALSE;
+		goto out;
+	}
+	for (i = 0; r && (i < size); i += CLEAR_BUFFER_SIZE) {
+		r = (read_sectors(h, BytesPerSect, i / BytesPerSect, CLEAR_BUFFER_SIZE / BytesPerSect, buf) == CLEAR_BUFFER_SIZE) &&
+			IsBufferZero(buf, CLEAR_BUFFER_SIZE);
+		if (!r)
+			uprintf("Data at offset 0x%llx was not cleared", i);
+	}
+
+out:
+	safe_mm_free(buf);
+	safe_closehandle(h);
+	return r;
+}
+#endif
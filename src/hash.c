@@ -71,11 +71,13 @@
 
 #include "db.h"
 #include "rufus.h"
+#include "drive.h"
 #include "winio.h"
 #include "missing.h"
 #include "resource.h"
 #include "msapi_utf8.h"
 #include "localization.h"
+#include "bled/bled.h"
 
 #if (defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__i386) || \
      defined(_X86_) || defined(__I86__) || defined(__x86_64__))
@@ -91,22 +93,24 @@
 
 #undef BIG_ENDIAN_HOST
 
-#define BUFFER_SIZE         (64*KB)
 #define WAIT_TIME           5000
 
-/* Number of buffers we work with */
-#define NUM_BUFFERS         3   // 2 + 1 as a mere double buffered async I/O
-                                // would modify the buffer being processed.
+/* Number of buffers we work with. The read thread can be up to NUM_BUFFERS */
+/* blocks ahead of the slowest hash thread, which absorbs speed variations. */
+#define NUM_BUFFERS         8
 
 /* Globals */
 char hash_str[HASH_MAX][150];
-HANDLE data_ready[HASH_MAX] = { 0 }, thread_ready[HASH_MAX] = { 0 };
+HANDLE data_ready[HASH_MAX] = { 0 }, buffer_free = NULL;
 DWORD read_size[NUM_BUFFERS];
+volatile LONG buffer_refs[NUM_BUFFERS];
 BOOL enable_extra_hashes = FALSE, validate_md5sum = FALSE;
 BOOL cpu_has_sha1_accel = FALSE, cpu_has_sha256_accel = FALSE;
-uint8_t ALIGNED(64) buffer[NUM_BUFFERS][BUFFER_SIZE];
+uint8_t* buffer[NUM_BUFFERS] = { 0 };
 uint8_t* pe256ssp = NULL;
-uint32_t proc_bufnum, hash_count[HASH_MAX] = { MD5_HASHSIZE, SHA1_HASHSIZE, SHA256_HASHSIZE, SHA512_HASHSIZE };
+uint32_t hash_count[HASH_MAX] = { MD5_HASHSIZE, SHA1_HASHSIZE, SHA256_HASHSIZE, SHA512_HASHSIZE };
+uint32_t hash_buffer_size = HASH_BUFFER_SIZE;
+int num_hashes, num_hash_threads;
 uint32_t pe256ssp_size = 0;
 uint64_t md5sum_totalbytes;
 StrArray modified_files = { 0 };
@@ -1954,59 +1958,73 @@ INT_PTR CALLBACK HashCallback(HWND hDlg, UINT message, WPARAM wParam, LPARAM lPa
 	return (INT_PTR)FALSE;
 }
 
-/* Individual thread that computes one of MD5, SHA1, SHA256 or SHA512 in parallel */
+/*
+ * Individual thread that computes one or more of MD5, SHA1, SHA256 or SHA512 in parallel.
+ * Thread #i processes all the hashes h for which (h % num_hash_threads) == i, so that,
+ * when there aren't enough cores for one thread per hash, a single thread can compute
+ * all the digests from each block while it is still in the CPU cache.
+ */
 DWORD WINAPI IndividualHashThread(void* param)
 {
-	HASH_CONTEXT hash_ctx = { {0} }; // There's a memset in hash_init, but static analyzers still bug us
-	uint32_t i = (uint32_t)(uintptr_t)param, j;
+	HASH_CONTEXT hash_ctx[HASH_MAX] = { { {0} } }; // There's a memset in hash_init, but static analyzers still bug us
+	uint32_t i = (uint32_t)(uintptr_t)param, h, j, bufnum;
 
-	hash_init[i](&hash_ctx);
-	// Signal that we're ready to service requests
-	if (!SetEvent(thread_ready[i]))
-		goto error;
+	for (h = i; h < (uint32_t)num_hashes; h += num_hash_threads)
+		hash_init[h](&hash_ctx[h]);
 
-	// Wait for requests
-	while (1) {
-		if (WaitForSingleObject(data_ready[i], WAIT_TIME) != WAIT_OBJECT_0) {
+	// Process the buffers in the order they were read, for as long as the read thread provides them
+	for (bufnum = 0; ; bufnum = (bufnum + 1) % NUM_BUFFERS) {
+		if (WaitForSingleObject(data_ready[i], DRIVE_ACCESS_TIMEOUT + WAIT_TIME) != WAIT_OBJECT_0) {
 			uprintf("Failed to wait for event for hash thread #%d: %s", i, WindowsErrorString());
 			return 1;
 		}
-		if (read_size[proc_bufnum] != 0) {
-			hash_write[i](&hash_ctx, buffer[proc_bufnum], (size_t)read_size[proc_bufnum]);
-			if (!SetEvent(thread_ready[i]))
-				goto error;
-		} else {
-			hash_final[i](&hash_ctx);
-			memset(&hash_str[i], 0, ARRAYSIZE(hash_str[i]));
-			for (j = 0; j < hash_count[i]; j++) {
-				hash_str[i][2 * j] = ((hash_ctx.buf[j] >> 4) < 10) ?
-					((hash_ctx.buf[j] >> 4) + '0') : ((hash_ctx.buf[j] >> 4) - 0xa + 'a');
-				hash_str[i][2 * j + 1] = ((hash_ctx.buf[j] & 15) < 10) ?
-					((hash_ctx.buf[j] & 15) + '0') : ((hash_ctx.buf[j] & 15) - 0xa + 'a');
-			}
-			hash_str[i][2 * j] = 0;
-			return 0;
+		if (read_size[bufnum] == 0)
+			break;
+		for (h = i; h < (uint32_t)num_hashes; h += num_hash_threads)
+			hash_write[h](&hash_ctx[h], buffer[bufnum], (size_t)read_size[bufnum]);
+		// The last thread to be done with a buffer hands it back to the read thread
+		if ((InterlockedDecrement(&buffer_refs[bufnum]) == 0) && !ReleaseSemaphore(buffer_free, 1, NULL)) {
+			uprintf("Failed to release buffer from hash thread #%d: %s", i, WindowsErrorString());
+			return 1;
+		}
+	}
+
+	for (h = i; h < (uint32_t)num_hashes; h += num_hash_threads) {
+		hash_final[h](&hash_ctx[h]);
+		memset(&hash_str[h], 0, ARRAYSIZE(hash_str[h]));
+		for (j = 0; j < hash_count[h]; j++) {
+			hash_str[h][2 * j] = ((hash_ctx[h].buf[j] >> 4) < 10) ?
+				((hash_ctx[h].buf[j] >> 4) + '0') : ((hash_ctx[h].buf[j] >> 4) - 0xa + 'a');
+			hash_str[h][2 * j + 1] = ((hash_ctx[h].buf[j] & 15) < 10) ?
+				((hash_ctx[h].buf[j] & 15) + '0') : ((hash_ctx[h].buf[j] & 15) - 0xa + 'a');
 		}
+		hash_str[h][2 * j] = 0;
 	}
-error:
-	uprintf("Failed to set event for hash thread #%d: %s", i, WindowsErrorString());
-	return 1;
+	return 0;
 }
 
 DWORD WINAPI HashThread(void* param)
 {
 	DWORD_PTR* thread_affinity = (DWORD_PTR*)param;
+	DWORD_PTR affinity, dummy;
 	HANDLE hash_thread[HASH_MAX] = { NULL, NULL, NULL, NULL };
-	DWORD wr;
+	DWORD buf_size, wr;
 	VOID* fd = NULL;
+	uint8_t* buffers = NULL;
 	uint64_t processed_bytes;
 	int i, read_bufnum, r = -1;
-	int num_hashes = HASH_MAX - (enable_extra_hashes ? 0 : 1);
 
 	if ((image_path == NULL) || (thread_affinity == NULL))
 		ExitThread(r);
 
 	uprintf("\r\nComputing hash for '%s'...", image_path);
+	num_hashes = HASH_MAX - (enable_extra_hashes ? 0 : 1);
+
+	// If we don't have a core for each hash thread, in addition to the read thread,
+	// we are better off having a single thread process all the hashes.
+	num_hash_threads = num_hashes;
+	if (GetProcessAffinityMask(GetCurrentProcess(), &affinity, &dummy) && (popcnt64(affinity) < num_hashes + 1))
+		num_hash_threads = 1;
 
 	if (thread_affinity[0] != 0)
 		// Use the first affinity mask, as our read thread is the least
@@ -2015,14 +2033,27 @@ DWORD WINAPI HashThread(void* param)
 		// is usually in this first mask, for other tasks.
 		SetThreadAffinityMask(GetCurrentThread(), thread_affinity[0]);
 
-	for (i = 0; i < num_hashes; i++) {
-		// NB: Can't use a single manual-reset event for data_ready as we
-		// wouldn't be able to ensure the event is reset before the thread
-		// gets into its next wait loop
-		data_ready[i] = CreateEvent(NULL, FALSE, FALSE, NULL);
-		thread_ready[i] = CreateEvent(NULL, FALSE, FALSE, NULL);
-		if ((data_ready[i] == NULL) || (thread_ready[i] == NULL)) {
-			uprintf("Unable to create hash thread event: %s", WindowsErrorString());
+	// Our buffer size must be a multiple of the largest hash block size
+	buf_size = HI_ALIGN_X_TO_Y(min(max(hash_buffer_size, 64 * KB), 64 * MB), SHA512_BLOCKSIZE);
+	buffers = (uint8_t*)_mm_malloc((size_t)buf_size * NUM_BUFFERS, 64);
+	if (buffers == NULL) {
+		uprintf("Could not allocate hash buffers");
+		ErrorStatus = RUFUS_ERROR(ERROR_NOT_ENOUGH_MEMORY);
+		goto out;
+	}
+	for (i = 0; i < NUM_BUFFERS; i++)
+		buffer[i] = &buffers[(size_t)i * buf_size];
+
+	buffer_free = CreateSemaphore(NULL, NUM_BUFFERS, NUM_BUFFERS, NULL);
+	if (buffer_free == NULL) {
+		uprintf("Unable to create hash thread semaphore: %s", WindowsErrorString());
+		goto out;
+	}
+	for (i = 0; i < num_hash_threads; i++) {
+		// Each hash thread gets a semaphore with the number of buffers it can process
+		data_ready[i] = CreateSemaphore(NULL, 0, NUM_BUFFERS, NULL);
+		if (data_ready[i] == NULL) {
+			uprintf("Unable to create hash thread semaphore: %s", WindowsErrorString());
 			goto out;
 		}
 		hash_thread[i] = CreateThread(NULL, 0, IndividualHashThread, (LPVOID)(uintptr_t)i, 0, NULL);
@@ -2042,57 +2073,49 @@ DWORD WINAPI HashThread(void* param)
 		goto out;
 	}
 
-	read_bufnum = 0;
-	proc_bufnum = 1;
-	read_size[proc_bufnum] = 1;	// To avoid early loop exit
 	UpdateProgressWithInfoInit(hMainDialog, FALSE);
-
-	// Start the initial read
-	ReadFileAsync(fd, buffer[read_bufnum], BUFFER_SIZE);
-
-	for (processed_bytes = 0; read_size[proc_bufnum] != 0; processed_bytes += read_size[proc_bufnum]) {
+	for (processed_bytes = 0, read_bufnum = 0; ; read_bufnum = (read_bufnum + 1) % NUM_BUFFERS) {
 		// 0. Update the progress and check for cancel
 		UpdateProgressWithInfo(OP_NOOP_WITH_TASKBAR, MSG_271, processed_bytes, img_report.image_size);
 		CHECK_FOR_USER_CANCEL;
 
-		// 1. Wait for the current read operation to complete (and update the read size)
-		if ((!WaitFileAsync(fd, DRIVE_ACCESS_TIMEOUT)) ||
-			(!GetSizeAsync(fd, &read_size[read_bufnum]))) {
-			uprintf("Read error: %s", WindowsErrorString());
-			ErrorStatus = RUFUS_ERROR(ERROR_READ_FAULT);
+		// 1. Wait for all the hash threads to be done with the buffer we want to read into
+		if (WaitForSingleObject(buffer_free, DRIVE_ACCESS_TIMEOUT + WAIT_TIME) != WAIT_OBJECT_0) {
+			SetLastError(ERROR_TIMEOUT);
+			uprintf("Hash threads failed to signal: %s", WindowsErrorString());
 			goto out;
 		}
 
-		// 2. Switch to the next reading buffer
-		read_bufnum = (read_bufnum + 1) % NUM_BUFFERS;
-
-		// 3. Launch the next asynchronous read operation
-		ReadFileAsync(fd, buffer[read_bufnum], BUFFER_SIZE);
-
-		// 4. Wait for all the hash threads to indicate that they are ready to process data
-		wr = WaitForMultipleObjects(num_hashes, thread_ready, TRUE, WAIT_TIME);
-		if (wr != WAIT_OBJECT_0) {
-			if (wr == STATUS_TIMEOUT)
-				SetLastError(ERROR_TIMEOUT);
-			uprintf("Hash threads failed to signal: %s", WindowsErrorString());
+		// 2. Read the next block
+		ReadFileAsync(fd, buffer[read_bufnum], buf_size);
+		if ((!WaitFileAsync(fd, DRIVE_ACCESS_TIMEOUT)) || (!GetSizeAsync(fd, &read_size[read_bufnum]))) {
+			uprintf("Read error: %s", WindowsErrorString());
+			ErrorStatus = RUFUS_ERROR(ERROR_READ_FAULT);
 			goto out;
 		}
 
-		// 5. Set the target buffer we want to process to the buffer we just read data into
-		// Note that this variable should only be updated AFTER all the threads have signalled.
-		proc_bufnum = (read_bufnum + NUM_BUFFERS - 1) % NUM_BUFFERS;
-
-		// 6. Signal the waiting threads that there is data available
-		for (i = 0; i < num_hashes; i++) {
-			if (!SetEvent(data_ready[i])) {
+		// 3. Hand the block over to all the hash threads at once. A zero
+		// sized block indicates that the threads should finalize the hashes.
+		buffer_refs[read_bufnum] = num_hash_threads;
+		for (i = 0; i < num_hash_threads; i++) {
+			if (!ReleaseSemaphore(data_ready[i], 1, NULL)) {
 				uprintf("Could not signal hash thread %d: %s", i, WindowsErrorString());
 				goto out;
 			}
 		}
+		if (read_size[read_bufnum] == 0)
+			break;
+		processed_bytes += read_size[read_bufnum];
 	}
 
-	// Our last event with read_size=0 signaled the threads to exit - wait for that to happen
-	if (WaitForMultipleObjects(num_hashes, hash_thread, TRUE, WAIT_TIME) != WAIT_OBJECT_0) {
+	// Our last block with read_size=0 signaled the threads to exit - wait for that to happen.
+	// With large buffers, the threads may still have a lot of queued data to process, so
+	// only give up if the user cancels or if waiting fails.
+	do {
+		CHECK_FOR_USER_CANCEL;
+		wr = WaitForMultipleObjects(num_hash_threads, hash_thread, TRUE, WAIT_TIME);
+	} while (wr == WAIT_TIMEOUT);
+	if (wr != WAIT_OBJECT_0) {
 		uprintf("Hash threads did not finalize: %s", WindowsErrorString());
 		goto out;
 	}
@@ -2110,19 +2133,329 @@ DWORD WINAPI HashThread(void* param)
 	r = 0;
 
 out:
-	for (i = 0; i < num_hashes; i++) {
-		if (hash_thread[i] != NULL)
+	for (i = 0; i < num_hash_threads; i++) {
+		if (hash_thread[i] != NULL) {
 			TerminateThread(hash_thread[i], 1);
+			CloseHandle(hash_thread[i]);
+		}
 		safe_closehandle(data_ready[i]);
-		safe_closehandle(thread_ready[i]);
 	}
+	safe_closehandle(buffer_free);
 	CloseFileAsync(fd);
+	memset(buffer, 0, sizeof(buffer));
+	safe_mm_free(buffers);
 	PostMessage(hMainDialog, UM_FORMAT_COMPLETED, (WPARAM)FALSE, 0);
 	if (r == 0)
 		MyDialogBox(hMainInstance, IDD_HASH, hMainDialog, HashCallback);
 	ExitThread(r);
 }
 
+/*
+ * Batch hashing of multiple images and/or devices, with the SHA-256 results
+ * written as a 'sha256sum' compatible manifest. Items are distributed over
+ * a pool of worker threads, with a limit on the number of concurrent reads
+ * for each physical disk, so that a spinning disk isn't thrashed by having
+ * multiple images read from it at the same time, while still letting the
+ * items that reside on other disks proceed at full speed.
+ */
+#define BATCH_MAX_WORKERS       16
+#define BATCH_HDD_LIMIT         1	// Concurrent reads for disks that incur a seek penalty
+#define BATCH_SSD_LIMIT         4	// Concurrent reads for disks that don't
+#define BATCH_UNKNOWN_DISK      MAX_DRIVES
+
+typedef struct {
+	char* path;
+	char* name;	// The path with forward slashes, as it appears in the output and the manifest
+	int disk;
+	BOOL started;
+	BOOL hashed;
+	char hash[2 * SHA256_HASHSIZE + 1];
+} BATCH_ITEM;
+
+static struct {
+	CRITICAL_SECTION lock;
+	CONDITION_VARIABLE slot_freed;
+	BATCH_ITEM* item;
+	uint32_t num_items;
+	uint32_t buf_size;
+	int active[MAX_DRIVES + 1];
+	int limit[MAX_DRIVES + 1];
+} batch;
+
+/* Query whether a device is a spinning disk. If we can't tell, we assume it is. */
+static BOOL IncursSeekPenalty(HANDLE hDevice)
+{
+	STORAGE_PROPERTY_QUERY query = { StorageDeviceSeekPenaltyProperty, PropertyStandardQuery };
+	DEVICE_SEEK_PENALTY_DESCRIPTOR desc = { 0 };
+	DWORD size = 0;
+
+	if (!DeviceIoControl(hDevice, IOCTL_STORAGE_QUERY_PROPERTY, &query, sizeof(query),
+		&desc, sizeof(desc), &size, NULL) || (size < sizeof(desc)))
+		return TRUE;
+	return desc.IncursSeekPenalty;
+}
+
+/* Return the physical disk an item resides on, or BATCH_UNKNOWN_DISK */
+static int GetBatchItemDisk(const char* path, BOOL* seek_penalty)
+{
+	char volume_path[MAX_PATH], volume_name[MAX_PATH];
+	const char* device = path;
+	HANDLE hDevice;
+	int disk;
+
+	*seek_penalty = TRUE;
+	if (strncmp(path, "\\\\.\\", 4) != 0) {
+		if (!GetVolumePathNameU(path, volume_path, sizeof(volume_path)) ||
+			!GetVolumeNameForVolumeMountPointU(volume_path, volume_name, sizeof(volume_name)))
+			return BATCH_UNKNOWN_DISK;
+		// Volume GUID paths must not have a trailing backslash when opened
+		volume_name[strlen(volume_name) - 1] = 0;
+		device = volume_name;
+	}
+	// We only need to issue IOCTLs, so no access rights are required
+	hDevice = CreateFileU(device, 0, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, 0, NULL);
+	if (hDevice == INVALID_HANDLE_VALUE)
+		return BATCH_UNKNOWN_DISK;
+	disk = GetDriveNumber(hDevice, (char*)device);
+	*seek_penalty = IncursSeekPenalty(hDevice);
+	CloseHandle(hDevice);
+	return (disk < 0) ? BATCH_UNKNOWN_DISK : disk;
+}
+
+/* Compute the SHA-256 of a single item, with double buffering of the reads */
+static BOOL BatchHashItem(BATCH_ITEM* item, uint8_t* buf[2])
+{
+	BOOL r = FALSE;
+	HASH_CONTEXT hash_ctx = { {0} };
+	GET_LENGTH_INFORMATION li;
+	LARGE_INTEGER li_size;
+	VOID* fd = NULL;
+	DWORD rs, size;
+	uint64_t total, processed_bytes;
+	uint32_t i;
+	int cur = 0;
+
+	fd = CreateFileAsync(item->path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, OPEN_EXISTING,
+		FILE_FLAG_SEQUENTIAL_SCAN);
+	if (fd == NULL) {
+		uprintf("Could not open '%s': %s", item->name, WindowsErrorString());
+		goto out;
+	}
+	// Devices don't report a file size, so we need to query their length
+	if (DeviceIoControl(((ASYNC_FD*)fd)->hFile, IOCTL_DISK_GET_LENGTH_INFO, NULL, 0, &li, sizeof(li), &size, NULL)) {
+		total = li.Length.QuadPart;
+	} else if (GetFileSizeEx(((ASYNC_FD*)fd)->hFile, &li_size)) {
+		total = li_size.QuadPart;
+	} else {
+		uprintf("Could not get size of '%s': %s", item->name, WindowsErrorString());
+		goto out;
+	}
+
+	hash_init[HASH_SHA256](&hash_ctx);
+	// Always issue the next read before hashing the block we already have
+	if (total != 0)
+		ReadFileAsync(fd, buf[cur], (DWORD)min(total, batch.buf_size));
+	for (processed_bytes = 0; processed_bytes < total; processed_bytes += rs, cur ^= 1) {
+		if ((!WaitFileAsync(fd, DRIVE_ACCESS_TIMEOUT)) || (!GetSizeAsync(fd, &rs)) || (rs == 0)) {
+			uprintf("Read error on '%s': %s", item->name, WindowsErrorString());
+			goto out;
+		}
+		if (processed_bytes + rs < total)
+			ReadFileAsync(fd, buf[cur ^ 1], (DWORD)min(total - processed_bytes - rs, batch.buf_size));
+		hash_write[HASH_SHA256](&hash_ctx, buf[cur], (size_t)rs);
+	}
+	hash_final[HASH_SHA256](&hash_ctx);
+
+	for (i = 0; i < SHA256_HASHSIZE; i++)
+		sprintf(&item->hash[2 * i], "%02x", hash_ctx.buf[i]);
+	r = TRUE;
+
+out:
+	CloseFileAsync(fd);
+	return r;
+}
+
+static DWORD WINAPI BatchHashWorker(void* param)
+{
+	uint8_t* buf[2];
+	uint32_t i;
+	BOOL pending;
+	BATCH_ITEM* item;
+
+	buf[0] = (uint8_t*)_mm_malloc((size_t)batch.buf_size * 2, 4096);
+	if (buf[0] == NULL)
+		return 1;
+	buf[1] = &buf[0][batch.buf_size];
+
+	EnterCriticalSection(&batch.lock);
+	while (1) {
+		// Pick the first pending item whose disk still has a read slot available,
+		// rather than block on a busy disk while items from other disks wait.
+		item = NULL;
+		pending = FALSE;
+		for (i = 0; i < batch.num_items; i++) {
+			if (batch.item[i].started)
+				continue;
+			pending = TRUE;
+			if (batch.active[batch.item[i].disk] < batch.limit[batch.item[i].disk]) {
+				item = &batch.item[i];
+				break;
+			}
+		}
+		if (!pending)
+			break;
+		if (item == NULL) {
+			SleepConditionVariableCS(&batch.slot_freed, &batch.lock, INFINITE);
+			continue;
+		}
+		item->started = TRUE;
+		batch.active[item->disk]++;
+		LeaveCriticalSection(&batch.lock);
+
+		item->hashed = BatchHashItem(item, buf);
+
+		EnterCriticalSection(&batch.lock);
+		batch.active[item->disk]--;
+		if (item->hashed)
+			printf("%s  %s\n", item->hash, item->name);
+		else
+			fprintf(stderr, "Could not hash '%s'\n", item->name);
+		WakeAllConditionVariable(&batch.slot_freed);
+	}
+	LeaveCriticalSection(&batch.lock);
+
+	_mm_free(buf[0]);
+	return 0;
+}
+
+/*
+ * Hash all the files and devices ('\\.\PhysicalDriveN') listed in list_path, one per line,
+ * and write the SHA-256 manifest to '<list_path>.sha256'. Empty lines and lines starting
+ * with '#' are ignored. Returns the number of items that could not be hashed, or -1 on error.
+ */
+int BatchHash(const char* list_path)
+{
+	FILE *fd = NULL;
+	char line[MAX_PATH + 2], path[MAX_PATH], manifest_path[MAX_PATH], *p, *q;
+	HANDLE worker[BATCH_MAX_WORKERS] = { 0 };
+	DWORD_PTR affinity, dummy;
+	StrArray paths, names;
+	BOOL seek_penalty;
+	uint32_t i, num_workers;
+	int r = -1;
+
+	StrArrayCreate(&paths, 64);
+	StrArrayCreate(&names, 64);
+	memset(&batch, 0, sizeof(batch));
+	InitializeCriticalSection(&batch.lock);
+	InitializeConditionVariable(&batch.slot_freed);
+
+	fd = fopenU(list_path, "r");
+	if (fd == NULL) {
+		printf("Could not open list '%s'\n", list_path);
+		goto out;
+	}
+	while (fgets(line, sizeof(line), fd) != NULL) {
+		// Trim leading and trailing whitespaces, including CR/LF
+		for (p = line; (*p == ' ') || (*p == '\t'); p++);
+		for (q = &p[strlen(p)]; (q > p) && ((q[-1] == ' ') || (q[-1] == '\t') || (q[-1] == '\r') || (q[-1] == '\n')); q--);
+		*q = 0;
+		if ((*p == 0) || (*p == '#'))
+			continue;
+		// Leave device paths alone, as GetFullPathName() would mangle them
+		if (strncmp(p, "\\\\.\\", 4) == 0)
+			static_strcpy(path, p);
+		else if (GetFullPathNameU(p, sizeof(path), path, NULL) == 0)
+			static_strcpy(path, p);
+		StrArrayAdd(&paths, path, TRUE);
+		// Backslashes are converted to forward slashes, which Windows accepts, since
+		// sha256sum otherwise expects escaping of any line where the path contains a
+		// backslash. The same form is used for the console and the log, so that what
+		// gets reported matches the manifest.
+		for (p = path; *p != 0; p++)
+			if (*p == '\\')
+				*p = '/';
+		StrArrayAdd(&names, path, TRUE);
+	}
+	fclose(fd);
+	fd = NULL;
+	if (paths.Index == 0) {
+		printf("No items to hash in '%s'\n", list_path);
+		goto out;
+	}
+
+	batch.num_items = paths.Index;
+	batch.item = calloc(batch.num_items, sizeof(BATCH_ITEM));
+	if (batch.item == NULL)
+		goto out;
+	for (i = 0; i <= BATCH_UNKNOWN_DISK; i++)
+		batch.limit[i] = BATCH_SSD_LIMIT;
+	for (i = 0; i < batch.num_items; i++) {
+		batch.item[i].path = paths.String[i];
+		batch.item[i].name = names.String[i];
+		batch.item[i].disk = GetBatchItemDisk(paths.String[i], &seek_penalty);
+		if (seek_penalty)
+			batch.limit[batch.item[i].disk] = BATCH_HDD_LIMIT;
+		if (batch.item[i].disk != BATCH_UNKNOWN_DISK)
+			uprintf("'%s' is on disk %d%s", batch.item[i].name, batch.item[i].disk, seek_penalty ? " (HDD)" : "");
+	}
+	// Since we can't tell what's behind items we couldn't map, be conservative
+	batch.limit[BATCH_UNKNOWN_DISK] = BATCH_HDD_LIMIT;
+
+	// Our buffer size must be a multiple of the sector size for device reads
+	batch.buf_size = HI_ALIGN_X_TO_Y(min(max(hash_buffer_size, 64 * KB), 64 * MB), 4 * KB);
+	num_workers = BATCH_MAX_WORKERS;
+	if (GetProcessAffinityMask(GetCurrentProcess(), &affinity, &dummy))
+		num_workers = min(num_workers, (uint32_t)popcnt64(affinity));
+	num_workers = max(min(num_workers, batch.num_items), 1);
+	uprintf("Hashing %d item(s) from '%s' using %d thread(s)...", batch.num_items, list_path, num_workers);
+
+	for (i = 0; i < num_workers; i++) {
+		worker[i] = CreateThread(NULL, 0, BatchHashWorker, NULL, 0, NULL);
+		if (worker[i] == NULL) {
+			uprintf("Unable to start batch hash thread #%d", i);
+			break;
+		}
+		SetThreadPriority(worker[i], default_thread_priority);
+	}
+	if (i == 0)
+		goto out;
+	WaitForMultipleObjects(i, worker, TRUE, INFINITE);
+	for (i = 0; i < num_workers; i++) {
+		if (worker[i] != NULL)
+			CloseHandle(worker[i]);
+	}
+
+	// Write the manifest in the same order as the list
+	static_sprintf(manifest_path, "%s.sha256", list_path);
+	fd = fopenU(manifest_path, "wb");
+	if (fd == NULL) {
+		printf("Could not create manifest '%s'\n", manifest_path);
+		goto out;
+	}
+	r = 0;
+	for (i = 0; i < batch.num_items; i++) {
+		if (!batch.item[i].hashed) {
+			r++;
+			continue;
+		}
+		fprintf(fd, "%s  %s\n", batch.item[i].hash, batch.item[i].name);
+	}
+	printf("Wrote %d hash(es) to '%s'", batch.num_items - r, manifest_path);
+	if (r != 0)
+		printf(" (%d item(s) failed)", r);
+	printf("\n");
+
+out:
+	if (fd != NULL)
+		fclose(fd);
+	safe_free(batch.item);
+	StrArrayDestroy(&paths);
+	StrArrayDestroy(&names);
+	DeleteCriticalSection(&batch.lock);
+	return r;
+}
+
 /*
  * The following 2 calls are used to check whether a buffer/file is in our hash DB
  */
@@ -2531,6 +2864,58 @@ const char* test_hash[HASH_MAX][4] = {
 	},
 };
 
+/* Tests the CRC-32 and CRC-32C implementations, and displays their throughput */
+static int TestCrcs(void)
+{
+	const char* impl_name[BLED_CRC_MAX] = { "auto", "byte", "slice8", "hw" };
+	const char* check_msg = "123456789";
+	const size_t bench_size = 64 * MB;
+	size_t i;
+	int impl, errors = 0, impl_errors;
+	uint32_t crc, crc_ref = 0, crcc_ref = 0;
+	uint64_t start, elapsed[2];
+	uint8_t* buf = malloc(bench_size);
+	if (buf == NULL)
+		return -1;
+
+	for (i = 0; i < bench_size; i++)
+		buf[i] = (uint8_t)(i * 7 + (i >> 11));
+	uprintf("CRC    acceleration: %s", (bled_crc_select(BLED_CRC_AUTO) == BLED_CRC_HW) ? "TRUE" : "FALSE");
+
+	for (impl = BLED_CRC_BYTEWISE; impl < BLED_CRC_MAX; impl++) {
+		if (bled_crc_select(impl) != impl)
+			continue;
+		// Check values from https://reveng.sourceforge.io/crc-catalogue/
+		if (~bled_crc32(~0, check_msg, 9) != 0xcbf43926 || ~bled_crc32c(~0, check_msg, 9) != 0xe3069283) {
+			uprintf("Test CRC %-6s: FAIL (check value)", impl_name[impl]);
+			errors++;
+			continue;
+		}
+		impl_errors = errors;
+		start = GetTickCount64();
+		crc = bled_crc32(~0, buf, bench_size);
+		elapsed[0] = max(GetTickCount64() - start, 1);
+		if (impl == BLED_CRC_BYTEWISE)
+			crc_ref = crc;
+		else if (crc != crc_ref)
+			errors++;
+		start = GetTickCount64();
+		crc = bled_crc32c(~0, buf, bench_size);
+		elapsed[1] = max(GetTickCount64() - start, 1);
+		if (impl == BLED_CRC_BYTEWISE)
+			crcc_ref = crc;
+		else if (crc != crcc_ref)
+			errors++;
+		uprintf("Test CRC %-6s: %s (CRC-32: %lld MB/s, CRC-32C: %lld MB/s)", impl_name[impl],
+			(errors == impl_errors) ? "PASS" : "FAIL", (1000 * (uint64_t)bench_size) / (MB * elapsed[0]),
+			(1000 * (uint64_t)bench_size) / (MB * elapsed[1]));
+	}
+	bled_crc_select(BLED_CRC_AUTO);
+
+	free(buf);
+	return errors;
+}
+
 /* Tests the message digest algorithms */
 int TestHashes(void)
 {
@@ -2572,6 +2957,6 @@ int TestHashes(void)
 	}
 
 	free(msg);
-	return errors;
+	return errors + TestCrcs();
 }
 #endif
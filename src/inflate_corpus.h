@@ -0,0 +1,835 @@
+/*
+ * Rufus: The Reliable USB Formatting Utility
+ * Golden corpus for the gzip decoder tests
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#pragma once
+
+/*
+ * NB: The uncompressed data of each entry is what inflate_test_data() from vhd.c produces
+ * for 'size' and 'seed' (a seed of 0 means all zeroes). It was compressed with Python's
+ * zlib.compressobj(level, zlib.DEFLATED, 16 + wbits, 8, strategy), using level 6 and
+ * wbits 15 unless the comment of the entry says otherwise. The "flush" entry issues a
+ * Z_SYNC_FLUSH after the first third of the data and a Z_FULL_FLUSH after the second
+ * one, and the "multi" entry holds the first and second halves of the data as separate
+ * members, at levels 6 and 9.
+ */
+typedef struct {
+	const char* name;
+	const uint8_t* data;
+	size_t len;
+	uint32_t size;
+	uint32_t seed;
+} inflate_test_case;
+
+static const uint8_t inflate_empty[] = {
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+static const uint8_t inflate_one[] = {
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x73, 0x04, 0x00, 0x8b, 0x9e, 0xd9, 0xd3, 0x01, 0x00, 0x00,
+	0x00
+};
+
+static const uint8_t inflate_stored[] = {
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x03, 0x01, 0xe8, 0x03, 0x17, 0xfc, 0x43, 0x70, 0x61, 0x72, 0x74,
+	0x69, 0x74, 0x69, 0x6f, 0x6e, 0x70, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x6f,
+	0x6e, 0x70, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x6f, 0x6e, 0x70, 0x61, 0x72,
+	0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x6f, 0x6e, 0x70, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69,
+	0x6f, 0x6e, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x6f, 0x6e, 0x70, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x69, 0x6d,
+	0x61, 0x67, 0x65, 0x6f, 0x6e, 0x70, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x6f,
+	0x6e, 0x70, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x6f, 0x6e, 0x70, 0x61, 0x72,
+	0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x7f, 0x45, 0x4c, 0x46, 0x6e, 0x69, 0x6d, 0x61, 0x67,
+	0x65, 0x6f, 0x6e, 0x70, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x6f, 0x6e, 0x70,
+	0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x7f, 0x45, 0x4c, 0x46, 0x6e, 0x69, 0x6d,
+	0x61, 0x67, 0x65, 0x6f, 0x6e, 0x70, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x6f,
+	0x6e, 0x70, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x7f, 0x45, 0x4c, 0x46, 0x6e,
+	0x69, 0x6d, 0x61, 0x67, 0x65, 0x6f, 0x6e, 0x70, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x69, 0x6d, 0x61, 0x67,
+	0x65, 0x6f, 0x6e, 0x70, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x4c, 0x40, 0x48, 0x48, 0x4a, 0x41, 0x0d, 0x0a, 0x7f, 0x45,
+	0x4c, 0x46, 0x42, 0x4e, 0x41, 0x4c, 0x7f, 0x45, 0x4c, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46,
+	0x49, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69,
+	0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61,
+	0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65,
+	0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69,
+	0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61,
+	0x67, 0x43, 0x7f, 0x45, 0x4c, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46,
+	0x49, 0x46, 0x49, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65,
+	0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69,
+	0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61,
+	0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65,
+	0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x43, 0x7f, 0x45,
+	0x4c, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x69,
+	0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61,
+	0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65,
+	0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69,
+	0x6d, 0x61, 0x67, 0x65, 0xff, 0xfe, 0x4c, 0x0d, 0x0a, 0x40, 0x73, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x69, 0x6d, 0x61, 0x67,
+	0x65, 0x46, 0x48, 0x46, 0x73, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67,
+	0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41,
+	0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x43, 0x7f, 0x45, 0x4c, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49,
+	0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d,
+	0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67,
+	0x65, 0x41, 0x69, 0x4e, 0x76, 0x6f, 0x6c, 0x75, 0x6d, 0x65, 0x70, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x69,
+	0x6d, 0x61, 0x67, 0x65, 0x6f, 0x6e, 0x70, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x4c, 0x40, 0x48, 0x48, 0x4a, 0x41, 0x0d,
+	0x0a, 0x7f, 0x45, 0x4c, 0x46, 0x42, 0x4e, 0x41, 0x4c, 0x7f, 0x45, 0x4c, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49,
+	0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x46, 0x49, 0x69, 0x6d, 0x61, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x4c,
+	0x40, 0x48, 0x48, 0x4a, 0x41, 0x0d, 0x0a, 0x7f, 0x45, 0x4c, 0x46, 0x42, 0x4e, 0x41, 0x4c, 0x7f, 0x45, 0x4c, 0x46, 0x4b,
+	0x4b, 0x48, 0x6e, 0x70, 0x61, 0x72, 0x74, 0x69, 0x44, 0x0d, 0x0a, 0x4b, 0x48, 0x6e, 0x70, 0x61, 0x72, 0x74, 0x69, 0x44,
+	0x0d, 0x0a, 0x4b, 0x48, 0x6e, 0x70, 0x61, 0x72, 0x74, 0x69, 0x44, 0x0d, 0x0a, 0x4b, 0x48, 0x6e, 0x70, 0x61, 0x72, 0x74,
+	0x69, 0x44, 0x0d, 0x0a, 0x4b, 0x48, 0x6e, 0x70, 0x61, 0x72, 0x74, 0x69, 0x44, 0x0d, 0x0a, 0x4b, 0x48, 0x6e, 0x70, 0x61,
+	0x72, 0x74, 0x69, 0x44, 0x0d, 0x0a, 0x4b, 0x48, 0x6e, 0x70, 0x61, 0x72, 0x74, 0x69, 0x44, 0x0d, 0x0a, 0x4b, 0x48, 0x6e,
+	0x70, 0x61, 0x72, 0x74, 0x69, 0x44, 0x0d, 0x0a, 0x44, 0x70, 0x61, 0x72, 0x74, 0x69, 0x74, 0x69, 0x6f, 0x6e, 0x69, 0x6d,
+	0x61, 0x67, 0x65, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61,
+	0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65,
+	0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0xff, 0xfe, 0x4c, 0x0d, 0x0a, 0x40, 0x73, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x69, 0x6d,
+	0x61, 0x67, 0x65, 0x46, 0x48, 0x46, 0x73, 0x65, 0x63, 0x74, 0x6f, 0x72, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d,
+	0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x41, 0x69, 0x6d, 0x61, 0x67, 0x65, 0x22, 0x90, 0x06, 0x97, 0xe8,
+	0x03, 0x00, 0x00
+};
+
+static const uint8_t inflate_fixed[] = {
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x03, 0x73, 0xf3, 0xe7, 0xe5, 0x72, 0xf5, 0x2e, 0x2d, 0x4e, 0x2a,
+	0xcb, 0xcf, 0x29, 0xcd, 0x4d, 0x2d, 0x4e, 0x4d, 0x2e, 0xc9, 0x2f, 0x82, 0xb0, 0x49, 0xa1, 0x9c, 0xa9, 0x23, 0x05, 0x74,
+	0x87, 0xfb, 0x70, 0xa6, 0x29, 0x0c, 0x15, 0x37, 0x37, 0x4f, 0x1c, 0x54, 0x71, 0xd2, 0xff, 0x7f, 0xae, 0x2e, 0x90, 0xd8,
+	0xf3, 0x18, 0x14, 0x5e, 0xa5, 0x49, 0x50, 0xa5, 0x14, 0x65, 0x96, 0xa5, 0xba, 0x13, 0x19, 0x54, 0xce, 0x40, 0x4e, 0xbd,
+	0xab, 0x8f, 0x9b, 0xa3, 0x33, 0x2f, 0x97, 0xa7, 0x5f, 0x51, 0x69, 0x5a, 0x69, 0x31, 0xb1, 0x49, 0x2d, 0x33, 0x37, 0x31,
+	0x3d, 0x35, 0x19, 0x18, 0xac, 0x25, 0xa9, 0x45, 0xc3, 0x34, 0xae, 0x9c, 0x9c, 0x07, 0xc2, 0x5a, 0x27, 0x1f, 0x68, 0xa8,
+	0x16, 0x24, 0x16, 0x95, 0x64, 0x96, 0x64, 0xe6, 0xe7, 0x79, 0x39, 0xfa, 0x26, 0xe5, 0xe7, 0x97, 0x78, 0xfa, 0x93, 0x97,
+	0x38, 0xdc, 0xc1, 0xf1, 0xea, 0x4d, 0xb6, 0xbb, 0xc0, 0x96, 0x3b, 0x42, 0x4c, 0xf3, 0x03, 0xa5, 0x16, 0x17, 0x47, 0x07,
+	0x07, 0x27, 0x7f, 0x7f, 0x10, 0x73, 0x78, 0x26, 0xd0, 0xff, 0xff, 0xa0, 0xfa, 0x7c, 0x86, 0x54, 0x79, 0x3c, 0x98, 0x4b,
+	0x5e, 0x68, 0x80, 0x7a, 0x41, 0xb4, 0x0e, 0xab, 0x6c, 0x4f, 0x64, 0x78, 0x82, 0x92, 0xb1, 0x07, 0x44, 0x04, 0x92, 0x23,
+	0x1d, 0xbd, 0x07, 0x71, 0x16, 0x20, 0x1c, 0xab, 0x34, 0x54, 0xee, 0x02, 0x2a, 0x71, 0xfc, 0xdc, 0xc0, 0x7e, 0x1d, 0xa1,
+	0xa9, 0x81, 0x0c, 0x69, 0x5f, 0x07, 0x4f, 0x78, 0x95, 0x41, 0xd5, 0xba, 0xc1, 0x13, 0xa2, 0x7a, 0xf8, 0xa4, 0x92, 0x91,
+	0x15, 0xdd, 0x40, 0xca, 0x0b, 0x5c, 0xe9, 0x0e, 0x58, 0x46, 0x23, 0xa5, 0xb4, 0x41, 0x2a, 0xee, 0xe0, 0xde, 0xa3, 0x6a,
+	0x06, 0xf6, 0xf0, 0x19, 0x89, 0xf1, 0xe8, 0xe4, 0xec, 0xed, 0xe5, 0x3f, 0x48, 0xb2, 0x1f, 0xd1, 0xb4, 0x33, 0xd8, 0xbb,
+	0xd0, 0x0a, 0xcc, 0xe9, 0xff, 0x3f, 0x90, 0x14, 0xd4, 0xaa, 0xc1, 0x5b, 0x74, 0x82, 0xdd, 0x0c, 0x26, 0x40, 0x89, 0x85,
+	0x76, 0x35, 0x38, 0xd8, 0x0a, 0x4f, 0x87, 0x61, 0x1c, 0x80, 0x2e, 0x8e, 0x2e, 0xfe, 0x9e, 0x5e, 0xc3, 0xb6, 0x16, 0xfb,
+	0xff, 0xcf, 0x0b, 0x28, 0xe9, 0x8b, 0x48, 0x2f, 0xd8, 0xca, 0xc0, 0x41, 0xd5, 0xe4, 0x23, 0xdc, 0x3e, 0x87, 0xda, 0x0c,
+	0xf6, 0xce, 0xff, 0x7f, 0x6e, 0x1e, 0x40, 0x71, 0xa8, 0x10, 0xc4, 0x2a, 0x90, 0xaf, 0x1c, 0xc0, 0xb2, 0x3e, 0x90, 0x78,
+	0x06, 0x77, 0x6c, 0xbd, 0xa1, 0x6a, 0x68, 0x55, 0x22, 0x03, 0xb5, 0x02, 0x11, 0x7d, 0xba, 0x1c, 0x0e, 0x74, 0x4c, 0x41,
+	0x14, 0x15, 0xc4, 0x3e, 0xa0, 0x90, 0xa3, 0x52, 0x59, 0x8d, 0x1a, 0x27, 0xbe, 0xc0, 0x54, 0x3b, 0x18, 0xab, 0x39, 0xb0,
+	0x3e, 0x90, 0xaf, 0x9d, 0xa1, 0x65, 0x81, 0x17, 0xc4, 0x10, 0x17, 0xa8, 0xe3, 0x11, 0xc6, 0xc2, 0x5d, 0x0a, 0x67, 0x78,
+	0xd2, 0x76, 0xfc, 0x04, 0xc8, 0xe5, 0xe5, 0xf2, 0x01, 0xa7, 0x46, 0x1f, 0x88, 0x13, 0x9c, 0x7d, 0xbd, 0xc0, 0x79, 0xd9,
+	0x01, 0xd5, 0x48, 0x98, 0x5b, 0x87, 0x4b, 0xf1, 0xcf, 0xcb, 0xe5, 0xec, 0x05, 0x75, 0xe0, 0xff, 0x7f, 0x1e, 0x9e, 0x6e,
+	0x10, 0xe7, 0x11, 0xe3, 0x04, 0x0f, 0x4f, 0xa0, 0x99, 0x83, 0x28, 0x32, 0xbd, 0xdd, 0x41, 0x52, 0x83, 0x98, 0x03, 0x0e,
+	0x12, 0xdf, 0x52, 0x92, 0xc6, 0x89, 0x06, 0xd9, 0x58, 0x08, 0x58, 0x2d, 0xd2, 0x30, 0xa2, 0xe7, 0x70, 0x2b, 0x8e, 0x20,
+	0x71, 0x04, 0xce, 0xf8, 0x2e, 0x60, 0xd2, 0x07, 0xc3, 0x62, 0x72, 0x92, 0x2e, 0xc8, 0x16, 0x60, 0x4e, 0xa3, 0x41, 0x59,
+	0x3f, 0x54, 0x06, 0xfd, 0x21, 0x6e, 0x71, 0x81, 0x0d, 0x43, 0x3a, 0x40, 0x0b, 0x1a, 0x2f, 0x67, 0x5f, 0x08, 0x83, 0x12,
+	0x1b, 0xbc, 0x3d, 0x86, 0xcf, 0x60, 0x26, 0x11, 0xf4, 0xc0, 0xd4, 0x19, 0xee, 0xd0, 0xa8, 0x73, 0x04, 0xa5, 0x65, 0xc2,
+	0x53, 0x0f, 0x40, 0x1a, 0x9e, 0xbf, 0xfe, 0xff, 0x43, 0x4c, 0xa5, 0xf0, 0x72, 0x81, 0x44, 0x5c, 0xc1, 0x72, 0x1e, 0x34,
+	0x99, 0x68, 0x01, 0x8a, 0xfb, 0x13, 0x8a, 0x13, 0x7f, 0x48, 0xdb, 0x17, 0x21, 0x33, 0x12, 0x27, 0x2b, 0x46, 0xd4, 0x48,
+	0x89, 0x8f, 0x03, 0xdc, 0xe9, 0x3e, 0xe0, 0x34, 0x46, 0xed, 0xde, 0x14, 0x99, 0xc5, 0x18, 0xd4, 0x3c, 0x0f, 0x4f, 0x2a,
+	0xd5, 0x07, 0x43, 0xa5, 0xb2, 0x05, 0x99, 0x46, 0x8b, 0xf2, 0x93, 0xc8, 0x5a, 0x93, 0xf6, 0x93, 0x41, 0xe0, 0x60, 0x04,
+	0x32, 0x7c, 0x86, 0xe3, 0x20, 0x92, 0x97, 0x33, 0x58, 0x13, 0xa4, 0x87, 0x34, 0x34, 0x0b, 0x92, 0x21, 0xd4, 0x26, 0xa0,
+	0x76, 0x9a, 0x06, 0x8f, 0x8b, 0x0e, 0xdd, 0xf2, 0x05, 0x6e, 0x95, 0xb3, 0x37, 0x22, 0x81, 0xd1, 0x3c, 0xe2, 0x52, 0x8b,
+	0xa8, 0x37, 0x26, 0x40, 0x97, 0x40, 0xa4, 0x72, 0x30, 0x0c, 0x5c, 0x3e, 0xff, 0xff, 0xcf, 0x91, 0x26, 0xe9, 0x89, 0x04,
+	0x1a, 0x64, 0x16, 0xd8, 0x1e, 0x07, 0x7f, 0x1f, 0x0f, 0x30, 0xc3, 0x19, 0x24, 0xe4, 0x01, 0xa9, 0x01, 0xfc, 0x87, 0xdd,
+	0x1c, 0xf1, 0x00, 0x4d, 0xfd, 0xd3, 0xad, 0xa0, 0x83, 0xa8, 0x20, 0xde, 0x83, 0xde, 0x58, 0xdd, 0x31, 0xd4, 0xbb, 0xde,
+	0xe0, 0xb0, 0xf3, 0x73, 0xf1, 0xf0, 0x74, 0x01, 0x15, 0x68, 0x03, 0x58, 0xea, 0x13, 0xf0, 0x04, 0xb9, 0x23, 0xe5, 0xbe,
+	0xf8, 0xca, 0x60, 0xa2, 0x5b, 0x54, 0x43, 0x6d, 0x16, 0xc1, 0x63, 0x70, 0x65, 0x1e, 0x7f, 0x57, 0x70, 0xea, 0x46, 0x2b,
+	0x34, 0xa1, 0x2e, 0x70, 0x70, 0xe7, 0xe5, 0x72, 0x72, 0x70, 0x74, 0xf5, 0x02, 0x49, 0x50, 0x79, 0x70, 0x18, 0x98, 0x64,
+	0xc1, 0x95, 0x35, 0x1e, 0x3d, 0xe0, 0xa1, 0x08, 0x5f, 0x62, 0x32, 0xe7, 0x20, 0x58, 0x3e, 0xe7, 0xe5, 0x49, 0x40, 0x05,
+	0x99, 0xfd, 0x04, 0x6c, 0x85, 0x97, 0x2f, 0x52, 0x32, 0x44, 0x62, 0xd2, 0x60, 0x6c, 0x1f, 0x1c, 0x45, 0x1e, 0xd4, 0xeb,
+	0x76, 0x61, 0xd0, 0x43, 0x64, 0x9d, 0xb4, 0x3b, 0xc4, 0x66, 0xb0, 0x6b, 0xe1, 0x61, 0xe9, 0x86, 0x3a, 0x00, 0xc1, 0xcb,
+	0x05, 0x8a, 0x65, 0x0a, 0xd2, 0xd0, 0x20, 0xec, 0x49, 0x12, 0x6e, 0xe6, 0xc0, 0xe7, 0xe7, 0x5d, 0xd1, 0xa4, 0x46, 0x50,
+	0xff, 0xce, 0x87, 0x58, 0xf3, 0x9c, 0xa0, 0x25, 0xed, 0xff, 0x7f, 0x14, 0xce, 0x58, 0x39, 0xd3, 0xb1, 0x64, 0x84, 0x88,
+	0x3b, 0xc1, 0xa7, 0x21, 0x71, 0x78, 0x71, 0x38, 0x37, 0x71, 0x07, 0x7e, 0x9c, 0x19, 0x32, 0x8c, 0x09, 0xad, 0x3c, 0x31,
+	0x87, 0x37, 0x87, 0xcd, 0x62, 0x11, 0x94, 0xb1, 0x2b, 0xb0, 0xdd, 0x43, 0x7d, 0x43, 0x99, 0x9f, 0x37, 0x49, 0xed, 0x3a,
+	0xb4, 0x0c, 0x33, 0x20, 0x55, 0x2b, 0x24, 0x06, 0x30, 0xc6, 0xbc, 0x4b, 0x49, 0xea, 0xce, 0x0f, 0xff, 0x31, 0xc0, 0x81,
+	0x70, 0x18, 0x0a, 0x0d, 0x6a, 0xbb, 0x63, 0x1b, 0x4c, 0xf2, 0x72, 0xf7, 0xf7, 0x72, 0x18, 0x1a, 0x4d, 0x31, 0xdf, 0xc1,
+	0x1a, 0xb9, 0x54, 0x29, 0x3d, 0x3d, 0xbc, 0x90, 0x4b, 0x2f, 0x47, 0xa0, 0x46, 0xa4, 0x46, 0xbb, 0x1f, 0xb8, 0x85, 0x07,
+	0xca, 0x23, 0xfe, 0x10, 0x79, 0x4f, 0xb2, 0x8a, 0x52, 0x5f, 0x67, 0x57, 0x28, 0x97, 0x7e, 0x4b, 0x6b, 0x89, 0x0a, 0x38,
+	0xd2, 0x9b, 0xb3, 0xd4, 0x5c, 0xf5, 0x09, 0x09, 0x62, 0x5e, 0x2e, 0x1a, 0xa5, 0xdb, 0xe1, 0x51, 0xde, 0x0f, 0x8f, 0x5c,
+	0x06, 0xe1, 0x39, 0xf9, 0x50, 0x3d, 0x28, 0xe1, 0x81, 0x39, 0x3c, 0xe7, 0x2f, 0x70, 0x24, 0x47, 0x70, 0xdb, 0x11, 0x92,
+	0xf7, 0x78, 0xb9, 0xa0, 0x41, 0xe0, 0x3a, 0x8c, 0xda, 0x7b, 0x64, 0x95, 0x01, 0x24, 0xf7, 0xa3, 0x3c, 0xc1, 0xad, 0x71,
+	0x08, 0x9b, 0xf0, 0x30, 0x81, 0x97, 0x37, 0x2f, 0x17, 0xa4, 0x2d, 0x3f, 0x92, 0x57, 0xbd, 0x03, 0x25, 0xe8, 0x36, 0xd4,
+	0x31, 0x04, 0x06, 0x9d, 0x48, 0xa1, 0xbd, 0xa1, 0x41, 0xe1, 0x3c, 0x68, 0xd6, 0xd3, 0xd2, 0x78, 0x71, 0x2d, 0xb9, 0x1d,
+	0xe2, 0x81, 0x9e, 0xf6, 0x03, 0xb9, 0x09, 0xc1, 0xf2, 0x85, 0xad, 0x89, 0x83, 0xdb, 0x0f, 0xf2, 0x84, 0x3f, 0x24, 0xf5,
+	0x0c, 0xe1, 0xe4, 0x48, 0x06, 0x0d, 0x3b, 0xd7, 0x81, 0x97, 0x0b, 0x7d, 0x19, 0xf3, 0xc0, 0xb9, 0x9b, 0x16, 0x25, 0x2a,
+	0xad, 0x17, 0x24, 0x3a, 0x81, 0x59, 0x44, 0x2f, 0x01, 0x02, 0x6a, 0x71, 0xf2, 0xc0, 0x3b, 0xcf, 0x07, 0x49, 0x3b, 0x14,
+	0x26, 0x41, 0x9c, 0xf5, 0xe7, 0x20, 0x5b, 0xf8, 0x46, 0xe1, 0x2a, 0x73, 0x88, 0x2b, 0x1d, 0xc1, 0xba, 0x80, 0x5c, 0x58,
+	0xc7, 0xce, 0x9d, 0xb4, 0x35, 0x3d, 0xa5, 0x83, 0x6b, 0x2e, 0x00, 0xd8, 0x34, 0x81, 0x58, 0xed, 0xe8, 0xe3, 0x09, 0xf2,
+	0x08, 0x96, 0xd2, 0x70, 0xd0, 0x1d, 0xe1, 0xe0, 0x30, 0xec, 0x13, 0x2e, 0x91, 0x16, 0x3b, 0x21, 0x2a, 0x1b, 0xef, 0xe1,
+	0xde, 0x8d, 0x81, 0x34, 0x9b, 0xc1, 0x6a, 0x11, 0xeb, 0x89, 0x21, 0x2d, 0x02, 0xa0, 0x61, 0x2e, 0x74, 0xac, 0x3a, 0xe8,
+	0x3f, 0x32, 0x47, 0xe6, 0xd6, 0x37, 0x17, 0x5e, 0x2e, 0x78, 0x48, 0x01, 0xdb, 0xe6, 0xbc, 0x5c, 0x54, 0x6f, 0x94, 0x03,
+	0x00, 0x15, 0x21, 0x2f, 0x77, 0x20, 0x4e, 0x00, 0x00
+};
+
+static const uint8_t inflate_huffman[] = {
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x03, 0x05, 0xc1, 0x41, 0x8a, 0x55, 0x41, 0x00, 0x43, 0xd1, 0x79,
+	0x43, 0xef, 0x49, 0xe9, 0x49, 0x89, 0x85, 0xae, 0xc1, 0x7f, 0x89, 0xe2, 0x40, 0x02, 0x49, 0xde, 0xf6, 0xd5, 0x73, 0x2a,
+	0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54, 0xcc,
+	0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53,
+	0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62,
+	0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x3a, 0x97, 0x39, 0x15,
+	0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6,
+	0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0xea, 0x5c, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31,
+	0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e,
+	0x9f, 0xbe, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98,
+	0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x0a, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54,
+	0xcc, 0xa9, 0x70, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x0a, 0xa7, 0x62, 0x4e,
+	0xc5, 0x9c, 0x8a, 0xb9, 0x62, 0xce, 0x17, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a,
+	0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73,
+	0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0xaa, 0x73, 0x99,
+	0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x70, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0xf3, 0xf9,
+	0xdb, 0xa7, 0xfb, 0xfe, 0xf6, 0xef, 0xef, 0xc7, 0xc7, 0xcb, 0xde, 0xef, 0x3f, 0x3f, 0x7e, 0x29, 0x15, 0x73, 0x2a, 0xe6,
+	0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9,
+	0xce, 0x65, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e,
+	0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0xf4, 0xe9, 0x8b, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98,
+	0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54, 0x88, 0x39, 0x15, 0x73, 0x2a, 0xe6,
+	0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0xaa, 0x73, 0x99, 0x53, 0x31,
+	0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e,
+	0xc5, 0x9c, 0xea, 0x5c, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73,
+	0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0xaa, 0x73, 0x99,
+	0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0xb3, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a,
+	0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0xce, 0x65, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54,
+	0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0xf4, 0xe9, 0x8b, 0x39,
+	0x15, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xe7, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31,
+	0xa7, 0x62, 0x16, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0xd5,
+	0xb9, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9,
+	0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x3e, 0x7d, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x95, 0x98,
+	0x53, 0x31, 0xa7, 0x62, 0x4e, 0x75, 0x2e, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5,
+	0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x4f, 0x5f, 0xcc, 0xa9, 0x98, 0x53,
+	0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x42,
+	0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98,
+	0xf3, 0xfc, 0x7c, 0xfa, 0xfe, 0xf6, 0xfd, 0xab, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0x85, 0x98, 0x53, 0x31, 0xa7, 0x62,
+	0x4e, 0xc5, 0x9c, 0x8a, 0x39, 0x15, 0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x3a, 0x97, 0x39, 0x15,
+	0x73, 0x2a, 0xe6, 0x54, 0xcc, 0xa9, 0x98, 0x53, 0x31, 0xa7, 0x62, 0x4e, 0xc5, 0xfe, 0x03, 0x0d, 0xbe, 0x0e, 0x24, 0xd0,
+	0x07, 0x00, 0x00
+};
+
+static const uint8_t inflate_rle[] = {
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x03, 0x05, 0xc1, 0x51, 0xaa, 0x2b, 0x3b, 0x0e, 0x05, 0xd0, 0xff,
+	0x40, 0x06, 0xd5, 0x3e, 0xdc, 0xe2, 0xd5, 0xe1, 0xa5, 0x32, 0x06, 0x39, 0xc8, 0x62, 0x43, 0xdb, 0x16, 0xd2, 0x56, 0xff,
+	0xde, 0x99, 0xa7, 0x7a, 0x2d, 0x4c, 0x31, 0x8d, 0x1a, 0x95, 0x67, 0x65, 0x77, 0x09, 0x82, 0xd8, 0x0b, 0x53, 0x4c, 0x5d,
+	0x82, 0x20, 0xf6, 0xba, 0x30, 0xc5, 0xd4, 0x25, 0x08, 0xe2, 0x98, 0x62, 0x1a, 0x35, 0x2a, 0xcf, 0xca, 0xee, 0x12, 0x04,
+	0xb1, 0x17, 0xa6, 0x98, 0xba, 0x04, 0x41, 0xec, 0x75, 0x61, 0x8a, 0xa9, 0x4b, 0x10, 0xc4, 0x31, 0xc5, 0x34, 0x6a, 0x54,
+	0x9e, 0x95, 0xdd, 0x25, 0x88, 0xbe, 0x37, 0x53, 0x3f, 0xdc, 0x11, 0x35, 0x2a, 0xdf, 0xcf, 0x47, 0x6b, 0xf7, 0xb7, 0x99,
+	0x46, 0x8d, 0xca, 0xb3, 0xb2, 0xbb, 0x04, 0x41, 0xec, 0x85, 0x29, 0xa6, 0x2e, 0x41, 0x10, 0x7b, 0x5d, 0x98, 0x62, 0xea,
+	0x12, 0x04, 0x71, 0x4c, 0x31, 0x8d, 0x1a, 0x95, 0x67, 0x65, 0x77, 0x09, 0x82, 0xd8, 0x0b, 0x53, 0x4c, 0x5d, 0x82, 0x20,
+	0xf6, 0xba, 0x30, 0xc5, 0xd4, 0x25, 0x08, 0xe2, 0x98, 0x62, 0x1a, 0x35, 0x2a, 0xcf, 0xca, 0xee, 0x12, 0x44, 0xdf, 0x9b,
+	0xa9, 0x1f, 0xee, 0x88, 0x1a, 0x95, 0xef, 0xe7, 0xa3, 0xb5, 0xfb, 0xdb, 0x4c, 0xa3, 0x46, 0xe5, 0x59, 0xd9, 0x5d, 0x82,
+	0x20, 0xf6, 0xc2, 0x14, 0x53, 0x97, 0x20, 0xa6, 0x98, 0xba, 0x04, 0x41, 0x1c, 0x53, 0x4c, 0xa3, 0x46, 0xe5, 0x59, 0xd9,
+	0x5d, 0x82, 0xe8, 0x7b, 0x33, 0xf5, 0xc3, 0x1d, 0x51, 0xa3, 0xf2, 0xfd, 0x7c, 0xb4, 0xa8, 0x51, 0xf9, 0x7c, 0xfc, 0xa7,
+	0xf2, 0xac, 0xec, 0x2e, 0x41, 0x10, 0x7b, 0x61, 0x8a, 0xa9, 0x4b, 0x10, 0xc4, 0x5e, 0x17, 0xa6, 0x98, 0xba, 0x04, 0x41,
+	0x1c, 0x53, 0x4c, 0xa3, 0x46, 0xe5, 0x59, 0xd9, 0x5d, 0x82, 0xaf, 0xd7, 0x5b, 0x4c, 0x5d, 0x82, 0x20, 0x8e, 0x29, 0xa6,
+	0x51, 0xa3, 0xf2, 0xac, 0xec, 0x2e, 0xc1, 0x1f, 0x09, 0xbe, 0x5e, 0x6f, 0x31, 0x75, 0x09, 0xfe, 0x06, 0x41, 0xec, 0x75,
+	0x61, 0x8a, 0xa9, 0x4b, 0x10, 0xc4, 0x31, 0xc5, 0x34, 0x6a, 0x54, 0x9e, 0x95, 0xdd, 0x25, 0x88, 0xbe, 0x37, 0x53, 0x3f,
+	0xdc, 0x11, 0x35, 0x2a, 0xdf, 0xcf, 0x47, 0x6b, 0xf7, 0xb7, 0x99, 0x46, 0x8d, 0xca, 0xb3, 0xb2, 0xbb, 0x04, 0x41, 0xec,
+	0x85, 0x29, 0xa6, 0x2e, 0x41, 0x10, 0x7b, 0x5d, 0x98, 0x62, 0x7d, 0x6f, 0x66, 0x77, 0x09, 0x82, 0xd8, 0x0b, 0x53, 0x4c,
+	0x5d, 0x82, 0x20, 0xf6, 0xba, 0x30, 0xc5, 0xd4, 0x25, 0x08, 0xe2, 0x98, 0x62, 0x1a, 0x35, 0x2a, 0xcf, 0xca, 0xee, 0x12,
+	0x7c, 0xbd, 0xde, 0x62, 0xea, 0x12, 0x04, 0x71, 0x4c, 0x31, 0x8d, 0x1a, 0x95, 0x67, 0x65, 0x77, 0x09, 0xfe, 0x48, 0xf0,
+	0xf5, 0x7a, 0x8b, 0xa9, 0x4b, 0xf0, 0x37, 0x08, 0x62, 0xaf, 0x0b, 0x53, 0x4c, 0x5d, 0x82, 0x20, 0x8e, 0x29, 0xa6, 0x51,
+	0xa3, 0xf2, 0xac, 0xec, 0x2e, 0x41, 0xf4, 0xbd, 0x99, 0xfa, 0xe1, 0x8e, 0xa8, 0x51, 0xf9, 0x7e, 0x3e, 0x5a, 0xbb, 0xff,
+	0xb7, 0xff, 0x5b, 0x53, 0x5f, 0x2e, 0x41, 0x10, 0x7b, 0xdd, 0xdf, 0x33, 0x6a, 0x54, 0xfe, 0x71, 0x09, 0xfe, 0x48, 0xf0,
+	0xf5, 0x7a, 0x8b, 0xa9, 0x4b, 0xf0, 0x37, 0x08, 0x62, 0xaf, 0x0b, 0x53, 0x4c, 0x5d, 0x82, 0x20, 0x8e, 0x29, 0xa6, 0x51,
+	0xa3, 0xf2, 0xac, 0xec, 0x2e, 0x41, 0xf4, 0xbd, 0x99, 0xfa, 0xe1, 0x8e, 0xa8, 0x51, 0xf9, 0x7e, 0x3e, 0x5a, 0xbb, 0xbf,
+	0xcd, 0x34, 0x6a, 0x54, 0x9e, 0x95, 0xdd, 0x25, 0x08, 0x62, 0x2f, 0x4c, 0x31, 0x75, 0x09, 0x82, 0xd8, 0xeb, 0xc2, 0x14,
+	0xeb, 0x7b, 0x33, 0xbb, 0x4b, 0x10, 0xc4, 0x5e, 0x98, 0x62, 0x1a, 0x35, 0x2a, 0x35, 0x6a, 0x54, 0x9e, 0x95, 0xdd, 0x25,
+	0x08, 0x62, 0x2f, 0x4c, 0x31, 0x75, 0x09, 0x82, 0xd8, 0xeb, 0xc2, 0x14, 0x53, 0x97, 0x20, 0x88, 0x63, 0x8a, 0x69, 0xd4,
+	0xa8, 0x3c, 0x2b, 0xbb, 0x4b, 0x10, 0xc4, 0x5e, 0x98, 0x62, 0xea, 0x12, 0x04, 0xb1, 0xd7, 0x85, 0x29, 0xa6, 0x2e, 0x41,
+	0x10, 0xc7, 0x14, 0xd3, 0xa8, 0x51, 0x79, 0x56, 0x76, 0x97, 0x20, 0xfa, 0xde, 0x4c, 0xfd, 0x70, 0x47, 0xd4, 0xa8, 0x7c,
+	0x3f, 0x1f, 0xad, 0xdd, 0xdf, 0x66, 0x1a, 0x35, 0x2a, 0x09, 0x62, 0x2f, 0x4c, 0x31, 0x75, 0x09, 0x82, 0xd8, 0xeb, 0xc2,
+	0x14, 0x53, 0x97, 0x20, 0x88, 0x63, 0x8a, 0x69, 0xd4, 0xa8, 0x3c, 0x2b, 0xbb, 0x4b, 0x10, 0xc4, 0x5e, 0x98, 0x62, 0xea,
+	0x12, 0x04, 0xb1, 0xd7, 0x85, 0x29, 0xa6, 0x2e, 0x41, 0x10, 0xc7, 0x14, 0xd3, 0xa8, 0x51, 0x79, 0x56, 0x76, 0x97, 0x20,
+	0xfa, 0xde, 0x4c, 0xfd, 0x70, 0x47, 0xd4, 0xa8, 0x7c, 0x3f, 0x1f, 0xad, 0xdd, 0xdf, 0x66, 0x1a, 0x35, 0x2a, 0x09, 0x62,
+	0x2f, 0x4c, 0x31, 0x75, 0x09, 0x82, 0xd8, 0xeb, 0xc2, 0x14, 0xfb, 0xfb, 0xe7, 0xdf, 0xc3, 0x25, 0x08, 0x62, 0xaf, 0xfb,
+	0x3b, 0xc5, 0xd4, 0x25, 0x08, 0x62, 0xaf, 0x0b, 0x53, 0xfe, 0xa9, 0xec, 0x62, 0x1a, 0x35, 0x2a, 0xcf, 0xca, 0xee, 0x12,
+	0xfc, 0x91, 0xe0, 0xeb, 0xf5, 0x16, 0x53, 0x97, 0xe0, 0x6f, 0x10, 0xc4, 0x5e, 0x17, 0xa6, 0x98, 0xba, 0x04, 0x41, 0x1c,
+	0x53, 0x4c, 0xa3, 0x46, 0xe5, 0x59, 0xd9, 0x5d, 0x82, 0xe8, 0x7b, 0x33, 0xf5, 0xc3, 0x1d, 0x51, 0xa3, 0xf2, 0xfd, 0x7c,
+	0xb4, 0x76, 0x7f, 0x9b, 0x69, 0xd4, 0xa8, 0x3c, 0x2b, 0xbb, 0x4b, 0x10, 0xc4, 0x5e, 0x98, 0x62, 0xea, 0x12, 0x04, 0xb1,
+	0xd7, 0x85, 0x29, 0xd6, 0xf7, 0x66, 0x76, 0x97, 0x20, 0x88, 0xbd, 0x30, 0xc5, 0xd4, 0x25, 0x08, 0x62, 0xaf, 0x0b, 0x53,
+	0x4c, 0x5d, 0x82, 0x20, 0x8e, 0x29, 0xa6, 0x51, 0xa3, 0xf2, 0xac, 0xec, 0x2e, 0xc1, 0xd7, 0xeb, 0x2d, 0xa6, 0x2e, 0x41,
+	0x10, 0xc7, 0x14, 0xd3, 0xa8, 0x51, 0x79, 0x56, 0x76, 0x97, 0xe0, 0x8f, 0x04, 0x5f, 0xaf, 0xca, 0xb3, 0xb2, 0xbb, 0x04,
+	0xd1, 0xf7, 0x66, 0xea, 0x87, 0x3b, 0xa2, 0x46, 0xe5, 0xfb, 0xf9, 0x68, 0xed, 0xfe, 0x36, 0xd3, 0xa8, 0x51, 0x49, 0x10,
+	0x7b, 0x61, 0x8a, 0xa9, 0x4b, 0x10, 0xc4, 0x5e, 0x17, 0xa6, 0xd8, 0xdf, 0x3f, 0xff, 0x1e, 0x2e, 0x41, 0x10, 0x7b, 0xdd,
+	0xdf, 0x29, 0xa6, 0x2e, 0x41, 0x10, 0x7b, 0x5d, 0x98, 0x72, 0x7f, 0xd7, 0x85, 0x29, 0xf6, 0xf7, 0xcf, 0xbf, 0x87, 0x4b,
+	0x10, 0xc4, 0x5e, 0xf7, 0x77, 0x8a, 0xa9, 0x4b, 0x10, 0xc4, 0x5e, 0x17, 0xa6, 0xfc, 0x53, 0xd9, 0xc5, 0x34, 0x6a, 0x54,
+	0x9e, 0x95, 0xdd, 0x25, 0xf8, 0x23, 0xc1, 0xd7, 0xeb, 0x2d, 0xa6, 0x2e, 0xc1, 0xdf, 0x20, 0x88, 0xbd, 0x2e, 0x4c, 0x31,
+	0x75, 0x09, 0x82, 0x38, 0xa6, 0x98, 0x46, 0x8d, 0xca, 0xb3, 0xb2, 0xbb, 0x04, 0xd1, 0xf7, 0x66, 0xea, 0x87, 0x3b, 0xa2,
+	0x46, 0xe5, 0xfb, 0xf9, 0x68, 0xed, 0xfe, 0x36, 0xd3, 0xa8, 0x51, 0x79, 0x56, 0x76, 0x97, 0x20, 0xd8, 0xda, 0xfd, 0x6d,
+	0xa6, 0x51, 0xa3, 0xf2, 0xac, 0xec, 0x2e, 0x41, 0xb0, 0xb5, 0xfb, 0xdb, 0x4c, 0xa3, 0x46, 0xe5, 0x59, 0xd9, 0x5d, 0x82,
+	0x60, 0x6b, 0xf7, 0xb7, 0x99, 0x46, 0x8d, 0xca, 0xb3, 0xb2, 0xbb, 0x04, 0xc1, 0xd6, 0xee, 0x6f, 0x33, 0x8d, 0x1a, 0x95,
+	0x67, 0x65, 0x77, 0x09, 0x82, 0xad, 0xdd, 0xdf, 0x66, 0x1a, 0x35, 0x2a, 0xcf, 0xca, 0xee, 0x12, 0x04, 0x5b, 0xbb, 0xbf,
+	0xcd, 0x34, 0x6a, 0x54, 0x9e, 0x95, 0xdd, 0x25, 0x08, 0xb6, 0x76, 0x7f, 0x9b, 0x69, 0xd4, 0xa8, 0x3c, 0x2b, 0xbb, 0x4b,
+	0x10, 0x6c, 0xed, 0xfe, 0x36, 0xd3, 0xa8, 0x51, 0x79, 0x56, 0x76, 0x97, 0x20, 0xfa, 0xde, 0xec, 0x7b, 0xf3, 0xf9, 0x38,
+	0x2b, 0xbb, 0x4b, 0xf0, 0x47, 0x82, 0xaf, 0xd7, 0x5b, 0x4c, 0x5d, 0x82, 0xbf, 0x41, 0x10, 0x7b, 0x5d, 0x98, 0x62, 0xea,
+	0x12, 0x04, 0x71, 0x4c, 0x31, 0x8d, 0x1a, 0x95, 0x67, 0x65, 0x77, 0x09, 0xa2, 0xef, 0xcd, 0xd4, 0x0f, 0x77, 0x44, 0x8d,
+	0xca, 0xf7, 0xf3, 0xd1, 0xda, 0xfd, 0x6d, 0xff, 0x07, 0xda, 0x08, 0x27, 0x0a, 0xd0, 0x07, 0x00, 0x00
+};
+
+static const uint8_t inflate_level1[] = {
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x03, 0xe5, 0x5c, 0xe9, 0x8e, 0xa3, 0x38, 0x10, 0xfe, 0x1f, 0x29,
+	0xef, 0x14, 0x92, 0x70, 0x84, 0x2b, 0xcf, 0x30, 0x47, 0x66, 0xd4, 0xd2, 0xcc, 0x66, 0x95, 0x4e, 0xe6, 0xef, 0xbe, 0x39,
+	0xac, 0xab, 0x7c, 0x60, 0x7c, 0x80, 0xb1, 0x49, 0x42, 0x32, 0x6a, 0x75, 0x03, 0xc6, 0xd8, 0x55, 0x5f, 0x9d, 0x2e, 0x4c,
+	0xd7, 0xdb, 0xb8, 0x7e, 0xb7, 0x9f, 0xba, 0x3a, 0x7c, 0xfb, 0x75, 0xfb, 0xbc, 0x9e, 0x2e, 0x65, 0x5a, 0x3d, 0x82, 0xbb,
+	0xa4, 0x6d, 0xf2, 0x5d, 0x76, 0xbf, 0x59, 0xd7, 0x2b, 0xc6, 0x4f, 0xdb, 0xdc, 0x9b, 0x1d, 0x1f, 0x56, 0x5c, 0x81, 0xf6,
+	0xed, 0x17, 0x31, 0xee, 0xf7, 0xff, 0xc5, 0x65, 0xf2, 0x79, 0xfa, 0x76, 0x3d, 0x5f, 0x86, 0x61, 0x58, 0xe0, 0x44, 0xe5,
+	0x7a, 0x55, 0x8e, 0xd8, 0x99, 0x4a, 0xf5, 0x3b, 0xb0, 0x1d, 0x47, 0xc5, 0x20, 0xd7, 0x2a, 0xcf, 0x36, 0xb9, 0xaa, 0xfd,
+	0x16, 0x80, 0xcd, 0xdf, 0x6c, 0x8a, 0xdf, 0x2f, 0x1f, 0x7f, 0x4e, 0x77, 0x70, 0xaf, 0xd4, 0xd1, 0x39, 0x58, 0xb8, 0x4d,
+	0x4f, 0x66, 0x69, 0x7f, 0xd8, 0x20, 0x5f, 0xcf, 0xe7, 0xab, 0xd1, 0x3c, 0x54, 0x75, 0xb7, 0x51, 0xa4, 0xf6, 0xf3, 0x32,
+	0x8b, 0xed, 0xe5, 0xf6, 0xe3, 0xf6, 0x79, 0xac, 0xda, 0x26, 0x2a, 0x8f, 0x28, 0x59, 0xa0, 0x6b, 0xd8, 0x6e, 0x6d, 0x04,
+	0x79, 0xb4, 0x7b, 0x46, 0xeb, 0x8f, 0xdf, 0x5f, 0x7e, 0x9e, 0x58, 0x60, 0xf8, 0x73, 0xfe, 0x75, 0xfb, 0x7d, 0xba, 0x7d,
+	0x7e, 0x2d, 0x8a, 0x18, 0xdb, 0x15, 0x50, 0x11, 0xa6, 0x89, 0x89, 0xce, 0x14, 0x4e, 0x66, 0x8b, 0xcf, 0x32, 0x53, 0x78,
+	0xfe, 0xef, 0x97, 0xcb, 0xf5, 0xe3, 0xfa, 0x71, 0xfe, 0x67, 0x9f, 0x44, 0x10, 0xfd, 0x92, 0x43, 0x45, 0x99, 0x15, 0x37,
+	0x48, 0x82, 0xa3, 0x6a, 0x81, 0x8d, 0xf4, 0xeb, 0xe9, 0xc5, 0xdc, 0xb1, 0x60, 0x92, 0x88, 0xf6, 0x90, 0x53, 0xc6, 0x33,
+	0x45, 0xb6, 0x36, 0x66, 0x9f, 0xd0, 0xee, 0xa9, 0xc9, 0x3a, 0xa5, 0x51, 0xbd, 0xad, 0xe3, 0x49, 0xb6, 0x9c, 0x66, 0x14,
+	0x9d, 0xc3, 0x7a, 0x05, 0x6a, 0x92, 0x57, 0x25, 0xd8, 0xf0, 0x11, 0xce, 0x05, 0x5e, 0xf7, 0x4c, 0xed, 0x74, 0x1e, 0x16,
+	0xd8, 0x12, 0x2c, 0x9f, 0x02, 0xf0, 0x5c, 0xaf, 0x6a, 0x8a, 0xf5, 0x5e, 0x20, 0xab, 0xf1, 0xaa, 0x35, 0x18, 0xba, 0xbe,
+	0x9b, 0xf3, 0x7f, 0x3f, 0xa5, 0x4d, 0x62, 0x22, 0x36, 0x77, 0xe7, 0xea, 0xb6, 0xda, 0x54, 0xc7, 0x63, 0x66, 0xde, 0x65,
+	0x54, 0x07, 0x4d, 0x57, 0xd4, 0x47, 0x5c, 0xb4, 0xcb, 0xd4, 0x67, 0xb1, 0xfc, 0x90, 0xc5, 0x11, 0x5f, 0xb0, 0x27, 0xdc,
+	0xef, 0x79, 0x03, 0x62, 0xe2, 0xfc, 0x59, 0x6d, 0x72, 0x3c, 0xef, 0x12, 0x2a, 0xc1, 0x2d, 0x63, 0x9a, 0xc7, 0xf4, 0xb8,
+	0x04, 0xff, 0x22, 0x07, 0x3d, 0x7c, 0x3e, 0x3a, 0x6a, 0x1a, 0x51, 0xdb, 0x5c, 0x19, 0xa2, 0x46, 0x97, 0xc8, 0xd5, 0x11,
+	0xb9, 0x86, 0x21, 0x4b, 0x36, 0x91, 0x3e, 0x4e, 0xbf, 0xc5, 0x36, 0x6a, 0xbf, 0xd7, 0xc0, 0x55, 0xb8, 0x83, 0x74, 0xa2,
+	0xd4, 0x97, 0x4e, 0xc0, 0xc2, 0xd9, 0xed, 0x5a, 0xe2, 0x2f, 0x05, 0x97, 0x24, 0x24, 0x28, 0x1b, 0x7a, 0x85, 0xa8, 0xcf,
+	0x53, 0x69, 0xf2, 0x65, 0x4d, 0x13, 0xca, 0x0c, 0xee, 0x18, 0xd7, 0x05, 0x87, 0x4a, 0x1b, 0xda, 0x62, 0x4d, 0xc1, 0xa4,
+	0xfb, 0x68, 0xcf, 0x26, 0x6a, 0x1b, 0xc7, 0x85, 0xe8, 0xac, 0xe9, 0x2f, 0xe8, 0xe9, 0xcc, 0xeb, 0x54, 0x61, 0xf8, 0x45,
+	0x7c, 0xac, 0x76, 0x08, 0x3e, 0x14, 0x31, 0xbd, 0x1d, 0xa1, 0xab, 0xdc, 0x48, 0xbf, 0x07, 0x46, 0x86, 0x54, 0x90, 0xa5,
+	0x86, 0x35, 0x8b, 0xc1, 0x59, 0xb4, 0x8d, 0x0c, 0xa3, 0x0e, 0x60, 0xee, 0x29, 0x60, 0x7d, 0xe2, 0x22, 0x42, 0xf0, 0x6c,
+	0x26, 0x71, 0xb4, 0x35, 0xd8, 0xb4, 0xf8, 0x0c, 0x33, 0x78, 0x85, 0xa9, 0x2b, 0x0b, 0x02, 0xbb, 0xa3, 0x6b, 0x7c, 0x02,
+	0x71, 0x16, 0xc1, 0xb8, 0x69, 0x16, 0x07, 0x95, 0x1f, 0x2d, 0x83, 0xf1, 0xdb, 0xfa, 0xf1, 0xc9, 0xe9, 0x01, 0x56, 0x14,
+	0x62, 0x22, 0x9f, 0xb6, 0x81, 0xfa, 0xc9, 0x32, 0xd6, 0x8e, 0x33, 0x81, 0xa8, 0x83, 0xed, 0xd4, 0x32, 0x9b, 0xa1, 0xe5,
+	0x75, 0x3c, 0xbb, 0xe3, 0x81, 0xd4, 0xe5, 0x50, 0x15, 0xbb, 0x98, 0x25, 0x49, 0x70, 0x8d, 0x61, 0xa2, 0xcb, 0x19, 0xf3,
+	0x22, 0xad, 0xb1, 0x09, 0xff, 0x08, 0x0a, 0x26, 0x83, 0x2a, 0x83, 0x15, 0xf4, 0x30, 0x19, 0x68, 0x36, 0x4c, 0x27, 0xf9,
+	0x07, 0x04, 0x80, 0x01, 0x15, 0xc9, 0xec, 0xd0, 0x73, 0x62, 0xe1, 0x07, 0xba, 0x8c, 0x5f, 0xaf, 0x62, 0xc8, 0x0b, 0xd1,
+	0x16, 0xdb, 0x06, 0x0f, 0xd9, 0xa1, 0x4c, 0x77, 0xac, 0xa0, 0x02, 0xf7, 0xf4, 0xc7, 0xbb, 0x96, 0xce, 0x55, 0x08, 0xb4,
+	0xc5, 0x49, 0x28, 0x72, 0x3e, 0xcf, 0xcf, 0x86, 0x76, 0xc7, 0xe2, 0x18, 0x04, 0x5d, 0x4f, 0x7a, 0x16, 0xec, 0xd6, 0x38,
+	0xdf, 0x94, 0x17, 0x2a, 0x88, 0x0d, 0xe6, 0x41, 0xea, 0x54, 0xec, 0x3a, 0xdf, 0x56, 0x28, 0x6f, 0xec, 0x93, 0xd2, 0xc4,
+	0x2c, 0x4b, 0x99, 0xf4, 0xdb, 0x86, 0x8e, 0xf0, 0xe8, 0x92, 0x1a, 0xc0, 0xe6, 0x55, 0xad, 0x9c, 0x4d, 0x84, 0x93, 0x0c,
+	0x06, 0x41, 0x0f, 0xae, 0x23, 0x42, 0x92, 0xc5, 0xc5, 0x37, 0x72, 0xf4, 0xaa, 0x47, 0x52, 0xd9, 0xd2, 0xbf, 0xb9, 0x79,
+	0x82, 0x60, 0xf8, 0x98, 0xde, 0x38, 0x6d, 0x1e, 0xe8, 0xcc, 0xdf, 0xa2, 0x9a, 0x8c, 0x46, 0xdf, 0x7e, 0x77, 0x4a, 0x8a,
+	0xbb, 0xe4, 0xb9, 0x70, 0x15, 0x97, 0xca, 0xdf, 0x73, 0x94, 0x6b, 0x52, 0x2a, 0x99, 0x97, 0xcb, 0x20, 0xda, 0x0e, 0x71,
+	0x91, 0xd4, 0xfb, 0x6e, 0x45, 0xa4, 0x52, 0xeb, 0x74, 0xed, 0xd2, 0xc9, 0xb9, 0xe8, 0x61, 0x1b, 0x4c, 0x55, 0x5f, 0x2f,
+	0xb5, 0x94, 0x5e, 0x34, 0x6e, 0x72, 0x0c, 0x12, 0xb6, 0xe9, 0xee, 0xda, 0x6e, 0xf0, 0x0f, 0xc0, 0x9e, 0x44, 0x1d, 0x2e,
+	0x71, 0xb2, 0xb6, 0xd9, 0xa9, 0x6c, 0x23, 0x5d, 0x09, 0x46, 0x99, 0x7c, 0xb6, 0x17, 0x2b, 0x92, 0x4a, 0x7b, 0xc1, 0x3a,
+	0xbe, 0xc7, 0x49, 0x24, 0x24, 0xe1, 0x4b, 0x60, 0x5a, 0x97, 0x30, 0x3b, 0x5e, 0xa9, 0xd5, 0x08, 0x1c, 0xb9, 0x8f, 0x51,
+	0xfa, 0x6f, 0x59, 0x6c, 0x60, 0x02, 0xb0, 0x45, 0x6d, 0x39, 0xd4, 0x78, 0xd8, 0xd1, 0x9a, 0xac, 0x04, 0xd4, 0x98, 0xa6,
+	0x5b, 0x2d, 0x57, 0x7e, 0x70, 0xd6, 0xca, 0x56, 0x2f, 0xec, 0xdd, 0x49, 0x21, 0xbb, 0xf0, 0xc3, 0xd9, 0x30, 0x4c, 0x24,
+	0xb4, 0x16, 0xa1, 0xc3, 0x24, 0x7d, 0x4f, 0x92, 0x75, 0xfe, 0x84, 0xdb, 0x51, 0xce, 0x45, 0xf1, 0x5c, 0x8c, 0xfa, 0xd8,
+	0x37, 0xea, 0x20, 0x47, 0xf8, 0x1d, 0x2e, 0x1a, 0x0a, 0xe2, 0xc2, 0x0d, 0x75, 0x1a, 0x4e, 0x3c, 0x43, 0x76, 0x03, 0x75,
+	0xb8, 0x17, 0x30, 0x91, 0x3f, 0x9a, 0x01, 0x89, 0x5d, 0xe9, 0x54, 0x21, 0x54, 0xbd, 0x9c, 0x6b, 0xc7, 0xe6, 0x70, 0x2a,
+	0x54, 0xb4, 0x0d, 0x51, 0x5b, 0x83, 0x82, 0x2b, 0xe4, 0x48, 0x74, 0x07, 0xa4, 0xe1, 0x34, 0x38, 0xd9, 0x87, 0xee, 0xdf,
+	0x79, 0x4c, 0xaa, 0x1b, 0xf2, 0xc6, 0x9c, 0x51, 0x28, 0x81, 0xd3, 0xe7, 0x00, 0xaf, 0x0c, 0x21, 0xdd, 0xd0, 0x8b, 0x8c,
+	0x51, 0x09, 0x0b, 0x33, 0xdf, 0x37, 0xb4, 0x56, 0xc5, 0x7a, 0x15, 0x69, 0x9a, 0xb2, 0x70, 0x98, 0xdb, 0x26, 0xdd, 0xb5,
+	0xcd, 0x20, 0x68, 0xb6, 0x10, 0xad, 0x42, 0xa0, 0xf6, 0xa3, 0x8a, 0x1c, 0xf1, 0xb1, 0x9d, 0xa1, 0x57, 0xc7, 0x55, 0xaf,
+	0x5f, 0xcc, 0x88, 0x30, 0x93, 0x29, 0x89, 0x9b, 0xdb, 0x6e, 0xa2, 0x64, 0x6c, 0x67, 0x72, 0x60, 0x31, 0x8a, 0x7a, 0x67,
+	0x48, 0x27, 0x38, 0xea, 0xec, 0xa8, 0xca, 0x86, 0x63, 0xea, 0x90, 0x66, 0x61, 0x26, 0xc2, 0x9c, 0x12, 0x2a, 0x33, 0xbe,
+	0x45, 0xd3, 0x57, 0x2a, 0xda, 0x14, 0xaf, 0xf0, 0xb2, 0x1e, 0xf7, 0x03, 0xd2, 0x7a, 0xcf, 0xf9, 0xb2, 0xc4, 0x42, 0x10,
+	0xd1, 0x1b, 0xb9, 0x8a, 0x2b, 0x57, 0x32, 0x34, 0xc0, 0x15, 0x99, 0x73, 0x19, 0xdb, 0x8e, 0xef, 0xee, 0xe2, 0x84, 0x8a,
+	0x42, 0x8a, 0xe1, 0x88, 0x8d, 0x5f, 0xa9, 0xa9, 0x22, 0x33, 0x8c, 0x38, 0x51, 0x10, 0x82, 0x7b, 0xf6, 0xfd, 0xe4, 0x24,
+	0x70, 0x8f, 0x76, 0x9e, 0x1c, 0x63, 0x92, 0x46, 0xa3, 0x87, 0xa8, 0xdb, 0x06, 0x48, 0x02, 0xc7, 0xa2, 0x55, 0x4a, 0xa8,
+	0x7a, 0xb9, 0x29, 0xa3, 0x08, 0xaa, 0x20, 0x92, 0xb0, 0x7d, 0x9a, 0xde, 0xeb, 0xcb, 0xf5, 0x8a, 0x24, 0x59, 0xc8, 0x20,
+	0xb0, 0x94, 0x09, 0x92, 0x6c, 0x66, 0x62, 0x6f, 0x77, 0xd4, 0x29, 0xeb, 0x00, 0x9e, 0x11, 0xb1, 0x82, 0xc5, 0x4d, 0x58,
+	0x96, 0x88, 0x42, 0x7d, 0xd6, 0x86, 0x8d, 0x3d, 0xe0, 0xbe, 0x5e, 0xed, 0x69, 0xb0, 0xa2, 0x7f, 0x63, 0x7a, 0x70, 0xfa,
+	0x62, 0x27, 0x82, 0xe7, 0x0b, 0x13, 0xaa, 0xc3, 0x99, 0x81, 0xe9, 0x09, 0x9a, 0x3f, 0x2b, 0x82, 0x54, 0x75, 0x79, 0x12,
+	0xd6, 0x30, 0x0b, 0x0c, 0x40, 0x76, 0x7f, 0x72, 0x21, 0xf5, 0xa2, 0xe6, 0x7a, 0x95, 0x31, 0xa3, 0xc2, 0x66, 0x62, 0x08,
+	0x9b, 0x8e, 0x30, 0x69, 0x66, 0x78, 0x5e, 0xff, 0x11, 0x1d, 0xa0, 0x34, 0x32, 0xef, 0x9b, 0x8e, 0x2a, 0xd3, 0xa7, 0x83,
+	0x16, 0x31, 0x25, 0x23, 0xc7, 0x0b, 0x8d, 0xf1, 0xd2, 0xd3, 0xd4, 0x89, 0x70, 0x8d, 0x4e, 0xb5, 0xc6, 0x8d, 0x6e, 0x73,
+	0x2f, 0x7d, 0xda, 0x3a, 0x26, 0xab, 0x10, 0x11, 0x2f, 0x82, 0x63, 0x87, 0x41, 0x88, 0x9c, 0x92, 0x17, 0x08, 0xc0, 0xa8,
+	0xa3, 0x15, 0x62, 0x1d, 0xd1, 0x8a, 0xc4, 0x00, 0x3f, 0x9c, 0x2f, 0xeb, 0xd1, 0xc7, 0xe1, 0x25, 0x54, 0xc6, 0x6d, 0x53,
+	0x0a, 0x4f, 0x4d, 0x64, 0x62, 0x9d, 0xc2, 0x42, 0xde, 0x3b, 0x7d, 0x2f, 0xa4, 0x2d, 0x31, 0x2d, 0x3c, 0x4b, 0x18, 0x05,
+	0x80, 0x98, 0x81, 0xb7, 0x15, 0xd0, 0xaf, 0x57, 0xa8, 0x11, 0x90, 0x08, 0x90, 0x6a, 0x05, 0xd6, 0x2d, 0x9d, 0xde, 0x5c,
+	0x06, 0x10, 0x20, 0x71, 0x37, 0xa7, 0x14, 0xd9, 0x97, 0xbf, 0x3d, 0xdf, 0x2c, 0x4d, 0x05, 0xe0, 0xa9, 0x9e, 0x4f, 0x02,
+	0x94, 0x6c, 0x56, 0x50, 0x3a, 0xdf, 0xf1, 0x9a, 0xe8, 0x3b, 0x20, 0x8d, 0x41, 0x1b, 0xe9, 0x1d, 0x9e, 0x4b, 0x25, 0x9b,
+	0x3a, 0x6c, 0xe3, 0x3a, 0x1c, 0x86, 0x95, 0xc2, 0x0f, 0x1f, 0xf7, 0x8d, 0xab, 0x4a, 0x3b, 0x02, 0xe6, 0xb6, 0x5f, 0xdf,
+	0xdd, 0x4d, 0x97, 0x24, 0x07, 0x2a, 0xe8, 0xe8, 0xf2, 0x30, 0x18, 0x9f, 0x91, 0xbc, 0xeb, 0xa9, 0xc0, 0x0f, 0xd7, 0x3d,
+	0x76, 0xac, 0x50, 0x87, 0x0a, 0xa2, 0x67, 0x23, 0x0f, 0x28, 0x88, 0xf4, 0xca, 0xa9, 0x4f, 0x6e, 0x21, 0x5c, 0x82, 0x08,
+	0x95, 0x3d, 0x3a, 0x1f, 0xb8, 0x51, 0x74, 0xda, 0xc6, 0x57, 0x7b, 0x55, 0x22, 0x25, 0x3b, 0x84, 0x87, 0xab, 0xee, 0x14,
+	0x02, 0x61, 0x5f, 0x68, 0x8b, 0x9b, 0x34, 0xed, 0x7d, 0x3e, 0xf5, 0x72, 0xe5, 0x12, 0x5b, 0x50, 0x46, 0xee, 0x28, 0x1e,
+	0xe4, 0x0b, 0x81, 0x97, 0xd8, 0x02, 0x08, 0xf2, 0xb1, 0x2a, 0x1e, 0x1a, 0x3d, 0xd8, 0x13, 0xf1, 0x00, 0x29, 0xb5, 0x81,
+	0xa8, 0x26, 0x59, 0x76, 0xdb, 0x64, 0xf2, 0x8b, 0x75, 0x21, 0xdd, 0x9e, 0x3a, 0xf7, 0x95, 0x1f, 0xae, 0xd4, 0x7e, 0x2c,
+	0x2d, 0xee, 0xe2, 0x89, 0xfe, 0x48, 0x48, 0xcb, 0x9c, 0xa1, 0x2f, 0xae, 0xc9, 0xa6, 0x43, 0xfc, 0xe1, 0x14, 0x59, 0xca,
+	0x1e, 0xc8, 0x0c, 0xef, 0x3b, 0x82, 0x47, 0xcd, 0xcb, 0x54, 0xbd, 0xd7, 0x82, 0x7c, 0x02, 0xf5, 0xa8, 0xa2, 0xa7, 0xde,
+	0xe7, 0xd7, 0x7a, 0xbf, 0xd0, 0x57, 0x04, 0x6c, 0xd9, 0x29, 0x71, 0x13, 0xd7, 0x7b, 0x9a, 0x51, 0xda, 0x5d, 0x03, 0x7c,
+	0xb1, 0xa5, 0xfb, 0x39, 0x9d, 0x38, 0x4e, 0x36, 0x39, 0x4a, 0xa7, 0xd2, 0x5c, 0xc6, 0xd6, 0xd9, 0x2d, 0x10, 0x66, 0xd1,
+	0x89, 0x93, 0x91, 0x9b, 0x1e, 0x06, 0x17, 0xaa, 0x0b, 0x42, 0x2a, 0x44, 0x84, 0xe2, 0x7c, 0x04, 0x70, 0x8b, 0xb6, 0x8b,
+	0xa7, 0x36, 0xc9, 0xf8, 0x7f, 0x0f, 0xb1, 0xa4, 0x48, 0x62, 0x0c, 0xa3, 0xa0, 0x5d, 0xee, 0x5a, 0x2b, 0xd2, 0x10, 0xb0,
+	0x2b, 0xf8, 0xd3, 0xff, 0xd6, 0xc3, 0x7b, 0x22, 0x23, 0x31, 0x0b, 0x70, 0x33, 0xdd, 0x7a, 0xc2, 0x22, 0xa7, 0x85, 0x6a,
+	0x22, 0x0a, 0x0e, 0x3e, 0xf5, 0x75, 0xb4, 0xad, 0x3c, 0x4b, 0x36, 0xac, 0x2c, 0xf2, 0xfd, 0x82, 0xb9, 0x7d, 0x9c, 0x92,
+	0x9d, 0x44, 0x19, 0x7b, 0x8f, 0xc9, 0x0e, 0x11, 0x7c, 0x5a, 0xea, 0xfe, 0x33, 0xa1, 0xab, 0x71, 0x50, 0x9b, 0x2b, 0x9a,
+	0x3c, 0xae, 0x6f, 0x29, 0x8e, 0x7f, 0x5d, 0x80, 0xd1, 0x5a, 0xfb, 0x47, 0x38, 0x7c, 0xfb, 0xae, 0x5a, 0x8a, 0x98, 0x8d,
+	0xec, 0x0e, 0x14, 0xb0, 0xb4, 0xee, 0x6a, 0xfc, 0x0c, 0x09, 0x66, 0x42, 0xf3, 0xfa, 0x82, 0x93, 0x43, 0x5c, 0x57, 0xf0,
+	0xa5, 0x85, 0xdd, 0x97, 0x3d, 0x64, 0x27, 0xe0, 0x0e, 0x12, 0x25, 0xd8, 0x8e, 0x30, 0xc4, 0x38, 0xe3, 0xd6, 0x29, 0xe0,
+	0xa3, 0xd1, 0x0e, 0x17, 0x92, 0xb0, 0x0b, 0x1b, 0x93, 0xd5, 0x83, 0x03, 0xfe, 0x8d, 0x95, 0xba, 0xbe, 0x8f, 0xf8, 0x8b,
+	0x8b, 0x21, 0x8e, 0x46, 0xef, 0x51, 0xc5, 0x4b, 0x40, 0x39, 0x3a, 0x3f, 0x35, 0xfa, 0x14, 0x17, 0xed, 0xf8, 0x27, 0x0e,
+	0xdd, 0x50, 0x5d, 0xfc, 0xa6, 0xbe, 0xa1, 0xbb, 0x23, 0x9f, 0x0d, 0x9b, 0xd9, 0x23, 0x37, 0x94, 0xfc, 0x0f, 0xf7, 0x63,
+	0x72, 0x72, 0x20, 0x4e, 0x00, 0x00
+};
+
+static const uint8_t inflate_level6[] = {
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xed, 0x1c, 0xd9, 0x6e, 0xdb, 0x30, 0xec, 0xdd, 0x80, 0xff,
+	0x49, 0xf1, 0x7d, 0xfb, 0x1b, 0x7a, 0x64, 0x43, 0x81, 0x6e, 0x19, 0x72, 0xf4, 0x75, 0x7f, 0x6e, 0xcf, 0xa2, 0x14, 0xdf,
+	0xae, 0x25, 0x87, 0xb6, 0x65, 0x67, 0x00, 0x9b, 0xa6, 0x3a, 0x49, 0x8a, 0x22, 0x29, 0x52, 0x2a, 0xf1, 0x0f, 0x7f, 0x5e,
+	0xce, 0xd7, 0x8f, 0xeb, 0xc7, 0xe9, 0x77, 0x9c, 0x67, 0xe7, 0xdb, 0x8f, 0xdb, 0xe5, 0xe3, 0xd7, 0xcb, 0xcf, 0x63, 0x6c,
+	0xdb, 0x6f, 0x9f, 0xb7, 0xcb, 0xf5, 0x78, 0xf6, 0xe3, 0xcb, 0xf1, 0xed, 0x7a, 0x3a, 0x43, 0x9d, 0xae, 0x59, 0xf1, 0xce,
+	0xc1, 0x75, 0xcd, 0xa7, 0xa7, 0xf4, 0xeb, 0xf4, 0x79, 0xfb, 0x75, 0x2c, 0x2a, 0x42, 0xc2, 0x16, 0xdf, 0x83, 0xd5, 0x8f,
+	0xd8, 0x1f, 0x20, 0x20, 0x5c, 0x3a, 0x0e, 0x55, 0x2f, 0x5e, 0x92, 0x1a, 0xce, 0x7a, 0x2c, 0x25, 0xaf, 0xa7, 0xd3, 0x95,
+	0xfe, 0xfc, 0xb5, 0x23, 0x87, 0x51, 0xf1, 0x38, 0x25, 0x79, 0x26, 0xc1, 0xba, 0xd5, 0x40, 0x45, 0x9c, 0x66, 0x81, 0x89,
+	0xfd, 0xbc, 0x14, 0x1f, 0x95, 0x52, 0x77, 0x32, 0x51, 0xdb, 0xa9, 0xe8, 0x1d, 0x28, 0x55, 0xb7, 0xcb, 0x6b, 0x4c, 0x29,
+	0xa3, 0xdf, 0xd7, 0x58, 0xf6, 0xbd, 0x88, 0xf7, 0xc4, 0x7e, 0xe3, 0xd2, 0x9b, 0x67, 0x61, 0x94, 0x67, 0x3e, 0x5d, 0x23,
+	0x33, 0xf0, 0x13, 0x3f, 0x4d, 0xc6, 0x47, 0x65, 0x62, 0x7a, 0x48, 0x7b, 0xc4, 0xec, 0x71, 0x50, 0x65, 0xc5, 0xa8, 0xc4,
+	0x3a, 0xef, 0xe7, 0x8f, 0xaf, 0x63, 0x9e, 0xd5, 0x77, 0x1d, 0xdb, 0x87, 0x18, 0x53, 0x78, 0x7e, 0xe5, 0x44, 0xad, 0x4c,
+	0xac, 0x00, 0xf8, 0xc3, 0x95, 0xb5, 0xa5, 0x72, 0x5d, 0xe0, 0x55, 0xe8, 0x33, 0x36, 0xa5, 0xab, 0x22, 0x3d, 0x56, 0x8d,
+	0x23, 0x69, 0xba, 0x66, 0xc6, 0xe1, 0x3e, 0xb9, 0x45, 0x4a, 0x01, 0x05, 0x1b, 0x64, 0x5a, 0xf0, 0xcb, 0x99, 0x3e, 0x09,
+	0xdf, 0x43, 0x8c, 0xf6, 0xad, 0xb9, 0x91, 0x0c, 0xaf, 0xd4, 0x30, 0x96, 0x5f, 0x9b, 0x65, 0x74, 0x22, 0xb0, 0x79, 0x79,
+	0xe2, 0x40, 0xc9, 0x32, 0xe6, 0x6e, 0x61, 0x8d, 0x08, 0xff, 0x36, 0xb1, 0xfb, 0x66, 0x4c, 0xb2, 0x67, 0xb0, 0x0d, 0x77,
+	0x3f, 0xd1, 0x07, 0x88, 0x3c, 0x6c, 0xcb, 0x33, 0x29, 0xfc, 0x44, 0x1d, 0x6d, 0xf4, 0x75, 0xa1, 0x20, 0x05, 0x24, 0x7a,
+	0x7d, 0x4c, 0x24, 0x40, 0xa4, 0x55, 0x75, 0x6e, 0x59, 0x1e, 0xa5, 0xc1, 0x66, 0xb0, 0xd1, 0x1d, 0x26, 0xa9, 0xc0, 0xf6,
+	0x24, 0xd9, 0x4c, 0xb0, 0xa1, 0x90, 0x94, 0x7a, 0xd5, 0x3e, 0x7c, 0x86, 0x46, 0xf5, 0x28, 0x57, 0x4b, 0x91, 0xd2, 0x99,
+	0xf5, 0x19, 0x9b, 0x70, 0x68, 0x40, 0x01, 0x5c, 0xdf, 0xcf, 0xa4, 0x55, 0x22, 0xac, 0x34, 0xa9, 0x2a, 0x26, 0x49, 0xc7,
+	0xc9, 0x53, 0x4b, 0x43, 0x12, 0x8a, 0xa5, 0x28, 0xdf, 0x47, 0xa1, 0xe9, 0xf9, 0x49, 0x73, 0x4c, 0x1c, 0x96, 0x62, 0x22,
+	0xd0, 0x91, 0xd2, 0x7d, 0x17, 0x98, 0x36, 0xc6, 0xe0, 0xb3, 0x29, 0xf9, 0x9a, 0x9f, 0xdb, 0x72, 0xc0, 0x6d, 0x13, 0x26,
+	0xf5, 0x66, 0x98, 0x74, 0x46, 0x18, 0xab, 0xc6, 0x56, 0x12, 0x2c, 0x13, 0x81, 0x86, 0xbe, 0x7a, 0xbe, 0x4a, 0x08, 0x5c,
+	0x00, 0x51, 0x78, 0x18, 0x79, 0x97, 0x6d, 0x69, 0xaa, 0x3b, 0xf6, 0x72, 0xec, 0x7a, 0x42, 0x92, 0x1b, 0x50, 0xd0, 0x9b,
+	0xe8, 0x1a, 0x60, 0xdf, 0xdf, 0xa2, 0xb6, 0x9f, 0x7a, 0xea, 0x9b, 0xc7, 0x8f, 0xb1, 0xd3, 0x4a, 0x39, 0xd6, 0x9d, 0xdb,
+	0xf3, 0x5a, 0x21, 0xaa, 0xbf, 0x93, 0x83, 0xd9, 0xb6, 0xe4, 0xd6, 0xa6, 0x4d, 0x13, 0xf0, 0xed, 0x86, 0x36, 0xdc, 0xb2,
+	0x96, 0x2e, 0xd9, 0x83, 0x7b, 0xa4, 0x52, 0xde, 0x64, 0x0c, 0xe8, 0xc2, 0x1a, 0xf0, 0x19, 0x5b, 0x8c, 0xc1, 0x45, 0x61,
+	0x2c, 0xd6, 0xbb, 0x22, 0x07, 0x0a, 0x9e, 0x29, 0x6d, 0x04, 0xf1, 0x7c, 0xd1, 0xe6, 0x53, 0x4c, 0xc8, 0xfa, 0xac, 0x2b,
+	0x81, 0xe2, 0xc5, 0x42, 0xb5, 0xbb, 0xd0, 0xf3, 0xa6, 0x23, 0x15, 0x72, 0x9e, 0xa2, 0x0b, 0x83, 0x72, 0x27, 0x55, 0xc0,
+	0x77, 0x47, 0x2b, 0x49, 0x23, 0xd4, 0x32, 0x75, 0x1d, 0xcb, 0x29, 0x84, 0xa6, 0x33, 0xd3, 0xce, 0x4c, 0x8a, 0xed, 0x95,
+	0x34, 0x37, 0xd3, 0x63, 0x0f, 0xc8, 0x02, 0x03, 0x45, 0x6d, 0xce, 0x61, 0x72, 0x7f, 0xcd, 0xcf, 0x33, 0x44, 0x64, 0x56,
+	0x06, 0x99, 0xb6, 0x64, 0xb8, 0x0a, 0x3d, 0x5c, 0x5f, 0xec, 0xb9, 0x90, 0xfb, 0xbe, 0xc9, 0xf7, 0x2d, 0x77, 0x19, 0x60,
+	0xa9, 0x14, 0x3f, 0x2f, 0x79, 0x1e, 0x67, 0x81, 0x51, 0xd7, 0x36, 0x53, 0x53, 0x81, 0x29, 0x3c, 0x8f, 0xe4, 0x99, 0x78,
+	0x8e, 0x5e, 0xd1, 0x83, 0x2a, 0x65, 0xd1, 0xc0, 0xba, 0x0e, 0x61, 0xb6, 0x6a, 0xc0, 0x05, 0x46, 0x93, 0x32, 0xf8, 0xb3,
+	0xde, 0xd1, 0x5a, 0x75, 0xef, 0x98, 0x28, 0xc4, 0x20, 0xb9, 0x83, 0x9c, 0x88, 0xb1, 0xd9, 0x90, 0xe3, 0x65, 0x42, 0x9a,
+	0x70, 0xc9, 0xcc, 0x35, 0xc2, 0x18, 0x5b, 0x3c, 0x8b, 0xe8, 0xd4, 0xb6, 0xd6, 0xb5, 0x8e, 0xc5, 0x02, 0x90, 0x35, 0x5d,
+	0x61, 0xcc, 0xc9, 0x77, 0x65, 0x4e, 0xe2, 0xfa, 0xb7, 0x01, 0x6d, 0xc6, 0x9b, 0x10, 0x43, 0x4a, 0x00, 0x14, 0x4d, 0x0a,
+	0xca, 0xf7, 0xe9, 0xa6, 0xc5, 0xeb, 0xb6, 0x7a, 0xa3, 0x69, 0xdc, 0x04, 0x8b, 0xe5, 0xf2, 0x3d, 0xd4, 0x4b, 0x4b, 0x08,
+	0x82, 0x6c, 0x0f, 0x70, 0xbb, 0x39, 0x93, 0xfb, 0x08, 0x47, 0x86, 0xc6, 0x39, 0x16, 0xe4, 0xaf, 0x60, 0x6c, 0xc4, 0x4b,
+	0x8d, 0x54, 0xd7, 0xe8, 0xb9, 0xfe, 0xdb, 0x31, 0x70, 0xcc, 0xad, 0x84, 0x49, 0x5b, 0xcb, 0xc9, 0x8f, 0x9c, 0xa0, 0x51,
+	0x25, 0xe1, 0x87, 0x01, 0x63, 0x53, 0xf8, 0x04, 0x1f, 0xde, 0xe7, 0x97, 0x6c, 0x8d, 0x80, 0x2f, 0xb5, 0x45, 0x1c, 0x8f,
+	0x23, 0xd3, 0xb9, 0x1a, 0x26, 0xe3, 0x15, 0x45, 0xa5, 0x96, 0xb1, 0xcd, 0xfb, 0x22, 0xfa, 0x9d, 0x76, 0xf2, 0x82, 0xb2,
+	0xa2, 0x3a, 0x83, 0x51, 0xe0, 0x83, 0x71, 0x06, 0x24, 0xc5, 0xcb, 0xb3, 0x04, 0x6a, 0x57, 0xbf, 0x4d, 0x97, 0x84, 0x05,
+	0x6f, 0xb8, 0x53, 0x52, 0x3b, 0x3e, 0xdd, 0xb7, 0x52, 0x1f, 0x6a, 0xff, 0x67, 0x4f, 0x57, 0x4c, 0x9a, 0x25, 0xd5, 0x3d,
+	0x74, 0xaa, 0x8e, 0x6c, 0x96, 0x5e, 0x56, 0xfd, 0xe4, 0xc7, 0x36, 0xd7, 0x46, 0x33, 0x7e, 0x88, 0x29, 0xba, 0x56, 0xdc,
+	0xa3, 0x7a, 0x98, 0xe9, 0x86, 0x79, 0xa6, 0x6b, 0xc4, 0x6e, 0xdd, 0x32, 0xdb, 0xc6, 0x15, 0x2a, 0xd0, 0x62, 0x96, 0x02,
+	0xda, 0x6c, 0x00, 0xc8, 0xb2, 0x61, 0x4d, 0x14, 0xc0, 0x7f, 0xd1, 0xe2, 0x22, 0x74, 0x29, 0xc4, 0xb3, 0x00, 0xa3, 0x77,
+	0xdb, 0x6f, 0x4b, 0x93, 0x51, 0xe4, 0xec, 0xfa, 0x70, 0x5b, 0xf7, 0x6f, 0x42, 0x62, 0x76, 0xab, 0x44, 0xa2, 0xe0, 0x78,
+	0x6f, 0xa4, 0x7a, 0x40, 0xf0, 0xfe, 0x7d, 0x3b, 0x31, 0x85, 0x87, 0x02, 0xa9, 0xdf, 0xbc, 0x0a, 0xb7, 0xb3, 0x9c, 0xb8,
+	0xee, 0x2a, 0x15, 0x83, 0xc0, 0x1d, 0x70, 0x9e, 0xfa, 0x81, 0x71, 0xa6, 0x3e, 0x6a, 0x84, 0x86, 0x8e, 0x5a, 0xc1, 0x00,
+	0x8e, 0x53, 0xa3, 0x0d, 0x6d, 0xa2, 0x6b, 0x81, 0xdc, 0xc8, 0xe3, 0x89, 0xf1, 0x34, 0x35, 0x0a, 0xe5, 0x62, 0xa3, 0x5c,
+	0xf4, 0x19, 0x81, 0x89, 0xf7, 0x0e, 0x75, 0x6d, 0x30, 0x15, 0xb7, 0x9f, 0xc7, 0x30, 0x56, 0x6f, 0x10, 0xae, 0xe3, 0xef,
+	0xb4, 0x60, 0x6f, 0x4f, 0x2a, 0x4a, 0x72, 0x22, 0xc2, 0xcb, 0x55, 0x38, 0xc3, 0x01, 0x11, 0x66, 0xcb, 0x51, 0x06, 0x6f,
+	0xa8, 0xef, 0x8a, 0x86, 0x38, 0x07, 0xc5, 0x41, 0xb5, 0xff, 0x22, 0xd0, 0x1e, 0x4d, 0xf2, 0xdc, 0xc3, 0x66, 0x30, 0x8c,
+	0x42, 0xef, 0xc4, 0x0d, 0x75, 0xb0, 0xcb, 0xa4, 0x7a, 0x1f, 0x50, 0x97, 0xd5, 0xf0, 0x9c, 0x25, 0x53, 0xa5, 0xdd, 0x22,
+	0x95, 0xaf, 0xca, 0x71, 0x7f, 0x37, 0x16, 0xb2, 0x16, 0xd2, 0x30, 0xb1, 0x1f, 0xb6, 0xb9, 0xc1, 0x26, 0xab, 0x0f, 0xd6,
+	0x7b, 0x4e, 0x48, 0xc5, 0x60, 0xbe, 0xf1, 0xc7, 0xaa, 0xa7, 0x5c, 0x52, 0x30, 0xa7, 0x46, 0x0a, 0x1e, 0x7d, 0x51, 0xa1,
+	0x57, 0xd8, 0x44, 0xbc, 0xe1, 0x22, 0xa1, 0x31, 0x47, 0xee, 0x66, 0x64, 0x17, 0xd4, 0x7f, 0x07, 0xc1, 0x75, 0x1c, 0x16,
+	0x23, 0x87, 0x56, 0x14, 0x88, 0xa4, 0x73, 0xdd, 0xff, 0xfb, 0x80, 0xff, 0xd4, 0xf7, 0x78, 0x7a, 0x0e, 0xfe, 0xbc, 0x42,
+	0x64, 0x99, 0xff, 0x01, 0xc0, 0x3c, 0x8e, 0xa8, 0x20, 0x4e, 0x00, 0x00
+};
+
+static const uint8_t inflate_level9[] = {
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0x5d, 0xe9, 0x92, 0xa4, 0x28, 0x10, 0xfe, 0x6f, 0x84,
+	0xef, 0x84, 0xa2, 0xe2, 0x81, 0xfa, 0x0c, 0xd3, 0xbd, 0xbd, 0x1b, 0x1d, 0x31, 0xb3, 0xbd, 0xd1, 0xc7, 0xfc, 0xdd, 0x37,
+	0xd7, 0x85, 0x4c, 0xc0, 0xa3, 0xbb, 0x66, 0xea, 0xb0, 0x94, 0x63, 0x23, 0xba, 0xeb, 0xb0, 0x10, 0x13, 0x48, 0xf2, 0xf8,
+	0x48, 0x12, 0xfa, 0xf3, 0xe5, 0xfb, 0xc7, 0x8f, 0xa7, 0x71, 0x78, 0xfc, 0xfe, 0xf1, 0xf6, 0xfe, 0xf4, 0xfa, 0xf6, 0xf4,
+	0xf8, 0xfe, 0xa2, 0x5e, 0xd5, 0x25, 0xbb, 0x2e, 0x96, 0x1f, 0x6f, 0x0f, 0x8b, 0x9f, 0x29, 0xfe, 0xf2, 0xfc, 0xe3, 0xdb,
+	0x5f, 0x4f, 0x8b, 0x9b, 0x44, 0xc1, 0x7f, 0xbe, 0xbd, 0xbe, 0x3f, 0xbf, 0x3f, 0xbf, 0xfc, 0xdd, 0xb8, 0x4b, 0x31, 0x9b,
+	0x6a, 0xdc, 0x97, 0xc6, 0x20, 0xc6, 0x02, 0x48, 0xa5, 0x69, 0x9b, 0x8a, 0x02, 0xbf, 0xbf, 0xfb, 0xdf, 0x9c, 0x17, 0x21,
+	0xf3, 0xde, 0xeb, 0xc7, 0x9f, 0x1f, 0x6f, 0xf8, 0xbd, 0xb4, 0xa4, 0x05, 0x96, 0x75, 0x3a, 0x8a, 0x53, 0xff, 0xc6, 0x66,
+	0x5f, 0x21, 0xa6, 0x9a, 0x61, 0x9f, 0x18, 0x8c, 0x23, 0x51, 0x02, 0xda, 0x9c, 0x2d, 0x14, 0xe6, 0x21, 0xfc, 0x7f, 0x1c,
+	0x23, 0xd8, 0xcf, 0x1c, 0x2d, 0x55, 0x77, 0x30, 0xf5, 0x0e, 0xbd, 0x72, 0xaa, 0xab, 0xda, 0x3f, 0x5e, 0x9f, 0x7f, 0x3e,
+	0xed, 0x38, 0xc1, 0xa0, 0x2e, 0xd3, 0x13, 0x0f, 0x2f, 0x2f, 0xef, 0x4c, 0xea, 0x96, 0xcb, 0xa9, 0xb3, 0x74, 0xc2, 0x19,
+	0x82, 0xca, 0x1d, 0xa5, 0x8e, 0xfa, 0x9e, 0x8a, 0xcf, 0x47, 0xc8, 0xaf, 0x44, 0x0e, 0xa3, 0x1c, 0x45, 0x1c, 0xae, 0xeb,
+	0x8c, 0x29, 0xa0, 0xc7, 0x3c, 0x1f, 0xb5, 0x89, 0xf9, 0x4a, 0xec, 0xb6, 0x79, 0xd4, 0x97, 0x16, 0xf8, 0x16, 0x5e, 0xc4,
+	0x93, 0x2d, 0x37, 0x94, 0x65, 0xeb, 0xb0, 0x97, 0xe3, 0x08, 0xc6, 0x2d, 0x8e, 0x74, 0x99, 0x1d, 0x07, 0x5b, 0x56, 0x46,
+	0x3b, 0xa8, 0xaa, 0x86, 0x8b, 0xf0, 0xb1, 0x84, 0x57, 0x1f, 0xb8, 0x3d, 0x0b, 0x9a, 0x95, 0xe0, 0xa1, 0x49, 0xb8, 0x56,
+	0x64, 0xa7, 0xea, 0x4b, 0xaa, 0x82, 0x30, 0xc2, 0xb0, 0x71, 0x1c, 0xdf, 0x24, 0x17, 0x39, 0xe5, 0x34, 0x21, 0xd9, 0xe1,
+	0xb0, 0x3f, 0xdf, 0x83, 0x32, 0x43, 0x02, 0xca, 0xc0, 0xa6, 0xae, 0xb7, 0x9e, 0x05, 0x29, 0x8d, 0xa3, 0xec, 0x42, 0x11,
+	0x5d, 0x25, 0x89, 0x9e, 0xcf, 0x86, 0x40, 0xf1, 0x1c, 0xf1, 0xe7, 0xa9, 0xdd, 0xb9, 0xa6, 0x80, 0x25, 0x35, 0xde, 0xbb,
+	0xe8, 0x2e, 0x46, 0xa1, 0x57, 0x95, 0x1a, 0x80, 0x1a, 0xfd, 0x47, 0x06, 0x39, 0xbe, 0xc7, 0x91, 0x63, 0x82, 0xa9, 0xc8,
+	0x35, 0x0b, 0x77, 0x93, 0xc0, 0x35, 0x8d, 0x37, 0xe5, 0xe4, 0xd5, 0xa6, 0x84, 0xb1, 0x4c, 0xe2, 0x88, 0x88, 0x7f, 0x4f,
+	0x30, 0xd6, 0xbb, 0x3d, 0x78, 0x31, 0x89, 0x6a, 0xec, 0xdb, 0x7c, 0x07, 0x39, 0xdf, 0x73, 0xa2, 0xbe, 0xc4, 0x51, 0xca,
+	0xa7, 0x1b, 0x2d, 0x46, 0xf1, 0x0f, 0x55, 0x15, 0x8e, 0xcc, 0xd9, 0x04, 0x55, 0x01, 0x33, 0xcd, 0x53, 0xe5, 0xbd, 0x32,
+	0x2a, 0xac, 0x70, 0x63, 0xa9, 0x46, 0xf0, 0x0c, 0x89, 0x79, 0x6d, 0xdb, 0x32, 0x47, 0xeb, 0xa8, 0xcd, 0xe0, 0x1b, 0x56,
+	0x0b, 0x77, 0x5f, 0x5e, 0x59, 0x5e, 0x6b, 0xe7, 0x7c, 0x4b, 0x8c, 0xc5, 0x39, 0x7b, 0x15, 0x9f, 0x9d, 0x5a, 0x6b, 0xcf,
+	0x78, 0x86, 0xc0, 0xf6, 0xb2, 0x11, 0x78, 0x15, 0xbb, 0xa6, 0x80, 0x7e, 0xac, 0x88, 0x81, 0xb4, 0x32, 0x41, 0x68, 0x97,
+	0x88, 0x17, 0x03, 0xe1, 0x84, 0xa4, 0x76, 0xb0, 0x53, 0x18, 0x34, 0x78, 0x62, 0xa8, 0x40, 0x50, 0x5f, 0xa4, 0xce, 0x03,
+	0x5c, 0xc9, 0x5b, 0xc3, 0x3f, 0x23, 0xb9, 0x61, 0x23, 0x85, 0x98, 0x89, 0xb6, 0xdd, 0x00, 0x2c, 0x4a, 0xfa, 0x96, 0x8c,
+	0x85, 0x3f, 0x92, 0x1a, 0xe5, 0x62, 0xa5, 0x0a, 0xe7, 0xd6, 0x5a, 0x6c, 0x5e, 0x00, 0x69, 0x95, 0xa4, 0x56, 0x81, 0x9e,
+	0x14, 0x48, 0xf7, 0x3c, 0xc6, 0x27, 0xed, 0x58, 0x33, 0xd3, 0xe0, 0xf8, 0x7a, 0x39, 0xd0, 0x2d, 0x7b, 0x4a, 0x7d, 0x6c,
+	0x36, 0x5d, 0x3e, 0x2d, 0xcd, 0x8d, 0x2d, 0x9a, 0x05, 0x5f, 0x7b, 0xaa, 0x5e, 0x62, 0xc4, 0x19, 0x5e, 0x1a, 0x07, 0xe8,
+	0xb3, 0x60, 0xe2, 0x7f, 0xb0, 0x70, 0x18, 0x11, 0x80, 0xa2, 0x8a, 0x06, 0xaf, 0x05, 0x1d, 0x7f, 0x40, 0x70, 0x21, 0xd5,
+	0x52, 0xe0, 0x62, 0x72, 0x2c, 0xaf, 0x85, 0x14, 0x0a, 0xd7, 0xa6, 0xab, 0xe4, 0x2f, 0xfc, 0x0c, 0xec, 0xb4, 0xf6, 0x38,
+	0xb8, 0xed, 0xbe, 0x7f, 0x1c, 0x25, 0x39, 0x5c, 0x23, 0xde, 0xc7, 0xc7, 0xd6, 0xe2, 0x95, 0xd7, 0x30, 0x4c, 0xe7, 0x1a,
+	0x62, 0x71, 0xd4, 0x8c, 0x83, 0x65, 0x9d, 0x61, 0x2a, 0x89, 0xa3, 0xe0, 0x91, 0xad, 0x45, 0xb9, 0xcf, 0x5d, 0xbe, 0x26,
+	0x69, 0x1f, 0xf6, 0x2b, 0x2f, 0xa6, 0x5c, 0x0b, 0x8b, 0xa6, 0xa1, 0x72, 0xb8, 0xf6, 0x5c, 0xbc, 0x50, 0x25, 0x30, 0x28,
+	0x07, 0x7a, 0xd0, 0x75, 0x85, 0x69, 0x8f, 0x60, 0x41, 0x7b, 0xb4, 0x6f, 0xb5, 0xc1, 0x6c, 0xba, 0x27, 0x1c, 0xbf, 0x2c,
+	0x03, 0xd2, 0x37, 0x40, 0xe6, 0xe5, 0xdb, 0x8e, 0x37, 0x15, 0x2d, 0x0e, 0x1e, 0xae, 0xc6, 0x8d, 0x83, 0x23, 0x38, 0xd2,
+	0x1d, 0x38, 0xa7, 0xf5, 0x60, 0xad, 0x48, 0x10, 0x95, 0x65, 0x72, 0x38, 0xd5, 0xb3, 0xe4, 0x47, 0xf8, 0x3d, 0xcf, 0xc3,
+	0x6e, 0x3c, 0x89, 0xa3, 0x69, 0xbd, 0x61, 0x8b, 0xa8, 0x4b, 0x6d, 0x2d, 0x1d, 0x29, 0xa6, 0x64, 0x6d, 0x0a, 0x0a, 0x90,
+	0x2f, 0xad, 0x5d, 0xd8, 0xdd, 0xc9, 0x67, 0x9c, 0xd1, 0xb2, 0x6c, 0x13, 0xc3, 0x8b, 0xb3, 0x6e, 0x1c, 0x4c, 0x77, 0xdb,
+	0x1b, 0x1d, 0x0b, 0x8c, 0x1a, 0x12, 0x66, 0x51, 0x94, 0x3c, 0x39, 0x6c, 0x1a, 0xef, 0xe0, 0x89, 0x6b, 0xe8, 0xc2, 0x47,
+	0xb4, 0x67, 0xc2, 0x01, 0xfc, 0xde, 0xe2, 0x54, 0x14, 0x15, 0x71, 0x33, 0x22, 0xc7, 0x73, 0xe0, 0xd7, 0xe6, 0x68, 0x35,
+	0x6b, 0x3d, 0xb1, 0xff, 0x21, 0x11, 0xd9, 0x1b, 0xa4, 0xee, 0x93, 0x59, 0xf0, 0xf3, 0x92, 0x64, 0xf8, 0xa1, 0x0e, 0x7c,
+	0xb7, 0xd2, 0x51, 0x08, 0xde, 0x96, 0xd2, 0x56, 0xc5, 0x7a, 0xb7, 0x50, 0x47, 0x01, 0xfa, 0xca, 0xb6, 0xb0, 0x8f, 0xc6,
+	0x44, 0x39, 0xc5, 0x91, 0xa2, 0xb6, 0x2d, 0x9a, 0x30, 0xcd, 0x90, 0x56, 0x3d, 0xd1, 0xd4, 0x5c, 0x85, 0xbe, 0x5e, 0x58,
+	0x3a, 0x19, 0x27, 0x39, 0x0e, 0x54, 0x09, 0xb7, 0x24, 0x09, 0x27, 0x40, 0x43, 0x4e, 0x03, 0x77, 0xf6, 0x20, 0x27, 0x61,
+	0xc5, 0x49, 0xe7, 0x8b, 0xe8, 0xd2, 0x03, 0xc3, 0x75, 0xa4, 0x9f, 0x3a, 0x91, 0x7a, 0x45, 0x3b, 0xa1, 0x34, 0xae, 0x5a,
+	0x64, 0x5e, 0xc7, 0x06, 0xdb, 0x06, 0x30, 0xb9, 0xa5, 0x67, 0xee, 0x6d, 0x69, 0xee, 0xbb, 0x41, 0xcf, 0xd4, 0xf1, 0x29,
+	0x1c, 0x2d, 0xef, 0x6f, 0xf7, 0x6e, 0xad, 0xc6, 0x6a, 0xb3, 0x8c, 0x61, 0xe9, 0xdc, 0xc0, 0x5f, 0x13, 0xf0, 0x72, 0x1f,
+	0x5d, 0x63, 0x7f, 0x98, 0x72, 0x28, 0x39, 0x56, 0x42, 0xdf, 0x47, 0x0d, 0xd4, 0x36, 0x7c, 0x86, 0xdd, 0xfb, 0x99, 0xff,
+	0xaf, 0xc2, 0xcb, 0x7e, 0xa7, 0xe9, 0xf3, 0x34, 0x5b, 0x54, 0xc2, 0x73, 0xfc, 0x3c, 0xa3, 0x5f, 0x8a, 0xa7, 0xf6, 0x40,
+	0x23, 0x7a, 0x52, 0xfa, 0xad, 0x43, 0x2b, 0x39, 0x07, 0x5b, 0x13, 0x27, 0xaa, 0xa3, 0xca, 0x0e, 0xa8, 0x10, 0x16, 0x93,
+	0x54, 0xa7, 0x4e, 0x45, 0xd9, 0xf3, 0xba, 0x36, 0x36, 0x5f, 0x1c, 0x39, 0x93, 0xd2, 0x46, 0x6d, 0x89, 0x77, 0x19, 0x24,
+	0xaa, 0xd6, 0xb4, 0x36, 0xb0, 0x33, 0x48, 0x50, 0x52, 0xed, 0xe5, 0x63, 0x31, 0xc6, 0xc3, 0x58, 0x70, 0x18, 0x87, 0x71,
+	0x20, 0x69, 0x37, 0x0e, 0xc9, 0x4c, 0xf0, 0x60, 0xc7, 0xb9, 0xbf, 0x88, 0x0c, 0xbd, 0x2d, 0x08, 0x89, 0x23, 0xc7, 0xd3,
+	0xfb, 0x74, 0xab, 0x2d, 0x6c, 0xb2, 0xe3, 0xc7, 0x01, 0xe8, 0x2b, 0x8c, 0x88, 0x0a, 0x2c, 0x77, 0x96, 0x53, 0x3b, 0x9b,
+	0x11, 0x79, 0x9a, 0xb8, 0x6a, 0x1c, 0xca, 0xa2, 0x20, 0xdb, 0xcb, 0x4f, 0x61, 0xf3, 0xcf, 0x49, 0x26, 0xab, 0x35, 0x95,
+	0x38, 0x62, 0xbc, 0xef, 0x64, 0x97, 0x80, 0x6b, 0xdc, 0x90, 0x93, 0x6c, 0x91, 0xb6, 0xc7, 0x05, 0x5c, 0xc7, 0x91, 0x1c,
+	0x2f, 0xea, 0x44, 0xbe, 0x3f, 0x31, 0x90, 0x1c, 0xa1, 0x09, 0xb8, 0x2e, 0x95, 0x14, 0x69, 0x17, 0x6d, 0xc2, 0x41, 0x3f,
+	0x00, 0xd4, 0xe5, 0x4b, 0x1c, 0x1b, 0xee, 0xd4, 0xc2, 0xe1, 0x5e, 0xd9, 0x75, 0x40, 0x22, 0xc5, 0x51, 0x9f, 0xbb, 0xb6,
+	0xd7, 0xa6, 0xca, 0x01, 0xbc, 0x92, 0xff, 0x82, 0x7e, 0x9a, 0x78, 0x9f, 0x1e, 0xcb, 0x79, 0xf9, 0x94, 0x1d, 0x6c, 0x83,
+	0xe0, 0xc5, 0x9a, 0x00, 0x87, 0xe5, 0x49, 0x41, 0xac, 0x8e, 0x73, 0x52, 0xc3, 0x7f, 0x7c, 0x34, 0xe3, 0x3c, 0x5f, 0x9e,
+	0x03, 0xb9, 0x0c, 0x3a, 0x32, 0x0e, 0x1a, 0xbc, 0x03, 0x74, 0xdb, 0xbb, 0xe5, 0xce, 0x7e, 0xed, 0x6d, 0xdd, 0x05, 0x5a,
+	0x4a, 0xb8, 0x33, 0x31, 0x97, 0xa0, 0x04, 0xfc, 0x38, 0x43, 0xa1, 0xb3, 0x51, 0x05, 0x04, 0xbd, 0x75, 0x39, 0x3b, 0x44,
+	0xf5, 0x34, 0xde, 0x47, 0x6a, 0x58, 0x1e, 0x29, 0x53, 0xdc, 0xc9, 0x2f, 0x26, 0x26, 0x84, 0x68, 0xe6, 0x6c, 0x10, 0x49,
+	0x59, 0x15, 0xe8, 0x9a, 0x00, 0xb9, 0x85, 0x07, 0x7c, 0x5b, 0x53, 0x1e, 0x07, 0x95, 0x66, 0x9c, 0x86, 0x04, 0x69, 0x6f,
+	0xa7, 0xc4, 0xe2, 0x08, 0x07, 0x42, 0x61, 0x6d, 0x2d, 0x0c, 0x7c, 0xa3, 0xfd, 0x93, 0xda, 0xba, 0xbd, 0xcb, 0x5a, 0x96,
+	0xde, 0x28, 0xd1, 0xb7, 0xda, 0x1a, 0x4b, 0x32, 0x20, 0x48, 0xa9, 0x2b, 0xc1, 0x7b, 0x9d, 0xcc, 0xc0, 0xd7, 0x36, 0xbf,
+	0x73, 0x0d, 0x8b, 0x30, 0x73, 0x2e, 0x6a, 0xcb, 0xe2, 0x16, 0x93, 0x84, 0x93, 0x9d, 0x62, 0x9e, 0xc9, 0xdd, 0xb1, 0xfc,
+	0x40, 0x76, 0x7f, 0x55, 0xb8, 0xb3, 0x14, 0x08, 0xe8, 0x7b, 0x3d, 0x94, 0xdb, 0xe0, 0x56, 0x58, 0x0c, 0x40, 0x49, 0xa8,
+	0x30, 0xdd, 0x07, 0x6e, 0xcf, 0x53, 0xb2, 0x5c, 0x2c, 0x9e, 0x61, 0x8f, 0xac, 0x71, 0xe0, 0x2c, 0x8d, 0x92, 0x2c, 0x8c,
+	0x3b, 0xdd, 0xc3, 0x96, 0x65, 0xe2, 0x49, 0xba, 0x13, 0x9c, 0x27, 0x0a, 0x79, 0x7f, 0xe2, 0xa6, 0x5e, 0xdb, 0x1b, 0x07,
+	0xc6, 0xb8, 0x6c, 0xb0, 0x12, 0xd9, 0x39, 0x67, 0x8d, 0x55, 0xd3, 0xc2, 0x80, 0x7f, 0xde, 0x38, 0xda, 0x70, 0x4d, 0x75,
+	0xb9, 0xc5, 0x63, 0xec, 0xf5, 0x06, 0x3f, 0xb5, 0xc0, 0x32, 0xc5, 0x40, 0x7e, 0x51, 0x95, 0xdc, 0x1a, 0x65, 0x97, 0xce,
+	0xaa, 0x76, 0x0e, 0xbb, 0xeb, 0x53, 0x9c, 0xaa, 0x40, 0x19, 0xad, 0x69, 0x91, 0x2a, 0x0b, 0x2e, 0xaf, 0xd3, 0xed, 0x62,
+	0x94, 0xb5, 0x8b, 0x10, 0xda, 0xee, 0xde, 0xd5, 0xe2, 0x4d, 0x6f, 0xa2, 0x31, 0x1f, 0xdf, 0x31, 0x40, 0xa1, 0xb2, 0x2a,
+	0x06, 0xc1, 0xe4, 0x03, 0x26, 0x71, 0x64, 0x49, 0x3e, 0x07, 0x7d, 0xf8, 0xf8, 0xf1, 0xa7, 0x30, 0x32, 0xea, 0x6d, 0x26,
+	0x02, 0x9d, 0xcb, 0xf6, 0xbe, 0xb3, 0xba, 0xd6, 0x51, 0x6b, 0x7d, 0x1c, 0x1d, 0x7b, 0x87, 0x4a, 0x81, 0x7f, 0x8e, 0x3f,
+	0xea, 0x2c, 0x5b, 0x1e, 0xb1, 0xd9, 0x40, 0x76, 0xa4, 0x01, 0xfe, 0x32, 0x9b, 0x73, 0x2c, 0x9c, 0x5b, 0x85, 0xda, 0x96,
+	0xa0, 0x0a, 0x30, 0x21, 0x16, 0xfd, 0x8c, 0x6b, 0x6c, 0xda, 0x7e, 0xf2, 0x10, 0x61, 0xb8, 0xec, 0xdc, 0xad, 0xe8, 0xcf,
+	0x66, 0x01, 0x33, 0x4f, 0xa8, 0xb0, 0xcc, 0x1d, 0x55, 0x1e, 0x77, 0xd6, 0x33, 0xab, 0x90, 0x4e, 0xa7, 0xf9, 0x45, 0x48,
+	0x0e, 0x49, 0x6f, 0x1c, 0x6d, 0xbd, 0x15, 0xb5, 0x9f, 0x2b, 0x1c, 0xb8, 0x2f, 0x6d, 0xb4, 0x57, 0x18, 0xc4, 0x9e, 0x9a,
+	0x4f, 0xeb, 0x61, 0xa1, 0xe5, 0xc3, 0xa6, 0x5b, 0xf9, 0x10, 0xf2, 0x79, 0x69, 0xb5, 0x80, 0xee, 0xc9, 0x17, 0x90, 0x7b,
+	0x71, 0x78, 0x34, 0xac, 0x6d, 0x61, 0x24, 0xbe, 0x2e, 0x32, 0xa9, 0xad, 0x5e, 0x19, 0x2e, 0x19, 0x3d, 0x42, 0x2d, 0x97,
+	0x06, 0xe9, 0x15, 0x87, 0x9c, 0x61, 0xe4, 0xfe, 0xf1, 0xe3, 0x4a, 0x61, 0xa4, 0x65, 0x57, 0xf5, 0x18, 0x38, 0xad, 0x7d,
+	0x0e, 0x73, 0x3c, 0x15, 0x14, 0x98, 0x2d, 0x1c, 0xa8, 0xba, 0x0e, 0x8a, 0x4f, 0x4e, 0x80, 0x12, 0x82, 0x5b, 0xce, 0x74,
+	0xce, 0xa1, 0xa3, 0xd3, 0x99, 0x95, 0x3e, 0x65, 0x9b, 0xd4, 0xbe, 0x2d, 0x42, 0x8b, 0x4c, 0x11, 0x68, 0x37, 0x30, 0x06,
+	0x2e, 0x76, 0xee, 0x96, 0x03, 0x7d, 0xfe, 0x59, 0x5c, 0xdd, 0x2c, 0xa3, 0xd9, 0x96, 0x08, 0x89, 0x99, 0xa8, 0x92, 0x77,
+	0xf4, 0xfe, 0x25, 0xad, 0x4a, 0x71, 0x45, 0xa6, 0x39, 0x53, 0x73, 0xd0, 0xba, 0x47, 0xba, 0xf3, 0x4a, 0x71, 0x4c, 0xd2,
+	0x29, 0x31, 0xb7, 0x1f, 0x5e, 0xa2, 0x1f, 0xd2, 0x9d, 0x3f, 0x83, 0x8d, 0xbf, 0x1c, 0x70, 0xfa, 0x26, 0x5b, 0x22, 0x60,
+	0xc5, 0x58, 0x87, 0x75, 0x3e, 0x5c, 0x93, 0xd0, 0xac, 0x2c, 0xd2, 0x85, 0x5a, 0x55, 0x73, 0xb9, 0xe5, 0x25, 0x1a, 0xb6,
+	0x41, 0x5b, 0x0c, 0xb4, 0x4a, 0x2c, 0x3d, 0x42, 0x65, 0x0e, 0x13, 0xfc, 0x7a, 0x16, 0x2a, 0x5e, 0x2e, 0xcf, 0xe9, 0xe9,
+	0xdc, 0xd6, 0x43, 0x60, 0x58, 0x25, 0x6d, 0x15, 0x73, 0x60, 0xeb, 0x4d, 0xc7, 0x37, 0x97, 0x0a, 0xa2, 0x50, 0x32, 0x20,
+	0xc4, 0xa8, 0x33, 0x13, 0xe1, 0xb9, 0x47, 0x46, 0x8e, 0xca, 0x6f, 0x66, 0x86, 0xd6, 0x43, 0xe7, 0x73, 0x2b, 0x17, 0xe6,
+	0xf0, 0x63, 0xb6, 0xa7, 0x79, 0x47, 0x1b, 0xcd, 0xb1, 0x82, 0xda, 0xbe, 0xa1, 0xa7, 0x4b, 0x1b, 0xce, 0x95, 0xff, 0x99,
+	0x27, 0x19, 0x49, 0x26, 0x04, 0x2b, 0x80, 0xb4, 0x0f, 0xd0, 0x0d, 0x3d, 0x5f, 0x9c, 0xe1, 0x71, 0x91, 0x8e, 0x5f, 0xb0,
+	0xe5, 0xaa, 0xeb, 0x76, 0xcd, 0xe6, 0x6e, 0xcd, 0x89, 0x6e, 0xf2, 0x70, 0xf2, 0x15, 0x5f, 0xc7, 0x11, 0xed, 0x58, 0x76,
+	0xb1, 0xde, 0x0b, 0xec, 0x1c, 0xae, 0x4e, 0x8b, 0x86, 0x70, 0x73, 0x25, 0x9c, 0xa5, 0xc2, 0x79, 0xad, 0x81, 0x2b, 0x57,
+	0x81, 0xf3, 0xd2, 0xf5, 0x13, 0x5e, 0xd4, 0x05, 0x47, 0x96, 0xf8, 0xf5, 0x52, 0x0c, 0x62, 0x9f, 0x52, 0x3e, 0x11, 0x63,
+	0xc0, 0x50, 0xa9, 0xe3, 0x69, 0xca, 0x66, 0x09, 0xb4, 0x94, 0x1d, 0x2b, 0x69, 0x4e, 0xf2, 0x9d, 0xe2, 0x58, 0xfa, 0x74,
+	0x1c, 0x38, 0xe9, 0x8e, 0xcb, 0xc4, 0xb7, 0x19, 0x93, 0x75, 0xe1, 0x1e, 0xe1, 0xbe, 0x8a, 0xad, 0xdf, 0x14, 0xa4, 0xaf,
+	0xf7, 0x9b, 0x71, 0xe6, 0x1e, 0xae, 0x73, 0x06, 0xcc, 0x94, 0x49, 0x33, 0x5b, 0xa5, 0x02, 0xc5, 0x73, 0x78, 0x0a, 0x1d,
+	0x8b, 0x42, 0xb8, 0xb3, 0x71, 0x90, 0x2a, 0x0a, 0x0a, 0x2f, 0x5a, 0x63, 0xb0, 0x9d, 0xa3, 0x51, 0x28, 0x1c, 0xcf, 0xfe,
+	0x8c, 0x08, 0x78, 0x65, 0x93, 0x04, 0x71, 0x82, 0x95, 0xda, 0xbf, 0xe0, 0xe3, 0xb9, 0xd1, 0x0c, 0xa3, 0xdb, 0x3d, 0x3c,
+	0xf0, 0x11, 0xf2, 0x67, 0x2b, 0x70, 0x89, 0x16, 0xcc, 0x90, 0x55, 0x87, 0x71, 0x00, 0xcc, 0x2a, 0x9b, 0xfb, 0x61, 0x92,
+	0x4b, 0x47, 0x05, 0x5d, 0xbb, 0xb0, 0x59, 0xaf, 0x7c, 0x45, 0xbd, 0x8e, 0xc6, 0xaf, 0x8e, 0xd4, 0x2a, 0x15, 0x97, 0xdf,
+	0x39, 0x2f, 0x61, 0xdb, 0xdd, 0x20, 0xa8, 0xd2, 0x8e, 0xa2, 0xfd, 0xe7, 0xe9, 0xc6, 0x19, 0x05, 0xfa, 0x91, 0x38, 0x12,
+	0x16, 0x50, 0x37, 0xb3, 0x19, 0xb2, 0xdd, 0xce, 0x6d, 0x9d, 0x6d, 0x99, 0x69, 0x8b, 0x39, 0xab, 0xe6, 0xfd, 0x9c, 0xcd,
+	0x73, 0xf0, 0x8d, 0xdd, 0x49, 0xcb, 0xb2, 0x4c, 0x84, 0x97, 0x9a, 0xb5, 0x68, 0x2c, 0x76, 0xcc, 0xd9, 0xad, 0xcc, 0xa1,
+	0x63, 0xad, 0x1d, 0x3d, 0x25, 0x3e, 0x5b, 0x65, 0xf7, 0x42, 0x1f, 0xa1, 0xec, 0x66, 0xf3, 0x65, 0xd3, 0x10, 0x9d, 0x2b,
+	0x7b, 0xc2, 0x34, 0x75, 0x1c, 0x42, 0x16, 0x48, 0x0b, 0xdf, 0x92, 0x04, 0x91, 0x22, 0x73, 0xb1, 0xa4, 0x27, 0x7a, 0x43,
+	0xbe, 0x4d, 0x7a, 0xf5, 0x0a, 0xdb, 0xf8, 0xe1, 0xa6, 0xd3, 0x37, 0x4b, 0xa7, 0xf2, 0x98, 0x6a, 0x31, 0x7e, 0x52, 0x49,
+	0xa8, 0x40, 0xbd, 0x8a, 0x8e, 0x83, 0x5a, 0x46, 0x9d, 0xf8, 0x8b, 0x06, 0x95, 0x17, 0xcc, 0x3b, 0x97, 0x41, 0x1b, 0xe8,
+	0x44, 0x56, 0x9b, 0xde, 0x9a, 0x8f, 0x6a, 0x26, 0xb3, 0xe0, 0xd6, 0xcf, 0xc3, 0x7c, 0xf1, 0x24, 0xfa, 0x85, 0x44, 0x2e,
+	0x72, 0xab, 0x8e, 0x36, 0x9e, 0xad, 0x9f, 0x06, 0x14, 0x29, 0x37, 0xe7, 0x09, 0x73, 0x47, 0xcb, 0xa1, 0x75, 0xbe, 0x9e,
+	0x6f, 0x27, 0x4c, 0xb9, 0x9a, 0xab, 0x99, 0x2c, 0xfc, 0xda, 0x4a, 0x28, 0x22, 0x27, 0x83, 0xad, 0xf9, 0x85, 0xba, 0xa7,
+	0x0f, 0x67, 0x63, 0xac, 0x19, 0x1a, 0xec, 0xc6, 0x2e, 0x35, 0x84, 0xed, 0xb8, 0x9d, 0xe6, 0xdc, 0x99, 0xf1, 0x1f, 0x00,
+	0x51, 0x5b, 0x81, 0x80, 0xbb, 0x00, 0x00
+};
+
+static const uint8_t inflate_window512[] = {
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xe5, 0x4f, 0xeb, 0x8e, 0xaa, 0x3c, 0x14, 0xfd, 0x4f, 0xc2,
+	0x3b, 0x39, 0x65, 0x5a, 0x41, 0x2a, 0x3c, 0x03, 0x97, 0x3a, 0x69, 0x02, 0x94, 0xec, 0xb6, 0xfc, 0xe5, 0xcd, 0xe1, 0xb3,
+	0xad, 0xf2, 0xa9, 0x83, 0x88, 0x33, 0xe3, 0xb9, 0xe4, 0x64, 0x45, 0x37, 0x6d, 0xd7, 0x5e, 0x97, 0x5c, 0x08, 0x95, 0x9f,
+	0x7e, 0xa1, 0xf9, 0x03, 0x7d, 0xd0, 0xf2, 0x2f, 0xc4, 0x38, 0x74, 0xa2, 0xd2, 0x35, 0x0b, 0x56, 0xb4, 0x30, 0x0c, 0xc9,
+	0x0a, 0x25, 0x60, 0xa5, 0x7a, 0x09, 0xbc, 0x63, 0x11, 0xb2, 0xa3, 0xc7, 0x94, 0xbc, 0x36, 0x07, 0x7a, 0xaa, 0xf8, 0xef,
+	0xc1, 0x8a, 0x9a, 0x8e, 0x80, 0xf6, 0xaf, 0xd2, 0x9f, 0x60, 0x18, 0x92, 0x15, 0x4a, 0xc0, 0x4a, 0xf5, 0x12, 0x78, 0xc7,
+	0x22, 0x64, 0x47, 0x8f, 0x29, 0x59, 0xcc, 0xd1, 0x66, 0xa0, 0xb8, 0xe2, 0xa2, 0xf9, 0x87, 0xcd, 0xf1, 0x3c, 0x3b, 0x20,
+	0xe3, 0x90, 0xae, 0x74, 0x7e, 0x12, 0xe3, 0xd0, 0x89, 0x4a, 0xd7, 0x2c, 0x08, 0x4d, 0x47, 0xd0, 0x87, 0x05, 0xae, 0x61,
+	0x48, 0x56, 0x28, 0x01, 0x2b, 0xd5, 0x4b, 0xe0, 0x1d, 0x8b, 0x90, 0x1d, 0x73, 0xbd, 0xee, 0xe4, 0xf8, 0x85, 0xce, 0xb6,
+	0xf0, 0x8e, 0x4e, 0x21, 0xda, 0x0c, 0x14, 0x57, 0x5c, 0x34, 0xf3, 0xfc, 0x17, 0xe4, 0xf0, 0x3d, 0x9b, 0xe1, 0x16, 0x9d,
+	0xa8, 0x74, 0xcd, 0xd0, 0x7e, 0x9d, 0xcd, 0x0d, 0xc6, 0xc1, 0xad, 0x07, 0xa1, 0x09, 0x3c, 0xab, 0x7f, 0x82, 0x0d, 0xa6,
+	0x65, 0x3e, 0xf5, 0x1e, 0x87, 0xcd, 0x97, 0x2c, 0x17, 0x90, 0x48, 0x56, 0x28, 0x01, 0x47, 0x17, 0xf7, 0x11, 0xfe, 0xc5,
+	0xa5, 0xf0, 0xc5, 0x21, 0x20, 0xe3, 0x90, 0xfe, 0x8c, 0xec, 0xd7, 0xbb, 0x4a, 0x6d, 0x18, 0x92, 0x15, 0x4a, 0xc0, 0xcc,
+	0x6b, 0x8f, 0x29, 0xb1, 0xeb, 0xfb, 0x36, 0x03, 0xc5, 0x15, 0x17, 0x4d, 0x6c, 0xee, 0xb6, 0xc7, 0xec, 0x1b, 0xb3, 0xf9,
+	0x8e, 0x5f, 0x1b, 0x60, 0x0e, 0x25, 0xf0, 0x8e, 0x45, 0xc8, 0x0e, 0x13, 0x66, 0x81, 0x3b, 0x0e, 0x53, 0xee, 0x1f, 0x32,
+	0x2f, 0x2a, 0x2d, 0x15, 0x03, 0x2d, 0xf3, 0x75, 0xfc, 0x8b, 0x28, 0x9d, 0xa8, 0x74, 0xcd, 0x82, 0xd0, 0x78, 0x82, 0x3e,
+	0x2c, 0x70, 0x9f, 0x4e, 0x55, 0x02, 0xef, 0x58, 0x84, 0xec, 0xe8, 0x31, 0x25, 0x8b, 0x39, 0xda, 0x0c, 0x14, 0x57, 0x5c,
+	0x34, 0xc7, 0xe3, 0xf4, 0xdd, 0x5c, 0x70, 0xde, 0xbe, 0x5d, 0xc1, 0x06, 0xd1, 0x32, 0x9f, 0xe4, 0xc7, 0x61, 0xb3, 0xae,
+	0xc9, 0x43, 0xe0, 0x8b, 0x43, 0x40, 0xc6, 0x21, 0x9d, 0x21, 0x6d, 0xc3, 0x58, 0xb2, 0x42, 0x09, 0x48, 0xa9, 0x9b, 0xf1,
+	0xb2, 0xe6, 0xfa, 0x62, 0x52, 0x1b, 0x86, 0x13, 0x5d, 0x99, 0xb8, 0x04, 0xde, 0xb1, 0x08, 0xd9, 0xd1, 0x63, 0x4a, 0x5e,
+	0x9b, 0x03, 0xd9, 0xc1, 0xeb, 0xec, 0x83, 0xb9, 0x57, 0xec, 0x7b, 0x56, 0xb9, 0xcd, 0x40, 0x69, 0x99, 0x9b, 0xc1, 0x15,
+	0x17, 0x4d, 0x72, 0x3c, 0x9c, 0x5d, 0xa7, 0xcb, 0x1f, 0xab, 0x1c, 0xc6, 0x6e, 0x21, 0xa5, 0x6e, 0xc6, 0xcb, 0x1b, 0x3f,
+	0x50, 0x7c, 0x29, 0x0d, 0xef, 0x58, 0x84, 0xec, 0xe8, 0x31, 0x25, 0x5f, 0xce, 0x81, 0xd6, 0xf9, 0xcd, 0xc2, 0x18, 0x37,
+	0x89, 0x96, 0xf9, 0xd9, 0xa8, 0xcd, 0x40, 0x71, 0xc5, 0x45, 0xf3, 0xed, 0x96, 0xdb, 0x6f, 0xc4, 0x7a, 0x06, 0xbe, 0xb7,
+	0x96, 0x39, 0x0e, 0x9d, 0xa8, 0x74, 0xcd, 0x82, 0xd0, 0xd4, 0x00, 0x7d, 0x58, 0xe0, 0x3e, 0x51, 0xd4, 0x01, 0x05, 0xbc,
+	0xce, 0x3e, 0x58, 0x51, 0x69, 0xa9, 0x18, 0x68, 0x99, 0x5f, 0xbd, 0x5a, 0xb3, 0x1d, 0x9d, 0x82, 0xb4, 0x19, 0x28, 0xae,
+	0xb8, 0x68, 0x26, 0x46, 0x8a, 0x4e, 0xab, 0x4f, 0x26, 0x76, 0x04, 0xb4, 0x5f, 0x97, 0xf2, 0x06, 0x2b, 0xf4, 0x27, 0x18,
+	0x86, 0x64, 0x85, 0x12, 0xb0, 0x52, 0xbd, 0x04, 0xde, 0xb1, 0x08, 0xd9, 0xd1, 0x63, 0x4a, 0x66, 0x38, 0xbe, 0x97, 0xd8,
+	0xf9, 0x03, 0x52, 0xe6, 0xfa, 0x41, 0x54, 0xb4, 0x2e, 0xf7, 0x6f, 0xc0, 0x38, 0x74, 0xa2, 0xd2, 0x35, 0x0b, 0x42, 0x13,
+	0x1d, 0xf4, 0x61, 0x81, 0x7b, 0xa7, 0xdc, 0x7d, 0x94, 0xc0, 0x3b, 0x16, 0x21, 0x3b, 0x7a, 0x4c, 0xc9, 0x27, 0xc6, 0xf6,
+	0xfb, 0xf9, 0xfe, 0x15, 0xea, 0x38, 0xf0, 0x3a, 0xfb, 0x60, 0xb8, 0xcd, 0x40, 0x71, 0xc5, 0x45, 0x23, 0x59, 0xa1, 0x04,
+	0x6c, 0x25, 0xba, 0x5d, 0xfd, 0x63, 0x70, 0x5b, 0x32, 0x01, 0xde, 0xb1, 0x08, 0x95, 0x66, 0xf4, 0x98, 0x92, 0x99, 0x15,
+	0xdf, 0x4b, 0xec, 0x7c, 0xa4, 0x5d, 0x3e, 0x96, 0x32, 0xd7, 0xe7, 0x6f, 0xe3, 0x2f, 0x59, 0xa1, 0x04, 0x5c, 0x71, 0xd0,
+	0x8b, 0x8a, 0x5f, 0xa0, 0xa8, 0xb4, 0x54, 0x0c, 0xda, 0x0c, 0x14, 0x57, 0x5c, 0x34, 0xaf, 0xb3, 0x1a, 0x87, 0x4e, 0x54,
+	0xba, 0x66, 0x41, 0x68, 0xda, 0x82, 0x4e, 0x80, 0x77, 0x2c, 0x42, 0xa5, 0x19, 0x3d, 0xa6, 0x64, 0x66, 0xc5, 0xf7, 0x12,
+	0x3b, 0x1f, 0x69, 0x97, 0x8f, 0xa5, 0xcc, 0xf5, 0xf9, 0xdb, 0xf8, 0x4b, 0x56, 0x28, 0x01, 0x57, 0x1c, 0xd4, 0x66, 0xa0,
+	0xb8, 0xe2, 0xa2, 0xf1, 0xbd, 0x07, 0xd4, 0x6f, 0x45, 0xb1, 0x00, 0x7d, 0xd0, 0x72, 0x47, 0x4f, 0xc7, 0x71, 0x98, 0xbc,
+	0xe7, 0xf9, 0x2f, 0xc8, 0xe1, 0x7b, 0x36, 0xc3, 0x2d, 0x3a, 0x51, 0xe9, 0xdd, 0x9b, 0xdd, 0x33, 0xa6, 0x41, 0x40, 0x31,
+	0x49, 0x37, 0x11, 0x26, 0xf4, 0xca, 0xff, 0xcf, 0xd3, 0x1f, 0x07, 0x4b, 0xd6, 0x32, 0x37, 0x27, 0xa3, 0x7d, 0x25, 0xf8,
+	0x08, 0x25, 0x84, 0xb1, 0x5b, 0x48, 0x4f, 0x49, 0xe2, 0xe5, 0x8d, 0x71, 0x30, 0x55, 0x6a, 0x16, 0x84, 0xc6, 0x6b, 0xb6,
+	0xeb, 0x84, 0x2f, 0xa4, 0xe1, 0xdd, 0xce, 0x6c, 0xdd, 0xba, 0x24, 0xa6, 0x63, 0x84, 0x6c, 0xd5, 0x1e, 0x53, 0xf2, 0xff,
+	0x4a, 0x51, 0x69, 0xa9, 0x18, 0x38, 0x9b, 0x64, 0x8b, 0xdb, 0x0c, 0x14, 0x57, 0x5c, 0x34, 0xee, 0x66, 0x2b, 0xd1, 0x27,
+	0x1b, 0xab, 0x92, 0xb8, 0xf7, 0x71, 0x30, 0x06, 0xe6, 0xe7, 0x0c, 0x8d, 0xf8, 0x97, 0x4a, 0x27, 0xfb, 0x8b, 0x83, 0x61,
+	0xef, 0xde, 0xac, 0x8f, 0x59, 0x08, 0x02, 0x8a, 0x49, 0xba, 0x89, 0x30, 0xa1, 0xce, 0xf5, 0xa2, 0xee, 0x7c, 0xab, 0x33,
+	0x7c, 0xef, 0xda, 0x6c, 0x1c, 0x2c, 0x59, 0xcb, 0xdc, 0x9c, 0x8c, 0xf6, 0x95, 0xe0, 0x23, 0x94, 0x10, 0xc6, 0x6e, 0x21,
+	0x3d, 0x25, 0x89, 0xa5, 0xa6, 0x71, 0x9b, 0x81, 0xe2, 0x8a, 0x8b, 0xa6, 0xa8, 0xb4, 0x54, 0x0c, 0x8e, 0xf2, 0xef, 0xbc,
+	0xce, 0x3e, 0x98, 0xef, 0xbd, 0x5b, 0xff, 0xfd, 0xe9, 0x61, 0x1c, 0x86, 0x89, 0x3b, 0x6f, 0xf1, 0x85, 0x48, 0xc7, 0x3e,
+	0x11, 0xb2, 0xa3, 0xc7, 0x94, 0x7c, 0x66, 0xf8, 0x9e, 0xcd, 0x70, 0x8b, 0x4e, 0x54, 0x7a, 0xf7, 0x66, 0xf7, 0x8c, 0x69,
+	0x10, 0x50, 0x4c, 0xd2, 0x4d, 0x84, 0x09, 0xbd, 0xf2, 0x3f, 0xeb, 0x1b, 0x8e, 0xfd, 0xb6, 0x7f, 0xab, 0x23, 0x3e, 0x8e,
+	0x37, 0x61, 0x1c, 0x4c, 0xa4, 0x9a, 0x05, 0xa1, 0xf1, 0x9a, 0xcd, 0x3c, 0xc1, 0x30, 0x66, 0x32, 0xa0, 0xe5, 0x30, 0xab,
+	0xd2, 0xee, 0x8c, 0xf6, 0x6d, 0x96, 0xe4, 0x6e, 0x8d, 0xa2, 0xd2, 0x52, 0x31, 0x70, 0x61, 0x92, 0x2d, 0x6e, 0x33, 0xd0,
+	0x32, 0xb7, 0xf9, 0xcc, 0x73, 0x40, 0xc6, 0x21, 0x9d, 0x71, 0xda, 0x86, 0xb1, 0x5b, 0x49, 0xa9, 0x9b, 0xf1, 0x72, 0xb4,
+	0xdb, 0x40, 0x87, 0x05, 0xae, 0x35, 0xb7, 0xa2, 0xd3, 0x5d, 0x6c, 0xee, 0xf6, 0xe8, 0xdc, 0xd1, 0x54, 0x19, 0x07, 0xbc,
+	0xe7, 0x75, 0xf6, 0xc1, 0xae, 0x96, 0x9d, 0x0b, 0xda, 0x2f, 0x86, 0xf9, 0x7e, 0x48, 0x1b, 0x42, 0xcb, 0xbc, 0xcd, 0x40,
+	0x71, 0xc5, 0x45, 0x33, 0x0e, 0x9b, 0x87, 0xf2, 0xc4, 0x95, 0x22, 0xd4, 0xf7, 0x5c, 0x70, 0x7b, 0xa4, 0x6e, 0x38, 0xe7,
+	0xa2, 0xd2, 0x52, 0x31, 0x38, 0x2d, 0xfc, 0x74, 0x80, 0xbb, 0x38, 0xee, 0xcf, 0xbf, 0xe4, 0x42, 0x28, 0x97, 0x6f, 0xa5,
+	0x92, 0xcd, 0x15, 0x21, 0x3b, 0x7a, 0x4c, 0xc9, 0x67, 0x86, 0xef, 0xc1, 0x5c, 0xaf, 0x4e, 0x54, 0xba, 0x66, 0x68, 0x7f,
+	0x57, 0x7a, 0xe7, 0x18, 0xef, 0xc1, 0xee, 0xf2, 0xd6, 0x1a, 0x69, 0x99, 0xb7, 0x19, 0x28, 0xae, 0x8e, 0x3d, 0xc6, 0x61,
+	0xb3, 0x26, 0xa7, 0x91, 0x0a, 0xc2, 0x5c, 0xfc, 0x92, 0xca, 0x0e, 0xb6, 0xf6, 0x8e, 0x1e, 0x3f, 0x8f, 0x79, 0xef, 0x90,
+	0xfe, 0x03, 0xcf, 0xcd, 0xfe, 0x73, 0x40, 0x1f, 0x00, 0x00
+};
+
+static const uint8_t inflate_flush[] = {
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xec, 0x58, 0x5f, 0x6f, 0x83, 0x20, 0x10, 0x7f, 0x37, 0xf1,
+	0x3b, 0x29, 0x2b, 0x52, 0x37, 0x6c, 0x3f, 0x43, 0xed, 0xd8, 0x62, 0xd2, 0x8e, 0x05, 0xb4, 0xaf, 0xfb, 0xe6, 0x3a, 0x0f,
+	0x56, 0x63, 0x16, 0xdd, 0x4a, 0x1c, 0x58, 0x74, 0x0f, 0x1e, 0xe2, 0xc1, 0x71, 0x7f, 0x7e, 0x1c, 0x87, 0xa2, 0x7a, 0xa9,
+	0x24, 0x5d, 0x2f, 0xf9, 0xc0, 0x34, 0xc9, 0xc2, 0x00, 0xe7, 0x9c, 0x97, 0xfe, 0x48, 0x6d, 0x6a, 0x7f, 0xd6, 0x82, 0xb1,
+	0xd1, 0xcd, 0xa3, 0x50, 0x25, 0xf3, 0xfd, 0xfb, 0x41, 0x94, 0x45, 0x59, 0xf0, 0xb7, 0x08, 0xa1, 0x67, 0x51, 0x5c, 0x18,
+	0x76, 0xe9, 0xf9, 0xf1, 0x16, 0x3b, 0x56, 0x75, 0x52, 0x10, 0x1d, 0x60, 0xc5, 0x65, 0xe4, 0xfb, 0x66, 0x8c, 0x89, 0x28,
+	0xce, 0x87, 0x57, 0xf6, 0x10, 0x2d, 0x07, 0xf8, 0xbf, 0x4f, 0xbf, 0x73, 0xf2, 0xcd, 0x6f, 0x36, 0xdc, 0x7c, 0x25, 0x92,
+	0x1d, 0x4b, 0x2e, 0x14, 0x68, 0x2e, 0xfc, 0x54, 0x9d, 0x19, 0x01, 0x69, 0x9b, 0x35, 0x80, 0x18, 0x0c, 0x25, 0x84, 0xda,
+	0x4b, 0x96, 0xf1, 0xf1, 0x54, 0xc9, 0x92, 0x89, 0xa7, 0xaf, 0xb6, 0xa9, 0x5b, 0x4b, 0x64, 0xde, 0x19, 0x3a, 0xd7, 0x07,
+	0x50, 0x3c, 0x0c, 0xbc, 0x41, 0x05, 0x9d, 0x00, 0xf3, 0x65, 0x64, 0x93, 0x4c, 0xc0, 0xdb, 0xb4, 0x5c, 0xfd, 0xe8, 0x9b,
+	0x0b, 0xe6, 0xdb, 0xbc, 0xeb, 0x2c, 0x82, 0xec, 0xa3, 0x6a, 0x71, 0xda, 0xf4, 0x7b, 0x61, 0x60, 0xbf, 0x8a, 0xea, 0xc2,
+	0xbd, 0xf8, 0x14, 0xa9, 0x0f, 0xa0, 0xa6, 0xbe, 0x9b, 0xf3, 0xc2, 0xa8, 0x38, 0xf9, 0xa9, 0x60, 0x19, 0x22, 0x5e, 0x08,
+	0x1e, 0xe3, 0x8c, 0xb7, 0x2e, 0x73, 0x9e, 0x2e, 0x53, 0x36, 0xd7, 0x92, 0x8b, 0x6c, 0xf5, 0x87, 0xa6, 0x56, 0xab, 0xec,
+	0x97, 0x31, 0xc1, 0xc4, 0x49, 0x33, 0x64, 0x10, 0x99, 0x63, 0x98, 0x0e, 0x0f, 0x86, 0x4e, 0xd6, 0x45, 0xdb, 0x7d, 0x99,
+	0x6e, 0xb2, 0x4b, 0x4c, 0x70, 0xd6, 0x27, 0x68, 0x67, 0xd5, 0xcb, 0x69, 0x92, 0x00, 0x5f, 0x83, 0x20, 0x26, 0x58, 0xe7,
+	0x44, 0xc5, 0x4d, 0x95, 0x2f, 0x80, 0xbb, 0xf5, 0xec, 0x4f, 0xc0, 0x8e, 0x66, 0xc4, 0x4f, 0x9c, 0xa2, 0xff, 0x63, 0x72,
+	0x80, 0xd0, 0x64, 0x20, 0x91, 0xfd, 0x3d, 0x01, 0x25, 0x5b, 0xbd, 0x6f, 0xb3, 0x70, 0xd6, 0x10, 0xb5, 0x52, 0x49, 0xac,
+	0xee, 0x6b, 0x1e, 0xe1, 0x0b, 0xc4, 0x2a, 0x95, 0x52, 0x83, 0x68, 0xae, 0xef, 0x56, 0x3a, 0xa0, 0xce, 0x27, 0x00, 0x00,
+	0x00, 0xff, 0xff, 0xe4, 0x5a, 0x5b, 0xb2, 0x83, 0x20, 0x0c, 0xfd, 0xef, 0x4c, 0xf7, 0x54, 0xa5, 0xc5, 0xd6, 0x52, 0xdc,
+	0xc5, 0x5d, 0x40, 0xf7, 0x3f, 0x50, 0x1e, 0x29, 0x7a, 0x15, 0xa6, 0x94, 0x41, 0x1a, 0xf4, 0x27, 0x4a, 0xc0, 0x18, 0x0f,
+	0x49, 0x80, 0xc4, 0x5f, 0x98, 0x8e, 0xee, 0xed, 0x49, 0x97, 0xa6, 0x66, 0xfe, 0x44, 0x97, 0xee, 0x8e, 0x10, 0x87, 0x2a,
+	0xa7, 0x34, 0x83, 0x84, 0x73, 0x63, 0xc2, 0x52, 0x60, 0x52, 0xea, 0x3d, 0x34, 0xb0, 0x72, 0x0f, 0x04, 0xf6, 0x89, 0x0c,
+	0xae, 0x9c, 0x33, 0x27, 0xa4, 0xd4, 0x77, 0x60, 0x52, 0x02, 0x52, 0x9a, 0x95, 0xe7, 0x1c, 0xee, 0x52, 0x98, 0x10, 0xa0,
+	0xc6, 0xf7, 0xeb, 0xdf, 0xd0, 0x73, 0x6d, 0x31, 0xf8, 0xef, 0xbb, 0xcc, 0xa0, 0x6e, 0xc5, 0x8c, 0xfb, 0x10, 0x15, 0x3b,
+	0x7a, 0x61, 0x83, 0x0f, 0x84, 0xe1, 0x78, 0xd0, 0x82, 0x6c, 0x70, 0x03, 0x1f, 0x18, 0x63, 0xb6, 0x1a, 0x6c, 0x02, 0x8b,
+	0x21, 0x99, 0xac, 0xfd, 0xf3, 0xa4, 0x94, 0x8a, 0x67, 0xa7, 0x56, 0x8a, 0xa6, 0x41, 0x64, 0x30, 0x0b, 0x06, 0x96, 0x84,
+	0xda, 0xb4, 0x55, 0x97, 0xbb, 0xf9, 0xd4, 0xb1, 0xf5, 0x23, 0x04, 0xa7, 0x34, 0xc7, 0x59, 0x0f, 0x81, 0x54, 0x8f, 0xd9,
+	0x94, 0x74, 0x3d, 0x07, 0x14, 0x82, 0xdb, 0x8d, 0x16, 0xb7, 0xc1, 0xff, 0xc4, 0xd9, 0x94, 0x14, 0xf7, 0xdb, 0x03, 0xb4,
+	0x82, 0x8b, 0xdd, 0x58, 0x32, 0x54, 0x1e, 0xb4, 0x20, 0x25, 0xce, 0x4d, 0x63, 0xb1, 0x57, 0x33, 0x88, 0x42, 0x82, 0x74,
+	0x74, 0x47, 0x39, 0xd4, 0xe9, 0x82, 0x5b, 0x85, 0xc2, 0xd9, 0x92, 0xbe, 0x3f, 0x37, 0xef, 0x72, 0xe4, 0x39, 0xe2, 0x67,
+	0xf7, 0x5f, 0x5d, 0xdf, 0xda, 0x9b, 0x16, 0xd0, 0x8c, 0x46, 0xd9, 0x36, 0x03, 0xa8, 0x86, 0x7d, 0x05, 0x4b, 0xf1, 0x4d,
+	0xf1, 0x8d, 0xc5, 0x9f, 0x76, 0x72, 0xd4, 0x80, 0x69, 0x24, 0xfa, 0x81, 0xa0, 0x40, 0x45, 0xb7, 0xe8, 0xe0, 0x1e, 0xee,
+	0x6c, 0x1f, 0x06, 0x4e, 0xe0, 0x87, 0x24, 0xd1, 0xdf, 0xd6, 0xac, 0x8a, 0xf8, 0xa4, 0x60, 0x4a, 0x2c, 0x24, 0x29, 0x61,
+	0x66, 0x97, 0x1d, 0x0f, 0x99, 0xbc, 0x1c, 0x6d, 0x8e, 0xca, 0xda, 0x9a, 0x71, 0x72, 0xd7, 0xdd, 0xf0, 0x0b, 0x31, 0xc7,
+	0xeb, 0x34, 0xcd, 0x16, 0x24, 0xcb, 0xfe, 0x73, 0x07, 0x33, 0xbe, 0x20, 0xd3, 0xd6, 0x1a, 0x3f, 0xa8, 0x4c, 0x32, 0x1d,
+	0xb5, 0x62, 0x16, 0xf7, 0xba, 0x2b, 0x7c, 0x9a, 0x11, 0xfe, 0x8c, 0x40, 0xca, 0x43, 0xde, 0xaf, 0xdb, 0xc8, 0x9f, 0x42,
+	0xba, 0xf5, 0x08, 0x8d, 0xe5, 0x52, 0x0c, 0xae, 0xa8, 0x34, 0xc7, 0x01, 0x77, 0xd1, 0xf2, 0xfa, 0x9d, 0x65, 0x38, 0xce,
+	0x0b, 0x00, 0x00, 0xff, 0xff, 0xe5, 0x58, 0x6d, 0x93, 0xa2, 0x30, 0x0c, 0xfe, 0xce, 0x0c, 0xff, 0x09, 0x90, 0x82, 0xbc,
+	0xff, 0x86, 0x75, 0x0f, 0x6f, 0x9c, 0xd9, 0x3d, 0x6f, 0x78, 0xf1, 0xeb, 0xfe, 0x73, 0x7a, 0x4d, 0x52, 0xaa, 0x28, 0x20,
+	0x45, 0x38, 0xdd, 0xbb, 0x99, 0xdd, 0x28, 0xcd, 0x0b, 0x49, 0xfa, 0x24, 0x4d, 0x8d, 0xeb, 0x7d, 0x5d, 0xc6, 0x67, 0xf2,
+	0xc5, 0x62, 0x2f, 0x31, 0x0d, 0xb6, 0x3b, 0xf2, 0xa6, 0x6f, 0xf5, 0x58, 0x75, 0xe5, 0x87, 0x09, 0xc8, 0x5a, 0x93, 0xa5,
+	0x9c, 0xba, 0xdc, 0x65, 0xbf, 0xdf, 0x8a, 0xea, 0x50, 0x1d, 0x8e, 0xbf, 0x2c, 0xc7, 0xf9, 0x51, 0x1c, 0xd4, 0x23, 0xbe,
+	0x1e, 0x24, 0xc5, 0xe2, 0x29, 0x2f, 0x40, 0x13, 0x89, 0xad, 0x24, 0xca, 0xfc, 0xbd, 0x3a, 0x16, 0x81, 0x85, 0x02, 0x20,
+	0x09, 0xec, 0xec, 0xfd, 0xa3, 0x2e, 0xab, 0xbc, 0x80, 0xe7, 0xd6, 0xe6, 0x29, 0x67, 0x69, 0x7a, 0xf8, 0x7c, 0xfb, 0x99,
+	0xf3, 0x26, 0xf7, 0xc1, 0xb0, 0x3b, 0x25, 0x98, 0x2e, 0xb9, 0x7c, 0x32, 0x0d, 0x61, 0x6b, 0x63, 0xe9, 0x19, 0xb8, 0x93,
+	0x74, 0x15, 0x16, 0xba, 0x1f, 0xcb, 0x30, 0xd2, 0x34, 0x56, 0x0c, 0xdf, 0x34, 0x42, 0x0c, 0xeb, 0xd1, 0x5d, 0x1a, 0x21,
+	0xab, 0xef, 0xaf, 0xd8, 0x8b, 0x56, 0xf4, 0x32, 0x8c, 0x2b, 0x12, 0x0a, 0x4d, 0xfa, 0x03, 0x5b, 0x1e, 0x90, 0x40, 0x19,
+	0xc2, 0x9d, 0x34, 0x0d, 0xc1, 0x24, 0x04, 0x24, 0xbc, 0xb1, 0x92, 0x94, 0x6d, 0x13, 0x64, 0xdc, 0x73, 0x0e, 0x12, 0x26,
+	0x54, 0x93, 0x30, 0x52, 0x06, 0xd1, 0x2d, 0xb1, 0x76, 0x3a, 0x7e, 0xd4, 0x9f, 0x79, 0x68, 0x91, 0xb0, 0xe7, 0xce, 0x09,
+	0xaf, 0x37, 0x3b, 0xbc, 0x71, 0x4d, 0x03, 0xd4, 0xe0, 0xdf, 0x34, 0x36, 0x21, 0x39, 0x4e, 0xef, 0xbb, 0x15, 0x07, 0x17,
+	0x7d, 0x3f, 0xbe, 0xce, 0x97, 0x06, 0xa4, 0xfa, 0xb1, 0x10, 0xd1, 0x6b, 0x51, 0x8e, 0x37, 0xa1, 0x84, 0xd8, 0x4c, 0x28,
+	0x4c, 0x23, 0x73, 0x81, 0xd6, 0x9b, 0x13, 0x4f, 0x7a, 0x1c, 0x78, 0x1d, 0xe6, 0xdf, 0x08, 0x19, 0x00, 0x89, 0x12, 0xe5,
+	0xce, 0xb7, 0xb1, 0x0f, 0x81, 0x45, 0x26, 0x1e, 0x59, 0x72, 0xae, 0xdc, 0x16, 0x19, 0x08, 0xc4, 0x6e, 0x7f, 0x70, 0x1e,
+	0x2e, 0x9c, 0xfb, 0xea, 0x43, 0x04, 0xcc, 0xa2, 0x4b, 0x41, 0x76, 0xc3, 0x05, 0x1e, 0xed, 0x14, 0x26, 0x8a, 0x37, 0x73,
+	0xfc, 0x8c, 0x27, 0x02, 0x50, 0xab, 0xa5, 0x68, 0xf5, 0x8d, 0x91, 0x5e, 0xd2, 0x25, 0xfe, 0x65, 0xe9, 0xa9, 0x14, 0x47,
+	0x5b, 0xde, 0x48, 0x6c, 0xe0, 0xf1, 0xf0, 0x40, 0x3c, 0x23, 0x44, 0x3b, 0x13, 0xd2, 0xa5, 0xf3, 0x22, 0x88, 0x24, 0x43,
+	0x06, 0x52, 0xde, 0x64, 0x6a, 0xab, 0xaf, 0xeb, 0xf0, 0x49, 0xbb, 0xbb, 0x07, 0x25, 0xf5, 0xb8, 0xdc, 0xa0, 0x71, 0x9f,
+	0x3c, 0x69, 0xa8, 0x61, 0x94, 0xe9, 0x5b, 0xfe, 0xf0, 0x27, 0xeb, 0xcd, 0xfa, 0x00, 0xf8, 0x35, 0xe2, 0x1e, 0x8a, 0xb0,
+	0xfd, 0xce, 0x1b, 0xe8, 0x5f, 0x5b, 0x71, 0x7c, 0x52, 0x35, 0x98, 0xc6, 0x56, 0x9c, 0xaa, 0x1d, 0x71, 0x7c, 0x77, 0x0c,
+	0x67, 0xed, 0x58, 0x1a, 0x4c, 0x43, 0x9e, 0x64, 0x25, 0x7d, 0xba, 0xb6, 0x04, 0xae, 0xbf, 0xa5, 0x05, 0xde, 0xa0, 0xa1,
+	0xdb, 0xee, 0xd3, 0x2a, 0x20, 0x64, 0x07, 0xb9, 0xda, 0xe6, 0x2e, 0x14, 0xc0, 0x6b, 0x97, 0xba, 0x7f, 0x42, 0xdc, 0xe8,
+	0x7b, 0x40, 0x32, 0x11, 0x2d, 0x09, 0x58, 0x32, 0x14, 0xd3, 0xc0, 0x13, 0x10, 0x13, 0xc5, 0xd4, 0xe8, 0x93, 0xe9, 0xb9,
+	0xb0, 0x44, 0x03, 0xc2, 0xc3, 0x2f, 0xb0, 0x2f, 0x55, 0xff, 0xc3, 0xe6, 0x4b, 0x33, 0x80, 0x0b, 0x4b, 0x2a, 0x0e, 0xaf,
+	0x38, 0xe3, 0xd0, 0x5f, 0xbe, 0xb3, 0x2c, 0xdf, 0x19, 0x7c, 0xed, 0x5b, 0xcc, 0x5a, 0x93, 0xa9, 0x22, 0x6d, 0xe5, 0x46,
+	0xf8, 0x89, 0x81, 0x8a, 0x53, 0x4b, 0x00, 0xac, 0xdc, 0xa9, 0xc8, 0xd7, 0x59, 0xa0, 0xd1, 0x7c, 0xcc, 0x39, 0x02, 0x2f,
+	0x46, 0x4e, 0x08, 0x9e, 0x78, 0x95, 0x9c, 0x0d, 0x82, 0x7f, 0x14, 0x2b, 0xf5, 0xf4, 0x31, 0xfa, 0x8b, 0x59, 0x6c, 0xf9,
+	0xbc, 0x6a, 0x24, 0x6c, 0xfa, 0xef, 0x06, 0xf2, 0x2e, 0x0a, 0x52, 0xfd, 0xed, 0x30, 0xdb, 0xb4, 0xb7, 0x8f, 0x9e, 0xbb,
+	0xfd, 0xea, 0x58, 0x6a, 0x9d, 0x88, 0x78, 0x43, 0x9e, 0x8e, 0x9e, 0xab, 0xd7, 0xaa, 0xb4, 0x9e, 0x92, 0x71, 0xe5, 0xb4,
+	0x0e, 0x1a, 0xf4, 0xc8, 0xdc, 0xf8, 0x57, 0xb7, 0x1e, 0x22, 0x1c, 0x54, 0x06, 0x92, 0x54, 0xa6, 0xd0, 0x96, 0xa3, 0x07,
+	0xe5, 0xd6, 0x0f, 0x1d, 0xfa, 0xe2, 0x48, 0xb6, 0xd2, 0xbf, 0x37, 0xd1, 0xb4, 0x83, 0xd4, 0x58, 0x29, 0x76, 0x08, 0x29,
+	0x2c, 0x7b, 0x0b, 0x5b, 0xe0, 0xca, 0x39, 0x97, 0xac, 0x74, 0x03, 0x7e, 0xe9, 0x7e, 0x08, 0x04, 0x7f, 0xd7, 0x7b, 0xe5,
+	0xd2, 0xb5, 0xe5, 0x8b, 0x36, 0x3d, 0x3d, 0x6a, 0xde, 0x54, 0x30, 0x1f, 0x25, 0xd3, 0x01, 0xee, 0xa4, 0x03, 0xa3, 0xb6,
+	0x52, 0x1d, 0xbf, 0xec, 0x66, 0xf0, 0xb1, 0x18, 0x08, 0x07, 0xc8, 0xb3, 0xee, 0xe6, 0x81, 0x69, 0xcc, 0x28, 0xc2, 0x17,
+	0x29, 0x9a, 0xfa, 0x81, 0x21, 0x62, 0x08, 0x90, 0xd3, 0x52, 0xbf, 0xaf, 0xa9, 0x12, 0x5e, 0x27, 0x17, 0x8f, 0x94, 0xcb,
+	0x1f, 0x45, 0x80, 0x8e, 0x6c, 0x20, 0x4e, 0x00, 0x00
+};
+
+static const uint8_t inflate_multi[] = {
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0xe5, 0x57, 0xe9, 0x8e, 0x82, 0x30, 0x10, 0xfe, 0x4f, 0xc2,
+	0x3b, 0x01, 0x05, 0x5b, 0xca, 0xf5, 0x0c, 0xea, 0xb2, 0x1b, 0x12, 0x5d, 0x36, 0x1c, 0xfe, 0xdd, 0x37, 0x87, 0xb5, 0x53,
+	0x82, 0xab, 0x82, 0x8a, 0x94, 0xab, 0x98, 0xd8, 0x68, 0x3b, 0x33, 0x9d, 0xf9, 0xe6, 0xea, 0x38, 0x4e, 0x8f, 0x8f, 0x87,
+	0xf2, 0x74, 0xa7, 0xcf, 0x69, 0xf3, 0x14, 0x1f, 0xf2, 0x63, 0xf8, 0xb3, 0x4d, 0xb2, 0x28, 0x8b, 0xe2, 0x6f, 0xbd, 0xbb,
+	0x84, 0x69, 0x55, 0x5d, 0x3c, 0x20, 0xfc, 0x3e, 0x53, 0x55, 0xca, 0xc2, 0xda, 0x1f, 0xf2, 0x34, 0x0b, 0x13, 0x55, 0xf9,
+	0x48, 0xa2, 0x53, 0x48, 0x50, 0xf5, 0x1f, 0xfe, 0x51, 0x58, 0xcb, 0xe2, 0x89, 0x58, 0xcb, 0x4e, 0xf2, 0xcf, 0x3c, 0xad,
+	0x38, 0xc9, 0x12, 0x4c, 0xed, 0xab, 0x58, 0x47, 0x03, 0xe5, 0x8a, 0x18, 0x2a, 0x1b, 0x19, 0xdd, 0xc5, 0x71, 0xc6, 0xbe,
+	0x88, 0xb8, 0x10, 0xf2, 0x55, 0xa4, 0x94, 0x45, 0x70, 0x26, 0x4a, 0xc3, 0x7d, 0x16, 0x27, 0x58, 0xa2, 0xa8, 0x35, 0xcc,
+	0x21, 0x95, 0x9f, 0x3c, 0x58, 0xb1, 0xc9, 0x5d, 0xb6, 0xb9, 0x3d, 0x10, 0x0c, 0x6b, 0x74, 0xdc, 0x7e, 0x85, 0x50, 0xfa,
+	0x54, 0xe5, 0x29, 0x77, 0x27, 0xa3, 0x04, 0x21, 0x5e, 0x16, 0xa3, 0x4a, 0xe7, 0xa8, 0x2f, 0x31, 0x21, 0x2e, 0x47, 0x1a,
+	0xe4, 0x3f, 0x2c, 0xe3, 0x39, 0xfe, 0xd7, 0x72, 0x37, 0x35, 0x57, 0xfd, 0x83, 0xd0, 0xb7, 0xe0, 0x7a, 0x01, 0x01, 0x56,
+	0xea, 0xd8, 0x9d, 0x60, 0x47, 0x59, 0x54, 0x80, 0xb2, 0x5d, 0xf1, 0xce, 0x43, 0x80, 0x25, 0x93, 0x5d, 0x65, 0x25, 0xf1,
+	0x0d, 0x1b, 0xf6, 0xd0, 0xbc, 0x9a, 0xc0, 0x8b, 0x64, 0xfd, 0x7a, 0x45, 0x1d, 0x2f, 0x12, 0x94, 0x59, 0xb6, 0xe9, 0x6e,
+	0xc8, 0xbb, 0x82, 0x5e, 0x7a, 0x87, 0xfa, 0x7d, 0xf5, 0xb5, 0x61, 0x6d, 0xad, 0x87, 0xd2, 0x3f, 0xd7, 0x6c, 0xbf, 0xf5,
+	0x68, 0xbc, 0x44, 0x41, 0xda, 0x10, 0xc6, 0x62, 0xad, 0x06, 0x94, 0x57, 0x6d, 0xae, 0x8c, 0xae, 0xb3, 0xd2, 0xe6, 0x48,
+	0xe5, 0xc5, 0xc6, 0xf4, 0xa0, 0x57, 0x6d, 0x83, 0x42, 0x31, 0x57, 0x15, 0xbb, 0x5d, 0x6e, 0x53, 0x9b, 0x91, 0x67, 0x16,
+	0xf4, 0x50, 0x2d, 0xa9, 0x0d, 0xc3, 0x37, 0xe2, 0x58, 0xab, 0x2c, 0x99, 0xbc, 0x73, 0x0c, 0x12, 0x5f, 0x1d, 0xf8, 0x40,
+	0xe3, 0x69, 0x46, 0x13, 0x21, 0x9e, 0x9f, 0xbc, 0x52, 0xdc, 0xec, 0xc9, 0x13, 0xce, 0xf4, 0x1f, 0xfd, 0x78, 0xc3, 0x85,
+	0x66, 0x54, 0xb5, 0x68, 0x05, 0x73, 0x04, 0x90, 0x58, 0x67, 0xc6, 0x60, 0xfe, 0x2f, 0xdc, 0x86, 0xcb, 0xf8, 0x5d, 0x84,
+	0x19, 0xe0, 0xd6, 0x63, 0x47, 0x40, 0xcf, 0xbd, 0x4a, 0x9f, 0x3a, 0xe2, 0x03, 0xbe, 0x0b, 0x66, 0x32, 0xf5, 0xae, 0xbd,
+	0x02, 0x4b, 0xb3, 0x4b, 0x1e, 0xdb, 0x7c, 0x7f, 0xb4, 0xac, 0xb9, 0x52, 0x55, 0xf8, 0x95, 0xae, 0x17, 0xa8, 0x8a, 0xde,
+	0xc3, 0x01, 0x3c, 0x5a, 0x90, 0x87, 0xef, 0x1f, 0xff, 0xe3, 0x8c, 0x8a, 0x73, 0x2d, 0x9a, 0x8f, 0x72, 0x8b, 0x9d, 0x2f,
+	0xaf, 0x0d, 0x88, 0xa9, 0x16, 0x3e, 0x5e, 0xe9, 0x93, 0x53, 0x70, 0x19, 0x08, 0x38, 0xf2, 0x65, 0x41, 0x5c, 0x55, 0xc1,
+	0x4f, 0xee, 0x1e, 0x39, 0x30, 0x1e, 0xc1, 0x8a, 0xf1, 0xc5, 0x7a, 0xec, 0x03, 0x9f, 0x33, 0xfb, 0xce, 0x6f, 0x1b, 0x9c,
+	0x69, 0xa0, 0x86, 0x2c, 0x9c, 0xcc, 0x04, 0x8c, 0xd7, 0x90, 0x2d, 0x9c, 0xec, 0x0f, 0x74, 0xac, 0xd5, 0xfc, 0x40, 0x1f,
+	0x00, 0x00, 0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xe5, 0x19, 0xd9, 0x92, 0xa2, 0x30, 0xf0, 0x9d,
+	0xaa, 0xfc, 0x13, 0xa7, 0x09, 0xf7, 0x37, 0xcc, 0xa8, 0x33, 0x65, 0xd5, 0xcc, 0xba, 0x85, 0x32, 0xaf, 0xfb, 0xe7, 0xb0,
+	0xe9, 0xee, 0x08, 0x88, 0x88, 0x01, 0x05, 0x1d, 0xa5, 0x14, 0x31, 0xe9, 0x23, 0x7d, 0x77, 0x42, 0x18, 0xe2, 0xe5, 0xf9,
+	0x59, 0xfe, 0x91, 0xef, 0x96, 0x5f, 0xf9, 0x6e, 0xbf, 0xce, 0x44, 0x78, 0xb8, 0x62, 0x27, 0xdf, 0xfd, 0x7d, 0xcb, 0xf6,
+	0x9b, 0xfd, 0x66, 0xfb, 0xc7, 0x08, 0x1b, 0xd7, 0xcf, 0xf6, 0x2b, 0xff, 0x5e, 0x57, 0x73, 0x16, 0x0e, 0xe6, 0xbb, 0x77,
+	0x2b, 0x3c, 0xbe, 0x80, 0x42, 0x73, 0xf0, 0x9f, 0x17, 0x2d, 0x2a, 0xac, 0xea, 0x41, 0x04, 0xe1, 0x31, 0x88, 0x44, 0x6a,
+	0xd1, 0x3e, 0x10, 0x23, 0xc6, 0x74, 0x7f, 0xdf, 0x6e, 0xf7, 0xf0, 0x1d, 0xb3, 0x90, 0x61, 0x83, 0x9d, 0xe2, 0x5e, 0x4f,
+	0xb6, 0x7b, 0x30, 0x0c, 0x4d, 0x65, 0x89, 0x9c, 0xf8, 0xba, 0xcc, 0x28, 0x0b, 0x6f, 0x19, 0x9c, 0xa5, 0xd1, 0x03, 0x16,
+	0x1c, 0x94, 0x14, 0xd4, 0xf0, 0xe7, 0x30, 0x89, 0x29, 0x33, 0x56, 0xd9, 0x58, 0x0d, 0x6c, 0xbe, 0xdf, 0x3e, 0xd7, 0xe8,
+	0x4b, 0x6c, 0xb4, 0xbb, 0xac, 0x97, 0xfb, 0x6d, 0x46, 0x08, 0x27, 0x32, 0x21, 0x69, 0x4d, 0x63, 0x95, 0x45, 0x6b, 0x9c,
+	0x28, 0xb7, 0xe1, 0x13, 0xaf, 0x41, 0x64, 0x0a, 0xc5, 0x3b, 0x22, 0x5a, 0x65, 0x9b, 0x9f, 0xb5, 0x22, 0x5d, 0x16, 0x6e,
+	0xd4, 0xef, 0x07, 0x08, 0x7d, 0xad, 0x6d, 0x98, 0x81, 0x08, 0x48, 0x2b, 0xc0, 0x7b, 0x59, 0xf4, 0x3a, 0x5f, 0x60, 0x5a,
+	0xa9, 0xfc, 0x9f, 0xc8, 0xef, 0xdd, 0x23, 0xe0, 0xbc, 0xf0, 0x52, 0x0e, 0xe1, 0xc8, 0xff, 0xc1, 0x51, 0x22, 0x09, 0xd0,
+	0xef, 0x98, 0xe1, 0x0f, 0x4b, 0x3c, 0x0d, 0x26, 0x68, 0xad, 0xda, 0x42, 0xea, 0x29, 0x56, 0xbf, 0x37, 0xc8, 0x0d, 0x37,
+	0xc8, 0x3f, 0xe4, 0xbf, 0x83, 0xd6, 0x08, 0x52, 0x87, 0xbf, 0xc0, 0x9c, 0xc3, 0x5c, 0xf5, 0xa4, 0x60, 0x59, 0x76, 0x04,
+	0x92, 0xa6, 0x36, 0xa9, 0xa8, 0x46, 0x7f, 0xb9, 0x02, 0x16, 0x29, 0x95, 0x98, 0x2d, 0xf9, 0xba, 0x53, 0xd5, 0x85, 0x14,
+	0xd6, 0x97, 0xe9, 0xee, 0xea, 0x04, 0x38, 0xdf, 0xa8, 0x05, 0xdd, 0x0c, 0x99, 0x81, 0x69, 0xa1, 0x5b, 0xc8, 0x4a, 0x33,
+	0x1a, 0x09, 0x1b, 0xf2, 0x22, 0x79, 0x16, 0x1f, 0x12, 0x33, 0xc4, 0x54, 0x78, 0x72, 0x12, 0xdd, 0x13, 0x57, 0x93, 0x06,
+	0x32, 0x4d, 0x59, 0x0a, 0xc5, 0x24, 0xaa, 0x35, 0xcd, 0x4b, 0xea, 0x8c, 0x9d, 0x0a, 0x54, 0xaf, 0x0a, 0x69, 0x15, 0xab,
+	0x31, 0x55, 0x2f, 0x1e, 0x9e, 0x13, 0xe7, 0xef, 0xca, 0x1c, 0x54, 0x39, 0x04, 0xa3, 0xfc, 0x10, 0xf4, 0x02, 0x4d, 0x3b,
+	0x67, 0xeb, 0x52, 0xa1, 0x46, 0xd5, 0x93, 0xdb, 0xb6, 0xe2, 0xed, 0xf5, 0x00, 0x63, 0xfd, 0x8b, 0x54, 0xc9, 0x72, 0x44,
+	0xcb, 0x34, 0x65, 0x45, 0xb8, 0xb6, 0x54, 0x9d, 0x4e, 0x99, 0x2b, 0x3f, 0x4e, 0x84, 0x25, 0x70, 0x0c, 0xe2, 0xdb, 0xbd,
+	0x09, 0x51, 0x70, 0x23, 0xbc, 0xb5, 0xd1, 0x1f, 0x23, 0x69, 0x80, 0xa0, 0xe6, 0xa5, 0x3e, 0x9d, 0x19, 0xa3, 0x42, 0x00,
+	0x41, 0x60, 0x85, 0xa9, 0x5e, 0xae, 0x00, 0x39, 0x48, 0x55, 0xc0, 0x40, 0x53, 0x8d, 0xfa, 0xcb, 0x12, 0xf3, 0xe5, 0x96,
+	0x40, 0x02, 0x9e, 0xd6, 0x87, 0x3e, 0xa2, 0x9c, 0xd7, 0xcb, 0xe7, 0x09, 0x25, 0x9f, 0x56, 0x50, 0x99, 0xb6, 0x2a, 0x75,
+	0xd3, 0xc7, 0x8f, 0x90, 0x35, 0xb1, 0xd5, 0xad, 0x74, 0x33, 0x60, 0x06, 0xa1, 0x45, 0x71, 0xca, 0x0c, 0xeb, 0x8a, 0xf2,
+	0x42, 0xce, 0xea, 0xc4, 0xbc, 0x85, 0xd7, 0x49, 0xc5, 0x41, 0xfd, 0x60, 0x8c, 0x12, 0x9e, 0x48, 0x6c, 0x1f, 0xc7, 0x9c,
+	0x31, 0x4b, 0x20, 0x1a, 0x75, 0x93, 0xf6, 0x5c, 0x75, 0x5c, 0xe5, 0x6f, 0xea, 0x98, 0x5e, 0xc9, 0xa0, 0xf7, 0xd8, 0x74,
+	0x95, 0x05, 0x08, 0x01, 0xd6, 0x27, 0xce, 0xc3, 0x7a, 0xc6, 0xdb, 0x57, 0xcf, 0xa9, 0x8f, 0xad, 0xb8, 0x40, 0x71, 0x7c,
+	0x5b, 0xd5, 0x4c, 0x90, 0x5c, 0xc9, 0xb6, 0x48, 0x1a, 0xbe, 0x3b, 0xf9, 0x11, 0x52, 0xa7, 0x1f, 0x96, 0xc5, 0x61, 0x9f,
+	0x03, 0x6b, 0x43, 0xe0, 0x24, 0x85, 0x47, 0x4f, 0x68, 0x06, 0xa2, 0xb0, 0x1f, 0xb2, 0x7f, 0x51, 0x84, 0x54, 0xb0, 0x80,
+	0x44, 0xf4, 0xe4, 0x55, 0xe8, 0x12, 0x85, 0x19, 0x23, 0x3b, 0x7e, 0xdd, 0x9a, 0x8a, 0x60, 0x84, 0x6b, 0x72, 0x2b, 0x89,
+	0x78, 0xa3, 0x21, 0x9c, 0x39, 0x81, 0x2a, 0x85, 0xf8, 0xa7, 0xfa, 0x84, 0x52, 0x0c, 0xc4, 0x9e, 0xe2, 0x00, 0x83, 0x60,
+	0xd2, 0xee, 0xc6, 0xd3, 0xb7, 0x89, 0xf9, 0xd0, 0x13, 0xc8, 0x7b, 0x81, 0xb9, 0x68, 0x5f, 0x29, 0x97, 0x4f, 0x56, 0x05,
+	0x2b, 0xb9, 0xbe, 0x87, 0xa3, 0x17, 0x88, 0xa3, 0x52, 0xfa, 0x78, 0x3f, 0x44, 0xe7, 0x6a, 0xd5, 0xa7, 0x37, 0xd5, 0x99,
+	0xdc, 0x5c, 0x5b, 0x2d, 0x94, 0xc0, 0x7f, 0x04, 0xeb, 0xb6, 0xde, 0x13, 0x9d, 0x4d, 0x7b, 0x5c, 0xce, 0x61, 0x3c, 0x4c,
+	0x7e, 0x22, 0x1e, 0x85, 0x97, 0xaf, 0xb9, 0x4a, 0xef, 0xf9, 0x8d, 0xa4, 0xe6, 0xb6, 0x65, 0x51, 0x16, 0xb6, 0x03, 0xfe,
+	0x17, 0xdc, 0x61, 0xcf, 0xac, 0x7f, 0xf8, 0xf1, 0xcc, 0x21, 0x8d, 0x10, 0x8e, 0xf7, 0x08, 0xab, 0xe2, 0x49, 0xa2, 0xde,
+	0x71, 0xd8, 0x1e, 0x33, 0x9c, 0x44, 0xa8, 0x6e, 0xfe, 0xa5, 0xeb, 0x9a, 0xf6, 0x4e, 0x4a, 0x01, 0xd0, 0x69, 0x83, 0x6a,
+	0xe0, 0x2d, 0x7c, 0x37, 0x32, 0xe6, 0xe4, 0x80, 0xd7, 0xb3, 0xff, 0x01, 0x94, 0x0e, 0xe5, 0x0e, 0x40, 0x1f, 0x00, 0x00
+};
+
+static const uint8_t inflate_zeros[] = {
+	0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0xc1, 0x31, 0x01, 0x00, 0x00, 0x00, 0xc2, 0xa0, 0xf5,
+	0x4f, 0x6d, 0x08, 0x5f, 0xa0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x3e, 0x03, 0x1c, 0xea, 0x38, 0xa7, 0x00, 0x00, 0x10, 0x00
+};
+
+static const inflate_test_case inflate_tests[] = {
+	{ "empty", inflate_empty, sizeof(inflate_empty), 0, 1 },	// empty input
+	{ "one", inflate_one, sizeof(inflate_one), 1, 2 },	// single byte
+	{ "stored", inflate_stored, sizeof(inflate_stored), 1000, 3 },	// level 0 (stored blocks)
+	{ "fixed", inflate_fixed, sizeof(inflate_fixed), 20000, 4 },	// fixed Huffman codes
+	{ "huffman", inflate_huffman, sizeof(inflate_huffman), 2000, 5 },	// Huffman only, no matches
+	{ "rle", inflate_rle, sizeof(inflate_rle), 2000, 6 },	// distance 1 matches only
+	{ "level1", inflate_level1, sizeof(inflate_level1), 20000, 7 },	// level 1
+	{ "level6", inflate_level6, sizeof(inflate_level6), 20000, 8 },	// level 6
+	{ "level9", inflate_level9, sizeof(inflate_level9), 48000, 9 },	// level 9, distances up to 32 KB
+	{ "window512", inflate_window512, sizeof(inflate_window512), 8000, 10 },	// 512 byte window
+	{ "flush", inflate_flush, sizeof(inflate_flush), 20000, 11 },	// sync and full flushes
+	{ "multi", inflate_multi, sizeof(inflate_multi), 16000, 12 },	// two gzip members
+	{ "zeros", inflate_zeros, sizeof(inflate_zeros), 1048576, 0 },	// 1 MB of zeroes
+};
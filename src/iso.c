@@ -85,8 +85,9 @@ int64_t iso_blocking_status = -1;
 extern uint64_t md5sum_totalbytes;
 extern BOOL preserve_timestamps, enable_ntfs_compression, validate_md5sum;
 extern HANDLE format_thread;
+extern int default_thread_priority;
 extern StrArray modified_files;
-BOOL enable_iso = TRUE, enable_joliet = TRUE, enable_rockridge = TRUE, has_ldlinux_c32;
+BOOL enable_iso = TRUE, enable_joliet = TRUE, enable_rockridge = TRUE, enable_parallel_extraction = TRUE, has_ldlinux_c32;
 #define ISO_BLOCKING(x) do {x; iso_blocking_status++; } while(0)
 static const char* psz_extract_dir;
 static const char* bootmgr_name = "bootmgr";
@@ -128,6 +129,7 @@ static uint64_t total_blocks, extra_blocks, nb_blocks, last_nb_blocks;
 static BOOL scan_only = FALSE;
 static FILE* fd_md5sum = NULL;
 static StrArray config_path, isolinux_path;
+static htab_table symlink_htab = HTAB_EMPTY;
 static char symlinked_syslinux[MAX_PATH], *md5sum_data = NULL, *md5sum_pos = NULL;
 
 // Ensure filenames do not contain invalid FAT32 or NTFS characters
@@ -161,6 +163,50 @@ static void log_handler (cdio_log_level_t level, const char *message)
 	uprintf("libcdio: %s", message);
 }
 
+/*
+ * Resolve the target of a Rock Ridge symbolic link. Since each resolution requires
+ * a lookup through the ISO directories, the targets are cached the first time they
+ * are resolved (for /firmware duplicates, this happens during the scan), so that the
+ * extraction doesn't have to look them up again.
+ * The caller must only free the returned stat if must_free is set.
+ */
+static iso9660_stat_t* resolve_symlink(iso9660_t* p_iso, char* target_path, BOOL* must_free)
+{
+	iso9660_stat_t* p_statbuf;
+	uint32_t i = 0;
+
+	*must_free = TRUE;
+	if ((symlink_htab.table == NULL) && !htab_create(ISO_MAX_CACHED_SYMLINKS, &symlink_htab))
+		return iso9660_ifs_stat_translate(p_iso, target_path);
+	// htab_hash() inserts any entry that doesn't exist, so don't invoke it once full
+	if (symlink_htab.filled < symlink_htab.size) {
+		i = htab_hash(target_path, &symlink_htab);
+		if ((i != 0) && (symlink_htab.table[i].data != NULL)) {
+			*must_free = FALSE;
+			return (iso9660_stat_t*)symlink_htab.table[i].data;
+		}
+	}
+	p_statbuf = iso9660_ifs_stat_translate(p_iso, target_path);
+	if ((i != 0) && (p_statbuf != NULL)) {
+		symlink_htab.table[i].data = p_statbuf;
+		*must_free = FALSE;
+	}
+	return p_statbuf;
+}
+
+static void clear_symlink_cache(void)
+{
+	uint32_t i;
+
+	if (symlink_htab.table == NULL)
+		return;
+	for (i = 0; i <= symlink_htab.size; i++) {
+		if (symlink_htab.table[i].data != NULL)
+			iso9660_stat_free((iso9660_stat_t*)symlink_htab.table[i].data);
+	}
+	htab_destroy(&symlink_htab);
+}
+
 /*
  * Scan and set ISO properties
  * Returns true if the the current file does not need to be processed further
@@ -598,6 +644,374 @@ static void __inline set_directory_timestamp(char* path, LPFILETIME creation, LP
 	safe_closehandle(dir_handle);
 }
 
+/*
+ * Parallel extraction of ISO9660 files.
+ * During the directory walk, regular files are only queued as extraction jobs.
+ * Once the walk is complete, the jobs are sorted by LSN and a single reader streams
+ * the ISO forward in large blocks, handing each block over to one of a pool of writer
+ * threads, that create, preallocate, write and hash the files in parallel.
+ * When libcdio has the image memory mapped, the writers access the data in place.
+ */
+#define EXTRACT_EXIT              0xFFFFFFFF
+#define EXTRACT_MAPPED            0xFFFFFFFF
+
+typedef struct {
+	char* path;				// Destination path, as displayed and used in md5sum.txt
+	char* san_path;			// Destination path, with invalid characters sanitized
+	char* iso_dir;			// ISO directory of the file, only set if the file needs fix_config()
+	lsn_t lsn;
+	int64_t size;
+	FILETIME ft;
+	EXTRACT_PROPS props;
+	BOOL dup;				// Same extent as the previous job, so it gets its data from that job's reads
+	BOOL hashed;
+	uint8_t md5[MD5_HASHSIZE];
+} EXTRACT_JOB;
+
+typedef struct {
+	uint32_t job;			// Index of the job, or EXTRACT_EXIT to terminate the writer
+	uint32_t buf;			// Index of the buffer the data resides in, or EXTRACT_MAPPED
+	uint32_t offset;		// Offset of the data in the buffer
+	uint32_t size;
+	const uint8_t* data;
+	BOOLEAN first;
+	BOOLEAN last;
+} EXTRACT_CHUNK;
+
+typedef struct {
+	HANDLE thread;
+	HANDLE chunk_ready;
+	HANDLE slot_free;
+	uint32_t head, tail;
+	EXTRACT_CHUNK chunk[ISO_WRITER_QUEUE_SIZE];
+} EXTRACT_WRITER;
+
+static EXTRACT_JOB* extract_job = NULL;
+static uint32_t nb_extract_jobs = 0, max_extract_jobs = 0;
+static uint8_t* extract_buf[ISO_EXTRACT_NB_BUFFERS];
+static HANDLE extract_buf_free[ISO_EXTRACT_NB_BUFFERS];
+static volatile LONG extract_buf_refs[ISO_EXTRACT_NB_BUFFERS];
+static volatile BOOL extract_failed;
+static BOOL parallel_extraction = FALSE;
+
+static void free_extract_jobs(void)
+{
+	uint32_t i;
+
+	for (i = 0; i < nb_extract_jobs; i++) {
+		safe_free(extract_job[i].path);
+		safe_free(extract_job[i].san_path);
+		safe_free(extract_job[i].iso_dir);
+	}
+	safe_free(extract_job);
+	nb_extract_jobs = 0;
+	max_extract_jobs = 0;
+}
+
+// Queue a file for extraction. Takes ownership of san_path.
+static BOOL queue_extract_job(const char* path, char* san_path, const char* iso_dir,
+	iso9660_stat_t* p_statbuf, int64_t size, EXTRACT_PROPS* props)
+{
+	EXTRACT_JOB* job;
+
+	if (nb_extract_jobs == max_extract_jobs) {
+		max_extract_jobs = (max_extract_jobs == 0) ? 1024 : 2 * max_extract_jobs;
+		job = (EXTRACT_JOB*)realloc(extract_job, max_extract_jobs * sizeof(EXTRACT_JOB));
+		if (job == NULL) {
+			uprintf("Could not allocate extraction jobs");
+			free(san_path);
+			return FALSE;
+		}
+		extract_job = job;
+	}
+	job = &extract_job[nb_extract_jobs];
+	memset(job, 0, sizeof(EXTRACT_JOB));
+	job->path = safe_strdup(path);
+	job->san_path = san_path;
+	if (props->is_cfg || props->is_conf)
+		job->iso_dir = safe_strdup(iso_dir);
+	job->lsn = p_statbuf->lsn;
+	job->size = size;
+	job->ft = *to_filetime(mktime(&p_statbuf->tm));
+	job->props = *props;
+	nb_extract_jobs++;
+	return (job->path != NULL);
+}
+
+// Sort by LSN, then by size, so that jobs that share the same extent follow each other
+static int __cdecl extract_job_cmp(const void* a, const void* b)
+{
+	const EXTRACT_JOB* job_a = (const EXTRACT_JOB*)a;
+	const EXTRACT_JOB* job_b = (const EXTRACT_JOB*)b;
+
+	if (job_a->lsn != job_b->lsn)
+		return (job_a->lsn < job_b->lsn) ? -1 : 1;
+	return (job_a->size < job_b->size) ? -1 : ((job_a->size > job_b->size) ? 1 : 0);
+}
+
+// Index of the next job that isn't a duplicate of the ones before it
+static __inline uint32_t next_extract_job(uint32_t j)
+{
+	for (j++; (j < nb_extract_jobs) && extract_job[j].dup; j++);
+	return j;
+}
+
+// Files that map to the same destination (e.g. names that only differ by case)
+// must always be processed by the same writer, in the order they were queued.
+static uint32_t extract_writer_index(const char* path, uint32_t nb_writers)
+{
+	uint32_t h = 2166136261U;
+
+	for (; *path != 0; path++)
+		h = (h ^ (uint8_t)tolower(*path)) * 16777619U;
+	return h % nb_writers;
+}
+
+static DWORD WINAPI extract_writer_thread(void* param)
+{
+	EXTRACT_WRITER* w = (EXTRACT_WRITER*)param;
+	EXTRACT_CHUNK c;
+	EXTRACT_JOB* job;
+	HANDLE file_handle = INVALID_HANDLE_VALUE;
+	HASH_CONTEXT ctx;
+	DWORD wr_size, err;
+	BOOL r;
+
+	while (1) {
+		if (WaitForSingleObject(w->chunk_ready, INFINITE) != WAIT_OBJECT_0)
+			return 1;
+		c = w->chunk[w->tail];
+		w->tail = (w->tail + 1) % ISO_WRITER_QUEUE_SIZE;
+		ReleaseSemaphore(w->slot_free, 1, NULL);
+		if (c.job == EXTRACT_EXIT)
+			break;
+		job = &extract_job[c.job];
+		// Keep draining the queue after an error, so that the reader never stalls
+		if (!extract_failed && !ErrorStatus) {
+			if (c.first) {
+				file_handle = CreatePreallocatedFile(job->san_path, GENERIC_READ | GENERIC_WRITE,
+					FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, job->size);
+				if (file_handle == INVALID_HANDLE_VALUE) {
+					err = GetLastError();
+					uprintf("  Unable to create file '%s': %s", job->san_path, WindowsErrorString());
+					if (((err == ERROR_ACCESS_DENIED) || (err == ERROR_INVALID_HANDLE)) &&
+						(safe_strcmp(&job->san_path[3], autorun_name) == 0))
+						uprintf(stupid_antivirus);
+					else
+						extract_failed = TRUE;
+				}
+				if (fd_md5sum != NULL)
+					hash_init[HASH_MD5](&ctx);
+			}
+			if (file_handle != INVALID_HANDLE_VALUE) {
+				if (fd_md5sum != NULL)
+					hash_write[HASH_MD5](&ctx, c.data, c.size);
+				ISO_BLOCKING(r = WriteFileWithRetry(file_handle, c.data, c.size, &wr_size, WRITE_RETRIES));
+				if (!r || (wr_size != c.size)) {
+					uprintf("  Error writing file '%s': %s", job->san_path, r ? "Short write detected" : WindowsErrorString());
+					extract_failed = TRUE;
+					ISO_BLOCKING(safe_closehandle(file_handle));
+				} else if (c.last) {
+					if (fd_md5sum != NULL) {
+						hash_final[HASH_MD5](&ctx);
+						memcpy(job->md5, ctx.buf, MD5_HASHSIZE);
+						job->hashed = TRUE;
+					}
+					if ((preserve_timestamps) && (!SetFileTime(file_handle, &job->ft, &job->ft, &job->ft)))
+						uprintf("  Could not set timestamp for '%s': %s", job->san_path, WindowsErrorString());
+					ISO_BLOCKING(safe_closehandle(file_handle));
+				}
+			}
+		}
+		// The last writer to be done with a buffer hands it back to the reader
+		if ((c.buf != EXTRACT_MAPPED) && (InterlockedDecrement(&extract_buf_refs[c.buf]) == 0))
+			SetEvent(extract_buf_free[c.buf]);
+	}
+	ISO_BLOCKING(safe_closehandle(file_handle));
+	return 0;
+}
+
+static BOOL push_extract_chunk(EXTRACT_WRITER* w, EXTRACT_CHUNK* c)
+{
+	if (WaitForSingleObject(w->slot_free, INFINITE) != WAIT_OBJECT_0)
+		return FALSE;
+	w->chunk[w->head] = *c;
+	w->head = (w->head + 1) % ISO_WRITER_QUEUE_SIZE;
+	return ReleaseSemaphore(w->chunk_ready, 1, NULL);
+}
+
+// Returns 0 on success, nonzero on error
+static int extract_queued_files(iso9660_t* p_iso)
+{
+	EXTRACT_WRITER writer[ISO_WRITER_THREADS] = { 0 };
+	EXTRACT_CHUNK c = { 0 }, chunk[ISO_WRITER_QUEUE_SIZE];
+	EXTRACT_JOB* job;
+	uint32_t i, j, k, d, b, nb_chunks, nb_refs, nb_writers = 0, w;
+	int64_t offset;
+	size_t nb;
+	DWORD dw;
+	lsn_t start, end, next_end;
+	const uint8_t* data;
+	int r = 1;
+
+	if (nb_extract_jobs == 0)
+		return 0;
+
+	// Sort the jobs so that the ISO is read in a single forward sweep
+	qsort(extract_job, nb_extract_jobs, sizeof(EXTRACT_JOB), extract_job_cmp);
+	// Files with duplicated extents (e.g. symlinked firmware) only get read once
+	for (j = 1; j < nb_extract_jobs; j++)
+		extract_job[j].dup = (extract_job[j].lsn == extract_job[j - 1].lsn) &&
+			(extract_job[j].size == extract_job[j - 1].size);
+	extract_failed = FALSE;
+	memset(extract_buf, 0, sizeof(extract_buf));
+	memset(extract_buf_free, 0, sizeof(extract_buf_free));
+	for (i = 0; i < ISO_EXTRACT_NB_BUFFERS; i++) {
+		extract_buf[i] = _mm_malloc(ISO_EXTRACT_BUFFER_SIZE, 16);
+		extract_buf_free[i] = CreateEvent(NULL, FALSE, TRUE, NULL);
+		if ((extract_buf[i] == NULL) || (extract_buf_free[i] == NULL)) {
+			uprintf("Could not allocate extraction buffers");
+			goto out;
+		}
+	}
+	for (nb_writers = 0; nb_writers < ISO_WRITER_THREADS; nb_writers++) {
+		w = nb_writers;
+		writer[w].chunk_ready = CreateSemaphore(NULL, 0, ISO_WRITER_QUEUE_SIZE, NULL);
+		writer[w].slot_free = CreateSemaphore(NULL, ISO_WRITER_QUEUE_SIZE, ISO_WRITER_QUEUE_SIZE, NULL);
+		if ((writer[w].chunk_ready == NULL) || (writer[w].slot_free == NULL))
+			break;
+		writer[w].thread = CreateThread(NULL, 0, extract_writer_thread, &writer[w], 0, NULL);
+		if (writer[w].thread == NULL)
+			break;
+		SetThreadPriority(writer[w].thread, default_thread_priority);
+	}
+	if (nb_writers == 0) {
+		uprintf("Could not start extraction threads: %s", WindowsErrorString());
+		goto out;
+	}
+	uprintf("Writing %d files using %d threads...", nb_extract_jobs, nb_writers);
+
+	// Replay the plan as a single forward sweep. Files that are smaller than a block are
+	// coalesced with the ones that follow them on disc into a single large read, as long
+	// as the gap between them is small enough that reading through it beats seeking. The
+	// data of each chunk is also handed to the jobs that duplicate the chunk's extent.
+	for (j = 0, offset = 0; j < nb_extract_jobs; ) {
+		if (ErrorStatus || extract_failed)
+			goto out;
+		job = &extract_job[j];
+		start = job->lsn + (lsn_t)(offset / ISO_BLOCKSIZE);
+		end = start + (lsn_t)MIN(ISO_EXTRACT_BUFFER_SIZE / ISO_BLOCKSIZE, (job->size - offset + ISO_BLOCKSIZE - 1) / ISO_BLOCKSIZE);
+		chunk[0].job = j;
+		chunk[0].offset = 0;
+		chunk[0].size = (uint32_t)MIN(job->size - offset, ISO_EXTRACT_BUFFER_SIZE);
+		chunk[0].first = (offset == 0);
+		chunk[0].last = (offset + chunk[0].size >= job->size);
+		nb_chunks = 1;
+		for (k = next_extract_job(j); chunk[0].last && (k < nb_extract_jobs) && (nb_chunks < ARRAYSIZE(chunk)); k = next_extract_job(k)) {
+			if ((extract_job[k].lsn < start) || (extract_job[k].lsn > end + ISO_EXTRACT_MAX_GAP / ISO_BLOCKSIZE))
+				break;
+			next_end = extract_job[k].lsn + (lsn_t)((extract_job[k].size + ISO_BLOCKSIZE - 1) / ISO_BLOCKSIZE);
+			if (next_end - start > ISO_EXTRACT_BUFFER_SIZE / ISO_BLOCKSIZE)
+				break;
+			end = MAX(end, next_end);
+			chunk[nb_chunks].job = k;
+			chunk[nb_chunks].offset = (uint32_t)(extract_job[k].lsn - start) * ISO_BLOCKSIZE;
+			chunk[nb_chunks].size = (uint32_t)extract_job[k].size;
+			chunk[nb_chunks].first = TRUE;
+			chunk[nb_chunks].last = TRUE;
+			nb_chunks++;
+		}
+
+		nb = (size_t)(end - start);
+		// If the image is memory mapped, the writers can use the data in place
+		data = iso9660_iso_seek_map(p_iso, start, (long)nb);
+		if (data != NULL) {
+			b = EXTRACT_MAPPED;
+		} else {
+			// Writers check for cancellation, so a buffer always eventually becomes available
+			dw = WaitForMultipleObjects(ISO_EXTRACT_NB_BUFFERS, extract_buf_free, FALSE, INFINITE);
+			if (dw >= WAIT_OBJECT_0 + ISO_EXTRACT_NB_BUFFERS) {
+				uprintf("Could not wait for extraction buffer: %s", WindowsErrorString());
+				goto out;
+			}
+			b = dw - WAIT_OBJECT_0;
+			if (iso9660_iso_seek_read(p_iso, extract_buf[b], start, (long)nb) != (nb * ISO_BLOCKSIZE)) {
+				uprintf("  Error reading ISO9660 file %s at LSN %lu",
+					&job->path[strlen(psz_extract_dir)], (long unsigned int)start);
+				goto out;
+			}
+			data = extract_buf[b];
+			// Set the reference count before the first writer can release it
+			for (i = 0, nb_refs = 0; i < nb_chunks; i++)
+				nb_refs += next_extract_job(chunk[i].job) - chunk[i].job;
+			extract_buf_refs[b] = (LONG)nb_refs;
+		}
+		for (i = 0; i < nb_chunks; i++) {
+			chunk[i].buf = b;
+			chunk[i].data = &data[chunk[i].offset];
+			for (d = chunk[i].job, k = next_extract_job(d); d < k; d++) {
+				c = chunk[i];
+				c.job = d;
+				if (!push_extract_chunk(&writer[extract_writer_index(extract_job[d].san_path, nb_writers)], &c)) {
+					uprintf("Could not queue extraction data: %s", WindowsErrorString());
+					goto out;
+				}
+				nb_blocks += (c.size + ISO_BLOCKSIZE - 1) / ISO_BLOCKSIZE;
+			}
+		}
+		if (nb_blocks - last_nb_blocks >= PROGRESS_THRESHOLD) {
+			UpdateProgressWithInfo(OP_FILE_COPY, MSG_231, nb_blocks, total_blocks +
+				((fs_type != FS_NTFS) ? extra_blocks : 0));
+			last_nb_blocks = nb_blocks;
+		}
+		if (chunk[0].last) {
+			j = next_extract_job(chunk[nb_chunks - 1].job);
+			offset = 0;
+		} else {
+			offset += chunk[0].size;
+		}
+	}
+	r = 0;
+
+out:
+	// Writers always drain their queue, so the termination chunk is guaranteed to go through
+	c.job = EXTRACT_EXIT;
+	for (w = 0; w < nb_writers; w++)
+		push_extract_chunk(&writer[w], &c);
+	for (w = 0; w < ISO_WRITER_THREADS; w++) {
+		if (writer[w].thread != NULL) {
+			WaitForSingleObject(writer[w].thread, INFINITE);
+			CloseHandle(writer[w].thread);
+		}
+		if (writer[w].chunk_ready != NULL)
+			CloseHandle(writer[w].chunk_ready);
+		if (writer[w].slot_free != NULL)
+			CloseHandle(writer[w].slot_free);
+	}
+	for (i = 0; i < ISO_EXTRACT_NB_BUFFERS; i++) {
+		safe_mm_free(extract_buf[i]);
+		if (extract_buf_free[i] != NULL)
+			CloseHandle(extract_buf_free[i]);
+	}
+	if (extract_failed)
+		r = 1;
+	if (r == 0) {
+		for (j = 0; j < nb_extract_jobs; j++) {
+			job = &extract_job[j];
+			if (job->hashed) {
+				for (i = 0; i < MD5_HASHSIZE; i++)
+					fprintf(fd_md5sum, "%02x", job->md5[i]);
+				fprintf(fd_md5sum, "  ./%s\n", &job->path[3]);
+			}
+			// Config files can only be patched once they have been written
+			if (job->iso_dir != NULL)
+				fix_config(job->san_path, job->iso_dir, PathFindFileNameU(job->path), &job->props);
+		}
+	}
+	free_extract_jobs();
+	return r;
+}
+
 // Returns 0 on success, nonzero on error
 static int udf_extract_files(udf_t *p_udf, udf_dirent_t *p_udf_dirent, const char *psz_path)
 {
@@ -755,7 +1169,7 @@ static int iso_extract_files(iso9660_t* p_iso, const char *psz_path)
 	DWORD buf_size, wr_size, err;
 	EXTRACT_PROPS props;
 	HASH_CONTEXT ctx;
-	BOOL is_symlink, is_identical, create_file, free_p_statbuf = FALSE;
+	BOOL is_symlink, is_identical, create_file, must_free, free_p_statbuf = FALSE;
 	int length, r = 1;
 	char psz_fullpath[MAX_PATH], *psz_basename = NULL, *psz_sanpath = NULL;
 	char tmp[128], target_path[256];
@@ -795,21 +1209,11 @@ static int iso_extract_files(iso9660_t* p_iso, const char *psz_path)
 		if (scan_only && (p_statbuf->rr.b3_rock == yep) && enable_rockridge) {
 			if (p_statbuf->rr.u_su_fields & ISO_ROCK_SUF_PL) {
 				if (!img_report.has_deep_directories)
-					uprintf("  Note: The selected ISO uses Rock Ridge 'deep directories'.\r\n"
-						"  Because of this, it may take a very long time to scan or extract...");
+					uprintf("  Note: The selected ISO uses Rock Ridge 'deep directories'.");
+				// Deep directory (CL/PL) entries are resolved through an LSN index
+				// that libcdio builds on first use, so there is no need to cut the
+				// scan short here.
 				img_report.has_deep_directories = TRUE;
-				// Due to the nature of the parsing of Rock Ridge deep directories
-				// which requires performing a *very costly* search of the whole
-				// ISO9660 file system to find the matching LSN, ISOs with loads of
-				// deep directory entries (e.g. OPNsense) are very slow to parse...
-				// To speed up the scan process, and since we expect deep directory
-				// entries to appear below anything we care for, we cut things
-				// short by telling the parent not to bother any further once we
-				// find that we are dealing with a deep directory.
-				r = -1;
-				// Add at least one extra block, since we're skipping content.
-				total_blocks++;
-				goto out;
 			}
 		}
 		// Eliminate . and .. entries
@@ -850,10 +1254,11 @@ static int iso_extract_files(iso9660_t* p_iso, const char *psz_path)
 					// Add symlink duplicated files to total_size at scantime
 					if ((strcmp(psz_path, "/firmware") == 0)) {
 						static_sprintf(target_path, "%s/%s", psz_path, p_statbuf->rr.psz_symlink);
-						iso9660_stat_t* p_statbuf2 = iso9660_ifs_stat_translate(p_iso, target_path);
+						iso9660_stat_t* p_statbuf2 = resolve_symlink(p_iso, target_path, &must_free);
 						if (p_statbuf2 != NULL) {
 							extra_blocks += (p_statbuf2->total_size + ISO_BLOCKSIZE - 1) / ISO_BLOCKSIZE;
-							iso9660_stat_free(p_statbuf2);
+							if (must_free)
+								iso9660_stat_free(p_statbuf2);
 						}
 					} else if ((strcmp(p_statbuf->filename, "live") == 0) &&
 						(strcmp(p_statbuf->rr.psz_symlink, "casper") == 0)) {
@@ -885,7 +1290,7 @@ static int iso_extract_files(iso9660_t* p_iso, const char *psz_path)
 				if (fs_type == FS_NTFS) {
 					// Replicate symlinks if NTFS is being used
 					static_sprintf(target_path, "%s/%s", psz_path, p_statbuf->rr.psz_symlink);
-					iso9660_stat_t* p_statbuf2 = iso9660_ifs_stat_translate(p_iso, target_path);
+					iso9660_stat_t* p_statbuf2 = resolve_symlink(p_iso, target_path, &must_free);
 					if (p_statbuf2 != NULL) {
 						to_windows_path(psz_fullpath);
 						to_windows_path(p_statbuf->rr.psz_symlink);
@@ -896,7 +1301,8 @@ static int iso_extract_files(iso9660_t* p_iso, const char *psz_path)
 							uprintf("  Could not create symlink: %s", WindowsErrorString());
 						to_unix_path(p_statbuf->rr.psz_symlink);
 						to_unix_path(psz_fullpath);
-						iso9660_stat_free(p_statbuf2);
+						if (must_free)
+							iso9660_stat_free(p_statbuf2);
 						create_file = FALSE;
 					}
 				} else if (file_length == 0) {
@@ -910,12 +1316,14 @@ static int iso_extract_files(iso9660_t* p_iso, const char *psz_path)
 						// Special handling for ISOs that use symlinks for /firmware/ (e.g. Debian non-free)
 						// TODO: Do we want to do this for all file symlinks?
 						static_sprintf(target_path, "%s/%s", psz_path, p_statbuf->rr.psz_symlink);
-						p_statbuf = iso9660_ifs_stat_translate(p_iso, target_path);
+						p_statbuf = resolve_symlink(p_iso, target_path, &must_free);
 						if (p_statbuf != NULL) {
 							// The original p_statbuf will be freed automatically, but not
-							// the new one so we need to force an explicit free.
-							free_p_statbuf = TRUE;
+							// the new one so we may need to force an explicit free.
+							free_p_statbuf = must_free;
 							file_length = p_statbuf->total_size;
+							// From now on, this is a regular copy of the target file
+							is_symlink = FALSE;
 							print_extracted_file(psz_fullpath, file_length);
 							uprintf("  Duplicated from '%s'", target_path);
 						} else {
@@ -931,6 +1339,17 @@ static int iso_extract_files(iso9660_t* p_iso, const char *psz_path)
 					create_file = FALSE;
 				}
 			}
+			if (create_file && !is_symlink && (file_length != 0) && parallel_extraction) {
+				// The data will be written once the whole directory tree has been walked
+				// (NB: psz_sanpath is owned by the queue from now on)
+				if (!queue_extract_job(psz_fullpath, psz_sanpath, psz_path, p_statbuf, file_length, &props)) {
+					psz_sanpath = NULL;
+					r = 1;
+					goto out;
+				}
+				psz_sanpath = NULL;
+				create_file = FALSE;
+			}
 			if (create_file) {
 				file_handle = CreatePreallocatedFile(psz_sanpath, GENERIC_READ | GENERIC_WRITE,
 					FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, file_length);
@@ -995,7 +1414,7 @@ static int iso_extract_files(iso9660_t* p_iso, const char *psz_path)
 			if (free_p_statbuf)
 				iso9660_stat_free(p_statbuf);
 			ISO_BLOCKING(safe_closehandle(file_handle));
-			if (props.is_cfg || props.is_conf)
+			if ((props.is_cfg || props.is_conf) && (psz_sanpath != NULL))
 				fix_config(psz_sanpath, psz_path, psz_basename, &props);
 			safe_free(psz_sanpath);
 		}
@@ -1112,6 +1531,7 @@ BOOL ExtractISO(const char* src_iso, const char* dest_dir, BOOL scan)
 		return FALSE;
 
 	scan_only = scan;
+	parallel_extraction = (!scan_only) && enable_parallel_extraction;
 	if (!scan_only)
 		spacing = "";
 	cdio_log_set_handler(log_handler);
@@ -1123,6 +1543,8 @@ BOOL ExtractISO(const char* src_iso, const char* dest_dir, BOOL scan)
 		total_blocks = 0;
 		extra_blocks = 0;
 		has_ldlinux_c32 = FALSE;
+		// Symlink targets from a previous image are no longer valid
+		clear_symlink_cache();
 		// String array of all isolinux/syslinux locations
 		StrArrayCreate(&config_path, 8);
 		StrArrayCreate(&isolinux_path, 8);
@@ -1209,6 +1631,11 @@ try_iso:
 			uprintf("%sThis image will not be extracted using any ISO extensions", spacing);
 	}
 	r = iso_extract_files(p_iso, "");
+	if (parallel_extraction) {
+		if (r == 0)
+			r = extract_queued_files(p_iso);
+		free_extract_jobs();
+	}
 
 out:
 	iso_blocking_status = -1;
@@ -1722,28 +2149,33 @@ typedef struct {
  * Read sectors from a FAT img file residing on an ISO-9660 filesystem.
  * NB: This assumes that the img file sectors are contiguous on the ISO.
   */
-int iso9660_readfat(intptr_t pp, void *buf, size_t secsize, libfat_sector_t sec)
+int iso9660_readfat(intptr_t pp, void *buf, size_t size, libfat_sector_t sec)
 {
 	iso9660_readfat_private* p_private = (iso9660_readfat_private*)pp;
+	const size_t secsize = LIBFAT_SECTOR_SIZE;
+	size_t i;
 
 	if (sizeof(p_private->buf) % secsize != 0) {
 		uprintf("iso9660_readfat: Sector size %zu is not a divisor of %zu", secsize, sizeof(p_private->buf));
 		return 0;
 	}
 
-	if ((sec < p_private->sec_start) || (sec >= p_private->sec_start + sizeof(p_private->buf) / secsize)) {
-		// Sector being queried is not in our multi block buffer -> Update it
-		p_private->sec_start = (((sec * secsize) / ISO_BLOCKSIZE) * ISO_BLOCKSIZE) / secsize;
-		if (iso9660_iso_seek_read(p_private->p_iso, p_private->buf,
-			p_private->lsn + (lsn_t)((p_private->sec_start * secsize) / ISO_BLOCKSIZE), ISO_NB_BLOCKS)
-			!= ISO_NB_BLOCKS * ISO_BLOCKSIZE) {
-			uprintf("Error reading ISO-9660 file %s at LSN %lu", img_report.efi_img_path,
-				(long unsigned int)(p_private->lsn + (p_private->sec_start * secsize) / ISO_BLOCKSIZE));
-			return 0;
+	// libfat may read ahead, in which case we are asked for multiple sectors
+	for (i = 0; i < size / secsize; i++, sec++) {
+		if ((sec < p_private->sec_start) || (sec >= p_private->sec_start + sizeof(p_private->buf) / secsize)) {
+			// Sector being queried is not in our multi block buffer -> Update it
+			p_private->sec_start = (((sec * secsize) / ISO_BLOCKSIZE) * ISO_BLOCKSIZE) / secsize;
+			if (iso9660_iso_seek_read(p_private->p_iso, p_private->buf,
+				p_private->lsn + (lsn_t)((p_private->sec_start * secsize) / ISO_BLOCKSIZE), ISO_NB_BLOCKS)
+				!= ISO_NB_BLOCKS * ISO_BLOCKSIZE) {
+				uprintf("Error reading ISO-9660 file %s at LSN %lu", img_report.efi_img_path,
+					(long unsigned int)(p_private->lsn + (p_private->sec_start * secsize) / ISO_BLOCKSIZE));
+				return 0;
+			}
 		}
+		memcpy(&((uint8_t*)buf)[i * secsize], &p_private->buf[(sec - p_private->sec_start) * secsize], secsize);
 	}
-	memcpy(buf, &p_private->buf[(sec - p_private->sec_start)*secsize], secsize);
-	return (int)secsize;
+	return (int)size;
 }
 
 /*
@@ -1926,8 +2358,6 @@ BOOL DumpFatDir(const char* path, int32_t cluster)
 					}
 					written += size;
 					s = libfat_nextsector(lf_fs, s);
-					// Trust me, you *REALLY* want to invoke libfat_flush() here
-					libfat_flush(lf_fs);
 				}
 				safe_closehandle(handle);
 				if (props.is_conf)
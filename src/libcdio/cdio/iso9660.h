@@ -726,6 +726,22 @@ typedef struct _iso9660_s iso9660_t;
   long int iso9660_iso_seek_read (const iso9660_t *p_iso, /*out*/ void *ptr,
                                   lsn_t start, long int i_size);
 
+  /*!
+    Get a pointer to i_size blocks of the image, without copying them.
+
+    @param p_iso the ISO-9660 file image to get data from
+
+    @param start location of the first block
+
+    @param i_size number of blocks. Each block is ISO_BLOCKSIZE bytes long.
+
+    @return a pointer to the data, which remains valid until p_iso is
+    closed, or NULL if the image is not memory mapped, in which case
+    iso9660_iso_seek_read() must be used instead.
+  */
+  const void *iso9660_iso_seek_map (const iso9660_t *p_iso, lsn_t start,
+                                    long int i_size);
+
   /*!
     Read the Primary Volume Descriptor for a CD.
     True is returned if read, and false if there was an error.
@@ -91,18 +91,140 @@ static inline int _stati64_utf8(const char *path, struct _stati64 *buffer) {
 
 #define CDIO_STDIO_BUFSIZE (128*1024)
 
+/* On 64-bit Windows, where address space is not an issue, we memory map
+   the whole image, so that reads are served straight from the file cache
+   and callers can access the data without any copy at all. */
+#if defined(_WIN32) && defined(_WIN64)
+#define CDIO_STDIO_MMAP
+#include <windows.h>
+#define CDIO_MMAP_PREFETCH_SIZE (16*1024*1024)
+#endif
+
 typedef struct {
   char *pathname;
   FILE *fd;
   char *fd_buf;
   off_t st_size; /* used only for source */
+#ifdef CDIO_STDIO_MMAP
+  HANDLE h_file;
+  HANDLE h_map;
+  const uint8_t *map;
+  off_t map_size;
+  off_t map_pos;
+  off_t prefetch_start;
+  off_t prefetch_end;
+#endif
 } _UserData;
 
+#ifdef CDIO_STDIO_MMAP
+static void
+_stdio_unmap (_UserData *ud)
+{
+  if (ud->map)
+    UnmapViewOfFile (ud->map);
+  ud->map = NULL;
+  if (ud->h_map)
+    CloseHandle (ud->h_map);
+  ud->h_map = NULL;
+  if (ud->h_file)
+    CloseHandle (ud->h_file);
+  ud->h_file = NULL;
+}
+
+static bool
+_stdio_map (_UserData *ud)
+{
+  wchar_t *wpath, wroot[MAX_PATH];
+  LARGE_INTEGER li;
+  bool r = false;
+
+  wpath = cdio_utf8_to_wchar (ud->pathname);
+  if (wpath == NULL)
+    return false;
+
+  /* An I/O error on a mapped view raises an exception instead of failing
+     a read, so we only map images that reside on local fixed disks. */
+  if (!GetVolumePathNameW (wpath, wroot, MAX_PATH) ||
+      GetDriveTypeW (wroot) != DRIVE_FIXED)
+    goto out;
+
+  ud->h_file = CreateFileW (wpath, GENERIC_READ, FILE_SHARE_READ, NULL,
+                            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (ud->h_file == INVALID_HANDLE_VALUE)
+    {
+      ud->h_file = NULL;
+      goto out;
+    }
+  if (!GetFileSizeEx (ud->h_file, &li) || li.QuadPart == 0)
+    goto out;
+  ud->h_map = CreateFileMappingW (ud->h_file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (ud->h_map == NULL)
+    goto out;
+  ud->map = MapViewOfFile (ud->h_map, FILE_MAP_READ, 0, 0, 0);
+  if (ud->map == NULL)
+    goto out;
+
+  ud->map_size = (off_t) li.QuadPart;
+  ud->map_pos = 0;
+  ud->prefetch_start = 0;
+  ud->prefetch_end = 0;
+  r = true;
+
+ out:
+  if (!r)
+    {
+      cdio_debug ("could not map `%s', using stdio", ud->pathname);
+      _stdio_unmap (ud);
+    }
+  cdio_free (wpath);
+  return r;
+}
+
+/* The equivalent of madvise(MADV_WILLNEED): have the system read ahead
+   of the position we are accessing, in large sequential requests. */
+static void
+_stdio_prefetch (_UserData *ud, off_t i_offset)
+{
+  WIN32_MEMORY_RANGE_ENTRY range;
+
+  if (i_offset >= ud->prefetch_start &&
+      i_offset + CDIO_MMAP_PREFETCH_SIZE / 2 < ud->prefetch_end)
+    return;
+  ud->prefetch_start = i_offset;
+  ud->prefetch_end = i_offset + CDIO_MMAP_PREFETCH_SIZE;
+  if (ud->prefetch_end > ud->map_size)
+    ud->prefetch_end = ud->map_size;
+  if (ud->prefetch_end <= ud->prefetch_start)
+    return;
+  range.VirtualAddress = (PVOID) &ud->map[i_offset];
+  range.NumberOfBytes = (SIZE_T) (ud->prefetch_end - i_offset);
+  PrefetchVirtualMemory (GetCurrentProcess (), 1, &range, 0);
+}
+
+static const void *
+_stdio_map_range (void *user_data, off_t i_offset, size_t count)
+{
+  _UserData *const ud = user_data;
+
+  if (!ud->map || i_offset > ud->map_size ||
+      (off_t) count > ud->map_size - i_offset)
+    return NULL;
+
+  _stdio_prefetch (ud, i_offset);
+  return &ud->map[i_offset];
+}
+#endif
+
 static int
 _stdio_open (void *user_data)
 {
   _UserData *const ud = user_data;
 
+#ifdef CDIO_STDIO_MMAP
+  if (_stdio_map (ud))
+    return 0;
+#endif
+
   if ((ud->fd = CDIO_FOPEN (ud->pathname, "rb")))
     {
       ud->fd_buf = calloc (1, CDIO_STDIO_BUFSIZE);
@@ -117,6 +239,14 @@ _stdio_close(void *user_data)
 {
   _UserData *const ud = user_data;
 
+#ifdef CDIO_STDIO_MMAP
+  if (ud->map)
+    {
+      _stdio_unmap (ud);
+      return 0;
+    }
+#endif
+
   if (fclose (ud->fd))
     cdio_error ("fclose (): %s", strerror (errno));
 
@@ -138,6 +268,9 @@ _stdio_free(void *user_data)
 
   if (ud->fd) /* should be NULL anyway... */
     _stdio_close(user_data);
+#ifdef CDIO_STDIO_MMAP
+  _stdio_unmap(ud);
+#endif
 
   free(ud);
 }
@@ -163,6 +296,25 @@ _stdio_seek(void *p_user_data, off_t i_offset, int whence)
 {
   _UserData *const ud = p_user_data;
   int ret;
+
+#ifdef CDIO_STDIO_MMAP
+  if (ud->map)
+    {
+      off_t i_pos = i_offset;
+      if (whence == SEEK_CUR)
+        i_pos += ud->map_pos;
+      else if (whence == SEEK_END)
+        i_pos += ud->map_size;
+      if (i_pos < 0)
+        {
+          errno = EINVAL;
+          return DRIVER_OP_ERROR;
+        }
+      ud->map_pos = i_pos;
+      return 0;
+    }
+#endif
+
 #if !defined(HAVE_FSEEKO) && !defined(HAVE_FSEEKO64)
   /* Detect if off_t is lossy-truncated to long to avoid data corruption */
   if ( (sizeof(off_t) > sizeof(long)) && (i_offset != (off_t)((long)i_offset)) ) {
@@ -210,6 +362,20 @@ _stdio_read(void *user_data, void *buf, size_t count)
   _UserData *const ud = user_data;
   long read_count;
 
+#ifdef CDIO_STDIO_MMAP
+  if (ud->map)
+    {
+      if (ud->map_pos >= ud->map_size)
+        return 0;
+      if ((off_t) count > ud->map_size - ud->map_pos)
+        count = (size_t) (ud->map_size - ud->map_pos);
+      _stdio_prefetch (ud, ud->map_pos);
+      memcpy (buf, &ud->map[ud->map_pos], count);
+      ud->map_pos += count;
+      return count;
+    }
+#endif
+
   read_count = fread(buf, 1, count, ud->fd);
 
   if (read_count != count)
@@ -244,7 +410,7 @@ CdioDataSource_t *
 cdio_stdio_new(const char pathname[])
 {
   CdioDataSource_t *new_obj = NULL;
-  cdio_stream_io_functions funcs = { NULL, NULL, NULL, NULL, NULL, NULL };
+  cdio_stream_io_functions funcs = { NULL, NULL, NULL, NULL, NULL, NULL, NULL };
   _UserData *ud = NULL;
   struct CDIO_STAT_STRUCT statbuf;
   char* pathdup;
@@ -277,6 +443,9 @@ cdio_stdio_new(const char pathname[])
   funcs.read   = _stdio_read;
   funcs.close  = _stdio_close;
   funcs.free   = _stdio_free;
+#ifdef CDIO_STDIO_MMAP
+  funcs.map    = _stdio_map_range;
+#endif
 
   new_obj = cdio_stream_new(ud, &funcs);
 
@@ -211,6 +211,20 @@ cdio_stream_stat(CdioDataSource_t *p_obj)
   return p_obj->op.stat(p_obj->user_data);
 }
 
+/**
+  Return a pointer to i_size bytes of a memory mapped stream, starting at
+  i_offset, or NULL if the stream is not mapped.
+ */
+const void *
+cdio_stream_map(CdioDataSource_t *p_obj, off_t i_offset, size_t i_size)
+{
+  if (!p_obj || !p_obj->op.map) return NULL;
+  if (!_cdio_stream_open_if_necessary(p_obj)) return NULL;
+  if (i_offset < 0) return NULL;
+
+  return p_obj->op.map(p_obj->user_data, i_offset, i_size);
+}
+
 
 /*
  * Local variables:
@@ -42,6 +42,9 @@ extern "C" {
   typedef int(*cdio_data_close_t)(void *user_data);
   
   typedef void(*cdio_data_free_t)(void *user_data);
+
+  typedef const void*(*cdio_data_map_t)(void *user_data, off_t offset,
+                                        size_t count);
   
   
   /* abstract data source */
@@ -53,6 +56,7 @@ extern "C" {
     cdio_data_read_t read;
     cdio_data_close_t close;
     cdio_data_free_t free;
+    cdio_data_map_t map;   /* optional */
   } cdio_stream_io_functions;
   
   /**
@@ -121,6 +125,16 @@ extern "C" {
   void cdio_stream_destroy(CdioDataSource_t *p_obj);
   
   void cdio_stream_close(CdioDataSource_t *p_obj);
+
+  /**
+    Return a pointer to i_size bytes of the stream, starting at i_offset,
+    if the stream is backed by a memory mapping. The data remains valid
+    until the stream is closed, and the stream position is not affected.
+    On error, or if the stream is not mapped, return NULL, in which case
+    the data must be obtained through cdio_stream_read() instead.
+  */
+  const void *cdio_stream_map(CdioDataSource_t *p_obj, off_t i_offset,
+                              size_t i_size);
   
 #ifdef __cplusplus
 }
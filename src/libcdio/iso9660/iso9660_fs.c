@@ -63,6 +63,12 @@
 /* Maximum number of El-Torito boot images we keep an index for */
 #define MAX_BOOT_IMAGES     8
 
+/* Entry of the Rock Ridge deep directory LSN index */
+typedef struct {
+  lsn_t lsn;
+  iso9660_stat_t *p_stat;
+} dd_index_entry_t;
+
 /** Implementation of iso9660_t type */
 struct _iso9660_s {
   cdio_header_t header;     /**< Internal header - MUST come first. */
@@ -103,8 +109,18 @@ struct _iso9660_s {
 			         different.
 			     */
   bool b_have_superblock;   /**< Superblock has been read in? */
+  struct {
+    uint32_t u_size;        /**< Number of slots in the table (a power of 2) */
+    dd_index_entry_t *p_entry; /**< LSN -> directory stat hash table, used
+			         to resolve Rock Ridge deep directory (CL)
+			         links without searching the whole file
+			         system every time. Built on first use. */
+    bool b_built;           /**< The index was built (or failed to be) */
+  } dd_index;
 };
 
+static void _iso9660_dd_index_free(iso9660_t *p_iso);
+
 static long int iso9660_seek_read_framesize (const iso9660_t *p_iso,
 					     void *ptr, lsn_t start,
 					     long int size,
@@ -297,6 +313,7 @@ iso9660_close (iso9660_t *p_iso)
   if (NULL != p_iso) {
     cdio_stdio_destroy(p_iso->stream);
     p_iso->stream = NULL;
+    _iso9660_dd_index_free(p_iso);
     free(p_iso);
   }
   return true;
@@ -794,6 +811,23 @@ iso9660_iso_seek_read (const iso9660_t *p_iso, void *ptr, lsn_t start,
   return iso9660_seek_read_framesize(p_iso, ptr, start, size, ISO_BLOCKSIZE);
 }
 
+/*!
+  Return a pointer to n blocks of a memory mapped image, without copying
+  them, or NULL if the image is not mapped (or uses raw frames).
+*/
+const void *
+iso9660_iso_seek_map (const iso9660_t *p_iso, lsn_t start, long int size)
+{
+  int64_t i_byte_offset;
+
+  if (!p_iso || p_iso->i_framesize != ISO_BLOCKSIZE || size < 0) return NULL;
+  i_byte_offset = (start * (int64_t)ISO_BLOCKSIZE)
+    + p_iso->i_fuzzy_offset + p_iso->i_datastart;
+
+  return cdio_stream_map (p_iso->stream, i_byte_offset,
+			  (size_t)size * ISO_BLOCKSIZE);
+}
+
 
 
 /*!
@@ -1949,6 +1983,159 @@ iso9660_ifs_find_lsn(iso9660_t *p_iso, lsn_t i_lsn)
 }
 
 #ifdef HAVE_ROCK
+/* Recursively collect a copy of all the directory entries of the file system */
+static bool
+_iso9660_dd_index_collect(iso9660_t *p_iso_dd, const char psz_path[],
+			  CdioList_t *p_list)
+{
+  CdioISO9660FileList_t *p_entlist = iso9660_ifs_readdir(p_iso_dd, psz_path);
+  CdioListNode_t *p_entnode;
+  iso9660_stat_t *p_copy;
+  char *psz_subpath;
+  unsigned int len;
+  bool b_ret = true;
+
+  if (!p_entlist)
+    return false;
+
+  _CDIO_LIST_FOREACH (p_entnode, p_entlist) {
+    iso9660_stat_t *p_stat = _cdio_list_node_data (p_entnode);
+    if (p_stat->type != _STAT_DIR || !strcmp(p_stat->filename, ".")
+	|| !strcmp(p_stat->filename, ".."))
+      continue;
+    /* We only need the stat data proper, so drop the filename and symlink */
+    p_copy = calloc(1, sizeof(iso9660_stat_t) + 1);
+    len = strlen(psz_path) + strlen(p_stat->filename) + 2;
+    psz_subpath = calloc(1, len);
+    if (!p_copy || !psz_subpath) {
+      cdio_warn("Couldn't allocate deep directory index entry");
+      free(p_copy);
+      free(psz_subpath);
+      b_ret = false;
+      break;
+    }
+    memcpy(p_copy, p_stat, sizeof(iso9660_stat_t));
+    p_copy->rr.psz_symlink = NULL;
+    p_copy->rr.i_symlink = 0;
+    p_copy->rr.i_symlink_max = 0;
+    _cdio_list_append(p_list, p_copy);
+    snprintf(psz_subpath, len, "%s%s/", psz_path, p_stat->filename);
+    b_ret = _iso9660_dd_index_collect(p_iso_dd, psz_subpath, p_list);
+    free(psz_subpath);
+    if (!b_ret)
+      break;
+  }
+
+  iso9660_filelist_free(p_entlist);
+  return b_ret;
+}
+
+/*
+   Build the LSN -> directory index, used to resolve Rock Ridge deep
+   directories. This replaces a search of the whole file system for
+   each CL entry, which makes ISOs with lots of relocated directories
+   (e.g. OPNsense) take minutes to process, with a single traversal.
+ */
+static void
+_iso9660_dd_index_build(iso9660_t *p_iso)
+{
+  CdioList_t *p_list;
+  CdioListNode_t *p_node;
+  iso9660_t *p_iso_dd;
+  uint32_t i, n;
+
+  p_iso->dd_index.b_built = true;
+
+  /* Work with a duplicate with deep directories disabled, so that the
+     relocated directories are listed where they physically reside. */
+  p_iso_dd = calloc(1, sizeof(iso9660_t));
+  p_list = _cdio_list_new();
+  if (!p_iso_dd || !p_list) {
+    cdio_warn("Memory duplication error");
+    goto out;
+  }
+  memcpy(p_iso_dd, p_iso, sizeof(iso9660_t));
+  p_iso_dd->header.u_flags |= CDIO_HEADER_FLAGS_DISABLE_RR_DD;
+  if (!_iso9660_dd_index_collect(p_iso_dd, "/", p_list))
+    goto out;
+
+  n = _cdio_list_length(p_list);
+  for (p_iso->dd_index.u_size = 16; p_iso->dd_index.u_size < 2 * n;
+       p_iso->dd_index.u_size <<= 1);
+  p_iso->dd_index.p_entry = calloc(p_iso->dd_index.u_size, sizeof(dd_index_entry_t));
+  if (!p_iso->dd_index.p_entry) {
+    cdio_warn("Couldn't allocate deep directory index");
+    p_iso->dd_index.u_size = 0;
+    goto out;
+  }
+
+  /* Open addressing with linear probing. Since the table is never more
+     than half full, lookups are O(1). The first entry for an LSN wins. */
+  _CDIO_LIST_FOREACH (p_node, p_list) {
+    iso9660_stat_t *p_stat = _cdio_list_node_data (p_node);
+    i = (p_stat->lsn * 2654435761U) & (p_iso->dd_index.u_size - 1);
+    while (p_iso->dd_index.p_entry[i].p_stat != NULL &&
+	   p_iso->dd_index.p_entry[i].lsn != p_stat->lsn)
+      i = (i + 1) & (p_iso->dd_index.u_size - 1);
+    if (p_iso->dd_index.p_entry[i].p_stat == NULL) {
+      p_iso->dd_index.p_entry[i].lsn = p_stat->lsn;
+      p_iso->dd_index.p_entry[i].p_stat = p_stat;
+    } else {
+      iso9660_stat_free(p_stat);
+    }
+  }
+  /* The table now owns all the list data */
+  _cdio_list_free(p_list, false, NULL);
+  p_list = NULL;
+
+out:
+  if (p_list)
+    _cdio_list_free(p_list, true, (CdioDataFree_t) iso9660_stat_free);
+  free(p_iso_dd);
+}
+
+static void
+_iso9660_dd_index_free(iso9660_t *p_iso)
+{
+  uint32_t i;
+
+  for (i = 0; i < p_iso->dd_index.u_size; i++)
+    iso9660_stat_free(p_iso->dd_index.p_entry[i].p_stat);
+  free(p_iso->dd_index.p_entry);
+  p_iso->dd_index.p_entry = NULL;
+  p_iso->dd_index.u_size = 0;
+  p_iso->dd_index.b_built = false;
+}
+
+/* Look up a directory in the deep directory index */
+static iso9660_stat_t *
+_iso9660_dd_index_find(iso9660_t *p_iso, lsn_t i_lsn, bool *pb_indexed)
+{
+  iso9660_stat_t *p_stat;
+  uint32_t i;
+
+  if (!p_iso->dd_index.b_built)
+    _iso9660_dd_index_build(p_iso);
+  *pb_indexed = (p_iso->dd_index.u_size != 0);
+  if (!*pb_indexed)
+    return NULL;
+
+  i = (i_lsn * 2654435761U) & (p_iso->dd_index.u_size - 1);
+  for (; p_iso->dd_index.p_entry[i].p_stat != NULL;
+       i = (i + 1) & (p_iso->dd_index.u_size - 1)) {
+    if (p_iso->dd_index.p_entry[i].lsn != i_lsn)
+      continue;
+    p_stat = calloc(1, sizeof(iso9660_stat_t) + 1);
+    if (!p_stat) {
+      cdio_warn("Couldn't calloc(1, %d)", (int)sizeof(iso9660_stat_t) + 1);
+      return NULL;
+    }
+    memcpy(p_stat, p_iso->dd_index.p_entry[i].p_stat, sizeof(iso9660_stat_t));
+    return p_stat;
+  }
+  return NULL;
+}
+
 /* Some compilers complain if the prototype is not defined */
 iso9660_stat_t *
 _iso9660_dd_find_lsn(void* p_image, lsn_t i_lsn);
@@ -1963,9 +2150,14 @@ _iso9660_dd_find_lsn(void* p_image, lsn_t i_lsn)
   iso9660_readdir_t* f_readdir;
   iso9660_stat_t* ret;
   size_t size;
+  bool b_indexed;
 
   switch(p_header->u_type) {
   case CDIO_HEADER_TYPE_ISO:
+    /* Use the LSN index, unless it could not be built */
+    ret = _iso9660_dd_index_find((iso9660_t*)p_image, i_lsn, &b_indexed);
+    if (b_indexed)
+      return ret;
     size = sizeof(iso9660_t);
     f_readdir = (iso9660_readdir_t*)iso9660_ifs_readdir;
     break;
@@ -1995,6 +2187,12 @@ _iso9660_dd_find_lsn(void* p_image, lsn_t i_lsn)
   free(p_image_dd);
   return ret;
 }
+#else
+static void
+_iso9660_dd_index_free(iso9660_t *p_iso)
+{
+  free(p_iso->dd_index.p_entry);
+}
 #endif /* HAVE ROCK */
 
 /*!
@@ -1414,6 +1414,46 @@ static __inline BOOL GetVolumeInformationU(LPCSTR lpRootPathName, LPSTR lpVolume
 	return ret;
 }
 
+static __inline BOOL GetVolumePathNameU(LPCSTR lpszFileName, LPSTR lpszVolumePathName, DWORD cchBufferLength)
+{
+	BOOL ret = FALSE;
+	DWORD err = ERROR_INVALID_DATA;
+	wconvert(lpszFileName);
+	// coverity[returned_null]
+	walloc(lpszVolumePathName, cchBufferLength);
+
+	ret = GetVolumePathNameW(wlpszFileName, wlpszVolumePathName, cchBufferLength);
+	err = GetLastError();
+	if ((ret) && (wchar_to_utf8_no_alloc(wlpszVolumePathName, lpszVolumePathName, cchBufferLength) == 0)) {
+		err = GetLastError();
+		ret = FALSE;
+	}
+	wfree(lpszVolumePathName);
+	wfree(lpszFileName);
+	SetLastError(err);
+	return ret;
+}
+
+static __inline BOOL GetVolumeNameForVolumeMountPointU(LPCSTR lpszVolumeMountPoint, LPSTR lpszVolumeName, DWORD cchBufferLength)
+{
+	BOOL ret = FALSE;
+	DWORD err = ERROR_INVALID_DATA;
+	wconvert(lpszVolumeMountPoint);
+	// coverity[returned_null]
+	walloc(lpszVolumeName, cchBufferLength);
+
+	ret = GetVolumeNameForVolumeMountPointW(wlpszVolumeMountPoint, wlpszVolumeName, cchBufferLength);
+	err = GetLastError();
+	if ((ret) && (wchar_to_utf8_no_alloc(wlpszVolumeName, lpszVolumeName, cchBufferLength) == 0)) {
+		err = GetLastError();
+		ret = FALSE;
+	}
+	wfree(lpszVolumeName);
+	wfree(lpszVolumeMountPoint);
+	SetLastError(err);
+	return ret;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -52,6 +52,8 @@
 #include "wue.h"
 #include "drive.h"
 #include "settings.h"
+#include "winio.h"
+#include "badblocks.h"
 #include "bled/bled.h"
 #include "cdio/logging.h"
 #include "../res/grub/grub_version.h"
@@ -91,8 +93,9 @@ static unsigned int timer;
 static char uppercase_select[2][64], uppercase_start[64], uppercase_close[64], uppercase_cancel[64];
 
 extern HANDLE update_check_thread, wim_thread;
-extern BOOL enable_iso, enable_joliet, enable_rockridge, enable_extra_hashes, is_bootloader_revoked;
+extern BOOL enable_iso, enable_joliet, enable_rockridge, enable_parallel_extraction, enable_extra_hashes, is_bootloader_revoked;
 extern BOOL validate_md5sum, cpu_has_sha1_accel, cpu_has_sha256_accel;
+extern uint32_t hash_buffer_size;
 extern BYTE* fido_script;
 extern HWND hFidoDlg;
 extern uint8_t* grub2_buf;
@@ -129,11 +132,11 @@ BOOL usb_debug, use_fake_units, preserve_timestamps = FALSE, fast_zeroing = FALS
 BOOL zero_drive = FALSE, list_non_usb_removable_drives = FALSE, enable_file_indexing, large_drive = FALSE;
 BOOL write_as_image = FALSE, write_as_esp = FALSE, use_vds = FALSE, ignore_boot_marker = FALSE;
 BOOL appstore_version = FALSE, is_vds_available = TRUE, persistent_log = FALSE, has_ffu_support = FALSE;
-BOOL expert_mode = FALSE, use_rufus_mbr = TRUE;
+BOOL expert_mode = FALSE, use_rufus_mbr = TRUE, sparse_write = FALSE, verify_write = FALSE;
 float fScale = 1.0f;
 int dialog_showing = 0, selection_default = BT_IMAGE, persistence_unit_selection = -1, imop_win_sel = 0;
 int default_fs, fs_type, boot_type, partition_type, target_type;
-int force_update = 0, default_thread_priority = THREAD_PRIORITY_ABOVE_NORMAL;
+int force_update = 0, default_thread_priority = THREAD_PRIORITY_ABOVE_NORMAL, dd_queue_depth = DD_QUEUE_DEPTH;
 char szFolderPath[MAX_PATH], app_dir[MAX_PATH], system_dir[MAX_PATH], temp_dir[MAX_PATH], sysnative_dir[MAX_PATH];
 char app_data_dir[MAX_PATH], user_dir[MAX_PATH], cur_dir[MAX_PATH];
 char embedded_sl_version_str[2][12] = { "?.??", "?.??" };
@@ -550,6 +553,8 @@ static BOOL SetFileSystemAndClusterSize(char* fs_name)
 			SelectedDrive.ClusterSize[FS_EXT2].Default = 1;
 			SelectedDrive.ClusterSize[FS_EXT3].Allowed = SINGLE_CLUSTERSIZE_DEFAULT;
 			SelectedDrive.ClusterSize[FS_EXT3].Default = 1;
+			SelectedDrive.ClusterSize[FS_EXT4].Allowed = SINGLE_CLUSTERSIZE_DEFAULT;
+			SelectedDrive.ClusterSize[FS_EXT4].Default = 1;
 		}
 
 		// ReFS (only applicable for a select number of Windows platforms and editions)
@@ -1394,6 +1399,255 @@ out:
 	ExitThread(0);
 }
 
+#if defined(RUFUS_TEST)
+/*
+ * Test cases that can be run from the IDC_TEST button. They are configured
+ * through the following environment variables:
+ * - RUFUS_TEST_DIR: where the scratch files are created (default: temp dir)
+ * - RUFUS_TEST_IMAGE: source image for the cases that need one (default:
+ *   the currently selected image)
+ * - RUFUS_TEST_ARCHIVE: comma separated list of compressed images (.gz, .bz2,
+ *   .xz, .zst, ...) for the decompression benchmark. Use a multi-block .xz,
+ *   such as the ones from 'xz -T0', and a multi-frame .zst, for their
+ *   parallel decoders to be used.
+ * - RUFUS_TEST_SEEKABLE: comma separated list of indexed archives (multi-block
+ *   .xz, seekable .zst or .gz) for the random access test
+ * - RUFUS_TEST_VOLUME: volume (e.g. "\\.\X:") for the cases that need a real
+ *   one. THE CONTENT OF THIS VOLUME IS DESTROYED.
+ * - RUFUS_TEST_SIZE: size of the scratch images, in MB (default: 256)
+ * - RUFUS_TEST_CASES: comma separated list of the cases to run (default: all)
+ * Each case creates and deletes its own files, so that a failing case does
+ * not affect the ones that follow.
+ */
+#define TEST_NEEDS_IMAGE            0x01
+#define TEST_NEEDS_VOLUME           0x02
+#define TEST_NEEDS_ARCHIVE          0x04
+#define TEST_NEEDS_SEEKABLE         0x08
+
+typedef struct {
+	char* dir;
+	char* image;
+	char* archive;
+	char* seekable;
+	char* volume;
+	uint64_t size;
+} rufus_test_config;
+
+typedef struct {
+	const char* name;
+	int needs;
+	BOOL (*run)(const rufus_test_config* cfg);
+} rufus_test;
+
+static BOOL TestIoQueue(const rufus_test_config* cfg)
+{
+	char path[MAX_PATH];
+
+	static_sprintf(path, "%s\\ddbench.img", cfg->dir);
+	return IoQueueBenchmark(cfg->image, path);
+}
+
+static BOOL TestCapture(const rufus_test_config* cfg)
+{
+	BOOL r;
+	char path[MAX_PATH];
+
+	static_sprintf(path, "%s\\capture.img.gz", cfg->dir);
+	r = CaptureImage(cfg->image, path, 512);
+	DeleteFileU(path);
+	return r;
+}
+
+static BOOL TestCaptureFat(const rufus_test_config* cfg)
+{
+	char path[MAX_PATH];
+
+	static_sprintf(path, "%s\\capture_fat.img", cfg->dir);
+	return CaptureImageTest(path, cfg->size);
+}
+
+static BOOL TestInflate(const rufus_test_config* cfg)
+{
+	return InflateTest(cfg->size);
+}
+
+// Run 'test' for each archive of a comma separated list
+static BOOL TestArchiveList(const char* archives, const char* dir, BOOL (*test)(const char*, const char*))
+{
+	BOOL r = TRUE;
+	char *list = safe_strdup(archives), *archive, *next;
+
+	if (list == NULL)
+		return FALSE;
+	for (archive = list; archive != NULL; archive = next) {
+		next = strchr(archive, ',');
+		if (next != NULL)
+			*next++ = 0;
+		if (*archive != 0)
+			r = test(archive, dir) && r;
+	}
+	free(list);
+	return r;
+}
+
+static BOOL TestDecompress(const rufus_test_config* cfg)
+{
+	return TestArchiveList(cfg->archive, cfg->dir, DecompressBenchmark);
+}
+
+static BOOL TestUnzip(const rufus_test_config* cfg)
+{
+	return UnzipBenchmark(cfg->dir, cfg->size);
+}
+
+static BOOL TestSeekable(const rufus_test_config* cfg)
+{
+	return TestArchiveList(cfg->seekable, cfg->dir, SeekableReadTest);
+}
+
+static BOOL TestBadBlocks(const rufus_test_config* cfg)
+{
+	char path[MAX_PATH];
+
+	static_sprintf(path, "%s\\bbtest.img", cfg->dir);
+	return BadBlocksTest(path, cfg->size, 1, 0);
+}
+
+// Several passes over a number of chunks that isn't a multiple of the queue depth
+static BOOL TestBadBlocksPasses(const rufus_test_config* cfg)
+{
+	char path[MAX_PATH];
+
+	static_sprintf(path, "%s\\bbpasses.img", cfg->dir);
+	return BadBlocksTest(path, (7 * BB_BLOCKS_PER_IO + 3) * BADBLOCK_BLOCK_SIZE, BADBLOCK_PATTERN_COUNT, 0);
+}
+
+static BOOL TestClearSystemArea(const rufus_test_config* cfg)
+{
+	char path[MAX_PATH];
+
+	static_sprintf(path, "%s\\fat32bench.img", cfg->dir);
+	return ClearSystemAreaBenchmark(path, cfg->size);
+}
+
+static BOOL TestClearSystemAreaVolume(const rufus_test_config* cfg)
+{
+	return ClearSystemAreaVolumeTest(cfg->volume, cfg->size);
+}
+
+static BOOL TestExtFs(const rufus_test_config* cfg)
+{
+	char path[MAX_PATH];
+
+	static_sprintf(path, "%s\\extbench.img", cfg->dir);
+	return ExtFsBenchmark(path, cfg->size);
+}
+
+static const rufus_test rufus_tests[] = {
+	{ "ioqueue", TEST_NEEDS_IMAGE, TestIoQueue },
+	{ "capture", TEST_NEEDS_IMAGE, TestCapture },
+	{ "capture_fat", 0, TestCaptureFat },
+	{ "inflate", 0, TestInflate },
+	{ "decompress", TEST_NEEDS_ARCHIVE, TestDecompress },
+	{ "unzip", 0, TestUnzip },
+	{ "seekable", TEST_NEEDS_SEEKABLE, TestSeekable },
+	{ "badblocks", 0, TestBadBlocks },
+	{ "badblocks_passes", 0, TestBadBlocksPasses },
+	{ "clearsystemarea", 0, TestClearSystemArea },
+	{ "clearsystemarea_volume", TEST_NEEDS_VOLUME, TestClearSystemAreaVolume },
+	{ "extfs", 0, TestExtFs },
+};
+
+static BOOL IsTestSelected(const char* list, const char* name)
+{
+	size_t len = strlen(name);
+	const char* p;
+
+	if (list == NULL || *list == 0)
+		return TRUE;
+	for (p = list; (p = strstr(p, name)) != NULL; p += len) {
+		if ((p == list || p[-1] == ',') && (p[len] == 0 || p[len] == ','))
+			return TRUE;
+	}
+	return FALSE;
+}
+
+static DWORD WINAPI TestThread(LPVOID param)
+{
+	static volatile LONG running = 0;
+	rufus_test_config cfg = { 0 };
+	char *size_str, *cases;
+	int i, nb_run = 0, nb_failed = 0;
+	BOOL r;
+
+	if (InterlockedExchange(&running, 1) != 0) {
+		uprintf("Tests are already running");
+		ExitThread(0);
+	}
+	cfg.dir = getenvU("RUFUS_TEST_DIR");
+	cfg.image = getenvU("RUFUS_TEST_IMAGE");
+	cfg.archive = getenvU("RUFUS_TEST_ARCHIVE");
+	cfg.seekable = getenvU("RUFUS_TEST_SEEKABLE");
+	cfg.volume = getenvU("RUFUS_TEST_VOLUME");
+	size_str = getenvU("RUFUS_TEST_SIZE");
+	cases = getenvU("RUFUS_TEST_CASES");
+	cfg.size = 256 * MB;
+	if (size_str != NULL && strtoull(size_str, NULL, 0) != 0)
+		cfg.size = strtoull(size_str, NULL, 0) * MB;
+	if (cfg.image == NULL && image_path != NULL)
+		cfg.image = safe_strdup(image_path);
+	if (cfg.dir == NULL) {
+		cfg.dir = safe_strdup(temp_dir);
+		// temp_dir has a trailing backslash
+		if (cfg.dir != NULL && cfg.dir[0] != 0 && cfg.dir[strlen(cfg.dir) - 1] == '\\')
+			cfg.dir[strlen(cfg.dir) - 1] = 0;
+	}
+	if (cfg.dir == NULL)
+		goto out;
+
+	for (i = 0; i < ARRAYSIZE(rufus_tests); i++) {
+		if (!IsTestSelected(cases, rufus_tests[i].name))
+			continue;
+		if ((rufus_tests[i].needs & TEST_NEEDS_IMAGE) && cfg.image == NULL) {
+			uprintf("TEST %s: SKIPPED (no image)", rufus_tests[i].name);
+			continue;
+		}
+		if ((rufus_tests[i].needs & TEST_NEEDS_ARCHIVE) && cfg.archive == NULL) {
+			uprintf("TEST %s: SKIPPED (no archive)", rufus_tests[i].name);
+			continue;
+		}
+		if ((rufus_tests[i].needs & TEST_NEEDS_SEEKABLE) && cfg.seekable == NULL) {
+			uprintf("TEST %s: SKIPPED (no seekable archive)", rufus_tests[i].name);
+			continue;
+		}
+		if ((rufus_tests[i].needs & TEST_NEEDS_VOLUME) && cfg.volume == NULL) {
+			uprintf("TEST %s: SKIPPED (no volume)", rufus_tests[i].name);
+			continue;
+		}
+		uprintf("TEST %s:", rufus_tests[i].name);
+		ErrorStatus = 0;
+		r = rufus_tests[i].run(&cfg);
+		nb_run++;
+		if (!r)
+			nb_failed++;
+		uprintf("TEST %s: %s", rufus_tests[i].name, r ? "PASSED" : "FAILED");
+	}
+	uprintf("%d test(s) run, %d failed", nb_run, nb_failed);
+
+out:
+	ErrorStatus = 0;
+	free(cfg.dir);
+	free(cfg.image);
+	free(cfg.archive);
+	free(cfg.seekable);
+	free(cfg.volume);
+	free(size_str);
+	free(cases);
+	InterlockedExchange(&running, 0);
+	ExitThread(0);
+}
+#endif
+
 #define MAP_BIT(bit) do { map[_log2(bit)] = b; b <<= 1; } while(0)
 
 // Likewise, boot check will block message processing => use a thread
@@ -2108,8 +2362,9 @@ static void InitDialog(HWND hDlg)
 	SendMessage(hProgress, PBM_SETRANGE, 0, (MAX_PROGRESS<<16) & 0xFFFF0000);
 
 	// Fill up the passes
-	for (i = 1; i <= 5; i++) {
-		msg = (i == 1) ? lmprintf(MSG_034, 1) : lmprintf(MSG_035, (i == 2) ? 2 : 4, (i == 2) ? "" : lmprintf(MSG_087, flash_type[i - 3]));
+	for (i = 1; i <= BADBLOCK_FAKE_PROBE + 1; i++) {
+		msg = (i == BADBLOCK_FAKE_PROBE + 1) ? lmprintf(MSG_353) : (i == 1) ? lmprintf(MSG_034, 1) :
+			lmprintf(MSG_035, (i == 2) ? 2 : 4, (i == 2) ? "" : lmprintf(MSG_087, flash_type[i - 3]));
 		IGNORE_RETVAL(ComboBox_AddStringU(hNBPasses, msg));
 	}
 	IGNORE_RETVAL(ComboBox_SetCurSel(hNBPasses, 0));
@@ -2219,6 +2474,8 @@ static INT_PTR CALLBACK MainCallback(HWND hDlg, UINT message, WPARAM wParam, LPA
 	case WM_COMMAND:
 #ifdef RUFUS_TEST
 		if (LOWORD(wParam) == IDC_TEST) {
+			if (CreateThread(NULL, 0, TestThread, NULL, 0, NULL) == NULL)
+				uprintf("Unable to start test thread");
 			break;
 		}
 #endif
@@ -3140,7 +3397,7 @@ static void PrintUsage(char* appname)
 	char fname[_MAX_FNAME];
 
 	_splitpath(appname, NULL, NULL, fname, NULL);
-	printf("\nUsage: %s [-x] [-g] [-h] [-f FILESYSTEM] [-i PATH] [-l LOCALE] [-w TIMEOUT]\n", fname);
+	printf("\nUsage: %s [-x] [-g] [-h] [-f FILESYSTEM] [-i PATH] [-l LOCALE] [-w TIMEOUT] [-H LIST]\n", fname);
 	printf("  -x, --extra-devs\n");
 	printf("     List extra devices, such as USB HDDs\n");
 	printf("  -g, --gui\n");
@@ -3154,6 +3411,9 @@ static void PrintUsage(char* appname)
 	printf("  -w TIMEOUT, --wait=TIMEOUT\n");
 	printf("     Wait TIMEOUT tens of seconds for the global application mutex to be released.\n");
 	printf("     Used when launching a newer version of " APPLICATION_NAME " from a running application.\n");
+	printf("  -H LIST, --hash-list=LIST\n");
+	printf("     Compute the SHA-256 of all the images or devices (\\\\.\\PhysicalDriveN) listed in\n");
+	printf("     the LIST file, one per line, and write them to a 'LIST.sha256' manifest, then exit.\n");
 	printf("  -h, --help\n");
 	printf("     This usage guide.\n");
 }
@@ -3239,7 +3499,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 	BYTE *loc_data;
 	DWORD loc_size, u = 0, size = sizeof(u);
 	char tmp_path[MAX_PATH] = "", loc_file[MAX_PATH] = "", ini_path[MAX_PATH] = "", ini_flags[] = "rb";
-	char *tmp, *locale_name = NULL, **argv = NULL;
+	char *tmp, *locale_name = NULL, *hash_list = NULL, **argv = NULL;
 	wchar_t **wenv, **wargv;
 	PF_TYPE_DECL(CDECL, int, __wgetmainargs, (int*, wchar_t***, wchar_t***, int, int*));
 	HANDLE mutex = NULL, hogmutex = NULL, hFile = NULL;
@@ -3250,6 +3510,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 		{"extra-devs", no_argument,       NULL, 'x'},
 		{"gui",        no_argument,       NULL, 'g'},
 		{"help",       no_argument,       NULL, 'h'},
+		{"hash-list",  required_argument, NULL, 'H'},
 		{"iso",        required_argument, NULL, 'i'},
 		{"locale",     required_argument, NULL, 'l'},
 		{"filesystem", required_argument, NULL, 'f'},
@@ -3429,7 +3690,7 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 				}
 			}
 
-			while ((opt = getopt_long(argc, argv, "ghxf:i:l:w:z:", long_options, &option_index)) != EOF) {
+			while ((opt = getopt_long(argc, argv, "ghxf:i:l:w:z:H:", long_options, &option_index)) != EOF) {
 				switch (opt) {
 				case 'x':
 					enable_HDDs = TRUE;
@@ -3479,6 +3740,13 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 				case 'w':
 					wait_for_mutex = atoi(optarg);
 					break;
+				case 'H':
+					safe_free(hash_list);
+					hash_list = calloc(1, MAX_PATH);
+					if (hash_list == NULL)
+						break;
+					IGNORE_RETVAL(GetFullPathNameU(optarg, MAX_PATH, hash_list, NULL));
+					break;
 				case 'h':
 					PrintUsage(argv[0]);
 					goto out;
@@ -3543,6 +3811,9 @@ skip_args_processing:
 	force_large_fat32 = ReadSettingBool(SETTING_FORCE_LARGE_FAT32_FORMAT);
 	enable_vmdk = ReadSettingBool(SETTING_ENABLE_VMDK_DETECTION);
 	enable_file_indexing = ReadSettingBool(SETTING_ENABLE_FILE_INDEXING);
+	sparse_write = ReadSettingBool(SETTING_ENABLE_SPARSE_WRITE);
+	verify_write = ReadSettingBool(SETTING_ENABLE_WRITE_VERIFY);
+	enable_parallel_extraction = !ReadSettingBool(SETTING_DISABLE_PARALLEL_EXTRACTION);
 	enable_VHDs = !ReadSettingBool(SETTING_DISABLE_VHDS);
 	enable_extra_hashes = ReadSettingBool(SETTING_ENABLE_EXTRA_HASHES);
 	expert_mode = ReadSettingBool(SETTING_EXPERT_MODE);
@@ -3559,6 +3830,14 @@ skip_args_processing:
 	}
 	// We want above normal priority by default, so we offset the value.
 	default_thread_priority = ReadSetting32(SETTING_DEFAULT_THREAD_PRIORITY) + THREAD_PRIORITY_ABOVE_NORMAL;
+	// Number of concurrent I/O requests to use when writing DD images
+	dd_queue_depth = ReadSetting32(SETTING_DD_QUEUE_DEPTH);
+	if ((dd_queue_depth <= 0) || (dd_queue_depth > IOQ_MAX_DEPTH))
+		dd_queue_depth = DD_QUEUE_DEPTH;
+	// Size of the blocks used when computing image hashes, in KB
+	hash_buffer_size = ReadSetting32(SETTING_HASH_BUFFER_SIZE) * KB;
+	if (hash_buffer_size == 0)
+		hash_buffer_size = HASH_BUFFER_SIZE;
 
 	// Initialize the global scaling, in case we need it before we initialize the dialog
 	hDC = GetDC(NULL);
@@ -3690,6 +3969,12 @@ skip_args_processing:
 	// Detect CPU acceleration for SHA-1/SHA-256
 	cpu_has_sha1_accel = DetectSHA1Acceleration();
 	cpu_has_sha256_accel = DetectSHA256Acceleration();
+
+	// Batch hashing is a commandline only operation
+	if (hash_list != NULL) {
+		BatchHash(hash_list);
+		goto out;
+	}
 	// FFU support started with Windows 10 1709 (through FfuProvider.dll)
 	static_sprintf(tmp_path, "%s\\dism\\FfuProvider.dll", sysnative_dir);
 	has_ffu_support = (_accessU(tmp_path, 0) == 0);
@@ -4142,6 +4427,7 @@ out:
 	safe_free(image_path);
 	safe_free(archive_path);
 	safe_free(locale_name);
+	safe_free(hash_list);
 	safe_free(update.download_url);
 	safe_free(update.release_notes);
 	safe_free(grub2_buf);
@@ -102,6 +102,7 @@
 #define FS_DEFAULT                  FS_FAT32
 #define SINGLE_CLUSTERSIZE_DEFAULT  0x00000100
 #define BADLOCKS_PATTERN_TYPES      5
+#define BADBLOCK_FAKE_PROBE         BADLOCKS_PATTERN_TYPES	// Index of the fake capacity probe in the passes dropdown
 #define BADBLOCK_PATTERN_COUNT      4
 #define BADBLOCK_PATTERN_ONE_PASS   {0x55, 0x00, 0x00, 0x00}
 #define BADBLOCK_PATTERN_TWO_PASSES {0x55, 0xaa, 0x00, 0x00}
@@ -115,8 +116,16 @@
 #define MAX_FAT32_SIZE              (2 * TB)	// Threshold above which we disable FAT32 formatting
 #define FAT32_CLUSTER_THRESHOLD     1.011f		// For FAT32, cluster size changes don't occur at power of 2 boundaries but slightly above
 #define DD_BUFFER_SIZE              (32 * MB)	// Minimum size of buffer to use for DD operations
+#define DD_QUEUE_DEPTH              4			// Default number of concurrent I/O requests for DD operations
+#define HASH_BUFFER_SIZE            (1 * MB)	// Default size of the blocks used when computing image hashes
 #define UBUFFER_SIZE                4096
 #define ISO_BUFFER_SIZE             (64 * KB)	// Buffer size used for ISO data extraction
+#define ISO_EXTRACT_BUFFER_SIZE     (1 * MB)	// Size of the blocks read from the ISO for parallel extraction
+#define ISO_EXTRACT_NB_BUFFERS      16			// Number of blocks that can be in flight for parallel extraction
+#define ISO_WRITER_THREADS          4			// Number of threads writing the extracted ISO files
+#define ISO_WRITER_QUEUE_SIZE       64			// Number of pending data chunks each ISO writer thread can hold
+#define ISO_EXTRACT_MAX_GAP         (64 * KB)	// Largest gap between ISO files that we read through rather than seek over
+#define ISO_MAX_CACHED_SYMLINKS     4096		// Maximum number of resolved Rock Ridge symlink targets we keep
 #define RSA_SIGNATURE_SIZE          256
 #define CBN_SELCHANGE_INTERNAL      (CBN_SELCHANGE + 256)
 #if defined(RUFUS_TEST)
@@ -556,6 +565,7 @@ typedef void hash_final_t(HASH_CONTEXT* ctx);
 extern hash_init_t* hash_init[HASH_MAX];
 extern hash_write_t* hash_write[HASH_MAX];
 extern hash_final_t* hash_final[HASH_MAX];
+extern uint32_t hash_count[HASH_MAX];
 
 #ifndef __VA_GROUP__
 #define __VA_GROUP__(...)  __VA_ARGS__
@@ -836,6 +846,7 @@ extern BOOL SetThreadAffinity(DWORD_PTR* thread_affinity, size_t num_threads);
 extern BOOL DetectSHA1Acceleration(void);
 extern BOOL DetectSHA256Acceleration(void);
 extern BOOL HashFile(const unsigned type, const char* path, uint8_t* sum);
+extern int BatchHash(const char* list_path);
 extern BOOL PE256Buffer(uint8_t* buf, uint32_t len, uint8_t* hash);
 extern void UpdateMD5Sum(const char* dest_dir, const char* md5sum_name);
 extern BOOL HashBuffer(const unsigned type, const uint8_t* buf, const size_t len, uint8_t* sum);
@@ -32,20 +32,25 @@ extern char* ini_file;
 #define SETTING_ADVANCED_MODE_DEVICE        "ShowAdvancedDriveProperties"
 #define SETTING_ADVANCED_MODE_FORMAT        "ShowAdvancedFormatOptions"
 #define SETTING_COMM_CHECK                  "CommCheck64"
+#define SETTING_DD_QUEUE_DEPTH              "DdQueueDepth"
 #define SETTING_DEFAULT_THREAD_PRIORITY     "DefaultThreadPriority"
 #define SETTING_DISABLE_FAKE_DRIVES_CHECK   "DisableFakeDrivesCheck"
 #define SETTING_DISABLE_LGP                 "DisableLGP"
+#define SETTING_DISABLE_PARALLEL_EXTRACTION "DisableParallelExtraction"
 #define SETTING_DISABLE_RUFUS_MBR           "DisableRufusMBR"
 #define SETTING_DISABLE_SECURE_BOOT_NOTICE  "DisableSecureBootNotice"
 #define SETTING_DISABLE_VHDS                "DisableVHDs"
 #define SETTING_ENABLE_EXTRA_HASHES         "EnableExtraHashes"
 #define SETTING_ENABLE_FILE_INDEXING        "EnableFileIndexing"
 #define SETTING_ENABLE_RUNTIME_VALIDATION   "EnableRuntimeValidation"
+#define SETTING_ENABLE_SPARSE_WRITE         "EnableSparseWrite"
 #define SETTING_ENABLE_USB_DEBUG            "EnableUsbDebug"
 #define SETTING_ENABLE_VMDK_DETECTION       "EnableVmdkDetection"
+#define SETTING_ENABLE_WRITE_VERIFY         "EnableWriteVerify"
 #define SETTING_ENABLE_WIN_DUAL_EFI_BIOS    "EnableWindowsDualUefiBiosMode"
 #define SETTING_EXPERT_MODE                 "ExpertMode"
 #define SETTING_FORCE_LARGE_FAT32_FORMAT    "ForceLargeFat32Formatting"
+#define SETTING_HASH_BUFFER_SIZE            "HashBufferSize"
 #define SETTING_IGNORE_BOOT_MARKER          "IgnoreBootMarker"
 #define SETTING_INCLUDE_BETAS               "CheckForBetas"
 #define SETTING_LAST_UPDATE                 "LastUpdateCheck"
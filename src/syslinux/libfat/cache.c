@@ -13,13 +13,68 @@
 /*
  * cache.c
  *
- * Simple sector cache
+ * Sector cache, with hashed lookups and LRU eviction
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <malloc.h>
 #include "libfatint.h"
 
+static inline struct libfat_sector **
+libfat_bucket(struct libfat_filesystem *fs, libfat_sector_t n)
+{
+    return &fs->sectors[n & (LIBFAT_HASH_SIZE - 1)];
+}
+
+static struct libfat_sector *
+libfat_lookup(struct libfat_filesystem *fs, libfat_sector_t n)
+{
+    struct libfat_sector *ls;
+
+    for (ls = *libfat_bucket(fs, n); ls; ls = ls->next) {
+	if (ls->n == n)
+	    return ls;
+    }
+    return NULL;
+}
+
+static void lru_unlink(struct libfat_filesystem *fs, struct libfat_sector *ls)
+{
+    if (ls->prev_lru)
+	ls->prev_lru->next_lru = ls->next_lru;
+    else
+	fs->lru_head = ls->next_lru;
+    if (ls->next_lru)
+	ls->next_lru->prev_lru = ls->prev_lru;
+    else
+	fs->lru_tail = ls->prev_lru;
+}
+
+static void lru_push(struct libfat_filesystem *fs, struct libfat_sector *ls)
+{
+    ls->prev_lru = NULL;
+    ls->next_lru = fs->lru_head;
+    if (fs->lru_head)
+	fs->lru_head->prev_lru = ls;
+    else
+	fs->lru_tail = ls;
+    fs->lru_head = ls;
+}
+
+static void libfat_evict(struct libfat_filesystem *fs)
+{
+    struct libfat_sector *ls = fs->lru_tail, **lsp;
+
+    if (!ls)
+	return;
+    lru_unlink(fs, ls);
+    for (lsp = libfat_bucket(fs, ls->n); *lsp != ls; lsp = &(*lsp)->next);
+    *lsp = ls->next;
+    _mm_free(ls);
+    fs->nsectors--;
+}
+
 /*
  * NB: We need to align our sector buffers to at least the 8-byte mark, as some Windows
  * disk devices, notably O2Micro PCI-E SD card readers, return ERROR_INVALID_PARAMETER
@@ -28,16 +83,14 @@
  * Also, since struct libfat_sector's data[0] is our buffer, this means we must BOTH
  * align that member in the struct declaration, and use aligned malloc/free.
  */
-void *libfat_get_sector(struct libfat_filesystem *fs, libfat_sector_t n)
+static struct libfat_sector *
+libfat_insert(struct libfat_filesystem *fs, libfat_sector_t n, const void *data)
 {
-    struct libfat_sector *ls;
+    struct libfat_sector *ls, **bucket;
 
-    for (ls = fs->sectors; ls; ls = ls->next) {
-	if (ls->n == n)
-	    return ls->data;	/* Found in cache */
-    }
+    while (fs->nsectors >= fs->maxsectors && fs->lru_tail)
+	libfat_evict(fs);
 
-    /* Not found in cache */
     ls = _mm_malloc(sizeof(struct libfat_sector) + LIBFAT_SECTOR_SIZE, 16);
     if (!ls) {
 	libfat_flush(fs);
@@ -47,28 +100,83 @@ void *libfat_get_sector(struct libfat_filesystem *fs, libfat_sector_t n)
 	    return NULL;	/* Can't allocate memory */
     }
 
-    if (fs->read(fs->readptr, ls->data, LIBFAT_SECTOR_SIZE, n)
-	!= LIBFAT_SECTOR_SIZE) {
-	_mm_free(ls);
-	return NULL;		/* I/O error */
-    }
-
+    memcpy(ls->data, data, LIBFAT_SECTOR_SIZE);
     ls->n = n;
-    ls->next = fs->sectors;
-    fs->sectors = ls;
+    bucket = libfat_bucket(fs, n);
+    ls->next = *bucket;
+    *bucket = ls;
+    lru_push(fs, ls);
+    fs->nsectors++;
 
-    return ls->data;
+    return ls;
 }
 
-void libfat_flush(struct libfat_filesystem *fs)
+void *libfat_get_sector(struct libfat_filesystem *fs, libfat_sector_t n)
 {
-    struct libfat_sector *ls, *lsnext;
+    struct libfat_sector *ls;
+    unsigned int i, count, max_count;
+    char *buf;
 
-    lsnext = fs->sectors;
-    fs->sectors = NULL;
+    ls = libfat_lookup(fs, n);
+    if (ls) {
+	/* Found in cache */
+	lru_unlink(fs, ls);
+	lru_push(fs, ls);
+	return ls->data;
+    }
 
-    for (ls = lsnext; ls; ls = lsnext) {
-	lsnext = ls->next;
-	_mm_free(ls);
+    /*
+     * Not found in cache. Read it, along with the uncached sectors that
+     * immediately follow, as FAT chains and directories tend to be walked
+     * in sequence. We never read ahead more than the cache can hold, so
+     * that the requested sector doesn't get evicted by its followers.
+     */
+    max_count = LIBFAT_READAHEAD;
+    if (max_count > fs->maxsectors)
+	max_count = fs->maxsectors;
+    if (n >= fs->end)
+	max_count = 1;
+    else if (fs->end - n < max_count)
+	max_count = (unsigned int)(fs->end - n);
+    for (count = 1; count < max_count && !libfat_lookup(fs, n + count); count++);
+
+    buf = _mm_malloc((size_t)count * LIBFAT_SECTOR_SIZE, 16);
+    if (!buf && count > 1) {
+	count = 1;
+	buf = _mm_malloc(LIBFAT_SECTOR_SIZE, 16);
     }
+    if (!buf)
+	return NULL;		/* Can't allocate memory */
+
+    if (fs->read(fs->readptr, buf, (size_t)count * LIBFAT_SECTOR_SIZE, n)
+	!= (int)(count * LIBFAT_SECTOR_SIZE)) {
+	/* Read-ahead may have gone into bad sectors - retry with just one */
+	if (count == 1 ||
+	    fs->read(fs->readptr, buf, LIBFAT_SECTOR_SIZE, n) != (int)LIBFAT_SECTOR_SIZE) {
+	    _mm_free(buf);
+	    return NULL;	/* I/O error */
+	}
+	count = 1;
+    }
+
+    /* Insert the requested sector last, so that it is the most recently used */
+    for (i = count - 1; i > 0; i--)
+	libfat_insert(fs, n + i, &buf[(size_t)i * LIBFAT_SECTOR_SIZE]);
+    ls = libfat_insert(fs, n, buf);
+    _mm_free(buf);
+
+    return ls ? ls->data : NULL;
+}
+
+void libfat_set_cache_size(struct libfat_filesystem *fs, unsigned int nsectors)
+{
+    fs->maxsectors = (nsectors == 0) ? 1 : nsectors;
+    while (fs->nsectors > fs->maxsectors)
+	libfat_evict(fs);
+}
+
+void libfat_flush(struct libfat_filesystem *fs)
+{
+    while (fs->lru_tail)
+	libfat_evict(fs);
 }
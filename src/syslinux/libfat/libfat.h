@@ -33,6 +33,10 @@ extern uint32_t LIBFAT_SECTOR_MASK;
 typedef uint64_t libfat_sector_t;
 struct libfat_filesystem;
 
+/* Default number of sectors kept in the cache, and maximum read-ahead */
+#define LIBFAT_CACHE_SECTORS	1024
+#define LIBFAT_READAHEAD	16
+
 struct libfat_direntry {
     libfat_sector_t sector;
     int offset;
@@ -54,12 +58,13 @@ typedef struct libfat_diritem {
 /*
  * Open the filesystem.  The readfunc is the function to read
  * sectors, in the format:
- * int readfunc(intptr_t readptr, void *buf, size_t secsize,
+ * int readfunc(intptr_t readptr, void *buf, size_t size,
  *              libfat_sector_t secno)
  *
- * ... where readptr is a private argument.
+ * ... where readptr is a private argument, and size is a multiple
+ * of LIBFAT_SECTOR_SIZE, as multiple sectors may be read at once.
  *
- * A return value of != secsize is treated as error.
+ * A return value of != size is treated as error.
  */
 struct libfat_filesystem
     *libfat_open(int (*readfunc) (intptr_t, void *, size_t, libfat_sector_t),
@@ -87,7 +92,13 @@ libfat_sector_t libfat_nextsector(struct libfat_filesystem *fs,
 void libfat_flush(struct libfat_filesystem *fs);
 
 /*
- * Get a pointer to a specific sector.
+ * Set the maximum number of sectors kept in the cache.
+ */
+void libfat_set_cache_size(struct libfat_filesystem *fs, unsigned int nsectors);
+
+/*
+ * Get a pointer to a specific sector.  The pointer is only valid
+ * until the next call into libfat, as the sector may then be evicted.
  */
 void *libfat_get_sector(struct libfat_filesystem *fs, libfat_sector_t n);
 
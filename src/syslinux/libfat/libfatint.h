@@ -32,11 +32,15 @@
 
 ALIGN_START(16) struct libfat_sector {
 	libfat_sector_t n;		/* Sector number */
-	struct libfat_sector *next;	/* Next in list */
+	struct libfat_sector *next;	/* Next in hash bucket */
+	struct libfat_sector *prev_lru;	/* More recently used */
+	struct libfat_sector *next_lru;	/* Less recently used */
 	/* data[0] MUST be aligned to at least 8 bytes - see cache.c */
 	ALIGN_START(16) char data[0] ALIGN_END(16);
 } ALIGN_END(16);
 
+#define LIBFAT_HASH_SIZE	256	/* Sector cache buckets, must be a power of 2 */
+
 enum fat_type {
     FAT12,
     FAT16,
@@ -58,7 +62,11 @@ struct libfat_filesystem {
     libfat_sector_t data;	/* Start of data area */
     libfat_sector_t end;	/* End of filesystem */
 
-    struct libfat_sector *sectors;
+    struct libfat_sector *sectors[LIBFAT_HASH_SIZE];
+    struct libfat_sector *lru_head;	/* Most recently used sector */
+    struct libfat_sector *lru_tail;	/* Least recently used sector */
+    unsigned int nsectors;		/* Number of cached sectors */
+    unsigned int maxsectors;		/* Cache capacity, in sectors */
 };
 
 #endif /* LIBFATINT_H */
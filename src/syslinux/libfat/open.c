@@ -18,6 +18,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include "libfatint.h"
 #include "ulint.h"
 
@@ -35,7 +36,11 @@ libfat_open(int (*readfunc) (intptr_t, void *, size_t, libfat_sector_t),
     if (!fs)
 	goto barf;
 
-    fs->sectors = NULL;
+    memset(fs->sectors, 0, sizeof(fs->sectors));
+    fs->lru_head = fs->lru_tail = NULL;
+    fs->nsectors = 0;
+    fs->maxsectors = LIBFAT_CACHE_SECTORS;
+    fs->end = 0;		/* Don't read ahead until we know the fs size */
     fs->read = readfunc;
     fs->readptr = readptr;
 
@@ -218,8 +218,9 @@ void GetHalfDropwdownWidth(HWND hDlg)
 		hw = max(hw, GetTextSize(GetDlgItem(hDlg, IDC_TARGET_SYSTEM), lmprintf(msg_id)).cx);
 
 	// Just in case, we also do the number of passes
-	for (i = 1; i <= 5; i++) {
-		char* msg = (i == 1) ? lmprintf(MSG_034, 1) : lmprintf(MSG_035, (i == 2) ? 2 : 4, (i == 2) ? "" : lmprintf(MSG_087, flash_type[i - 3]));
+	for (i = 1; i <= BADBLOCK_FAKE_PROBE + 1; i++) {
+		char* msg = (i == BADBLOCK_FAKE_PROBE + 1) ? lmprintf(MSG_353) : (i == 1) ? lmprintf(MSG_034, 1) :
+			lmprintf(MSG_035, (i == 2) ? 2 : 4, (i == 2) ? "" : lmprintf(MSG_087, flash_type[i - 3]));
 		hw = max(hw, GetTextSize(GetDlgItem(hDlg, IDC_TARGET_SYSTEM), msg).cx);
 	}
 
@@ -1558,6 +1559,10 @@ void SetPassesTooltip(void)
 	{ BADBLOCK_PATTERN_ONE_PASS, BADBLOCK_PATTERN_TWO_PASSES, BADBLOCK_PATTERN_SLC,
 	  BADCLOCK_PATTERN_MLC, BADBLOCK_PATTERN_TLC };
 	int sel = ComboBox_GetCurSel(hNBPasses);
+	if (sel == BADBLOCK_FAKE_PROBE) {
+		CreateTooltip(hNBPasses, lmprintf(MSG_354), -1);
+		return;
+	}
 	CreateTooltip(hNBPasses, lmprintf(MSG_153 + ((sel >= 2) ? 3 : sel),
 		pattern[sel][0], pattern[sel][1], pattern[sel][2], pattern[sel][3]), -1);
 }
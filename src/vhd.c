@@ -118,7 +118,8 @@ static int8_t IsCompressedBootableImage(const char* path)
 	int i;
 	FILE* fd = NULL;
 	BOOL r = 0;
-	int64_t dc = 0;
+	int64_t dc = 0, size;
+	bled_seekable_t* s;
 
 	img_report.compression_type = BLED_COMPRESSION_NONE;
 	if (safe_strlen(path) > 4)
@@ -133,7 +134,16 @@ static int8_t IsCompressedBootableImage(const char* path)
 			ErrorStatus = 0;
 			if (img_report.compression_type < BLED_COMPRESSION_MAX) {
 				bled_init(0, uprintf, NULL, NULL, NULL, NULL, &ErrorStatus);
-				dc = bled_uncompress_to_buffer(path, (char*)buf, MBR_SIZE, file_assoc[i].type);
+				// Use random access, so that the indexes of .xz and seekable .zst images get
+				// parsed, which gives us their uncompressed size without decompressing them.
+				s = bled_seekable_open(path, file_assoc[i].type, 0);
+				if (s != NULL) {
+					size = bled_seekable_size(s);
+					if (size >= 0)
+						uprintf("  Uncompressed size: %s", SizeToHumanReadable(size, FALSE, FALSE));
+					dc = bled_seekable_read(s, 0, (char*)buf, MBR_SIZE);
+					bled_seekable_close(s);
+				}
 				bled_exit();
 			} else if (img_report.compression_type == BLED_COMPRESSION_MAX) {
 				// Dism, through FfuProvider.dll, can mount a .ffu as a physicaldrive, which we
@@ -1108,6 +1118,25 @@ static DWORD WINAPI FfuSaveImageThread(void* param)
 	ExitThread(r);
 }
 
+// Native capture to a gzip compressed DD image, which skips the unallocated
+// parts of the file systems we know about, and that we can write back ourselves.
+static DWORD WINAPI DdSaveImageThread(void* param)
+{
+	DWORD r = 0;
+	IMG_SAVE* img_save = (IMG_SAVE*)param;
+
+	UpdateProgressWithInfoInit(NULL, FALSE);
+	if (!CaptureImage(img_save->DevicePath, img_save->ImagePath, SelectedDrive.SectorSize)) {
+		if (!IS_ERROR(ErrorStatus))
+			ErrorStatus = RUFUS_ERROR(ERROR_GEN_FAILURE);
+		r = SCODE_CODE(ErrorStatus);
+	}
+	safe_free(img_save->DevicePath);
+	safe_free(img_save->ImagePath);
+	PostMessage(hMainDialog, UM_FORMAT_COMPLETED, (WPARAM)TRUE, 0);
+	ExitThread(r);
+}
+
 void VhdSaveImage(void)
 {
 	UINT i;
@@ -1115,9 +1144,9 @@ void VhdSaveImage(void)
 	char filename[128];
 	char path[MAX_PATH];
 	int DriveIndex = ComboBox_GetCurSel(hDeviceList);
-	enum { image_type_vhd = 1, image_type_vhdx = 2, image_type_ffu = 3 };
-	static EXT_DECL(img_ext, filename, __VA_GROUP__("*.vhd", "*.vhdx", "*.ffu"),
-		__VA_GROUP__(lmprintf(MSG_343), lmprintf(MSG_342), lmprintf(MSG_344)));
+	enum { image_type_vhd = 1, image_type_vhdx = 2, image_type_img_gz = 3, image_type_ffu = 4 };
+	static EXT_DECL(img_ext, filename, __VA_GROUP__("*.vhd", "*.vhdx", "*.img.gz", "*.ffu"),
+		__VA_GROUP__(lmprintf(MSG_343), lmprintf(MSG_342), lmprintf(MSG_358), lmprintf(MSG_344)));
 	ULARGE_INTEGER free_space;
 
 	memset(&img_save, 0, sizeof(IMG_SAVE));
@@ -1128,7 +1157,7 @@ void VhdSaveImage(void)
 	img_save.DeviceNum = (DWORD)ComboBox_GetItemData(hDeviceList, DriveIndex);
 	img_save.DevicePath = GetPhysicalName(img_save.DeviceNum);
 	// FFU support requires GPT
-	img_ext.count = (!has_ffu_support || SelectedDrive.PartitionStyle != PARTITION_STYLE_GPT) ? 2 : 3;
+	img_ext.count = (!has_ffu_support || SelectedDrive.PartitionStyle != PARTITION_STYLE_GPT) ? 3 : 4;
 	for (i = 1; i <= (UINT)img_ext.count && (safe_strcmp(save_image_type , &_img_ext_x[i - 1][2]) != 0); i++);
 	if (i > (UINT)img_ext.count)
 		i = image_type_vhdx;
@@ -1148,6 +1177,9 @@ void VhdSaveImage(void)
 	case image_type_vhd:
 		img_save.Type = VIRTUAL_STORAGE_TYPE_DEVICE_VHD;
 		break;
+	case image_type_img_gz:
+		img_save.Type = VIRTUAL_STORAGE_TYPE_DEVICE_IMG_GZ;
+		break;
 	case image_type_ffu:
 		img_save.Type = VIRTUAL_STORAGE_TYPE_DEVICE_FFU;
 		break;
@@ -1176,8 +1208,9 @@ void VhdSaveImage(void)
 		EnableControls(FALSE, FALSE);
 		ErrorStatus = 0;
 		InitProgress(TRUE);
-		format_thread = CreateThread(NULL, 0, img_save.Type == VIRTUAL_STORAGE_TYPE_DEVICE_FFU ?
-			FfuSaveImageThread : VhdSaveImageThread, &img_save, 0, NULL);
+		format_thread = CreateThread(NULL, 0, img_save.Type == VIRTUAL_STORAGE_TYPE_DEVICE_FFU ? FfuSaveImageThread :
+			(img_save.Type == VIRTUAL_STORAGE_TYPE_DEVICE_IMG_GZ ? DdSaveImageThread : VhdSaveImageThread),
+			&img_save, 0, NULL);
 		if (format_thread != NULL) {
 			uprintf("\r\nSave to VHD operation started");
 			PrintInfo(0, -1);
@@ -1194,3 +1227,513 @@ out:
 		safe_free(img_save.ImagePath);
 	}
 }
+
+#if defined(RUFUS_TEST)
+#include "inflate_corpus.h"
+
+static __inline uint32_t inflate_test_rand(uint32_t* seed)
+{
+	*seed = *seed * 1103515245 + 12345;
+	return *seed >> 16;
+}
+
+// Produce the uncompressed data of an inflate_tests[] entry
+static void inflate_test_data(uint8_t* buf, size_t size, uint32_t seed)
+{
+	static const char* words[] = { "rufus", "usb", "boot", "image", "partition", "sector",
+		"cluster", "volume", "\r\n", "\x7f" "ELF", "\xff\xfe", "drive" };
+	const char* w;
+	size_t pos = 0, dist, len;
+	uint32_t k;
+
+	if (seed == 0) {
+		memset(buf, 0, size);
+		return;
+	}
+	while (pos < size) {
+		k = inflate_test_rand(&seed) % 8;
+		if ((k < 2) && (pos > 0)) {
+			dist = 1 + inflate_test_rand(&seed) % min(pos, 32768);
+			len = 3 + inflate_test_rand(&seed) % 256;
+			for (; (len > 0) && (pos < size); len--, pos++)
+				buf[pos] = buf[pos - dist];
+		} else if (k < 5) {
+			buf[pos++] = 0x40 + inflate_test_rand(&seed) % 16;
+		} else {
+			for (w = words[inflate_test_rand(&seed) % ARRAYSIZE(words)]; (*w != 0) && (pos < size); w++)
+				buf[pos++] = *w;
+		}
+	}
+}
+
+/*
+ * Decode the golden gzip corpus and compare the output with the data it was created
+ * from, check that a truncated stream is rejected, and then report the throughput of
+ * the decoder on the larger entries, over 'size' bytes of output each.
+ */
+BOOL InflateTest(uint64_t size)
+{
+	BOOL r, ret = TRUE;
+	char *ref = NULL, *buf = NULL;
+	int i;
+	int64_t len;
+	uint64_t total, start, elapsed;
+	const inflate_test_case* t;
+
+	bled_init(0, uprintf, NULL, NULL, NULL, NULL, &ErrorStatus);
+	for (i = 0; i < ARRAYSIZE(inflate_tests); i++) {
+		t = &inflate_tests[i];
+		ref = malloc(t->size + 1);
+		buf = malloc(t->size + 1);
+		if ((ref == NULL) || (buf == NULL)) {
+			ret = FALSE;
+			break;
+		}
+		inflate_test_data((uint8_t*)ref, t->size, t->seed);
+		len = bled_uncompress_from_buffer_to_buffer((const char*)t->data, t->len, buf, t->size + 1, BLED_COMPRESSION_GZIP);
+		r = (len == t->size) && (memcmp(buf, ref, t->size) == 0);
+		// Losing the last byte of the trailer must be reported as an error
+		if (r)
+			r = (bled_uncompress_from_buffer_to_buffer((const char*)t->data, t->len - 1, buf, t->size + 1, BLED_COMPRESSION_GZIP) < 0);
+		if (r && (t->size >= 16000)) {
+			start = GetTickCount64();
+			for (total = 0; r && (total < size); total += t->size)
+				r = (bled_uncompress_from_buffer_to_buffer((const char*)t->data, t->len, buf, t->size + 1, BLED_COMPRESSION_GZIP) == t->size);
+			elapsed = max(GetTickCount64() - start, 1);
+			uprintf("Inflate %s: %s (%0.1f MB/s)", t->name, r ? "OK" : "FAILED", (1000.0f * total) / (1.0f * MB * elapsed));
+		} else {
+			uprintf("Inflate %s: %s", t->name, r ? "OK" : "FAILED");
+		}
+		ret = ret && r;
+		safe_free(ref);
+		safe_free(buf);
+	}
+	safe_free(ref);
+	safe_free(buf);
+	bled_exit();
+	return ret;
+}
+
+static BOOL compare_files(const char* path1, const char* path2)
+{
+	BOOL r = FALSE;
+	FILE *fd1 = fopenU(path1, "rb"), *fd2 = fopenU(path2, "rb");
+	char *buf1 = malloc(MB), *buf2 = malloc(MB);
+	size_t n1, n2;
+
+	if ((fd1 == NULL) || (fd2 == NULL) || (buf1 == NULL) || (buf2 == NULL))
+		goto out;
+	do {
+		n1 = fread(buf1, 1, MB, fd1);
+		n2 = fread(buf2, 1, MB, fd2);
+		r = (n1 == n2) && (memcmp(buf1, buf2, n1) == 0);
+	} while (r && (n1 == MB));
+
+out:
+	if (fd1 != NULL)
+		fclose(fd1);
+	if (fd2 != NULL)
+		fclose(fd2);
+	free(buf1);
+	free(buf2);
+	return r;
+}
+
+static int get_compression_type(const char* path)
+{
+	const char* ext = NULL;
+	int i, type = BLED_COMPRESSION_NONE;
+
+	if (safe_strlen(path) > 4)
+		for (ext = &path[safe_strlen(path) - 1]; (*ext != '.') && (ext != path); ext--);
+	for (i = 0; i < ARRAYSIZE(file_assoc); i++) {
+		if (safe_stricmp(ext, file_assoc[i].ext) == 0)
+			type = file_assoc[i].type;
+	}
+	return type;
+}
+
+/*
+ * Decompress 'image' into 'dir', first with the sequential decoders only and then
+ * with one thread per CPU, check that both outputs are the same and report the speedup.
+ */
+BOOL DecompressBenchmark(const char* image, const char* dir)
+{
+	char path[2][MAX_PATH];
+	BOOL ret = FALSE;
+	int pass, type;
+	int64_t size[2] = { -1, -1 };
+	uint64_t start, elapsed[2];
+	SYSTEM_INFO si;
+
+	type = get_compression_type(image);
+	// .zip archives are extracted to a directory, rather than to a single file
+	if ((type == BLED_COMPRESSION_NONE) || (type == BLED_COMPRESSION_ZIP) || (type >= BLED_COMPRESSION_MAX)) {
+		uprintf("'%s' is not a compressed image that can be benchmarked", image);
+		return FALSE;
+	}
+	uprintf("Decompressing '%s'", image);
+	GetSystemInfo(&si);
+	static_sprintf(path[0], "%s\\decompress0.img", dir);
+	static_sprintf(path[1], "%s\\decompress1.img", dir);
+
+	for (pass = 0; pass < 2; pass++) {
+		bled_init(0, uprintf, NULL, NULL, NULL, NULL, &ErrorStatus);
+		bled_set_max_threads((pass == 0) ? 1 : 0);
+		start = GetTickCount64();
+		size[pass] = bled_uncompress(image, path[pass], type);
+		elapsed[pass] = max(GetTickCount64() - start, 1);
+		bled_exit();
+		if (size[pass] < 0)
+			break;
+		uprintf("%s: %s decompressed in %0.2f s (%0.1f MB/s)", (pass == 0) ? "1 thread" : "1 thread per CPU",
+			SizeToHumanReadable(size[pass], FALSE, FALSE), elapsed[pass] / 1000.0f,
+			(1000.0f * size[pass]) / (1.0f * MB * elapsed[pass]));
+	}
+	bled_set_max_threads(0);
+
+	ret = (size[0] >= 0) && (size[0] == size[1]) && compare_files(path[0], path[1]);
+	if (ret)
+		uprintf("Speedup with %d CPU(s): %0.2fx", si.dwNumberOfProcessors, (1.0f * elapsed[0]) / elapsed[1]);
+	else
+		uprintf("Decompression failed, or the outputs differ");
+	DeleteFileU(path[0]);
+	DeleteFileU(path[1]);
+	return ret;
+}
+
+/*
+ * Decompress 'archive' into 'dir', then read it back through bled_seekable_read() at
+ * random offsets and lengths, and check the data against the full decompression.
+ * The archive must have an index, i.e. be a multi-block .xz, a seekable .zst or a
+ * .gz, for which one is built, so that the reads do go through the seek points.
+ */
+BOOL SeekableReadTest(const char* archive, const char* dir)
+{
+	char path[MAX_PATH];
+	uint8_t *buf = NULL, *ref = NULL;
+	BOOL ret = FALSE;
+	int i, type;
+	int64_t size, r;
+	size_t len, nb_points;
+	uint32_t seed = (uint32_t)GetTickCount64();
+	uint64_t offset, start, elapsed = 0, total = 0;
+	bled_seekable_t* s = NULL;
+	FILE* fd = NULL;
+
+	type = get_compression_type(archive);
+	if ((type != BLED_COMPRESSION_XZ) && (type != BLED_COMPRESSION_ZSTD) && (type != BLED_COMPRESSION_GZIP)) {
+		uprintf("'%s' is not an .xz, .zst or .gz archive", archive);
+		return FALSE;
+	}
+	static_sprintf(path, "%s\\seekable.img", dir);
+	buf = malloc(SEEKABLE_TEST_MAX_READ);
+	ref = malloc(SEEKABLE_TEST_MAX_READ);
+	if ((buf == NULL) || (ref == NULL))
+		goto out;
+
+	bled_init(0, uprintf, NULL, NULL, NULL, NULL, &ErrorStatus);
+	size = bled_uncompress(archive, path, type);
+	if (size <= 0) {
+		uprintf("Could not decompress '%s'", archive);
+		goto out;
+	}
+	s = bled_seekable_open(archive, type, (type == BLED_COMPRESSION_GZIP) ? SEEKABLE_TEST_GZ_SPACING : 0);
+	fd = fopenU(path, "rb");
+	if ((s == NULL) || (fd == NULL))
+		goto out;
+	nb_points = bled_seekable_nb_points(s);
+	if (nb_points < 2) {
+		uprintf("'%s' has %d seek point(s), so reading it does not exercise seeking", archive, (int)nb_points);
+		goto out;
+	}
+	if (bled_seekable_size(s) != size) {
+		uprintf("Seekable size %lld does not match the decompressed size %lld", bled_seekable_size(s), size);
+		goto out;
+	}
+	uprintf("%s: %s uncompressed, %d seek points, seed 0x%08x", archive,
+		SizeToHumanReadable(size, FALSE, FALSE), (int)nb_points, seed);
+
+	// Random reads, then the start of the data, a read across its end and one past it
+	for (i = 0; i < SEEKABLE_TEST_NB_READS + 3; i++) {
+		if (i < SEEKABLE_TEST_NB_READS) {
+			offset = (((uint64_t)inflate_test_rand(&seed) << 32) | ((uint64_t)inflate_test_rand(&seed) << 16) |
+				inflate_test_rand(&seed)) % size;
+			len = 1 + (((size_t)inflate_test_rand(&seed) << 16) | inflate_test_rand(&seed)) % SEEKABLE_TEST_MAX_READ;
+		} else {
+			offset = (i == SEEKABLE_TEST_NB_READS) ? 0 : size - ((i == SEEKABLE_TEST_NB_READS + 1) ? 1 : 0);
+			len = SEEKABLE_TEST_MAX_READ;
+		}
+		start = GetTickCount64();
+		r = bled_seekable_read(s, offset, (char*)buf, len);
+		elapsed += GetTickCount64() - start;
+		// Reads must stop at the end of the data
+		len = (size_t)min((uint64_t)len, size - offset);
+		if (r != (int64_t)len) {
+			uprintf("Read of %d bytes at offset 0x%llx returned %lld", (int)len, offset, r);
+			goto out;
+		}
+		total += len;
+		if ((len != 0) && ((_fseeki64(fd, offset, SEEK_SET) != 0) || (fread(ref, 1, len, fd) != len) ||
+			(memcmp(buf, ref, len) != 0))) {
+			uprintf("Read of %d bytes at offset 0x%llx returned the wrong data", (int)len, offset);
+			goto out;
+		}
+	}
+	uprintf("%d reads, %s in %0.2f s", SEEKABLE_TEST_NB_READS + 3, SizeToHumanReadable(total, FALSE, FALSE),
+		elapsed / 1000.0f);
+	ret = TRUE;
+
+out:
+	if (fd != NULL)
+		fclose(fd);
+	bled_seekable_close(s);
+	bled_exit();
+	DeleteFileU(path);
+	free(buf);
+	free(ref);
+	return ret;
+}
+
+// Fixed Huffman deflate, with literals only, which is all a test archive needs
+typedef struct {
+	uint8_t* out;
+	size_t pos;
+	uint64_t bits;
+	int nb_bits;
+} deflate_writer;
+
+static void deflate_put_bits(deflate_writer* w, uint32_t code, int len)
+{
+	w->bits |= (uint64_t)code << w->nb_bits;
+	for (w->nb_bits += len; w->nb_bits >= 8; w->nb_bits -= 8) {
+		w->out[w->pos++] = (uint8_t)w->bits;
+		w->bits >>= 8;
+	}
+}
+
+// Huffman codes go into the stream from their most significant bit
+static uint32_t deflate_code(uint32_t code, int len)
+{
+	uint32_t r = 0;
+
+	for (; len > 0; len--, code >>= 1)
+		r = (r << 1) | (code & 1);
+	return r;
+}
+
+// 'dst' must be able to hold 9/8 of 'len', plus 2 bytes
+static size_t deflate_fixed(const uint8_t* src, size_t len, uint8_t* dst)
+{
+	deflate_writer w = { dst, 0, 0, 0 };
+	size_t i;
+
+	// BFINAL, followed by BTYPE 01 (fixed Huffman)
+	deflate_put_bits(&w, 0x03, 3);
+	for (i = 0; i < len; i++) {
+		if (src[i] < 144)
+			deflate_put_bits(&w, deflate_code(0x30 + src[i], 8), 8);
+		else
+			deflate_put_bits(&w, deflate_code(0x190 + src[i] - 144, 9), 9);
+	}
+	// End of block
+	deflate_put_bits(&w, 0, 7);
+	if (w.nb_bits != 0)
+		deflate_put_bits(&w, 0, 8 - w.nb_bits);
+	return w.pos;
+}
+
+static __inline void put_le16(uint8_t* p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+static __inline void put_le32(uint8_t* p, uint32_t v) { put_le16(p, (uint16_t)v); put_le16(&p[2], (uint16_t)(v >> 16)); }
+
+typedef struct {
+	char name[32];
+	uint16_t method;
+	uint32_t attr;
+	uint32_t offset;
+	uint32_t crc;
+	uint32_t csize;
+	uint32_t usize;
+} zip_test_entry;
+
+/*
+ * Create a zip with a directory, empty stored and deflated entries, and then
+ * stored and deflated files, in the root as well as in nested directories,
+ * for a total of about 'size' bytes of uncompressed data.
+ */
+static BOOL create_test_zip(const char* path, uint64_t size, int* nb_entries)
+{
+	const int nb_files = 48;
+	BOOL r = FALSE;
+	FILE* fd = fopenU(path, "wb");
+	zip_test_entry* e = calloc(nb_files + 3, sizeof(zip_test_entry));
+	uint8_t hdr[46], *data = NULL, *cdata = NULL;
+	uint32_t i, n = 0, file_size, cdf_offset, cdf_size = 0;
+
+	size = min(size, 1 * GB);
+	file_size = (uint32_t)(size / nb_files);
+	data = malloc(2 * (size_t)file_size + 1);
+	cdata = malloc((2 * (size_t)file_size + 1) * 9 / 8 + 16);
+	if ((fd == NULL) || (e == NULL) || (data == NULL) || (cdata == NULL))
+		goto out;
+
+	static_strcpy(e[n].name, "dir/");
+	e[n++].attr = FILE_ATTRIBUTE_DIRECTORY;
+	static_strcpy(e[n++].name, "empty.txt");
+	static_strcpy(e[n].name, "dir/empty.bin");
+	e[n++].method = 8;
+	for (i = 0; i < (uint32_t)nb_files; i++, n++) {
+		static_sprintf(e[n].name, "%sfile%02d.%s", (i % 3 == 0) ? "" : ((i % 3 == 1) ? "dir/" : "dir/sub/"),
+			i, (i % 2 == 0) ? "txt" : "bin");
+		e[n].method = (i % 2 == 0) ? 0 : 8;
+		e[n].attr = FILE_ATTRIBUTE_ARCHIVE;
+		// Between half and one and a half times the average size
+		e[n].usize = file_size / 2 + (uint32_t)(((uint64_t)file_size * i) / nb_files);
+	}
+
+	for (i = 0; i < n; i++) {
+		inflate_test_data(data, e[i].usize, i + 1);
+		e[i].crc = ~bled_crc32(~0, data, e[i].usize);
+		if ((e[i].method == 8) && (e[i].attr != FILE_ATTRIBUTE_DIRECTORY)) {
+			e[i].csize = (uint32_t)deflate_fixed(data, e[i].usize, cdata);
+		} else {
+			e[i].csize = e[i].usize;
+			memcpy(cdata, data, e[i].usize);
+		}
+		e[i].offset = (uint32_t)_ftelli64(fd);
+		memset(hdr, 0, sizeof(hdr));
+		put_le32(&hdr[0], 0x04034b50);
+		put_le16(&hdr[4], 20);
+		put_le16(&hdr[8], e[i].method);
+		put_le16(&hdr[12], 0x0021);	// 1980.01.01
+		put_le32(&hdr[14], e[i].crc);
+		put_le32(&hdr[18], e[i].csize);
+		put_le32(&hdr[22], e[i].usize);
+		put_le16(&hdr[26], (uint16_t)strlen(e[i].name));
+		if ((fwrite(hdr, 1, 30, fd) != 30) || (fwrite(e[i].name, 1, strlen(e[i].name), fd) != strlen(e[i].name)) ||
+			(fwrite(cdata, 1, e[i].csize, fd) != e[i].csize))
+			goto out;
+	}
+
+	cdf_offset = (uint32_t)_ftelli64(fd);
+	for (i = 0; i < n; i++) {
+		memset(hdr, 0, sizeof(hdr));
+		put_le32(&hdr[0], 0x02014b50);
+		put_le16(&hdr[4], 20);
+		put_le16(&hdr[6], 20);
+		put_le16(&hdr[10], e[i].method);
+		put_le16(&hdr[14], 0x0021);
+		put_le32(&hdr[16], e[i].crc);
+		put_le32(&hdr[20], e[i].csize);
+		put_le32(&hdr[24], e[i].usize);
+		put_le16(&hdr[28], (uint16_t)strlen(e[i].name));
+		put_le32(&hdr[38], e[i].attr);
+		put_le32(&hdr[42], e[i].offset);
+		if ((fwrite(hdr, 1, 46, fd) != 46) || (fwrite(e[i].name, 1, strlen(e[i].name), fd) != strlen(e[i].name)))
+			goto out;
+		cdf_size += 46 + (uint32_t)strlen(e[i].name);
+	}
+	memset(hdr, 0, sizeof(hdr));
+	put_le32(&hdr[0], 0x06054b50);
+	put_le16(&hdr[8], (uint16_t)n);
+	put_le16(&hdr[10], (uint16_t)n);
+	put_le32(&hdr[12], cdf_size);
+	put_le32(&hdr[16], cdf_offset);
+	r = (fwrite(hdr, 1, 22, fd) == 22);
+	*nb_entries = n;
+
+out:
+	if (fd != NULL)
+		fclose(fd);
+	free(e);
+	free(data);
+	free(cdata);
+	return r;
+}
+
+// Check that two directories hold the same subdirectories and files, with the same content
+static BOOL compare_dirs(char* dir1, char* dir2, uint32_t* nb_items)
+{
+	BOOL r = FALSE;
+	StrArray list1, list2;
+	char path[MAX_PATH];
+	size_t len1 = strlen(dir1);
+	uint32_t i;
+
+	StrArrayCreate(&list1, 64);
+	StrArrayCreate(&list2, 64);
+	ListDirectoryContent(&list1, dir1, LIST_DIR_TYPE_FILE | LIST_DIR_TYPE_DIRECTORY | LIST_DIR_TYPE_RECURSIVE);
+	ListDirectoryContent(&list2, dir2, LIST_DIR_TYPE_FILE | LIST_DIR_TYPE_DIRECTORY | LIST_DIR_TYPE_RECURSIVE);
+	*nb_items = list1.Index;
+	if ((list1.Index == 0) || (list1.Index != list2.Index))
+		goto out;
+	for (i = 0; i < list1.Index; i++) {
+		static_sprintf(path, "%s%s", dir2, &list1.String[i][len1]);
+		if (StrArrayFind(&list2, path) < 0)
+			goto out;
+		// Directories are listed with a trailing backslash
+		if ((path[strlen(path) - 1] != '\\') && !compare_files(list1.String[i], path))
+			goto out;
+	}
+	r = TRUE;
+
+out:
+	StrArrayDestroy(&list1);
+	StrArrayDestroy(&list2);
+	return r;
+}
+
+/*
+ * Extract a zip archive that we create into 'dir', first with the sequential
+ * decoder only and then with one thread per CPU, check that both trees are
+ * the same and report the speedup.
+ */
+BOOL UnzipBenchmark(const char* dir, uint64_t size)
+{
+	char zip[MAX_PATH], path[2][MAX_PATH];
+	BOOL ret = FALSE;
+	int pass, nb_entries = 0;
+	int64_t extracted[2] = { -1, -1 };
+	uint32_t nb_items = 0;
+	uint64_t start, elapsed[2];
+	SYSTEM_INFO si;
+
+	GetSystemInfo(&si);
+	static_sprintf(zip, "%s\\unzip_test.zip", dir);
+	static_sprintf(path[0], "%s\\unzip0", dir);
+	static_sprintf(path[1], "%s\\unzip1", dir);
+	if (!create_test_zip(zip, size, &nb_entries)) {
+		uprintf("Could not create '%s'", zip);
+		goto out;
+	}
+
+	for (pass = 0; pass < 2; pass++) {
+		bled_init(0, uprintf, NULL, NULL, NULL, NULL, &ErrorStatus);
+		bled_set_max_threads((pass == 0) ? 1 : 0);
+		start = GetTickCount64();
+		extracted[pass] = bled_uncompress_to_dir(zip, path[pass], BLED_COMPRESSION_ZIP);
+		elapsed[pass] = max(GetTickCount64() - start, 1);
+		bled_exit();
+		if (extracted[pass] < 0)
+			break;
+		uprintf("%s: %d entries (%s) extracted in %0.2f s (%0.1f MB/s)", (pass == 0) ? "1 thread" : "1 thread per CPU",
+			nb_entries, SizeToHumanReadable(extracted[pass], FALSE, FALSE), elapsed[pass] / 1000.0f,
+			(1000.0f * extracted[pass]) / (1.0f * MB * elapsed[pass]));
+	}
+	bled_set_max_threads(0);
+
+	ret = (extracted[0] >= 0) && (extracted[0] == extracted[1]) && compare_dirs(path[0], path[1], &nb_items);
+	// Every entry must have been extracted, along with 'dir/sub/', which has no entry of its own
+	ret = ret && (nb_items == (uint32_t)nb_entries + 1);
+	if (ret)
+		uprintf("Speedup with %d CPU(s): %0.2fx", si.dwNumberOfProcessors, (1.0f * elapsed[0]) / elapsed[1]);
+	else
+		uprintf("Extraction failed, or the extracted trees differ (%d items for %d entries)", nb_items, nb_entries);
+
+out:
+	SHDeleteDirectoryExU(NULL, path[0], FOF_NO_UI);
+	SHDeleteDirectoryExU(NULL, path[1], FOF_NO_UI);
+	DeleteFileU(zip);
+	return ret;
+}
+#endif
@@ -39,6 +39,11 @@
 
 #define INVALID_CALLBACK_VALUE				0xFFFFFFFF
 
+// Random reads done by SeekableReadTest(), of up to 4 MB each
+#define SEEKABLE_TEST_NB_READS				256
+#define SEEKABLE_TEST_MAX_READ				(4 * 1024 * 1024)
+#define SEEKABLE_TEST_GZ_SPACING			(1024 * 1024)
+
 #define WIM_FLAG_RESERVED					0x00000001
 #define WIM_FLAG_VERIFY						0x00000002
 #define WIM_FLAG_INDEX						0x00000004
@@ -60,6 +65,7 @@
 
 #define MBR_SIZE							512	// Might need to review this once we see bootable 4k systems
 
+#define VIRTUAL_STORAGE_TYPE_DEVICE_IMG_GZ                 98
 #define VIRTUAL_STORAGE_TYPE_DEVICE_FFU                    99
 #define CREATE_VIRTUAL_DISK_VERSION_2                       2
 #define CREATE_VIRTUAL_DISK_FLAG_CREATE_BACKING_STORAGE     8
@@ -141,4 +147,12 @@ extern char* VhdMountImageAndGetSize(const char* path, uint64_t* disksize);
 #define VhdMountImage(path) VhdMountImageAndGetSize(path, NULL)
 extern void VhdUnmountImage(void);
 extern void VhdSaveImage(void);
+extern BOOL CaptureImage(const char* src, const char* dst, DWORD sector_size);
+#if defined(RUFUS_TEST)
+extern BOOL CaptureImageTest(const char* path, uint64_t size);
+extern BOOL InflateTest(uint64_t size);
+extern BOOL DecompressBenchmark(const char* image, const char* dir);
+extern BOOL UnzipBenchmark(const char* dir, uint64_t size);
+extern BOOL SeekableReadTest(const char* archive, const char* dir);
+#endif
 extern void IsoSaveImage(void);
@@ -0,0 +1,1098 @@
+/*
+ * Rufus: The Reliable USB Formatting Utility
+ * Asynchronous I/O queues
+ * Copyright © 2024 Pete Batard <pete@akeo.ie>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifdef _CRTDBG_MAP_ALLOC
+#include <stdlib.h>
+#include <crtdbg.h>
+#endif
+
+#include <windows.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <assert.h>
+
+#include "rufus.h"
+#include "missing.h"
+#include "winio.h"
+#include "msapi_utf8.h"
+#include "localization.h"
+
+#if (defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__i386) || \
+     defined(_X86_) || defined(__I86__) || defined(__x86_64__))
+#include <intrin.h>
+#include <immintrin.h>
+#define CPU_X86_SIMD                    1
+#endif
+
+#if defined(_MSC_VER)
+#define RUFUS_ENABLE_GCC_ARCH(arch)
+#else
+#define RUFUS_ENABLE_GCC_ARCH(arch) __attribute__ ((target (arch)))
+#endif
+
+#if defined(CPU_X86_SIMD)
+static int cpu_has_avx2 = -1;
+
+/*
+ * Detect if the processor and OS support AVX2. Unlike SSE2, which all the
+ * Windows versions we support require, this must be checked at runtime.
+ */
+static BOOL DetectAVX2Support(void)
+{
+#if defined(_MSC_VER)
+	int regs0[4] = { 0,0,0,0 }, regs1[4] = { 0,0,0,0 }, regs7[4] = { 0,0,0,0 };
+	const int OSXSAVE_BIT = 1 << 27;	/* Function 1, Bit 27 of ECX */
+	const int AVX_BIT = 1 << 28;		/* Function 1, Bit 28 of ECX */
+	const int AVX2_BIT = 1 << 5;		/* Function 7, Bit  5 of EBX */
+
+	__cpuid(regs0, 0);
+	if (regs0[0] < 0x07)
+		return FALSE;
+	__cpuidex(regs1, 1, 0);
+	__cpuidex(regs7, 7, 0);
+	if (!(regs1[2] & OSXSAVE_BIT) || !(regs1[2] & AVX_BIT) || !(regs7[1] & AVX2_BIT))
+		return FALSE;
+	// The OS must also save the YMM registers on context switches
+	return ((_xgetbv(0) & 0x06) == 0x06);
+#elif defined(__GNUC__) || defined(__clang__)
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") ? TRUE : FALSE;
+#else
+	return FALSE;
+#endif
+}
+
+RUFUS_ENABLE_GCC_ARCH("sse2")
+static BOOL IsFilledSSE2(const uint8_t* p, size_t size, uint8_t val, size_t* pLen)
+{
+	size_t i, end;
+	const __m128i ref = _mm_set1_epi8((char)val);
+	__m128i acc;
+
+	// XOR 64 bytes at a time into an accumulator, that we only test every KB
+	for (i = 0; i + 1024 <= size; i = end) {
+		acc = _mm_setzero_si128();
+		for (end = i + 1024; i < end; i += 64) {
+			acc = _mm_or_si128(acc, _mm_xor_si128(ref, _mm_loadu_si128((const __m128i*)&p[i])));
+			acc = _mm_or_si128(acc, _mm_xor_si128(ref, _mm_loadu_si128((const __m128i*)&p[i + 16])));
+			acc = _mm_or_si128(acc, _mm_xor_si128(ref, _mm_loadu_si128((const __m128i*)&p[i + 32])));
+			acc = _mm_or_si128(acc, _mm_xor_si128(ref, _mm_loadu_si128((const __m128i*)&p[i + 48])));
+		}
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128())) != 0xffff)
+			return FALSE;
+	}
+	*pLen = i;
+	return TRUE;
+}
+
+RUFUS_ENABLE_GCC_ARCH("avx2")
+static BOOL IsFilledAVX2(const uint8_t* p, size_t size, uint8_t val, size_t* pLen)
+{
+	size_t i, end;
+	const __m256i ref = _mm256_set1_epi8((char)val);
+	__m256i acc;
+
+	for (i = 0; i + 2048 <= size; i = end) {
+		acc = _mm256_setzero_si256();
+		for (end = i + 2048; i < end; i += 128) {
+			acc = _mm256_or_si256(acc, _mm256_xor_si256(ref, _mm256_loadu_si256((const __m256i*)&p[i])));
+			acc = _mm256_or_si256(acc, _mm256_xor_si256(ref, _mm256_loadu_si256((const __m256i*)&p[i + 32])));
+			acc = _mm256_or_si256(acc, _mm256_xor_si256(ref, _mm256_loadu_si256((const __m256i*)&p[i + 64])));
+			acc = _mm256_or_si256(acc, _mm256_xor_si256(ref, _mm256_loadu_si256((const __m256i*)&p[i + 96])));
+		}
+		if (!_mm256_testz_si256(acc, acc))
+			return FALSE;
+	}
+	*pLen = i;
+	return TRUE;
+}
+
+RUFUS_ENABLE_GCC_ARCH("sse2")
+static BOOL IsEqualSSE2(const uint8_t* p1, const uint8_t* p2, size_t size, size_t* pLen)
+{
+	size_t i, end;
+	__m128i acc;
+
+	for (i = 0; i + 1024 <= size; i = end) {
+		acc = _mm_setzero_si128();
+		for (end = i + 1024; i < end; i += 32) {
+			acc = _mm_or_si128(acc, _mm_xor_si128(_mm_loadu_si128((const __m128i*)&p1[i]),
+				_mm_loadu_si128((const __m128i*)&p2[i])));
+			acc = _mm_or_si128(acc, _mm_xor_si128(_mm_loadu_si128((const __m128i*)&p1[i + 16]),
+				_mm_loadu_si128((const __m128i*)&p2[i + 16])));
+		}
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(acc, _mm_setzero_si128())) != 0xffff)
+			return FALSE;
+	}
+	*pLen = i;
+	return TRUE;
+}
+
+RUFUS_ENABLE_GCC_ARCH("avx2")
+static BOOL IsEqualAVX2(const uint8_t* p1, const uint8_t* p2, size_t size, size_t* pLen)
+{
+	size_t i, end;
+	__m256i acc;
+
+	for (i = 0; i + 2048 <= size; i = end) {
+		acc = _mm256_setzero_si256();
+		for (end = i + 2048; i < end; i += 64) {
+			acc = _mm256_or_si256(acc, _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)&p1[i]),
+				_mm256_loadu_si256((const __m256i*)&p2[i])));
+			acc = _mm256_or_si256(acc, _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)&p1[i + 32]),
+				_mm256_loadu_si256((const __m256i*)&p2[i + 32])));
+		}
+		if (!_mm256_testz_si256(acc, acc))
+			return FALSE;
+	}
+	*pLen = i;
+	return TRUE;
+}
+#endif
+
+/// <summary>
+/// Check whether a buffer only contains bytes of a specific value.
+/// On x86, this uses AVX2 or SSE2 for the bulk of the buffer.
+/// </summary>
+/// <param name="pBuf">The buffer to check</param>
+/// <param name="size">The size of the buffer</param>
+/// <param name="val">The value that all the bytes must have</param>
+/// <returns>TRUE if all the bytes of the buffer are set to val, FALSE otherwise</returns>
+BOOL IsBufferFilled(const void* pBuf, size_t size, uint8_t val)
+{
+	const uint8_t* p = (const uint8_t*)pBuf;
+	size_t i = 0, len;
+
+	// Start by checking the first bytes, so that most non matching buffers are ruled out early
+	for (; (i < size) && (i < 16); i++) {
+		if (p[i] != val)
+			return FALSE;
+	}
+#if defined(CPU_X86_SIMD)
+	if (size - i >= 1024) {
+		if (cpu_has_avx2 < 0)
+			cpu_has_avx2 = DetectAVX2Support();
+		if (!(cpu_has_avx2 ? IsFilledAVX2(&p[i], size - i, val, &len) : IsFilledSSE2(&p[i], size - i, val, &len)))
+			return FALSE;
+		i += len;
+	}
+#endif
+	for (; i < size; i++) {
+		if (p[i] != val)
+			return FALSE;
+	}
+	return TRUE;
+}
+
+/// <summary>
+/// Check whether a buffer only contains zeroes.
+/// </summary>
+/// <param name="pBuf">The buffer to check</param>
+/// <param name="size">The size of the buffer</param>
+/// <returns>TRUE if the buffer is zeroed, FALSE otherwise</returns>
+BOOL IsBufferZero(const void* pBuf, size_t size)
+{
+	return IsBufferFilled(pBuf, size, 0x00);
+}
+
+/// <summary>
+/// Check whether a buffer is blank, i.e. all its bits are either cleared (zeroed) or set
+/// (which is what erased flash blocks usually read back as).
+/// </summary>
+/// <param name="pBuf">The buffer to check</param>
+/// <param name="size">The size of the buffer</param>
+/// <returns>TRUE if the buffer is blank, FALSE otherwise</returns>
+BOOL IsBufferBlank(const void* pBuf, size_t size)
+{
+	const uint8_t* p = (const uint8_t*)pBuf;
+
+	if (size == 0)
+		return TRUE;
+	return ((p[0] == 0x00) || (p[0] == 0xff)) && IsBufferFilled(pBuf, size, p[0]);
+}
+
+/// <summary>
+/// Compare two buffers for equality. Unlike memcmp(), this doesn't tell which
+/// buffer is greater, which lets us use AVX2 or SSE2 without early exits.
+/// </summary>
+/// <param name="pBuf1">The first buffer to compare</param>
+/// <param name="pBuf2">The second buffer to compare</param>
+/// <param name="size">The number of bytes to compare</param>
+/// <returns>TRUE if the buffers have the same content, FALSE otherwise</returns>
+BOOL IsBufferEqual(const void* pBuf1, const void* pBuf2, size_t size)
+{
+	const uint8_t *p1 = (const uint8_t*)pBuf1, *p2 = (const uint8_t*)pBuf2;
+	size_t i = 0, len;
+
+#if defined(CPU_X86_SIMD)
+	if (size >= 1024) {
+		if (cpu_has_avx2 < 0)
+			cpu_has_avx2 = DetectAVX2Support();
+		if (!(cpu_has_avx2 ? IsEqualAVX2(p1, p2, size, &len) : IsEqualSSE2(p1, p2, size, &len)))
+			return FALSE;
+		i = len;
+	}
+#endif
+	return (i >= size) || (memcmp(&p1[i], &p2[i], size - i) == 0);
+}
+
+/// <summary>
+/// Open a new handle to an already opened file or device, for overlapped access.
+/// This lets us issue multiple I/O requests at once on a drive that was opened
+/// (and locked) for synchronous access.
+/// Note that the original handle must have been opened with compatible sharing.
+/// </summary>
+/// <param name="hFile">The handle of the file or device to reopen</param>
+/// <param name="dwDesiredAccess">The requested access to the file or device</param>
+/// <returns>Non NULL on success</returns>
+HANDLE ReOpenFileAsync(HANDLE hFile, DWORD dwDesiredAccess)
+{
+	HANDLE h = ReOpenFile(hFile, dwDesiredAccess, FILE_SHARE_READ | FILE_SHARE_WRITE,
+		FILE_FLAG_OVERLAPPED | FILE_FLAG_NO_BUFFERING);
+	return (h == INVALID_HANDLE_VALUE) ? NULL : h;
+}
+
+/// <summary>
+/// Initialize an I/O queue, and allocate its sector aligned buffers.
+/// If hSource is NULL, the content of the buffers (which are zeroed by default
+/// and can be accessed through q->pBuffers) is written repeatedly to the target.
+/// </summary>
+/// <param name="q">The queue to initialize</param>
+/// <param name="hSource">An overlapped source handle, or NULL</param>
+/// <param name="hTarget">A target handle, either overlapped or synchronous</param>
+/// <param name="qwSize">The number of bytes to process</param>
+/// <param name="dwSectorSize">The sector size to align buffers and I/O sizes to</param>
+/// <param name="dwBufferSize">The size of each individual buffer</param>
+/// <param name="dwDepth">The number of buffers (and therefore maximum concurrent I/Os)</param>
+/// <returns>TRUE on success, FALSE on error</returns>
+BOOL IoQueueInit(IO_QUEUE* q, HANDLE hSource, HANDLE hTarget, uint64_t qwSize,
+	DWORD dwSectorSize, DWORD dwBufferSize, DWORD dwDepth)
+{
+	DWORD i;
+
+	if_not_assert(q != NULL)
+		return FALSE;
+	memset(q, 0, sizeof(IO_QUEUE));
+	if_not_assert(hTarget != NULL && hTarget != INVALID_HANDLE_VALUE && IS_POWER_OF_2(dwSectorSize))
+		return FALSE;
+
+	q->hSource = hSource;
+	q->hTarget = hTarget;
+	q->qwSize = qwSize;
+	q->dwSectorSize = dwSectorSize;
+	q->dwDepth = min(max(dwDepth, 1), IOQ_MAX_DEPTH);
+	// Our buffer size must be a multiple of the sector size and *ALIGNED* to the sector size
+	q->dwBufferSize = HI_ALIGN_X_TO_Y(max(dwBufferSize, dwSectorSize), dwSectorSize);
+	q->pBuffers = (uint8_t*)_mm_malloc((size_t)q->dwBufferSize * q->dwDepth, dwSectorSize);
+	if (q->pBuffers == NULL) {
+		SetLastError(ERROR_NOT_ENOUGH_MEMORY);
+		return FALSE;
+	}
+	memset(q->pBuffers, 0, (size_t)q->dwBufferSize * q->dwDepth);
+	for (i = 0; i < q->dwDepth; i++) {
+		q->Slot[i].pBuffer = &q->pBuffers[(size_t)i * q->dwBufferSize];
+		q->Slot[i].Overlapped.hEvent = CreateEventA(NULL, TRUE, FALSE, NULL);
+		if (q->Slot[i].Overlapped.hEvent == NULL) {
+			IoQueueExit(q);
+			return FALSE;
+		}
+	}
+	return TRUE;
+}
+
+/* Issue the read, target check or write for a queue slot */
+static BOOL IoQueueIssue(IO_QUEUE* q, IO_QUEUE_SLOT* s, int iState)
+{
+	BOOL r = TRUE;
+
+	s->iState = iState;
+	s->Overlapped.Internal[0] = 0;
+	s->Overlapped.Internal[1] = 0;
+	switch (iState) {
+	case IOQ_SLOT_READING:
+		s->Overlapped.Offset = s->qwOffset;
+		if ((q->hSource != NULL) && !s->bHole)
+			r = ReadFile(q->hSource, s->pBuffer, s->dwSize, NULL, (OVERLAPPED*)&s->Overlapped);
+		break;
+	case IOQ_SLOT_CHECKING:
+		s->Overlapped.Offset = s->qwOffset + s->dwStart;
+		r = ReadFile(q->hTarget, &s->pBuffer[s->dwStart], s->dwEnd - s->dwStart, NULL, (OVERLAPPED*)&s->Overlapped);
+		break;
+	default:
+		s->Overlapped.Offset = s->qwOffset + s->dwStart;
+		// Writes only ever use the synchronous path if the target was not opened for overlapped I/O
+		r = WriteFile(q->hTarget, &s->pBuffer[s->dwStart], s->dwEnd - s->dwStart, NULL, (OVERLAPPED*)&s->Overlapped);
+		break;
+	}
+	return (r || (GetLastError() == ERROR_IO_PENDING));
+}
+
+/* Wait for the I/O of a queue slot to complete and return the number of bytes transferred */
+static BOOL IoQueueWait(IO_QUEUE* q, IO_QUEUE_SLOT* s, DWORD* pdwSize)
+{
+	BOOL bRead = (s->iState == IOQ_SLOT_READING);
+
+	*pdwSize = 0;
+	// Zero sized slots are used to flag a premature end of the source, and
+	// empty ranges to flag that there is nothing left to write.
+	if (bRead ? (s->dwSize == 0) : (s->dwStart == s->dwEnd))
+		return TRUE;
+	if (bRead && ((q->hSource == NULL) || s->bHole)) {
+		*pdwSize = s->dwSize;
+		return TRUE;
+	}
+	if (bRead && (WaitForSingleObject(s->Overlapped.hEvent, DRIVE_ACCESS_TIMEOUT) != WAIT_OBJECT_0)) {
+		SetLastError(ERROR_TIMEOUT);
+		return FALSE;
+	}
+	if (!GetOverlappedResult(bRead ? q->hSource : q->hTarget, (OVERLAPPED*)&s->Overlapped, pdwSize, TRUE))
+		// When reading from VHD/VHDX we get SECTOR_NOT_FOUND rather than EOF for the end of the drive
+		return bRead && (GetLastError() == ERROR_HANDLE_EOF || GetLastError() == ERROR_SECTOR_NOT_FOUND);
+	return TRUE;
+}
+
+/* Apply the same retry policy as WriteFileWithRetry() to a failed queued write */
+static BOOL IoQueueRetryWrite(IO_QUEUE* q, IO_QUEUE_SLOT* s, BOOL bSuccess, DWORD dwWritten)
+{
+	DWORD i;
+
+	for (i = 1; i <= WRITE_RETRIES; i++) {
+		if (bSuccess)
+			uprintf("\r\nWrite error: Wrote %d bytes, expected %d bytes", dwWritten, s->dwEnd - s->dwStart);
+		else
+			uprintf("\r\nWrite error at sector %lld: %s", s->Overlapped.Offset / q->dwSectorSize, WindowsErrorString());
+		if (i >= WRITE_RETRIES)
+			break;
+		uprintf("Retrying in %d seconds...", WRITE_TIMEOUT / 1000);
+		Sleep(WRITE_TIMEOUT);
+		if (IS_ERROR(ErrorStatus) && (SCODE_CODE(ErrorStatus) == ERROR_CANCELLED))
+			return FALSE;
+		bSuccess = IoQueueIssue(q, s, IOQ_SLOT_WRITING) && IoQueueWait(q, s, &dwWritten);
+		if (bSuccess && (dwWritten == s->dwEnd - s->dwStart))
+			return TRUE;
+	}
+	ErrorStatus = RUFUS_ERROR(ERROR_WRITE_FAULT);
+	return FALSE;
+}
+
+/* Cancel and wait for all the I/Os that are still in flight */
+static void IoQueueDrain(IO_QUEUE* q)
+{
+	DWORD i, size;
+	HANDLE h;
+	IO_QUEUE_SLOT* s;
+
+	for (i = 0; i < q->dwDepth; i++) {
+		s = &q->Slot[i];
+		if (s->iState == IOQ_SLOT_HASHING) {
+			WaitForSingleObject(s->hHashed, INFINITE);
+			s->iState = IOQ_SLOT_FREE;
+			continue;
+		}
+		if ((s->iState == IOQ_SLOT_FREE) || (s->dwSize == 0))
+			continue;
+		if ((s->iState == IOQ_SLOT_READING) ? s->bHole : (s->dwStart == s->dwEnd))
+			continue;
+		h = (s->iState == IOQ_SLOT_READING) ? q->hSource : q->hTarget;
+		if (h != NULL) {
+			CancelIoEx(h, (OVERLAPPED*)&s->Overlapped);
+			GetOverlappedResult(h, (OVERLAPPED*)&s->Overlapped, &size, TRUE);
+		}
+		s->iState = IOQ_SLOT_FREE;
+	}
+}
+
+/* Check if a section of the source falls entirely within one of its holes */
+static BOOL IoQueueIsHole(IO_QUEUE* q, uint64_t qwOffset, DWORD dwSize)
+{
+	FILE_ALLOCATED_RANGE_BUFFER* r;
+
+	if (q->pExtents == NULL)
+		return FALSE;
+	// Reads are issued in sequence, so we never need to look back
+	while (q->dwExtent < q->dwNbExtents) {
+		r = &q->pExtents[q->dwExtent];
+		if ((uint64_t)(r->FileOffset.QuadPart + r->Length.QuadPart) > qwOffset)
+			break;
+		q->dwExtent++;
+	}
+	return (q->dwExtent >= q->dwNbExtents) ||
+		((uint64_t)q->pExtents[q->dwExtent].FileOffset.QuadPart >= qwOffset + dwSize);
+}
+
+/* Set the slot range to the next run of zeroed or non zeroed data, and return FALSE if there is none */
+static BOOL IoQueueNextRange(IO_QUEUE* q, IO_QUEUE_SLOT* s, BOOL* pbZero)
+{
+	DWORD pos = s->dwEnd;
+
+	if (pos >= s->dwSize)
+		return FALSE;
+	s->dwStart = pos;
+	*pbZero = FALSE;
+	if (!q->bSparse) {
+		s->dwEnd = s->dwSize;
+		return TRUE;
+	}
+	if (s->bHole) {
+		*pbZero = TRUE;
+		s->dwEnd = s->dwSize;
+		return TRUE;
+	}
+	*pbZero = IsBufferZero(&s->pBuffer[pos], min(IOQ_SPARSE_BLOCK_SIZE, s->dwSize - pos));
+	for (pos += IOQ_SPARSE_BLOCK_SIZE; pos < s->dwSize; pos += IOQ_SPARSE_BLOCK_SIZE) {
+		if (IsBufferZero(&s->pBuffer[pos], min(IOQ_SPARSE_BLOCK_SIZE, s->dwSize - pos)) != *pbZero)
+			break;
+	}
+	s->dwEnd = min(pos, s->dwSize);
+	return TRUE;
+}
+
+/* Issue the next check or write for a slot, skipping the data that doesn't need to be written */
+static BOOL IoQueueNext(IO_QUEUE* q, IO_QUEUE_SLOT* s)
+{
+	BOOL bZero;
+
+	while (IoQueueNextRange(q, s, &bZero)) {
+		if (bZero && q->bTargetZeroed) {
+			q->qwSkipped += s->dwEnd - s->dwStart;
+			continue;
+		}
+		// Zeroed data only needs to be written if the target doesn't already read back as zero.
+		// If we can't read the target, we just write the zeroes.
+		if (bZero && IoQueueIssue(q, s, IOQ_SLOT_CHECKING))
+			return TRUE;
+		return IoQueueIssue(q, s, IOQ_SLOT_WRITING) || IoQueueRetryWrite(q, s, FALSE, 0);
+	}
+	// Nothing left to write for this slot
+	s->dwStart = s->dwEnd;
+	s->iState = IOQ_SLOT_WRITING;
+	return TRUE;
+}
+
+/// <summary>
+/// Enable sparse mode on an I/O queue, where zeroed source data is only written if the
+/// target doesn't already read back as zero. If the source is a sparse file, its holes
+/// are not read either.
+/// </summary>
+/// <param name="q">An initialized queue, that must have a source</param>
+/// <param name="bTargetZeroed">Whether the target is known to read back as zero, in which
+/// case zeroed data is skipped without checking the target</param>
+/// <returns>TRUE on success, FALSE on error</returns>
+BOOL IoQueueSetSparse(IO_QUEUE* q, BOOL bTargetZeroed)
+{
+	BOOL r = FALSE;
+	BY_HANDLE_FILE_INFORMATION fi;
+	FILE_ALLOCATED_RANGE_BUFFER range;
+	OVERLAPPED overlapped = { 0 };
+	DWORD size = 0, max_extents = 64;
+
+	if_not_assert(q != NULL && q->pBuffers != NULL && q->hSource != NULL)
+		return FALSE;
+	q->bSparse = TRUE;
+	q->bTargetZeroed = bTargetZeroed;
+
+	// Sparse files let us know where their holes are, so that we don't have to read them
+	if (!GetFileInformationByHandle(q->hSource, &fi) || !(fi.dwFileAttributes & FILE_ATTRIBUTE_SPARSE_FILE))
+		return TRUE;
+	overlapped.hEvent = CreateEventA(NULL, TRUE, FALSE, NULL);
+	if (overlapped.hEvent == NULL)
+		return TRUE;
+	range.FileOffset.QuadPart = 0;
+	range.Length.QuadPart = q->qwSize;
+	do {
+		max_extents *= 2;
+		safe_free(q->pExtents);
+		q->pExtents = (FILE_ALLOCATED_RANGE_BUFFER*)malloc(max_extents * sizeof(FILE_ALLOCATED_RANGE_BUFFER));
+		if (q->pExtents == NULL)
+			break;
+		// The source was opened for overlapped I/O, so we must use an OVERLAPPED
+		r = DeviceIoControl(q->hSource, FSCTL_QUERY_ALLOCATED_RANGES, &range, sizeof(range), q->pExtents,
+			max_extents * sizeof(FILE_ALLOCATED_RANGE_BUFFER), NULL, &overlapped);
+		if (r || (GetLastError() == ERROR_IO_PENDING))
+			r = GetOverlappedResult(q->hSource, &overlapped, &size, TRUE);
+	} while (!r && (GetLastError() == ERROR_MORE_DATA) && (max_extents < 1024 * 1024));
+	CloseHandle(overlapped.hEvent);
+	if (!r) {
+		uprintf("Could not get allocated ranges of sparse source: %s", WindowsErrorString());
+		safe_free(q->pExtents);
+		return TRUE;
+	}
+	q->dwNbExtents = size / sizeof(FILE_ALLOCATED_RANGE_BUFFER);
+	q->dwExtent = 0;
+	uprintf("Source is a sparse file with %d allocated range%s", q->dwNbExtents, (q->dwNbExtents == 1) ? "" : "s");
+	return TRUE;
+}
+
+/// <summary>
+/// Copy data from the source to the target of an I/O queue, using as many concurrent
+/// reads and writes as the queue has buffers. Writes are issued and retired in order.
+/// </summary>
+/// <param name="q">An initialized queue</param>
+/// <param name="nMsg">The message ID to use when reporting progress</param>
+/// <returns>TRUE on success, FALSE on error (in which case ErrorStatus is set)</returns>
+BOOL IoQueueCopy(IO_QUEUE* q, int nMsg)
+{
+	BOOL s_ok;
+	DWORD size, rhead = 0, whead = 0, tail = 0, used = 0, nb_writes = 0;
+	uint64_t read_offset = 0, done, cur_value, last_value = 0;
+	IO_QUEUE_SLOT* s;
+
+	if_not_assert(q != NULL && q->pBuffers != NULL)
+		return FALSE;
+
+	while (TRUE) {
+		CHECK_FOR_USER_CANCEL;
+
+		// 1. Queue as many reads as we have free buffers
+		while ((used < q->dwDepth) && (read_offset < q->qwSize)) {
+			s = &q->Slot[tail];
+			s->qwOffset = read_offset;
+			// It is VERY IMPORTANT that we don't attempt to read past the source or target
+			// sizes, as mounted VHDs will start returning ERRONEOUS DATA if we do so.
+			s->dwSize = (DWORD)MIN(q->dwBufferSize, q->qwSize - read_offset);
+			s->bHole = IoQueueIsHole(q, read_offset, s->dwSize);
+			if (s->bHole)
+				memset(s->pBuffer, 0, s->dwSize);
+			if (!IoQueueIssue(q, s, IOQ_SLOT_READING)) {
+				if (GetLastError() != ERROR_HANDLE_EOF) {
+					uprintf("\r\nRead error: %s", WindowsErrorString());
+					ErrorStatus = RUFUS_ERROR(ERROR_READ_FAULT);
+					goto out;
+				}
+				s->dwSize = 0;
+			}
+			read_offset += q->dwBufferSize;
+			tail = (tail + 1) % q->dwDepth;
+			used++;
+		}
+		if (used == 0)
+			break;
+
+		// 2. If the oldest read has completed (or we have no write to wait on), send it to the target
+		s = &q->Slot[rhead];
+		if ((s->iState == IOQ_SLOT_READING) && ((nb_writes == 0) || (q->hSource == NULL) || s->bHole ||
+			HasOverlappedIoCompleted((OVERLAPPED*)&s->Overlapped))) {
+			if (!IoQueueWait(q, s, &size)) {
+				uprintf("\r\nRead error: %s", WindowsErrorString());
+				ErrorStatus = RUFUS_ERROR(ERROR_READ_FAULT);
+				goto out;
+			}
+			if (size == 0) {
+				// Source is shorter than expected => Don't issue any more reads
+				read_offset = q->qwSize;
+			} else if (size % q->dwSectorSize != 0) {
+				// WriteFile fails unless the size is a multiple of sector size
+				memset(&s->pBuffer[size], 0, HI_ALIGN_X_TO_Y(size, q->dwSectorSize) - size);
+				size = HI_ALIGN_X_TO_Y(size, q->dwSectorSize);
+			}
+			s->dwSize = size;
+			// The I/Os of the other slots remain in flight while we hash this one
+			if ((q->pDigests != NULL) && (size != 0)) {
+				HashBuffer(q->iHashType, s->pBuffer, size,
+					&q->pDigests[(s->qwOffset / q->dwBufferSize) * hash_count[q->iHashType]]);
+				q->qwHashed = s->qwOffset + size;
+			}
+			s->dwStart = s->dwEnd = 0;
+			if (!IoQueueNext(q, s))
+				goto out;
+			rhead = (rhead + 1) % q->dwDepth;
+			nb_writes++;
+			continue;
+		}
+
+		// 3. Wait for the oldest check or write to complete, and release its buffer once
+		// there is nothing left to write from it
+		s = &q->Slot[whead];
+		if_not_assert(s->iState == IOQ_SLOT_WRITING || s->iState == IOQ_SLOT_CHECKING)
+			goto out;
+		s_ok = IoQueueWait(q, s, &size);
+		if (s->iState == IOQ_SLOT_CHECKING) {
+			if (!s_ok || (size != s->dwEnd - s->dwStart) || !IsBufferZero(&s->pBuffer[s->dwStart], size)) {
+				// The target data differs (or couldn't be read) => write the zeroes
+				memset(&s->pBuffer[s->dwStart], 0, s->dwEnd - s->dwStart);
+				if (!IoQueueIssue(q, s, IOQ_SLOT_WRITING) && !IoQueueRetryWrite(q, s, FALSE, 0))
+					goto out;
+				continue;
+			}
+			q->qwSkipped += size;
+		} else {
+			if ((!s_ok || size != s->dwEnd - s->dwStart) && !IoQueueRetryWrite(q, s, s_ok, size))
+				goto out;
+			q->qwWritten += s->dwEnd - s->dwStart;
+		}
+		if (s->dwEnd < s->dwSize) {
+			if (!IoQueueNext(q, s))
+				goto out;
+			if (s->dwStart != s->dwEnd)
+				continue;
+		}
+		s->iState = IOQ_SLOT_FREE;
+		whead = (whead + 1) % q->dwDepth;
+		used--;
+		nb_writes--;
+
+		done = MIN(q->qwWritten + q->qwSkipped, q->qwSize);
+		UpdateProgressWithInfo(OP_FORMAT, nMsg, done, q->qwSize);
+		cur_value = (done * 80) / q->qwSize;
+		for (; cur_value > last_value && last_value < 80; last_value++)
+			uprintfs("+");
+	}
+	return TRUE;
+
+out:
+	IoQueueDrain(q);
+	return FALSE;
+}
+
+/// <summary>
+/// Have IoQueueCopy() compute the hash of each buffer sized range of the data it writes,
+/// so that the target can then be checked against it with IoQueueVerify().
+/// </summary>
+/// <param name="q">An initialized queue</param>
+/// <param name="iHashType">The type of hash to use</param>
+/// <returns>TRUE on success, FALSE on error</returns>
+BOOL IoQueueSetHash(IO_QUEUE* q, int iHashType)
+{
+	if_not_assert(q != NULL && q->pBuffers != NULL && iHashType >= 0 && iHashType < HASH_MAX)
+		return FALSE;
+	safe_free(q->pDigests);
+	q->iHashType = iHashType;
+	q->qwHashed = 0;
+	q->pDigests = (uint8_t*)calloc((size_t)((q->qwSize + q->dwBufferSize - 1) / q->dwBufferSize),
+		hash_count[iHashType]);
+	if (q->pDigests == NULL) {
+		SetLastError(ERROR_NOT_ENOUGH_MEMORY);
+		return FALSE;
+	}
+	return TRUE;
+}
+
+/* Hash the buffer of a slot, from a thread pool thread */
+static DWORD WINAPI IoQueueHashWorker(LPVOID param)
+{
+	IO_QUEUE_SLOT* s = (IO_QUEUE_SLOT*)param;
+
+	HashBuffer(s->iHashType, s->pBuffer, s->dwSize, s->pDigest);
+	SetEvent(s->hHashed);
+	return 0;
+}
+
+/* Read a section of a file or device synchronously, through the overlapped structure of a slot */
+static BOOL IoQueueReadAt(HANDLE h, IO_QUEUE_SLOT* s, uint8_t* pBuf, DWORD dwSize, uint64_t qwOffset, DWORD* pdwRead)
+{
+	*pdwRead = 0;
+	s->Overlapped.Internal[0] = 0;
+	s->Overlapped.Internal[1] = 0;
+	s->Overlapped.Offset = qwOffset;
+	if (!ReadFile(h, pBuf, dwSize, NULL, (OVERLAPPED*)&s->Overlapped) && (GetLastError() != ERROR_IO_PENDING))
+		return (GetLastError() == ERROR_HANDLE_EOF);
+	if (!GetOverlappedResult(h, (OVERLAPPED*)&s->Overlapped, pdwRead, TRUE))
+		return (GetLastError() == ERROR_HANDLE_EOF || GetLastError() == ERROR_SECTOR_NOT_FOUND);
+	return TRUE;
+}
+
+/* Compare a range of the source and the device, and report the first sector that differs */
+static void IoQueueReportMismatch(IO_QUEUE* q, HANDLE hDevice, uint64_t qwOffset, DWORD dwSize)
+{
+	DWORD i, size;
+	uint8_t* buf = NULL;
+	IO_QUEUE_SLOT* s = &q->Slot[0];
+
+	buf = (uint8_t*)_mm_malloc(q->dwBufferSize, q->dwSectorSize);
+	if ((buf == NULL) || !IoQueueReadAt(hDevice, s, buf, dwSize, qwOffset, &size) || (size != dwSize) ||
+		!IoQueueReadAt(q->hSource, s, s->pBuffer, dwSize, qwOffset, &size)) {
+		uprintf("Could not read the mismatched data: %s", WindowsErrorString());
+		goto out;
+	}
+	// Data past the end of the source was written as zeroes
+	memset(&s->pBuffer[size], 0, dwSize - size);
+	for (i = 0; i < dwSize; i += q->dwSectorSize) {
+		if (memcmp(&s->pBuffer[i], &buf[i], q->dwSectorSize) != 0) {
+			uprintf("First mismatch at sector %lld (offset 0x%llx)", (qwOffset + i) / q->dwSectorSize, qwOffset + i);
+			goto out;
+		}
+	}
+	// The device may not return the same data on every read
+	uprintf("Could not locate the mismatch on second read");
+
+out:
+	safe_mm_free(buf);
+}
+
+/// <summary>
+/// Read back the data that was written by IoQueueCopy(), and check that it matches the
+/// source. Reads are issued with the same depth as the queue, and the buffers are hashed
+/// on thread pool threads as soon as they are read, so that hashing overlaps with I/O.
+/// </summary>
+/// <param name="q">A queue that was set up with IoQueueSetHash() and used with IoQueueCopy()</param>
+/// <param name="hDevice">An overlapped or synchronous handle to read back the data from</param>
+/// <param name="nMsg">The message ID to use when reporting progress</param>
+/// <returns>TRUE if the data matches, FALSE otherwise (in which case ErrorStatus is set)</returns>
+BOOL IoQueueVerify(IO_QUEUE* q, HANDLE hDevice, int nMsg)
+{
+	BOOL ret = FALSE;
+	DWORD i, size, hash_size, rhead = 0, whead = 0, tail = 0, used = 0, nb_hashing = 0;
+	uint64_t read_offset = 0, done = 0, cur_value, last_value = 0;
+	uint8_t* digests = NULL;
+	HANDLE hSource;
+	IO_QUEUE_SLOT* s;
+
+	if_not_assert(q != NULL && q->pDigests != NULL && hDevice != NULL && hDevice != INVALID_HANDLE_VALUE)
+		return FALSE;
+	if (q->qwHashed == 0)
+		return TRUE;
+	hash_size = hash_count[q->iHashType];
+	digests = (uint8_t*)malloc((size_t)q->dwDepth * hash_size);
+	if (digests == NULL) {
+		ErrorStatus = RUFUS_ERROR(ERROR_NOT_ENOUGH_MEMORY);
+		return FALSE;
+	}
+	for (i = 0; i < q->dwDepth; i++) {
+		q->Slot[i].iState = IOQ_SLOT_FREE;
+		q->Slot[i].iHashType = q->iHashType;
+		q->Slot[i].pDigest = &digests[i * hash_size];
+		if (q->Slot[i].hHashed == NULL)
+			q->Slot[i].hHashed = CreateEventA(NULL, TRUE, FALSE, NULL);
+		if (q->Slot[i].hHashed == NULL) {
+			ErrorStatus = RUFUS_ERROR(GetLastError());
+			free(digests);
+			return FALSE;
+		}
+	}
+
+	// The device becomes the source of the queue for the duration of the readback
+	hSource = q->hSource;
+	q->hSource = hDevice;
+
+	while (TRUE) {
+		CHECK_FOR_USER_CANCEL;
+
+		// 1. Queue as many reads as we have free buffers
+		while ((used < q->dwDepth) && (read_offset < q->qwHashed)) {
+			s = &q->Slot[tail];
+			s->qwOffset = read_offset;
+			s->dwSize = (DWORD)MIN(q->dwBufferSize, q->qwHashed - read_offset);
+			s->bHole = FALSE;
+			if (!IoQueueIssue(q, s, IOQ_SLOT_READING)) {
+				uprintf("\r\nRead error: %s", WindowsErrorString());
+				ErrorStatus = RUFUS_ERROR(ERROR_READ_FAULT);
+				goto out;
+			}
+			read_offset += s->dwSize;
+			tail = (tail + 1) % q->dwDepth;
+			used++;
+		}
+		if (used == 0)
+			break;
+
+		// 2. If the oldest read has completed (or we have nothing else to wait on), hash it in the background
+		s = &q->Slot[rhead];
+		if ((s->iState == IOQ_SLOT_READING) && ((nb_hashing == 0) ||
+			HasOverlappedIoCompleted((OVERLAPPED*)&s->Overlapped))) {
+			if (!IoQueueWait(q, s, &size) || (size != s->dwSize)) {
+				uprintf("\r\nRead error at sector %lld: %s", s->qwOffset / q->dwSectorSize, WindowsErrorString());
+				ErrorStatus = RUFUS_ERROR(ERROR_READ_FAULT);
+				goto out;
+			}
+			s->iState = IOQ_SLOT_HASHING;
+			ResetEvent(s->hHashed);
+			if (!QueueUserWorkItem(IoQueueHashWorker, s, WT_EXECUTEDEFAULT))
+				IoQueueHashWorker(s);
+			rhead = (rhead + 1) % q->dwDepth;
+			nb_hashing++;
+			continue;
+		}
+
+		// 3. Wait for the oldest hash to complete, compare it and release its buffer
+		s = &q->Slot[whead];
+		if_not_assert(s->iState == IOQ_SLOT_HASHING)
+			goto out;
+		WaitForSingleObject(s->hHashed, INFINITE);
+		s->iState = IOQ_SLOT_FREE;
+		if (memcmp(s->pDigest, &q->pDigests[(s->qwOffset / q->dwBufferSize) * hash_size], hash_size) != 0) {
+			uprintf("\r\nVerification failed: Data mismatch between offsets 0x%llx and 0x%llx",
+				s->qwOffset, s->qwOffset + s->dwSize);
+			IoQueueDrain(q);
+			q->hSource = hSource;
+			IoQueueReportMismatch(q, hDevice, s->qwOffset, s->dwSize);
+			ErrorStatus = RUFUS_ERROR(ERROR_CRC);
+			goto out;
+		}
+		whead = (whead + 1) % q->dwDepth;
+		used--;
+		nb_hashing--;
+
+		done += s->dwSize;
+		UpdateProgressWithInfo(OP_FORMAT, nMsg, done, q->qwHashed);
+		cur_value = (done * 80) / q->qwHashed;
+		for (; cur_value > last_value && last_value < 80; last_value++)
+			uprintfs("+");
+	}
+	ret = TRUE;
+
+out:
+	if (q->hSource == hDevice) {
+		IoQueueDrain(q);
+		q->hSource = hSource;
+	}
+	for (i = 0; i < q->dwDepth; i++)
+		q->Slot[i].pDigest = NULL;
+	free(digests);
+	return ret;
+}
+
+/// <summary>
+/// Release the resources used by an I/O queue, after cancelling any pending I/O.
+/// </summary>
+/// <param name="q">The queue to release</param>
+void IoQueueExit(IO_QUEUE* q)
+{
+	DWORD i;
+
+	if (q == NULL)
+		return;
+	IoQueueDrain(q);
+	for (i = 0; i < IOQ_MAX_DEPTH; i++) {
+		safe_closehandle(q->Slot[i].Overlapped.hEvent);
+		safe_closehandle(q->Slot[i].hHashed);
+		q->Slot[i].pBuffer = NULL;
+	}
+	safe_free(q->pExtents);
+	safe_free(q->pDigests);
+	safe_mm_free(q->pBuffers);
+}
+
+/* Write the blocks handed over by the producer, in order, until we get an empty one */
+static DWORD WINAPI WriteQueueThread(void* param)
+{
+	WRITE_QUEUE* q = (WRITE_QUEUE*)param;
+	DWORD size;
+
+	while (WaitForSingleObject(q->hFull, INFINITE) == WAIT_OBJECT_0) {
+		size = q->dwSize[q->dwConsumer];
+		if (size == 0)
+			break;
+		// On error or cancellation, keep consuming blocks so that the producer never stalls
+		if (IS_ERROR(ErrorStatus) && (SCODE_CODE(ErrorStatus) == ERROR_CANCELLED))
+			InterlockedCompareExchange(&q->lError, ERROR_CANCELLED, 0);
+		if (q->lError == 0) {
+			if (WriteFileWithRetry(q->hTarget, &q->pBuffers[(size_t)q->dwConsumer * q->dwBufferSize],
+				size, NULL, WRITE_RETRIES))
+				q->qwWritten += size;
+			else
+				InterlockedCompareExchange(&q->lError, ERROR_WRITE_FAULT, 0);
+		}
+		q->dwConsumer = (q->dwConsumer + 1) % q->dwDepth;
+		ReleaseSemaphore(q->hFree, 1, NULL);
+	}
+	ExitThread(0);
+}
+
+/// <summary>
+/// Initialize a write queue and start its writer thread.
+/// The target handle must not be used by anything else until WriteQueueFlush()
+/// or WriteQueueExit() has been called.
+/// </summary>
+/// <param name="q">The queue to initialize</param>
+/// <param name="hTarget">A synchronous target handle</param>
+/// <param name="dwSectorSize">The sector size to align buffers and writes to</param>
+/// <param name="dwBufferSize">The size of each individual block</param>
+/// <param name="dwDepth">The number of blocks</param>
+/// <returns>TRUE on success, FALSE on error</returns>
+BOOL WriteQueueInit(WRITE_QUEUE* q, HANDLE hTarget, DWORD dwSectorSize, DWORD dwBufferSize, DWORD dwDepth)
+{
+	if_not_assert(q != NULL)
+		return FALSE;
+	memset(q, 0, sizeof(WRITE_QUEUE));
+	if_not_assert(hTarget != NULL && hTarget != INVALID_HANDLE_VALUE && IS_POWER_OF_2(dwSectorSize))
+		return FALSE;
+
+	q->hTarget = hTarget;
+	q->dwSectorSize = dwSectorSize;
+	// We need at least two blocks, for the producer and consumer to run in parallel
+	q->dwDepth = min(max(dwDepth, 2), IOQ_MAX_DEPTH);
+	q->dwBufferSize = HI_ALIGN_X_TO_Y(max(dwBufferSize, dwSectorSize), dwSectorSize);
+	q->pBuffers = (uint8_t*)_mm_malloc((size_t)q->dwBufferSize * q->dwDepth, dwSectorSize);
+	if (q->pBuffers == NULL) {
+		SetLastError(ERROR_NOT_ENOUGH_MEMORY);
+		return FALSE;
+	}
+	// The producer always owns one block, so it doesn't count as free
+	q->hFree = CreateSemaphoreA(NULL, q->dwDepth - 1, q->dwDepth, NULL);
+	q->hFull = CreateSemaphoreA(NULL, 0, q->dwDepth, NULL);
+	if ((q->hFree == NULL) || (q->hFull == NULL))
+		goto out;
+	q->hThread = CreateThread(NULL, 0, WriteQueueThread, (LPVOID)q, 0, NULL);
+	if (q->hThread == NULL)
+		goto out;
+	return TRUE;
+
+out:
+	WriteQueueExit(q);
+	return FALSE;
+}
+
+/* Hand the current block over to the writer thread and wait for the next one */
+static BOOL WriteQueueSubmit(WRITE_QUEUE* q)
+{
+	q->dwSize[q->dwProducer] = q->dwFill;
+	q->dwProducer = (q->dwProducer + 1) % q->dwDepth;
+	q->dwFill = 0;
+	ReleaseSemaphore(q->hFull, 1, NULL);
+	return (WaitForSingleObject(q->hFree, INFINITE) == WAIT_OBJECT_0);
+}
+
+/// <summary>
+/// Append data to a write queue. The data is written once a full block is available.
+/// </summary>
+/// <param name="q">An initialized queue</param>
+/// <param name="pBuf">The data to write</param>
+/// <param name="dwSize">The size of the data</param>
+/// <returns>The number of bytes queued or -1 on error</returns>
+int WriteQueuePush(WRITE_QUEUE* q, const void* pBuf, DWORD dwSize)
+{
+	const uint8_t* buf = (const uint8_t*)pBuf;
+	DWORD size, pos = 0;
+
+	if_not_assert(q != NULL && q->hThread != NULL && dwSize <= INT_MAX)
+		return -1;
+
+	while (pos < dwSize) {
+		if (q->lError != 0) {
+			SetLastError(RUFUS_ERROR(q->lError));
+			return -1;
+		}
+		size = min(dwSize - pos, q->dwBufferSize - q->dwFill);
+		memcpy(&q->pBuffers[(size_t)q->dwProducer * q->dwBufferSize + q->dwFill], &buf[pos], size);
+		q->dwFill += size;
+		pos += size;
+		if ((q->dwFill == q->dwBufferSize) && !WriteQueueSubmit(q))
+			return -1;
+	}
+	return (int)dwSize;
+}
+
+/// <summary>
+/// Write any remaining data, padded with zeroes up to the next sector boundary,
+/// and wait for the writer thread to complete.
+/// </summary>
+/// <param name="q">An initialized queue</param>
+/// <returns>TRUE if all the data was written, FALSE otherwise</returns>
+BOOL WriteQueueFlush(WRITE_QUEUE* q)
+{
+	DWORD size;
+
+	if_not_assert(q != NULL && q->hThread != NULL)
+		return FALSE;
+
+	if (q->dwFill != 0) {
+		size = HI_ALIGN_X_TO_Y(q->dwFill, q->dwSectorSize);
+		memset(&q->pBuffers[(size_t)q->dwProducer * q->dwBufferSize + q->dwFill], 0, size - q->dwFill);
+		q->dwFill = size;
+		WriteQueueSubmit(q);
+	}
+	// An empty block tells the writer thread to exit
+	q->dwSize[q->dwProducer] = 0;
+	ReleaseSemaphore(q->hFull, 1, NULL);
+	WaitForSingleObject(q->hThread, INFINITE);
+	CloseHandle(q->hThread);
+	q->hThread = NULL;
+	return (q->lError == 0);
+}
+
+/// <summary>
+/// Stop the writer thread, discarding any data that hasn't been submitted, and
+/// release the resources used by a write queue.
+/// </summary>
+/// <param name="q">The queue to release</param>
+void WriteQueueExit(WRITE_QUEUE* q)
+{
+	if (q == NULL)
+		return;
+	if (q->hThread != NULL) {
+		// Tell the writer thread to skip pending blocks and exit
+		InterlockedCompareExchange(&q->lError, ERROR_CANCELLED, 0);
+		q->dwSize[q->dwProducer] = 0;
+		ReleaseSemaphore(q->hFull, 1, NULL);
+		WaitForSingleObject(q->hThread, INFINITE);
+		CloseHandle(q->hThread);
+		q->hThread = NULL;
+	}
+	safe_closehandle(q->hFree);
+	safe_closehandle(q->hFull);
+	safe_mm_free(q->pBuffers);
+}
+
+#if defined(RUFUS_TEST)
+/*
+ * Benchmark the DD write pipeline, at various queue depths, using a sparse image file as target.
+ */
+BOOL IoQueueBenchmark(const char* src, const char* dst)
+{
+	BOOL r = FALSE;
+	DWORD depth, size;
+	HANDLE hSrc = INVALID_HANDLE_VALUE, hDst = INVALID_HANDLE_VALUE;
+	LARGE_INTEGER li;
+	IO_QUEUE q = { 0 };
+	uint64_t start, elapsed;
+
+	for (depth = 1; depth <= IOQ_MAX_DEPTH / 2; depth <<= 1) {
+		hSrc = CreateFileU(src, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+			FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if ((hSrc == INVALID_HANDLE_VALUE) || !GetFileSizeEx(hSrc, &li)) {
+			uprintf("Could not open '%s': %s", src, WindowsErrorString());
+			goto out;
+		}
+		// FSCTL_SET_SPARSE must be issued on a synchronous handle
+		hDst = CreateFileU(dst, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+		if ((hDst == INVALID_HANDLE_VALUE) || !DeviceIoControl(hDst, FSCTL_SET_SPARSE, NULL, 0, NULL, 0, &size, NULL))
+			uprintf("Warning: Could not create sparse file '%s': %s", dst, WindowsErrorString());
+		safe_closehandle(hDst);
+		hDst = CreateFileU(dst, GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_EXISTING,
+			FILE_FLAG_OVERLAPPED | FILE_FLAG_NO_BUFFERING, NULL);
+		if (hDst == INVALID_HANDLE_VALUE) {
+			uprintf("Could not open '%s': %s", dst, WindowsErrorString());
+			goto out;
+		}
+		if (!IoQueueInit(&q, hSrc, hDst, li.QuadPart, 4096, (2 * DD_BUFFER_SIZE) / depth, depth)) {
+			uprintf("Could not initialize I/O queue: %s", WindowsErrorString());
+			goto out;
+		}
+		start = GetTickCount64();
+		uprintf("Queue depth %d:", depth);
+		if (!IoQueueCopy(&q, MSG_261))
+			goto out;
+		elapsed = max(GetTickCount64() - start, 1);
+		uprintf("\r\n%s written in %0.2f s (%0.1f MB/s)", SizeToHumanReadable(q.qwWritten, FALSE, FALSE),
+			elapsed / 1000.0f, (1000.0f * q.qwWritten) / (1.0f * MB * elapsed));
+		IoQueueExit(&q);
+		safe_closehandle(hSrc);
+		safe_closehandle(hDst);
+	}
+	r = TRUE;
+
+out:
+	IoQueueExit(&q);
+	safe_closehandle(hSrc);
+	safe_closehandle(hDst);
+	DeleteFileU(dst);
+	return r;
+}
+#endif
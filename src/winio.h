@@ -19,10 +19,15 @@
 */
 
 #include <windows.h>
+#include <winioctl.h>
+#include <stdint.h>
 #include "msapi_utf8.h"
 
 #pragma once
 
+// Maximum number of buffers that can be used by an I/O queue
+#define IOQ_MAX_DEPTH                       32
+
 // https://docs.microsoft.com/en-us/windows/win32/api/minwinbase/ns-minwinbase-overlapped
 // See Microsoft? It's not THAT hard to define an OVERLAPPED struct in a manner that
 // doesn't qualify as an example of "Crimes against humanity" in the Geneva convention.
@@ -175,3 +180,99 @@ static __inline BOOL GetSizeAsync(HANDLE h, LPDWORD lpNumberOfBytes)
 	fd->Overlapped.Offset += *lpNumberOfBytes;
 	return TRUE;
 }
+
+/*
+ * Asynchronous I/O queues.
+ * These are used to keep multiple sequential reads and writes in flight at
+ * once, so that fast devices are not left idle while we wait for a single
+ * synchronous write to complete. Completion is always processed in order.
+ */
+enum ioq_slot_state {
+	IOQ_SLOT_FREE = 0,
+	IOQ_SLOT_READING,
+	IOQ_SLOT_CHECKING,
+	IOQ_SLOT_WRITING,
+	IOQ_SLOT_HASHING,
+};
+
+// Granularity at which zeroed data is detected in sparse mode
+#define IOQ_SPARSE_BLOCK_SIZE               (64 * 1024)
+
+typedef struct {
+	NOW_THATS_WHAT_I_CALL_AN_OVERLAPPED Overlapped;
+	uint8_t*                            pBuffer;
+	uint64_t                            qwOffset;	// Source and target offset of the buffer
+	DWORD                               dwSize;
+	DWORD                               dwStart;	// Start of the buffer range being checked or written
+	DWORD                               dwEnd;		// End of the buffer range being checked or written
+	BOOL                                bHole;		// The data comes from a hole in the source and wasn't read
+	int                                 iState;
+	int                                 iHashType;
+	uint8_t*                            pDigest;	// Where to store the hash of the buffer when verifying
+	HANDLE                              hHashed;	// Signaled once the buffer has been hashed
+} IO_QUEUE_SLOT;
+
+typedef struct {
+	HANDLE                              hSource;	// Overlapped source, or NULL to write the buffers as is
+	HANDLE                              hTarget;	// Overlapped or synchronous target
+	uint64_t                            qwSize;		// Number of bytes to process
+	uint64_t                            qwWritten;	// Number of bytes written so far
+	uint64_t                            qwSkipped;	// Number of bytes that didn't need to be written
+	BOOL                                bSparse;	// Don't write zeroed blocks that the target already has
+	BOOL                                bTargetZeroed;	// The target is known to read back as zero
+	DWORD                               dwSectorSize;
+	DWORD                               dwBufferSize;
+	DWORD                               dwDepth;
+	DWORD                               dwNbExtents;
+	DWORD                               dwExtent;
+	FILE_ALLOCATED_RANGE_BUFFER*        pExtents;	// Allocated ranges of a sparse source, or NULL
+	int                                 iHashType;
+	uint64_t                            qwHashed;	// Number of bytes for which we have digests
+	uint8_t*                            pDigests;	// Digests of each buffer sized range, or NULL
+	uint8_t*                            pBuffers;
+	IO_QUEUE_SLOT                       Slot[IOQ_MAX_DEPTH];
+} IO_QUEUE;
+
+extern BOOL IsBufferFilled(const void* pBuf, size_t size, uint8_t val);
+extern BOOL IsBufferZero(const void* pBuf, size_t size);
+extern BOOL IsBufferBlank(const void* pBuf, size_t size);
+extern BOOL IsBufferEqual(const void* pBuf1, const void* pBuf2, size_t size);
+extern HANDLE ReOpenFileAsync(HANDLE hFile, DWORD dwDesiredAccess);
+extern BOOL IoQueueInit(IO_QUEUE* q, HANDLE hSource, HANDLE hTarget, uint64_t qwSize,
+	DWORD dwSectorSize, DWORD dwBufferSize, DWORD dwDepth);
+extern BOOL IoQueueSetSparse(IO_QUEUE* q, BOOL bTargetZeroed);
+extern BOOL IoQueueSetHash(IO_QUEUE* q, int iHashType);
+extern BOOL IoQueueCopy(IO_QUEUE* q, int nMsg);
+extern BOOL IoQueueVerify(IO_QUEUE* q, HANDLE hDevice, int nMsg);
+extern void IoQueueExit(IO_QUEUE* q);
+#if defined(RUFUS_TEST)
+extern BOOL IoQueueBenchmark(const char* src, const char* dst);
+#endif
+
+/*
+ * Write queues.
+ * These let a producer, such as a decompressor, hand over sector aligned blocks
+ * of data to a dedicated writer thread, so that producing the data and writing
+ * it to the target can happen in parallel.
+ */
+typedef struct {
+	HANDLE                              hTarget;
+	HANDLE                              hThread;
+	HANDLE                              hFree;		// Semaphore for the blocks available to the producer
+	HANDLE                              hFull;		// Semaphore for the blocks ready to be written
+	DWORD                               dwSectorSize;
+	DWORD                               dwBufferSize;
+	DWORD                               dwDepth;
+	DWORD                               dwProducer;	// Index of the block being filled
+	DWORD                               dwConsumer;	// Index of the block being written
+	DWORD                               dwFill;		// Number of bytes in the block being filled
+	DWORD                               dwSize[IOQ_MAX_DEPTH];
+	volatile LONG                       lError;
+	uint64_t                            qwWritten;
+	uint8_t*                            pBuffers;
+} WRITE_QUEUE;
+
+extern BOOL WriteQueueInit(WRITE_QUEUE* q, HANDLE hTarget, DWORD dwSectorSize, DWORD dwBufferSize, DWORD dwDepth);
+extern int WriteQueuePush(WRITE_QUEUE* q, const void* pBuf, DWORD dwSize);
+extern BOOL WriteQueueFlush(WRITE_QUEUE* q);
+extern void WriteQueueExit(WRITE_QUEUE* q);